@@ -35,6 +35,8 @@
     "test/cxx/Core/ApplicationPool/OptionsTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/Core/ApplicationPool/ProcessTest.o" =>
     "test/cxx/Core/ApplicationPool/ProcessTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/Core/ApplicationPool/ProcessRoutingTableTest.o" =>
+    "test/cxx/Core/ApplicationPool/ProcessRoutingTableTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/Core/ApplicationPool/PoolTest.o" =>
     "test/cxx/Core/ApplicationPool/PoolTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/Core/SpawningKit/DirectSpawnerTest.o" =>
@@ -44,6 +46,10 @@
 
   "#{TEST_OUTPUT_DIR}cxx/Core/ResponseCacheTest.o" =>
     "test/cxx/Core/ResponseCacheTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/Core/ResponseHeaderTemplatesTest.o" =>
+    "test/cxx/Core/ResponseHeaderTemplatesTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/Core/SharedResponseCacheTest.o" =>
+    "test/cxx/Core/SharedResponseCacheTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/Core/SecurityUpdateCheckerTest.o" =>
       "test/cxx/Core/SecurityUpdateCheckerTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/Core/ControllerTest.o" =>
@@ -57,8 +63,16 @@
     "test/cxx/ServerKit/HeaderTableTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/ServerKit/ServerTest.o" =>
     "test/cxx/ServerKit/ServerTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/ServerKit/AcceptLoadBalancerTest.o" =>
+    "test/cxx/ServerKit/AcceptLoadBalancerTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/ServerKit/HttpServerTest.o" =>
     "test/cxx/ServerKit/HttpServerTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/ServerKit/HttpParserTest.o" =>
+    "test/cxx/ServerKit/HttpParserTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/ServerKit/HttpChunkedBodyParserTest.o" =>
+    "test/cxx/ServerKit/HttpChunkedBodyParserTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/ServerKit/HttpHeaderParserTest.o" =>
+    "test/cxx/ServerKit/HttpHeaderParserTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/ServerKit/CookieUtilsTest.o" =>
     "test/cxx/ServerKit/CookieUtilsTest.cpp",
 
@@ -80,6 +94,10 @@
     "test/cxx/DataStructures/LStringTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/DataStructures/StringKeyTableTest.o" =>
     "test/cxx/DataStructures/StringKeyTableTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/DataStructures/HashedStaticStringTest.o" =>
+    "test/cxx/DataStructures/HashedStaticStringTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/DataStructures/IndexedMinHeapTest.o" =>
+    "test/cxx/DataStructures/IndexedMinHeapTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/MessageReadersWritersTest.o" =>
     "test/cxx/MessageReadersWritersTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/StaticStringTest.o" =>
@@ -90,6 +108,10 @@
     "test/cxx/FileDescriptorTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/SystemTimeTest.o" =>
     "test/cxx/SystemTimeTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/SafeLibevTest.o" =>
+    "test/cxx/SafeLibevTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/ShardedSharedMutexTest.o" =>
+    "test/cxx/ShardedSharedMutexTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/FilterSupportTest.o" =>
     "test/cxx/FilterSupportTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/CachedFileStatTest.o" =>
@@ -12,6 +12,7 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
@@ -30,6 +31,7 @@
    "src/agent/Core/UnionStation/StopwatchLog.h",
    "src/agent/Core/UnionStation/Transaction.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
    "src/cxx_supportlib/ConfigKit/AsyncUtils.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
@@ -42,6 +44,7 @@
    "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
@@ -78,6 +81,7 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -114,6 +118,7 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/ConfigChange.h",
@@ -122,8 +127,11 @@
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseHeaderTemplates.h",
    "src/agent/Core/Controller/TurboCaching.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/ResponseCompressor.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/DirectSpawner.h",
@@ -154,6 +162,7 @@
    "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/LString.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
@@ -193,6 +202,7 @@
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParser.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParserState.h",
    "src/cxx_supportlib/ServerKit/HttpRequest.h",
@@ -220,6 +230,7 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -424,6 +435,7 @@
    "src/cxx_supportlib/Utils/MemZeroGuard.h",
    "src/cxx_supportlib/Utils/MessageIO.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
    "src/cxx_supportlib/Utils/SystemTime.h",
@@ -550,6 +562,7 @@
    "src/agent/Core/ApplicationPool/Context.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
@@ -567,9 +580,11 @@
    "src/agent/Core/UnionStation/Context.h",
    "src/agent/Core/UnionStation/Transaction.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
@@ -602,6 +617,7 @@
    "src/cxx_supportlib/Utils/MessageIO.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
    "src/cxx_supportlib/Utils/StringScanning.h",
@@ -633,6 +649,7 @@
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
@@ -650,9 +667,11 @@
    "src/agent/Core/UnionStation/Context.h",
    "src/agent/Core/UnionStation/Transaction.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
@@ -685,6 +704,7 @@
    "src/cxx_supportlib/Utils/MessageIO.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
    "src/cxx_supportlib/Utils/StringScanning.h",
@@ -716,6 +736,7 @@
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
@@ -733,9 +754,11 @@
    "src/agent/Core/UnionStation/Context.h",
    "src/agent/Core/UnionStation/Transaction.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
@@ -768,6 +791,7 @@
    "src/cxx_supportlib/Utils/MessageIO.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
    "src/cxx_supportlib/Utils/StringScanning.h",
@@ -799,6 +823,7 @@
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
@@ -816,9 +841,11 @@
    "src/agent/Core/UnionStation/Context.h",
    "src/agent/Core/UnionStation/Transaction.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
@@ -851,6 +878,7 @@
    "src/cxx_supportlib/Utils/MessageIO.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
    "src/cxx_supportlib/Utils/StringScanning.h",
@@ -882,6 +910,7 @@
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
@@ -899,9 +928,11 @@
    "src/agent/Core/UnionStation/Context.h",
    "src/agent/Core/UnionStation/Transaction.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
@@ -934,6 +965,7 @@
    "src/cxx_supportlib/Utils/MessageIO.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
    "src/cxx_supportlib/Utils/StringScanning.h",
@@ -965,6 +997,7 @@
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
@@ -982,9 +1015,11 @@
    "src/agent/Core/UnionStation/Context.h",
    "src/agent/Core/UnionStation/Transaction.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
@@ -1018,6 +1053,7 @@
    "src/cxx_supportlib/Utils/MessageIO.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
    "src/cxx_supportlib/Utils/StringScanning.h",
@@ -1049,6 +1085,7 @@
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
@@ -1066,9 +1103,11 @@
    "src/agent/Core/UnionStation/Context.h",
    "src/agent/Core/UnionStation/Transaction.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
@@ -1101,6 +1140,7 @@
    "src/cxx_supportlib/Utils/MessageIO.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
    "src/cxx_supportlib/Utils/StringScanning.h",
@@ -1132,6 +1172,7 @@
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
@@ -1149,9 +1190,11 @@
    "src/agent/Core/UnionStation/Context.h",
    "src/agent/Core/UnionStation/Transaction.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
@@ -1184,6 +1227,7 @@
    "src/cxx_supportlib/Utils/MessageIO.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
    "src/cxx_supportlib/Utils/StringScanning.h",
@@ -1215,6 +1259,7 @@
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
@@ -1232,9 +1277,11 @@
    "src/agent/Core/UnionStation/Context.h",
    "src/agent/Core/UnionStation/Transaction.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
@@ -1267,6 +1314,7 @@
    "src/cxx_supportlib/Utils/MessageIO.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
    "src/cxx_supportlib/Utils/StringScanning.h",
@@ -1298,6 +1346,7 @@
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
@@ -1315,9 +1364,11 @@
    "src/agent/Core/UnionStation/Context.h",
    "src/agent/Core/UnionStation/Transaction.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
@@ -1350,6 +1401,7 @@
    "src/cxx_supportlib/Utils/MessageIO.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
    "src/cxx_supportlib/Utils/StringScanning.h",
@@ -1381,6 +1433,7 @@
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
@@ -1398,9 +1451,11 @@
    "src/agent/Core/UnionStation/Context.h",
    "src/agent/Core/UnionStation/Transaction.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
@@ -1433,6 +1488,7 @@
    "src/cxx_supportlib/Utils/MessageIO.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
    "src/cxx_supportlib/Utils/StringScanning.h",
@@ -1484,6 +1540,7 @@
    "src/agent/Core/ApplicationPool/Pool/ProcessUtils.cpp",
    "src/agent/Core/ApplicationPool/Pool/StateInspection.cpp",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
@@ -1502,6 +1559,7 @@
    "src/agent/Core/UnionStation/StopwatchLog.h",
    "src/agent/Core/UnionStation/Transaction.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
@@ -1512,6 +1570,7 @@
    "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
@@ -1547,6 +1606,7 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -1619,6 +1679,7 @@
    "src/agent/Core/ApplicationPool/Group.h",
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
@@ -1637,6 +1698,7 @@
    "src/agent/Core/UnionStation/StopwatchLog.h",
    "src/agent/Core/UnionStation/Transaction.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
@@ -1647,6 +1709,7 @@
    "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
@@ -1681,6 +1744,7 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -1715,6 +1779,7 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
@@ -1733,6 +1798,7 @@
    "src/agent/Core/UnionStation/StopwatchLog.h",
    "src/agent/Core/UnionStation/Transaction.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
@@ -1743,6 +1809,7 @@
    "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
@@ -1777,6 +1844,7 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -1811,6 +1879,7 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
@@ -1829,6 +1898,7 @@
    "src/agent/Core/UnionStation/StopwatchLog.h",
    "src/agent/Core/UnionStation/Transaction.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
@@ -1839,6 +1909,7 @@
    "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
@@ -1873,6 +1944,7 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -1907,6 +1979,7 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
@@ -1925,6 +1998,7 @@
    "src/agent/Core/UnionStation/StopwatchLog.h",
    "src/agent/Core/UnionStation/Transaction.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
@@ -1935,6 +2009,7 @@
    "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
@@ -1969,6 +2044,7 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -2003,6 +2079,7 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
@@ -2021,6 +2098,7 @@
    "src/agent/Core/UnionStation/StopwatchLog.h",
    "src/agent/Core/UnionStation/Transaction.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
@@ -2031,6 +2109,7 @@
    "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
@@ -2065,6 +2144,7 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -2099,6 +2179,7 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
@@ -2117,6 +2198,7 @@
    "src/agent/Core/UnionStation/StopwatchLog.h",
    "src/agent/Core/UnionStation/Transaction.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
@@ -2127,6 +2209,7 @@
    "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
@@ -2161,6 +2244,7 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -2195,6 +2279,7 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
@@ -2213,6 +2298,7 @@
    "src/agent/Core/UnionStation/StopwatchLog.h",
    "src/agent/Core/UnionStation/Transaction.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
@@ -2223,6 +2309,7 @@
    "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
@@ -2257,6 +2344,7 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -2291,6 +2379,7 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
@@ -2309,6 +2398,7 @@
    "src/agent/Core/UnionStation/StopwatchLog.h",
    "src/agent/Core/UnionStation/Transaction.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
@@ -2319,6 +2409,7 @@
    "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
@@ -2353,6 +2444,7 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -2387,6 +2479,7 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
@@ -2405,6 +2498,7 @@
    "src/agent/Core/UnionStation/StopwatchLog.h",
    "src/agent/Core/UnionStation/Transaction.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
@@ -2415,6 +2509,7 @@
    "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
@@ -2449,6 +2544,7 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -2497,6 +2593,88 @@
    "src/agent/Core/UnionStation/Context.h",
    "src/agent/Core/UnionStation/Transaction.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
+   "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/StringKeyTable.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/FileTools/PathManip.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/LveLoggingDecorator.h",
+   "src/cxx_supportlib/MemoryKit/palloc.h",
+   "src/cxx_supportlib/ProcessManagement/Spawn.h",
+   "src/cxx_supportlib/RandomGenerator.h",
+   "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/BufferedIO.h",
+   "src/cxx_supportlib/Utils/CachedFileStat.hpp",
+   "src/cxx_supportlib/Utils/ClassUtils.h",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/HashMap.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/Lock.h",
+   "src/cxx_supportlib/Utils/MemZeroGuard.h",
+   "src/cxx_supportlib/Utils/MessageIO.h",
+   "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
+   "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/StringMap.h",
+   "src/cxx_supportlib/Utils/StringScanning.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/Utils/Timer.h",
+   "src/cxx_supportlib/Utils/VariantMap.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp"],
+ "src/agent/Core/ApplicationPool/ProcessRoutingTable.h"=>
+  ["src/agent/Core/ApplicationPool/AbstractSession.h",
+   "src/agent/Core/ApplicationPool/BasicGroupInfo.h",
+   "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
+   "src/agent/Core/ApplicationPool/Common.h",
+   "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/Options.h",
+   "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/Session.h",
+   "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
+   "src/agent/Core/SpawningKit/Config.h",
+   "src/agent/Core/SpawningKit/DirectSpawner.h",
+   "src/agent/Core/SpawningKit/DummySpawner.h",
+   "src/agent/Core/SpawningKit/Factory.h",
+   "src/agent/Core/SpawningKit/Options.h",
+   "src/agent/Core/SpawningKit/PipeWatcher.h",
+   "src/agent/Core/SpawningKit/Result.h",
+   "src/agent/Core/SpawningKit/SmartSpawner.h",
+   "src/agent/Core/SpawningKit/Spawner.h",
+   "src/agent/Core/SpawningKit/UserSwitchingRules.h",
+   "src/agent/Core/UnionStation/Connection.h",
+   "src/agent/Core/UnionStation/Context.h",
+   "src/agent/Core/UnionStation/Transaction.h",
+   "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
@@ -2530,6 +2708,7 @@
    "src/cxx_supportlib/Utils/MessageIO.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
    "src/cxx_supportlib/Utils/StringScanning.h",
@@ -2607,6 +2786,7 @@
    "src/cxx_supportlib/Utils/MessageIO.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
    "src/cxx_supportlib/Utils/StringScanning.h",
@@ -2661,6 +2841,7 @@
    "src/cxx_supportlib/Utils/MemZeroGuard.h",
    "src/cxx_supportlib/Utils/MessageIO.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
    "src/cxx_supportlib/Utils/SystemTime.h",
@@ -2708,6 +2889,7 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/ConfigChange.h",
@@ -2716,9 +2898,12 @@
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseHeaderTemplates.h",
    "src/agent/Core/Controller/TurboCaching.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/ResponseCompressor.h",
    "src/agent/Core/SecurityUpdateChecker.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/DirectSpawner.h",
@@ -2753,6 +2938,7 @@
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/Crypto.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/LString.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
@@ -2794,6 +2980,7 @@
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParser.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParserState.h",
    "src/cxx_supportlib/ServerKit/HttpRequest.h",
@@ -2822,6 +3009,7 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -2861,6 +3049,7 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/Config.h",
@@ -2870,9 +3059,12 @@
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseHeaderTemplates.h",
    "src/agent/Core/Controller/TurboCaching.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/ResponseCompressor.h",
    "src/agent/Core/SecurityUpdateChecker.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/DirectSpawner.h",
@@ -2907,6 +3099,7 @@
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/Crypto.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/LString.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
@@ -2948,6 +3141,7 @@
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParser.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParserState.h",
    "src/cxx_supportlib/ServerKit/HttpRequest.h",
@@ -2976,6 +3170,7 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -3039,14 +3234,18 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/Controller/AppResponse.h",
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseHeaderTemplates.h",
    "src/agent/Core/Controller/TurboCaching.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/ResponseCompressor.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/DirectSpawner.h",
@@ -3075,6 +3274,7 @@
    "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/LString.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
@@ -3112,6 +3312,7 @@
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParser.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParserState.h",
    "src/cxx_supportlib/ServerKit/HttpRequest.h",
@@ -3139,6 +3340,7 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -3165,7 +3367,8 @@
    "src/cxx_supportlib/oxt/thread.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
  "src/agent/Core/Controller/AppResponse.h"=>
-  ["src/cxx_supportlib/ConfigKit/Common.h",
+  ["src/cxx_supportlib/Algorithms/MovingAverage.h",
+   "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
    "src/cxx_supportlib/ConfigKit/Schema.h",
@@ -3197,6 +3400,7 @@
    "src/cxx_supportlib/ServerKit/HeaderTable.h",
    "src/cxx_supportlib/ServerKit/Hooks.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParserState.h",
    "src/cxx_supportlib/ServerKit/http_parser.h",
    "src/cxx_supportlib/StaticString.h",
@@ -3237,6 +3441,7 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/Controller.h",
@@ -3244,8 +3449,11 @@
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseHeaderTemplates.h",
    "src/agent/Core/Controller/TurboCaching.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/ResponseCompressor.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/DirectSpawner.h",
@@ -3274,6 +3482,7 @@
    "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/LString.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
@@ -3311,6 +3520,7 @@
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParser.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParserState.h",
    "src/cxx_supportlib/ServerKit/HttpRequest.h",
@@ -3338,6 +3548,7 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -3374,6 +3585,7 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/Controller.h",
@@ -3381,8 +3593,11 @@
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseHeaderTemplates.h",
    "src/agent/Core/Controller/TurboCaching.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/ResponseCompressor.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/DirectSpawner.h",
@@ -3411,6 +3626,7 @@
    "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/LString.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
@@ -3448,6 +3664,7 @@
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParser.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParserState.h",
    "src/cxx_supportlib/ServerKit/HttpRequest.h",
@@ -3475,6 +3692,7 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -3510,11 +3728,14 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/Controller/AppResponse.h",
    "src/agent/Core/Controller/Config.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/DirectSpawner.h",
@@ -3543,6 +3764,7 @@
    "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/LString.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
@@ -3568,6 +3790,7 @@
    "src/cxx_supportlib/ServerKit/ClientRef.h",
    "src/cxx_supportlib/ServerKit/Config.h",
    "src/cxx_supportlib/ServerKit/Context.h",
+   "src/cxx_supportlib/ServerKit/CookieUtils.h",
    "src/cxx_supportlib/ServerKit/Errors.h",
    "src/cxx_supportlib/ServerKit/FdSinkChannel.h",
    "src/cxx_supportlib/ServerKit/FdSourceChannel.h",
@@ -3578,6 +3801,7 @@
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParser.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParserState.h",
    "src/cxx_supportlib/ServerKit/HttpRequest.h",
@@ -3591,6 +3815,7 @@
    "src/cxx_supportlib/Utils/BufferedIO.h",
    "src/cxx_supportlib/Utils/CachedFileStat.hpp",
    "src/cxx_supportlib/Utils/ClassUtils.h",
+   "src/cxx_supportlib/Utils/DateParsing.h",
    "src/cxx_supportlib/Utils/FastStringStream.h",
    "src/cxx_supportlib/Utils/HashMap.h",
    "src/cxx_supportlib/Utils/Hasher.h",
@@ -3604,6 +3829,7 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -3639,6 +3865,7 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/Controller.h",
@@ -3646,8 +3873,11 @@
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseHeaderTemplates.h",
    "src/agent/Core/Controller/TurboCaching.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/ResponseCompressor.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/DirectSpawner.h",
@@ -3676,6 +3906,7 @@
    "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/LString.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
@@ -3713,6 +3944,7 @@
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParser.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParserState.h",
    "src/cxx_supportlib/ServerKit/HttpRequest.h",
@@ -3740,6 +3972,7 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -3806,6 +4039,7 @@
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParser.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParserState.h",
    "src/cxx_supportlib/ServerKit/HttpRequest.h",
@@ -3855,6 +4089,7 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/Controller.h",
@@ -3862,8 +4097,11 @@
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseHeaderTemplates.h",
    "src/agent/Core/Controller/TurboCaching.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/ResponseCompressor.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/DirectSpawner.h",
@@ -3892,6 +4130,7 @@
    "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/LString.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
@@ -3929,6 +4168,7 @@
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParser.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParserState.h",
    "src/cxx_supportlib/ServerKit/HttpRequest.h",
@@ -3956,6 +4196,7 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -3992,6 +4233,7 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/Controller.h",
@@ -3999,8 +4241,11 @@
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseHeaderTemplates.h",
    "src/agent/Core/Controller/TurboCaching.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/ResponseCompressor.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/DirectSpawner.h",
@@ -4029,6 +4274,7 @@
    "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/LString.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
@@ -4066,6 +4312,7 @@
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParser.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParserState.h",
    "src/cxx_supportlib/ServerKit/HttpRequest.h",
@@ -4093,6 +4340,7 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -4129,6 +4377,7 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/Controller.h",
@@ -4145,10 +4394,14 @@
    "src/agent/Core/Controller/InternalUtils.cpp",
    "src/agent/Core/Controller/Miscellaneous.cpp",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseHeaderTemplates.h",
+   "src/agent/Core/Controller/SendFile.cpp",
    "src/agent/Core/Controller/SendRequest.cpp",
    "src/agent/Core/Controller/StateInspection.cpp",
    "src/agent/Core/Controller/TurboCaching.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/ResponseCompressor.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/DirectSpawner.h",
@@ -4177,6 +4430,7 @@
    "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/LString.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
@@ -4214,6 +4468,7 @@
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParser.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParserState.h",
    "src/cxx_supportlib/ServerKit/HttpRequest.h",
@@ -4241,6 +4496,7 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -4277,6 +4533,7 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/Controller.h",
@@ -4284,8 +4541,11 @@
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseHeaderTemplates.h",
    "src/agent/Core/Controller/TurboCaching.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/ResponseCompressor.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/DirectSpawner.h",
@@ -4314,6 +4574,7 @@
    "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/LString.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
@@ -4351,6 +4612,7 @@
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParser.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParserState.h",
    "src/cxx_supportlib/ServerKit/HttpRequest.h",
@@ -4378,6 +4640,7 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -4414,6 +4677,7 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/Controller.h",
@@ -4421,8 +4685,11 @@
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseHeaderTemplates.h",
    "src/agent/Core/Controller/TurboCaching.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/ResponseCompressor.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/DirectSpawner.h",
@@ -4451,6 +4718,7 @@
    "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/LString.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
@@ -4488,6 +4756,7 @@
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParser.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParserState.h",
    "src/cxx_supportlib/ServerKit/HttpRequest.h",
@@ -4515,6 +4784,7 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -4551,6 +4821,7 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/Controller.h",
@@ -4558,8 +4829,11 @@
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseHeaderTemplates.h",
    "src/agent/Core/Controller/TurboCaching.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/ResponseCompressor.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/DirectSpawner.h",
@@ -4588,6 +4862,7 @@
    "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/LString.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
@@ -4625,6 +4900,7 @@
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParser.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParserState.h",
    "src/cxx_supportlib/ServerKit/HttpRequest.h",
@@ -4652,6 +4928,7 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -4688,6 +4965,7 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/Controller.h",
@@ -4695,8 +4973,11 @@
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseHeaderTemplates.h",
    "src/agent/Core/Controller/TurboCaching.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/ResponseCompressor.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/DirectSpawner.h",
@@ -4725,6 +5006,7 @@
    "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/LString.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
@@ -4762,6 +5044,7 @@
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParser.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParserState.h",
    "src/cxx_supportlib/ServerKit/HttpRequest.h",
@@ -4789,6 +5072,7 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -4824,10 +5108,162 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
+   "src/agent/Core/ApplicationPool/Session.h",
+   "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/Controller/AppResponse.h",
+   "src/agent/Core/Controller/Config.h",
+   "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/SharedResponseCache.h",
+   "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
+   "src/agent/Core/SpawningKit/Config.h",
+   "src/agent/Core/SpawningKit/DirectSpawner.h",
+   "src/agent/Core/SpawningKit/DummySpawner.h",
+   "src/agent/Core/SpawningKit/Factory.h",
+   "src/agent/Core/SpawningKit/Options.h",
+   "src/agent/Core/SpawningKit/PipeWatcher.h",
+   "src/agent/Core/SpawningKit/Result.h",
+   "src/agent/Core/SpawningKit/SmartSpawner.h",
+   "src/agent/Core/SpawningKit/Spawner.h",
+   "src/agent/Core/SpawningKit/UserSwitchingRules.h",
+   "src/agent/Core/UnionStation/Connection.h",
+   "src/agent/Core/UnionStation/Context.h",
+   "src/agent/Core/UnionStation/StopwatchLog.h",
+   "src/agent/Core/UnionStation/Transaction.h",
+   "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
+   "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/ConfigKit/Common.h",
+   "src/cxx_supportlib/ConfigKit/ConfigKit.h",
+   "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
+   "src/cxx_supportlib/ConfigKit/Schema.h",
+   "src/cxx_supportlib/ConfigKit/SchemaUtils.h",
+   "src/cxx_supportlib/ConfigKit/Store.h",
+   "src/cxx_supportlib/ConfigKit/Translator.h",
+   "src/cxx_supportlib/ConfigKit/Utils.h",
+   "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
+   "src/cxx_supportlib/DataStructures/LString.h",
+   "src/cxx_supportlib/DataStructures/StringKeyTable.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/FileTools/PathManip.h",
+   "src/cxx_supportlib/Hooks.h",
+   "src/cxx_supportlib/Integrations/LibevJsonUtils.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/LveLoggingDecorator.h",
+   "src/cxx_supportlib/MemoryKit/mbuf.h",
+   "src/cxx_supportlib/MemoryKit/palloc.h",
+   "src/cxx_supportlib/ProcessManagement/Spawn.h",
+   "src/cxx_supportlib/ProcessManagement/Utils.h",
+   "src/cxx_supportlib/RandomGenerator.h",
+   "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
+   "src/cxx_supportlib/ServerKit/Channel.h",
+   "src/cxx_supportlib/ServerKit/Client.h",
+   "src/cxx_supportlib/ServerKit/ClientRef.h",
+   "src/cxx_supportlib/ServerKit/Config.h",
+   "src/cxx_supportlib/ServerKit/Context.h",
+   "src/cxx_supportlib/ServerKit/CookieUtils.h",
+   "src/cxx_supportlib/ServerKit/Errors.h",
+   "src/cxx_supportlib/ServerKit/FdSinkChannel.h",
+   "src/cxx_supportlib/ServerKit/FdSourceChannel.h",
+   "src/cxx_supportlib/ServerKit/FileBufferedChannel.h",
+   "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
+   "src/cxx_supportlib/ServerKit/HeaderTable.h",
+   "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
+   "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
+   "src/cxx_supportlib/ServerKit/HttpClient.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderParser.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderParserState.h",
+   "src/cxx_supportlib/ServerKit/HttpRequest.h",
+   "src/cxx_supportlib/ServerKit/HttpRequestRef.h",
+   "src/cxx_supportlib/ServerKit/HttpServer.h",
+   "src/cxx_supportlib/ServerKit/Server.h",
+   "src/cxx_supportlib/ServerKit/http_parser.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/AnsiColorConstants.h",
+   "src/cxx_supportlib/Utils/BufferedIO.h",
+   "src/cxx_supportlib/Utils/CachedFileStat.hpp",
+   "src/cxx_supportlib/Utils/ClassUtils.h",
+   "src/cxx_supportlib/Utils/DateParsing.h",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/HashMap.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/HttpConstants.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/Lock.h",
+   "src/cxx_supportlib/Utils/MemZeroGuard.h",
+   "src/cxx_supportlib/Utils/MessageIO.h",
+   "src/cxx_supportlib/Utils/MessagePassing.h",
+   "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
+   "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
+   "src/cxx_supportlib/Utils/SpeedMeter.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/StringMap.h",
+   "src/cxx_supportlib/Utils/StringScanning.h",
+   "src/cxx_supportlib/Utils/SystemMetricsCollector.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/Utils/Timer.h",
+   "src/cxx_supportlib/Utils/VariantMap.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/dynamic_thread_group.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp"],
+ "src/agent/Core/Controller/ResponseHeaderTemplates.h"=>
+  ["src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/MemoryKit/palloc.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils/HttpConstants.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/oxt/macros.hpp"],
+ "src/agent/Core/Controller/SendFile.cpp"=>
+  ["src/agent/Core/ApplicationPool/AbstractSession.h",
+   "src/agent/Core/ApplicationPool/BasicGroupInfo.h",
+   "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
+   "src/agent/Core/ApplicationPool/Common.h",
+   "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/ErrorRenderer.h",
+   "src/agent/Core/ApplicationPool/Group.h",
+   "src/agent/Core/ApplicationPool/Options.h",
+   "src/agent/Core/ApplicationPool/Pool.h",
+   "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/Controller.h",
    "src/agent/Core/Controller/AppResponse.h",
+   "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
+   "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseHeaderTemplates.h",
+   "src/agent/Core/Controller/TurboCaching.h",
+   "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/ResponseCompressor.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/DirectSpawner.h",
@@ -4856,6 +5292,7 @@
    "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/LString.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
@@ -4871,6 +5308,7 @@
    "src/cxx_supportlib/LveLoggingDecorator.h",
    "src/cxx_supportlib/MemoryKit/mbuf.h",
    "src/cxx_supportlib/MemoryKit/palloc.h",
+   "src/cxx_supportlib/MessageReadersWriters.h",
    "src/cxx_supportlib/ProcessManagement/Spawn.h",
    "src/cxx_supportlib/ProcessManagement/Utils.h",
    "src/cxx_supportlib/RandomGenerator.h",
@@ -4881,6 +5319,7 @@
    "src/cxx_supportlib/ServerKit/ClientRef.h",
    "src/cxx_supportlib/ServerKit/Config.h",
    "src/cxx_supportlib/ServerKit/Context.h",
+   "src/cxx_supportlib/ServerKit/CookieUtils.h",
    "src/cxx_supportlib/ServerKit/Errors.h",
    "src/cxx_supportlib/ServerKit/FdSinkChannel.h",
    "src/cxx_supportlib/ServerKit/FdSourceChannel.h",
@@ -4891,6 +5330,7 @@
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParser.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParserState.h",
    "src/cxx_supportlib/ServerKit/HttpRequest.h",
@@ -4904,6 +5344,7 @@
    "src/cxx_supportlib/Utils/BufferedIO.h",
    "src/cxx_supportlib/Utils/CachedFileStat.hpp",
    "src/cxx_supportlib/Utils/ClassUtils.h",
+   "src/cxx_supportlib/Utils/DateParsing.h",
    "src/cxx_supportlib/Utils/FastStringStream.h",
    "src/cxx_supportlib/Utils/HashMap.h",
    "src/cxx_supportlib/Utils/Hasher.h",
@@ -4917,12 +5358,14 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
    "src/cxx_supportlib/Utils/StringScanning.h",
    "src/cxx_supportlib/Utils/SystemMetricsCollector.h",
    "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/Utils/Template.h",
    "src/cxx_supportlib/Utils/Timer.h",
    "src/cxx_supportlib/Utils/VariantMap.h",
    "src/cxx_supportlib/oxt/backtrace.hpp",
@@ -4952,6 +5395,7 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/Controller.h",
@@ -4959,8 +5403,11 @@
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseHeaderTemplates.h",
    "src/agent/Core/Controller/TurboCaching.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/ResponseCompressor.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/DirectSpawner.h",
@@ -4989,6 +5436,7 @@
    "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/LString.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
@@ -5026,6 +5474,7 @@
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParser.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParserState.h",
    "src/cxx_supportlib/ServerKit/HttpRequest.h",
@@ -5053,6 +5502,7 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -5089,6 +5539,7 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/Controller.h",
@@ -5096,8 +5547,11 @@
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseHeaderTemplates.h",
    "src/agent/Core/Controller/TurboCaching.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/ResponseCompressor.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/DirectSpawner.h",
@@ -5126,6 +5580,7 @@
    "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/LString.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
@@ -5163,6 +5618,7 @@
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParser.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParserState.h",
    "src/cxx_supportlib/ServerKit/HttpRequest.h",
@@ -5190,6 +5646,7 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -5217,6 +5674,9 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
  "src/agent/Core/Controller/TurboCaching.h"=>
   ["src/agent/Core/ResponseCache.h",
+   "src/agent/Core/ResponseCompressor.h",
+   "src/agent/Core/SharedResponseCache.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -5283,6 +5743,7 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/Config.h",
@@ -5293,10 +5754,13 @@
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseHeaderTemplates.h",
    "src/agent/Core/Controller/TurboCaching.h",
    "src/agent/Core/OptionParser.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/ResponseCompressor.h",
    "src/agent/Core/SecurityUpdateChecker.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/DirectSpawner.h",
@@ -5337,6 +5801,7 @@
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/Crypto.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/LString.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
@@ -5380,6 +5845,7 @@
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParser.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParserState.h",
    "src/cxx_supportlib/ServerKit/HttpRequest.h",
@@ -5409,6 +5875,7 @@
    "src/cxx_supportlib/Utils/OptionParsing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -5448,8 +5915,10 @@
    "src/cxx_supportlib/oxt/macros.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
  "src/agent/Core/ResponseCache.h"=>
-  ["src/cxx_supportlib/DataStructures/HashedStaticString.h",
-   "src/cxx_supportlib/DataStructures/LString.h",
+  ["src/agent/Core/SharedResponseCache.h",
+   "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/LString.h",
    "src/cxx_supportlib/MemoryKit/mbuf.h",
    "src/cxx_supportlib/MemoryKit/palloc.h",
    "src/cxx_supportlib/ServerKit/CookieUtils.h",
@@ -5462,6 +5931,20 @@
    "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
    "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
    "src/cxx_supportlib/oxt/macros.hpp"],
+ "src/agent/Core/ResponseCompressor.h"=>
+  ["src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp"],
  "src/agent/Core/SecurityUpdateChecker.h"=>
   ["src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
@@ -5503,6 +5986,11 @@
    "src/cxx_supportlib/oxt/system_calls.hpp",
    "src/cxx_supportlib/oxt/thread.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
+ "src/agent/Core/SharedResponseCache.h"=>
+  ["src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/oxt/macros.hpp"],
  "src/agent/Core/SpawningKit/BackgroundIOCapturer.h"=>
   ["src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
@@ -6108,6 +6596,7 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
@@ -6137,6 +6626,7 @@
    "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/LString.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
@@ -6169,6 +6659,7 @@
    "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
    "src/cxx_supportlib/ServerKit/HeaderTable.h",
    "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/ServerKit/Server.h",
    "src/cxx_supportlib/ServerKit/http_parser.h",
    "src/cxx_supportlib/StaticString.h",
@@ -6189,6 +6680,7 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -6478,6 +6970,7 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
@@ -6509,6 +7002,7 @@
    "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/LString.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
@@ -6545,6 +7039,7 @@
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParser.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParserState.h",
    "src/cxx_supportlib/ServerKit/HttpRequest.h",
@@ -6571,6 +7066,7 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -6608,6 +7104,7 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/Config.h",
@@ -6617,9 +7114,12 @@
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseHeaderTemplates.h",
    "src/agent/Core/Controller/TurboCaching.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/ResponseCompressor.h",
    "src/agent/Core/SecurityUpdateChecker.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/DirectSpawner.h",
@@ -6655,6 +7155,7 @@
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/Crypto.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/LString.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
@@ -6696,6 +7197,7 @@
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParser.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParserState.h",
    "src/cxx_supportlib/ServerKit/HttpRequest.h",
@@ -6724,6 +7226,7 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -6791,6 +7294,7 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/Config.h",
@@ -6800,10 +7304,13 @@
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseHeaderTemplates.h",
    "src/agent/Core/Controller/TurboCaching.h",
    "src/agent/Core/OptionParser.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/ResponseCompressor.h",
    "src/agent/Core/SecurityUpdateChecker.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/DirectSpawner.h",
@@ -6847,6 +7354,7 @@
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/Crypto.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/LString.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
@@ -6889,6 +7397,7 @@
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParser.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParserState.h",
    "src/cxx_supportlib/ServerKit/HttpRequest.h",
@@ -6919,6 +7428,7 @@
    "src/cxx_supportlib/Utils/OptionParsing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -7218,7 +7728,8 @@
    "src/cxx_supportlib/oxt/system_calls.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
  "src/cxx_supportlib/BackgroundEventLoop.cpp"=>
-  ["src/cxx_supportlib/BackgroundEventLoop.h",
+  ["src/cxx_supportlib/Algorithms/MovingAverage.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/LoggingKit/Assert.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
@@ -7227,6 +7738,7 @@
    "src/cxx_supportlib/SafeLibev.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
    "src/cxx_supportlib/oxt/backtrace.hpp",
    "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
    "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
@@ -7442,6 +7954,8 @@
   ["src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils/Hasher.h",
    "src/cxx_supportlib/oxt/macros.hpp"],
+ "src/cxx_supportlib/DataStructures/IndexedMinHeap.h"=>
+  [],
  "src/cxx_supportlib/DataStructures/LString.cpp"=>
   ["src/cxx_supportlib/DataStructures/LString.h",
    "src/cxx_supportlib/MemoryKit/mbuf.h",
@@ -7880,12 +8394,15 @@
    "src/cxx_supportlib/oxt/macros.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
  "src/cxx_supportlib/SafeLibev.h"=>
-  ["src/cxx_supportlib/LoggingKit/Assert.h",
+  ["src/cxx_supportlib/Algorithms/MovingAverage.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
    "src/cxx_supportlib/LoggingKit/Forward.h",
    "src/cxx_supportlib/LoggingKit/Logging.h",
    "src/cxx_supportlib/LoggingKit/LoggingKit.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
    "src/cxx_supportlib/oxt/backtrace.hpp",
    "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
    "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
@@ -7894,10 +8411,13 @@
    "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
    "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
    "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
    "src/cxx_supportlib/oxt/macros.hpp",
    "src/cxx_supportlib/oxt/spin_lock.hpp",
    "src/cxx_supportlib/oxt/system_calls.hpp",
-   "src/cxx_supportlib/oxt/thread.hpp"],
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp"],
  "src/cxx_supportlib/ServerKit/AcceptLoadBalancer.h"=>
   ["src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/Exceptions.h",
@@ -7926,7 +8446,8 @@
    "src/cxx_supportlib/oxt/thread.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
  "src/cxx_supportlib/ServerKit/Channel.h"=>
-  ["src/cxx_supportlib/ConfigKit/Common.h",
+  ["src/cxx_supportlib/Algorithms/MovingAverage.h",
+   "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
    "src/cxx_supportlib/ConfigKit/Schema.h",
@@ -7976,7 +8497,8 @@
    "src/cxx_supportlib/oxt/thread.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
  "src/cxx_supportlib/ServerKit/Client.h"=>
-  ["src/cxx_supportlib/ConfigKit/Common.h",
+  ["src/cxx_supportlib/Algorithms/MovingAverage.h",
+   "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
    "src/cxx_supportlib/ConfigKit/Schema.h",
@@ -8063,7 +8585,8 @@
    "src/cxx_supportlib/oxt/macros.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
  "src/cxx_supportlib/ServerKit/Context.h"=>
-  ["src/cxx_supportlib/ConfigKit/Common.h",
+  ["src/cxx_supportlib/Algorithms/MovingAverage.h",
+   "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
    "src/cxx_supportlib/ConfigKit/Schema.h",
@@ -8124,7 +8647,8 @@
  "src/cxx_supportlib/ServerKit/Errors.h"=>
   ["src/cxx_supportlib/ServerKit/http_parser.h"],
  "src/cxx_supportlib/ServerKit/FdSinkChannel.h"=>
-  ["src/cxx_supportlib/ConfigKit/Common.h",
+  ["src/cxx_supportlib/Algorithms/MovingAverage.h",
+   "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
    "src/cxx_supportlib/ConfigKit/Schema.h",
@@ -8175,7 +8699,8 @@
    "src/cxx_supportlib/oxt/thread.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
  "src/cxx_supportlib/ServerKit/FdSourceChannel.h"=>
-  ["src/cxx_supportlib/ConfigKit/Common.h",
+  ["src/cxx_supportlib/Algorithms/MovingAverage.h",
+   "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
    "src/cxx_supportlib/ConfigKit/Schema.h",
@@ -8226,7 +8751,8 @@
    "src/cxx_supportlib/oxt/thread.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
  "src/cxx_supportlib/ServerKit/FileBufferedChannel.h"=>
-  ["src/cxx_supportlib/ConfigKit/Common.h",
+  ["src/cxx_supportlib/Algorithms/MovingAverage.h",
+   "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
    "src/cxx_supportlib/ConfigKit/Schema.h",
@@ -8279,7 +8805,8 @@
    "src/cxx_supportlib/oxt/thread.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
  "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h"=>
-  ["src/cxx_supportlib/ConfigKit/Common.h",
+  ["src/cxx_supportlib/Algorithms/MovingAverage.h",
+   "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
    "src/cxx_supportlib/ConfigKit/Schema.h",
@@ -8337,6 +8864,7 @@
    "src/cxx_supportlib/DataStructures/LString.h",
    "src/cxx_supportlib/MemoryKit/mbuf.h",
    "src/cxx_supportlib/MemoryKit/palloc.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils/Hasher.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
@@ -8353,7 +8881,8 @@
  "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h"=>
   [],
  "src/cxx_supportlib/ServerKit/HttpClient.h"=>
-  ["src/cxx_supportlib/ConfigKit/Common.h",
+  ["src/cxx_supportlib/Algorithms/MovingAverage.h",
+   "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
    "src/cxx_supportlib/ConfigKit/Schema.h",
@@ -8385,6 +8914,7 @@
    "src/cxx_supportlib/ServerKit/HeaderTable.h",
    "src/cxx_supportlib/ServerKit/Hooks.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParserState.h",
    "src/cxx_supportlib/ServerKit/HttpRequest.h",
    "src/cxx_supportlib/ServerKit/http_parser.h",
@@ -8415,8 +8945,21 @@
    "src/cxx_supportlib/oxt/system_calls.hpp",
    "src/cxx_supportlib/oxt/thread.hpp",
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
+ "src/cxx_supportlib/ServerKit/HttpHeaderIds.h"=>
+  ["src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/LString.h",
+   "src/cxx_supportlib/MemoryKit/mbuf.h",
+   "src/cxx_supportlib/MemoryKit/palloc.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp"],
  "src/cxx_supportlib/ServerKit/HttpHeaderParser.h"=>
-  ["src/cxx_supportlib/ConfigKit/Common.h",
+  ["src/cxx_supportlib/Algorithms/MovingAverage.h",
+   "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
    "src/cxx_supportlib/ConfigKit/Schema.h",
@@ -8448,6 +8991,7 @@
    "src/cxx_supportlib/ServerKit/HeaderTable.h",
    "src/cxx_supportlib/ServerKit/Hooks.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParserState.h",
    "src/cxx_supportlib/ServerKit/HttpRequest.h",
    "src/cxx_supportlib/ServerKit/http_parser.h",
@@ -8490,7 +9034,8 @@
    "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
    "src/cxx_supportlib/oxt/macros.hpp"],
  "src/cxx_supportlib/ServerKit/HttpRequest.h"=>
-  ["src/cxx_supportlib/ConfigKit/Common.h",
+  ["src/cxx_supportlib/Algorithms/MovingAverage.h",
+   "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
    "src/cxx_supportlib/ConfigKit/Schema.h",
@@ -8522,6 +9067,7 @@
    "src/cxx_supportlib/ServerKit/HeaderTable.h",
    "src/cxx_supportlib/ServerKit/Hooks.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParserState.h",
    "src/cxx_supportlib/ServerKit/http_parser.h",
    "src/cxx_supportlib/StaticString.h",
@@ -8591,6 +9137,7 @@
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParser.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParserState.h",
    "src/cxx_supportlib/ServerKit/HttpRequest.h",
@@ -8627,8 +9174,16 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp"],
  "src/cxx_supportlib/ServerKit/Implementation.cpp"=>
   ["src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/LString.h",
+   "src/cxx_supportlib/MemoryKit/mbuf.h",
+   "src/cxx_supportlib/MemoryKit/palloc.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
    "src/cxx_supportlib/oxt/macros.hpp"],
  "src/cxx_supportlib/ServerKit/Server.h"=>
   ["src/cxx_supportlib/Algorithms/MovingAverage.h",
@@ -8994,6 +9549,8 @@
    "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
    "src/cxx_supportlib/oxt/macros.hpp",
    "src/cxx_supportlib/oxt/system_calls.hpp"],
+ "src/cxx_supportlib/Utils/ShardedSharedMutex.h"=>
+  ["src/cxx_supportlib/oxt/macros.hpp"],
  "src/cxx_supportlib/Utils/SpeedMeter.h"=>
   ["src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/Utils/SystemTime.h",
@@ -9545,6 +10102,7 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/Config.h",
@@ -9554,9 +10112,12 @@
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseHeaderTemplates.h",
    "src/agent/Core/Controller/TurboCaching.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/ResponseCompressor.h",
    "src/agent/Core/SecurityUpdateChecker.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/DirectSpawner.h",
@@ -9593,6 +10154,7 @@
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/Crypto.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/LString.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
@@ -9634,6 +10196,7 @@
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParser.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParserState.h",
    "src/cxx_supportlib/ServerKit/HttpRequest.h",
@@ -9662,6 +10225,7 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -10066,6 +10630,7 @@
    "src/agent/Core/UnionStation/Context.h",
    "src/agent/Core/UnionStation/Transaction.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
    "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/Constants.h",
@@ -10102,6 +10667,7 @@
    "src/cxx_supportlib/Utils/MessageIO.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
    "src/cxx_supportlib/Utils/StringScanning.h",
@@ -10135,6 +10701,7 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
@@ -10153,6 +10720,7 @@
    "src/agent/Core/UnionStation/StopwatchLog.h",
    "src/agent/Core/UnionStation/Transaction.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
    "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
@@ -10164,6 +10732,7 @@
    "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
@@ -10202,6 +10771,7 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -10228,6 +10798,93 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp",
    "test/cxx/TestSupport.h",
    "test/tut/tut.h"],
+ "test/cxx/Core/ApplicationPool/ProcessRoutingTableTest.cpp"=>
+  ["src/agent/Core/ApplicationPool/AbstractSession.h",
+   "src/agent/Core/ApplicationPool/BasicGroupInfo.h",
+   "src/agent/Core/ApplicationPool/BasicProcessInfo.h",
+   "src/agent/Core/ApplicationPool/Common.h",
+   "src/agent/Core/ApplicationPool/Context.h",
+   "src/agent/Core/ApplicationPool/Options.h",
+   "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
+   "src/agent/Core/ApplicationPool/Session.h",
+   "src/agent/Core/ApplicationPool/Socket.h",
+   "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
+   "src/agent/Core/SpawningKit/Config.h",
+   "src/agent/Core/SpawningKit/DirectSpawner.h",
+   "src/agent/Core/SpawningKit/DummySpawner.h",
+   "src/agent/Core/SpawningKit/Factory.h",
+   "src/agent/Core/SpawningKit/Options.h",
+   "src/agent/Core/SpawningKit/PipeWatcher.h",
+   "src/agent/Core/SpawningKit/Result.h",
+   "src/agent/Core/SpawningKit/SmartSpawner.h",
+   "src/agent/Core/SpawningKit/Spawner.h",
+   "src/agent/Core/SpawningKit/UserSwitchingRules.h",
+   "src/agent/Core/UnionStation/Connection.h",
+   "src/agent/Core/UnionStation/Context.h",
+   "src/agent/Core/UnionStation/Transaction.h",
+   "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
+   "src/cxx_supportlib/AppTypes.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/StringKeyTable.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/FileTools/PathManip.h",
+   "src/cxx_supportlib/InstanceDirectory.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/LveLoggingDecorator.h",
+   "src/cxx_supportlib/MemoryKit/palloc.h",
+   "src/cxx_supportlib/ProcessManagement/Spawn.h",
+   "src/cxx_supportlib/ProcessManagement/Utils.h",
+   "src/cxx_supportlib/RandomGenerator.h",
+   "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/BufferedIO.h",
+   "src/cxx_supportlib/Utils/CachedFileStat.hpp",
+   "src/cxx_supportlib/Utils/ClassUtils.h",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/HashMap.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/Lock.h",
+   "src/cxx_supportlib/Utils/MemZeroGuard.h",
+   "src/cxx_supportlib/Utils/MessageIO.h",
+   "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
+   "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/StringMap.h",
+   "src/cxx_supportlib/Utils/StringScanning.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/Utils/Timer.h",
+   "src/cxx_supportlib/Utils/VariantMap.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp",
+   "test/cxx/TestSupport.h",
+   "test/tut/tut.h"],
  "test/cxx/Core/ApplicationPool/ProcessTest.cpp"=>
   ["src/agent/Core/ApplicationPool/AbstractSession.h",
    "src/agent/Core/ApplicationPool/BasicGroupInfo.h",
@@ -10253,6 +10910,7 @@
    "src/agent/Core/UnionStation/Context.h",
    "src/agent/Core/UnionStation/Transaction.h",
    "src/agent/Shared/ApplicationPoolApiKey.h",
+   "src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/AppTypes.h",
    "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
@@ -10298,6 +10956,7 @@
    "src/cxx_supportlib/Utils/MessageIO.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
    "src/cxx_supportlib/Utils/StringScanning.h",
@@ -10332,6 +10991,7 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/ApplicationPool/TestSession.h",
@@ -10340,8 +11000,11 @@
    "src/agent/Core/Controller/Client.h",
    "src/agent/Core/Controller/Config.h",
    "src/agent/Core/Controller/Request.h",
+   "src/agent/Core/Controller/ResponseHeaderTemplates.h",
    "src/agent/Core/Controller/TurboCaching.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/ResponseCompressor.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/DirectSpawner.h",
@@ -10371,6 +11034,7 @@
    "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/LString.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
@@ -10409,6 +11073,7 @@
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParser.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParserState.h",
    "src/cxx_supportlib/ServerKit/HttpRequest.h",
@@ -10436,6 +11101,7 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -10473,12 +11139,15 @@
    "src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/ApplicationPool/Pool.h",
    "src/agent/Core/ApplicationPool/Process.h",
+   "src/agent/Core/ApplicationPool/ProcessRoutingTable.h",
    "src/agent/Core/ApplicationPool/Session.h",
    "src/agent/Core/ApplicationPool/Socket.h",
    "src/agent/Core/Controller/AppResponse.h",
    "src/agent/Core/Controller/Config.h",
    "src/agent/Core/Controller/Request.h",
    "src/agent/Core/ResponseCache.h",
+   "src/agent/Core/ResponseCompressor.h",
+   "src/agent/Core/SharedResponseCache.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
    "src/agent/Core/SpawningKit/Config.h",
    "src/agent/Core/SpawningKit/DirectSpawner.h",
@@ -10508,6 +11177,7 @@
    "src/cxx_supportlib/ConfigKit/Utils.h",
    "src/cxx_supportlib/Constants.h",
    "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
    "src/cxx_supportlib/DataStructures/LString.h",
    "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
@@ -10545,6 +11215,7 @@
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParser.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParserState.h",
    "src/cxx_supportlib/ServerKit/HttpRequest.h",
@@ -10572,6 +11243,7 @@
    "src/cxx_supportlib/Utils/MessagePassing.h",
    "src/cxx_supportlib/Utils/ProcessMetricsCollector.h",
    "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
    "src/cxx_supportlib/Utils/SpeedMeter.h",
    "src/cxx_supportlib/Utils/StrIntUtils.h",
    "src/cxx_supportlib/Utils/StringMap.h",
@@ -10598,6 +11270,48 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp",
    "test/cxx/TestSupport.h",
    "test/tut/tut.h"],
+ "test/cxx/Core/ResponseHeaderTemplatesTest.cpp"=>
+  ["src/agent/Core/Controller/ResponseHeaderTemplates.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/InstanceDirectory.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/MemoryKit/palloc.h",
+   "src/cxx_supportlib/ProcessManagement/Spawn.h",
+   "src/cxx_supportlib/ProcessManagement/Utils.h",
+   "src/cxx_supportlib/RandomGenerator.h",
+   "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/HttpConstants.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp",
+   "test/cxx/TestSupport.h",
+   "test/tut/tut.h"],
  "test/cxx/Core/SecurityUpdateCheckerTest.cpp"=>
   ["src/agent/Core/SecurityUpdateChecker.h",
    "src/cxx_supportlib/BackgroundEventLoop.h",
@@ -10650,6 +11364,48 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp",
    "test/cxx/TestSupport.h",
    "test/tut/tut.h"],
+ "test/cxx/Core/SharedResponseCacheTest.cpp"=>
+  ["src/agent/Core/SharedResponseCache.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/InstanceDirectory.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/ProcessManagement/Spawn.h",
+   "src/cxx_supportlib/ProcessManagement/Utils.h",
+   "src/cxx_supportlib/RandomGenerator.h",
+   "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp",
+   "test/cxx/TestSupport.h",
+   "test/tut/tut.h"],
  "test/cxx/Core/SpawningKit/DirectSpawnerTest.cpp"=>
   ["src/agent/Core/ApplicationPool/Options.h",
    "src/agent/Core/SpawningKit/BackgroundIOCapturer.h",
@@ -10862,9 +11618,10 @@
    "test/cxx/TestSupport.h",
    "test/tut/tut.h",
    "test/tut/tut_reporter.h"],
- "test/cxx/DataStructures/LStringTest.cpp"=>
+ "test/cxx/DataStructures/HashedStaticStringTest.cpp"=>
   ["src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/DataStructures/HashedStaticString.h",
    "src/cxx_supportlib/DataStructures/LString.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
@@ -10905,11 +11662,94 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp",
    "test/cxx/TestSupport.h",
    "test/tut/tut.h"],
- "test/cxx/DataStructures/StringKeyTableTest.cpp"=>
+ "test/cxx/DataStructures/IndexedMinHeapTest.cpp"=>
   ["src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/Constants.h",
-   "src/cxx_supportlib/DataStructures/HashedStaticString.h",
-   "src/cxx_supportlib/DataStructures/StringKeyTable.h",
+   "src/cxx_supportlib/DataStructures/IndexedMinHeap.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/InstanceDirectory.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/ProcessManagement/Spawn.h",
+   "src/cxx_supportlib/ProcessManagement/Utils.h",
+   "src/cxx_supportlib/RandomGenerator.h",
+   "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp",
+   "test/cxx/TestSupport.h",
+   "test/tut/tut.h"],
+ "test/cxx/DataStructures/LStringTest.cpp"=>
+  ["src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/DataStructures/LString.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/InstanceDirectory.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/MemoryKit/mbuf.h",
+   "src/cxx_supportlib/MemoryKit/palloc.h",
+   "src/cxx_supportlib/ProcessManagement/Spawn.h",
+   "src/cxx_supportlib/ProcessManagement/Utils.h",
+   "src/cxx_supportlib/RandomGenerator.h",
+   "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp",
+   "test/cxx/TestSupport.h",
+   "test/tut/tut.h"],
+ "test/cxx/DataStructures/StringKeyTableTest.cpp"=>
+  ["src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/StringKeyTable.h",
    "src/cxx_supportlib/Exceptions.h",
    "src/cxx_supportlib/FileDescriptor.h",
    "src/cxx_supportlib/FileTools/FileManip.h",
@@ -11399,8 +12239,121 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp",
    "test/cxx/TestSupport.h",
    "test/tut/tut.h"],
+ "test/cxx/SafeLibevTest.cpp"=>
+  ["src/cxx_supportlib/Algorithms/MovingAverage.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/InstanceDirectory.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/ProcessManagement/Spawn.h",
+   "src/cxx_supportlib/ProcessManagement/Utils.h",
+   "src/cxx_supportlib/RandomGenerator.h",
+   "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp",
+   "test/cxx/TestSupport.h",
+   "test/tut/tut.h"],
+ "test/cxx/ServerKit/AcceptLoadBalancerTest.cpp"=>
+  ["src/cxx_supportlib/Algorithms/MovingAverage.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/ConfigKit/Common.h",
+   "src/cxx_supportlib/ConfigKit/ConfigKit.h",
+   "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
+   "src/cxx_supportlib/ConfigKit/Schema.h",
+   "src/cxx_supportlib/ConfigKit/Store.h",
+   "src/cxx_supportlib/ConfigKit/Translator.h",
+   "src/cxx_supportlib/ConfigKit/Utils.h",
+   "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/StringKeyTable.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/FileTools/PathManip.h",
+   "src/cxx_supportlib/InstanceDirectory.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/MemoryKit/mbuf.h",
+   "src/cxx_supportlib/ProcessManagement/Spawn.h",
+   "src/cxx_supportlib/ProcessManagement/Utils.h",
+   "src/cxx_supportlib/RandomGenerator.h",
+   "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
+   "src/cxx_supportlib/ServerKit/AcceptLoadBalancer.h",
+   "src/cxx_supportlib/ServerKit/Channel.h",
+   "src/cxx_supportlib/ServerKit/Client.h",
+   "src/cxx_supportlib/ServerKit/ClientRef.h",
+   "src/cxx_supportlib/ServerKit/Config.h",
+   "src/cxx_supportlib/ServerKit/Context.h",
+   "src/cxx_supportlib/ServerKit/Errors.h",
+   "src/cxx_supportlib/ServerKit/FdSourceChannel.h",
+   "src/cxx_supportlib/ServerKit/FileBufferedChannel.h",
+   "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
+   "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/Server.h",
+   "src/cxx_supportlib/ServerKit/http_parser.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/MemZeroGuard.h",
+   "src/cxx_supportlib/Utils/MessageIO.h",
+   "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/Utils/VariantMap.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp",
+   "test/cxx/TestSupport.h",
+   "test/tut/tut.h"],
  "test/cxx/ServerKit/ChannelTest.cpp"=>
-  ["src/cxx_supportlib/BackgroundEventLoop.h",
+  ["src/cxx_supportlib/Algorithms/MovingAverage.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -11505,7 +12458,8 @@
    "test/cxx/TestSupport.h",
    "test/tut/tut.h"],
  "test/cxx/ServerKit/FileBufferedChannelTest.cpp"=>
-  ["src/cxx_supportlib/BackgroundEventLoop.h",
+  ["src/cxx_supportlib/Algorithms/MovingAverage.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/ConfigKit/Common.h",
    "src/cxx_supportlib/ConfigKit/ConfigKit.h",
    "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
@@ -11588,6 +12542,7 @@
    "src/cxx_supportlib/RandomGenerator.h",
    "src/cxx_supportlib/ResourceLocator.h",
    "src/cxx_supportlib/ServerKit/HeaderTable.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/StaticString.h",
    "src/cxx_supportlib/Utils.h",
    "src/cxx_supportlib/Utils/FastStringStream.h",
@@ -11613,6 +12568,166 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp",
    "test/cxx/TestSupport.h",
    "test/tut/tut.h"],
+ "test/cxx/ServerKit/HttpChunkedBodyParserTest.cpp"=>
+  ["src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/InstanceDirectory.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/MemoryKit/mbuf.h",
+   "src/cxx_supportlib/ProcessManagement/Spawn.h",
+   "src/cxx_supportlib/ProcessManagement/Utils.h",
+   "src/cxx_supportlib/RandomGenerator.h",
+   "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/ServerKit/Errors.h",
+   "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
+   "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
+   "src/cxx_supportlib/ServerKit/http_parser.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp",
+   "test/cxx/TestSupport.h",
+   "test/tut/tut.h"],
+ "test/cxx/ServerKit/HttpHeaderParserTest.cpp"=>
+  ["src/cxx_supportlib/Algorithms/MovingAverage.h",
+   "src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/ConfigKit/Common.h",
+   "src/cxx_supportlib/ConfigKit/ConfigKit.h",
+   "src/cxx_supportlib/ConfigKit/DummyTranslator.h",
+   "src/cxx_supportlib/ConfigKit/Schema.h",
+   "src/cxx_supportlib/ConfigKit/Store.h",
+   "src/cxx_supportlib/ConfigKit/Translator.h",
+   "src/cxx_supportlib/ConfigKit/Utils.h",
+   "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/DataStructures/HashedStaticString.h",
+   "src/cxx_supportlib/DataStructures/LString.h",
+   "src/cxx_supportlib/DataStructures/StringKeyTable.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/FileTools/PathManip.h",
+   "src/cxx_supportlib/InstanceDirectory.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/MemoryKit/mbuf.h",
+   "src/cxx_supportlib/MemoryKit/palloc.h",
+   "src/cxx_supportlib/ProcessManagement/Spawn.h",
+   "src/cxx_supportlib/ProcessManagement/Utils.h",
+   "src/cxx_supportlib/RandomGenerator.h",
+   "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/SafeLibev.h",
+   "src/cxx_supportlib/ServerKit/Channel.h",
+   "src/cxx_supportlib/ServerKit/Client.h",
+   "src/cxx_supportlib/ServerKit/Config.h",
+   "src/cxx_supportlib/ServerKit/Context.h",
+   "src/cxx_supportlib/ServerKit/Errors.h",
+   "src/cxx_supportlib/ServerKit/FdSourceChannel.h",
+   "src/cxx_supportlib/ServerKit/FileBufferedChannel.h",
+   "src/cxx_supportlib/ServerKit/FileBufferedFdSinkChannel.h",
+   "src/cxx_supportlib/ServerKit/HeaderTable.h",
+   "src/cxx_supportlib/ServerKit/Hooks.h",
+   "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderParser.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderParserState.h",
+   "src/cxx_supportlib/ServerKit/HttpRequest.h",
+   "src/cxx_supportlib/ServerKit/http_parser.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/Hasher.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/JsonUtils.h",
+   "src/cxx_supportlib/Utils/MemZeroGuard.h",
+   "src/cxx_supportlib/Utils/MessageIO.h",
+   "src/cxx_supportlib/Utils/ScopeGuard.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/Utils/VariantMap.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp",
+   "test/cxx/TestSupport.h",
+   "test/tut/tut.h"],
+ "test/cxx/ServerKit/HttpParserTest.cpp"=>
+  ["src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/InstanceDirectory.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/ProcessManagement/Spawn.h",
+   "src/cxx_supportlib/ProcessManagement/Utils.h",
+   "src/cxx_supportlib/RandomGenerator.h",
+   "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/ServerKit/http_parser.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp",
+   "test/cxx/TestSupport.h",
+   "test/tut/tut.h"],
  "test/cxx/ServerKit/HttpServerTest.cpp"=>
   ["src/cxx_supportlib/Algorithms/MovingAverage.h",
    "src/cxx_supportlib/BackgroundEventLoop.h",
@@ -11658,6 +12773,7 @@
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParser.h",
    "src/cxx_supportlib/ServerKit/HttpChunkedBodyParserState.h",
    "src/cxx_supportlib/ServerKit/HttpClient.h",
+   "src/cxx_supportlib/ServerKit/HttpHeaderIds.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParser.h",
    "src/cxx_supportlib/ServerKit/HttpHeaderParserState.h",
    "src/cxx_supportlib/ServerKit/HttpRequest.h",
@@ -11767,6 +12883,46 @@
    "src/cxx_supportlib/oxt/tracable_exception.hpp",
    "test/cxx/TestSupport.h",
    "test/tut/tut.h"],
+ "test/cxx/ShardedSharedMutexTest.cpp"=>
+  ["src/cxx_supportlib/BackgroundEventLoop.h",
+   "src/cxx_supportlib/Constants.h",
+   "src/cxx_supportlib/Exceptions.h",
+   "src/cxx_supportlib/FileDescriptor.h",
+   "src/cxx_supportlib/FileTools/FileManip.h",
+   "src/cxx_supportlib/InstanceDirectory.h",
+   "src/cxx_supportlib/LoggingKit/Assert.h",
+   "src/cxx_supportlib/LoggingKit/Forward.h",
+   "src/cxx_supportlib/LoggingKit/Logging.h",
+   "src/cxx_supportlib/LoggingKit/LoggingKit.h",
+   "src/cxx_supportlib/ProcessManagement/Spawn.h",
+   "src/cxx_supportlib/ProcessManagement/Utils.h",
+   "src/cxx_supportlib/RandomGenerator.h",
+   "src/cxx_supportlib/ResourceLocator.h",
+   "src/cxx_supportlib/StaticString.h",
+   "src/cxx_supportlib/Utils.h",
+   "src/cxx_supportlib/Utils/FastStringStream.h",
+   "src/cxx_supportlib/Utils/IOUtils.h",
+   "src/cxx_supportlib/Utils/IniFile.h",
+   "src/cxx_supportlib/Utils/ShardedSharedMutex.h",
+   "src/cxx_supportlib/Utils/StrIntUtils.h",
+   "src/cxx_supportlib/Utils/SystemTime.h",
+   "src/cxx_supportlib/oxt/backtrace.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/backtrace_enabled.hpp",
+   "src/cxx_supportlib/oxt/detail/context.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_darwin.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_gcc_x86.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_portable.hpp",
+   "src/cxx_supportlib/oxt/detail/spin_lock_pthreads.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_disabled.hpp",
+   "src/cxx_supportlib/oxt/detail/tracable_exception_enabled.hpp",
+   "src/cxx_supportlib/oxt/macros.hpp",
+   "src/cxx_supportlib/oxt/spin_lock.hpp",
+   "src/cxx_supportlib/oxt/system_calls.hpp",
+   "src/cxx_supportlib/oxt/thread.hpp",
+   "src/cxx_supportlib/oxt/tracable_exception.hpp",
+   "test/cxx/TestSupport.h",
+   "test/tut/tut.h"],
  "test/cxx/StaticStringTest.cpp"=>
   ["src/cxx_supportlib/BackgroundEventLoop.h",
    "src/cxx_supportlib/Constants.h",
@@ -37,6 +37,7 @@
 #include <MemoryKit/palloc.h>
 #include <DataStructures/StringKeyTable.h>
 #include <Utils/VariantMap.h>
+#include <Utils/ShardedSharedMutex.h>
 #include <Core/ApplicationPool/Options.h>
 #include <Core/SpawningKit/Config.h>
 #include <Core/UnionStation/Context.h>
@@ -172,6 +173,33 @@ typedef StringKeyTable<GroupPtr> GroupMap;
 typedef boost::function<void (const ProcessPtr &process, DisableResult result)> DisableCallback;
 typedef boost::function<void ()> Callback;
 
+/**
+ * The type of `Pool::syncher`. It is a readers-writer lock: almost all pool
+ * operations lock it exclusively, but checking out a session from a process
+ * that is ready to accept it, and closing a session without side effects on
+ * the rest of the pool, only lock it in shared mode plus the lock of the
+ * Group involved (`Group::syncher`). Those operations therefore do not contend
+ * with each other as long as they involve different Groups. Shared locking
+ * only touches a per-thread shard of the lock, so that the controller threads
+ * don't bounce a shared cache line between each other.
+ */
+typedef ShardedSharedMutex PoolMutex;
+typedef boost::lock_guard<PoolMutex> PoolLockGuard;
+typedef boost::unique_lock<PoolMutex> PoolScopedLock;
+typedef boost::shared_lock<PoolMutex> PoolSharedLock;
+
+/** Like DynamicScopedLock, but for the pool lock. */
+class DynamicPoolScopedLock: public PoolScopedLock {
+public:
+	DynamicPoolScopedLock(PoolMutex &m, bool lockNow = true)
+		: PoolScopedLock(m, boost::defer_lock)
+	{
+		if (lockNow) {
+			lock();
+		}
+	}
+};
+
 struct GetCallback {
 	void (*func)(const AbstractSessionPtr &session, const ExceptionPtr &e, void *userData);
 	mutable void *userData;
@@ -46,12 +46,14 @@
 #include <cassert>
 #include <SmallVector.h>
 #include <MemoryKit/palloc.h>
+#include <DataStructures/IndexedMinHeap.h>
 #include <Hooks.h>
 #include <Utils.h>
 #include <Core/ApplicationPool/Common.h>
 #include <Core/ApplicationPool/Context.h>
 #include <Core/ApplicationPool/BasicGroupInfo.h>
 #include <Core/ApplicationPool/Process.h>
+#include <Core/ApplicationPool/ProcessRoutingTable.h>
 #include <Core/ApplicationPool/Options.h>
 #include <Core/SpawningKit/Factory.h>
 #include <Core/SpawningKit/UserSwitchingRules.h>
@@ -125,6 +127,14 @@ public:
 	 * Read-only; only set during initialization.
 	 */
 	Pool *pool;
+	/**
+	 * Serializes the session checkout and session close fast paths on this
+	 * Group. Those fast paths only lock `pool->syncher` in shared mode, so
+	 * they use this lock to protect the session statistics of this Group and
+	 * its Processes from each other. Code that locks `pool->syncher`
+	 * exclusively does not need to lock this.
+	 */
+	boost::mutex syncher;
 	time_t lastRestartFileMtime;
 	time_t lastRestartFileCheckTime;
 
@@ -186,7 +196,7 @@ public:
 	 * whether any of the Processes can be shut down.
 	 */
 	bool detachedProcessesCheckerActive;
-	boost::condition_variable detachedProcessesCheckerCond;
+	boost::condition_variable_any detachedProcessesCheckerCond;
 	Callback shutdownCallback;
 	GroupPtr selfPointer;
 
@@ -201,12 +211,14 @@ public:
 
 	/****** Session management ******/
 
-	RouteResult route(const Options &options) const;
+	RouteResult route(unsigned int stickySessionId, unsigned long long now) const;
 	SessionPtr newSession(Process *process, unsigned long long now = 0);
 	static void _onSessionInitiateFailure(Session *session);
 	static void _onSessionClose(Session *session);
 	OXT_FORCE_INLINE void onSessionInitiateFailure(Process *process, Session *session);
 	OXT_FORCE_INLINE void onSessionClose(Process *process, Session *session);
+	OXT_FORCE_INLINE void updateStatisticsAfterSessionClose(Process *process, Session *session);
+	bool canCloseSessionQuickly(const Process *process) const;
 
 	/****** Spawning and restarting ******/
 
@@ -221,9 +233,13 @@ public:
 	/****** Process list management ******/
 
 	Process *findProcessWithStickySessionId(unsigned int id) const;
-	Process *findProcessWithStickySessionIdOrLowestBusyness(unsigned int id) const;
-	Process *findProcessWithLowestBusyness(const ProcessList &processes) const;
-	Process *findEnabledProcessWithLowestBusyness() const;
+	unsigned int findEnabledProcessIndexWithStickySessionIdOrLowestBusyness(unsigned int id) const;
+	unsigned int findEnabledProcessIndexWithLowestBusyness() const;
+	unsigned int findEnabledProcessIndexWithPowerOfTwoChoices() const;
+	unsigned int findEnabledProcessIndexWithLowestExpectedLatency(unsigned long long now) const;
+	unsigned int findEnabledProcessIndexToRouteTo(unsigned long long now) const;
+	unsigned int nextRoutingRandomNumber() const;
+	void updateRoutingState(const Process *process);
 
 	void addProcessToList(const ProcessPtr &process, ProcessList &destination);
 	void removeProcessFromList(const ProcessPtr &process, ProcessList &source);
@@ -254,6 +270,7 @@ public:
 
 	void resetOptions(const Options &newOptions, Options *destination = NULL);
 	void mergeOptions(const Options &other);
+	void persistRoutingPolicy(const Options &other, Options &destination);
 
 	bool prepareHookScriptOptions(HookScriptOptions &hsOptions, const char *name);
 	void runAttachHooks(const ProcessPtr process) const;
@@ -360,11 +377,33 @@ public:
 	ProcessList detachedProcesses;
 
 	/**
-	 * A cache of the processes' busyness. It's in a compact structure
-	 * so that `findProcessWithLowestBusyness()` can work very quickly
-	 * when there are a large number of processes.
+	 * A cache of the enabled processes' busyness, indexed in the same way as
+	 * `enabledProcesses`. It keeps track of the least busy process, so that
+	 * `findEnabledProcessIndexWithLowestBusyness()` is O(1) and updating a
+	 * busyness level is O(log n), even when there are a large number of processes.
+	 */
+	IndexedMinHeap<int> enabledProcessBusynessLevels;
+
+	/**
+	 * Compact copies of the routing-relevant state of the processes in
+	 * `enabledProcesses` and `disablingProcesses` respectively, so that routing
+	 * doesn't have to access the Process objects themselves. Kept up to date
+	 * by addProcessToList(), removeProcessFromList() and updateRoutingState().
+	 */
+	ProcessRoutingTable enabledProcessRoutingTable;
+	ProcessRoutingTable disablingProcessRoutingTable;
+
+	/**
+	 * State of the pseudo-random number generator used by the
+	 * RP_POWER_OF_TWO_CHOICES routing policy. Protected by the same locks
+	 * as `enabledProcessBusynessLevels`.
+	 */
+	mutable boost::uint32_t routingRandomState;
+	/**
+	 * Whether we've already warned about a get() request with an unknown
+	 * routing policy. Protected by the same locks as `options`.
 	 */
-	boost::container::vector<int> enabledProcessBusynessLevels;
+	bool unknownRoutingPolicyWarned;
 
 	/**
 	 * get() requests for this group that cannot be immediately satisfied are
@@ -379,7 +418,8 @@ public:
 	 *    if getWaitlist is non-empty:
 	 *       enabledProcesses.empty() || (no request in getWaitlist is routeable)
 	 *
-	 * Here, "routeable" is defined as `route(options).process != NULL`.
+	 * Here, "routeable" is defined as
+	 * `route(options.stickySessionId, options.currentTime).process != NULL`.
 	 *
 	 * ### Invariant 2 (progress)
 	 *
@@ -441,12 +481,14 @@ public:
 
 	SessionPtr get(const Options &newOptions, const GetCallback &callback,
 		boost::container::vector<Callback> &postLockActions);
+	SessionPtr getQuickly(const Options &newOptions, const PerRequestOptions &requestOptions);
 
 	/****** Spawning and restarting ******/
 
 	void restart(const Options &options, RestartMethod method = RM_DEFAULT);
 	bool restarting() const;
 	bool needsRestart(const Options &options);
+	bool restartFileCheckDue(const Options &options, unsigned long long currentTime) const;
 
 	SpawnResult spawn();
 	bool spawning() const;
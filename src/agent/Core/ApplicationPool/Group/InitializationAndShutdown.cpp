@@ -104,11 +104,13 @@ Group::Group(Pool *_pool, const Options &_options)
 	info.group   = this;
 	info.name    = _options.getAppGroupName().toString();
 	info.apiKey  = generateApiKey(_pool);
+	unknownRoutingPolicyWarned = false;
 	resetOptions(_options);
 	enabledCount   = 0;
 	disablingCount = 0;
 	disabledCount  = 0;
 	nEnabledProcessesTotallyBusy = 0;
+	routingRandomState = (boost::uint32_t) (SystemTime::getUsec() ^ (uintptr_t) this) | 1;
 	spawner        = getContext()->getSpawningKitFactory()->create(options);
 	restartsInitiated = 0;
 	processesBeingSpawned = 0;
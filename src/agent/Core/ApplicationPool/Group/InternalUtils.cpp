@@ -75,6 +75,7 @@ Group::resetOptions(const Options &newOptions, Options *destination) {
 	*destination = newOptions;
 	destination->persist(newOptions);
 	destination->clearPerRequestFields();
+	persistRoutingPolicy(newOptions, *destination);
 	destination->apiKey    = getApiKey().toStaticString();
 	destination->groupUuid = uuid;
 }
@@ -88,6 +89,29 @@ Group::mergeOptions(const Options &other) {
 	options.minProcesses     = other.minProcesses;
 	options.statThrottleRate = other.statThrottleRate;
 	options.maxPreloaderIdleTime = other.maxPreloaderIdleTime;
+	persistRoutingPolicy(other, options);
+}
+
+/**
+ * Copies the routing policy from `other` into `destination`. An unknown
+ * routing policy, e.g. from a typo in the web server config, results in the
+ * default one. We warn about that only once per Group because this is called
+ * on every get() request.
+ */
+void
+Group::persistRoutingPolicy(const Options &other, Options &destination) {
+	if (OXT_LIKELY(other.routingPolicy != RP_UNKNOWN)) {
+		destination.routingPolicy = other.routingPolicy;
+		return;
+	}
+
+	if (!unknownRoutingPolicyWarned) {
+		unknownRoutingPolicyWarned = true;
+		P_WARN("Group " << info.name << " was requested with an unknown routing "
+			"policy. Valid values are: least-busy, power-of-two-choices, "
+			"least-expected-latency. Using least-busy instead");
+	}
+	destination.routingPolicy = RP_LEAST_BUSY;
 }
 
 /* Given a hook name like "queue_full_error", we return HookScriptOptions filled in with this name and a spec
@@ -258,7 +282,7 @@ Group::assignSessionsToGetWaitersQuickly(Lock &lock) {
 
 	while (!done && i < getWaitlist.size()) {
 		const GetWaiter &waiter = getWaitlist[i];
-		RouteResult result = route(waiter.options);
+		RouteResult result = route(waiter.options.stickySessionId, waiter.options.currentTime);
 		if (result.process != NULL) {
 			GetAction action;
 			action.callback = waiter.callback;
@@ -288,7 +312,7 @@ Group::assignSessionsToGetWaiters(boost::container::vector<Callback> &postLockAc
 
 	while (!done && i < getWaitlist.size()) {
 		const GetWaiter &waiter = getWaitlist[i];
-		RouteResult result = route(waiter.options);
+		RouteResult result = route(waiter.options.stickySessionId, waiter.options.currentTime);
 		if (result.process != NULL) {
 			postLockActions.push_back(boost::bind(
 				GetCallback::call,
@@ -47,82 +47,156 @@ using namespace boost;
 
 Process *
 Group::findProcessWithStickySessionId(unsigned int id) const {
-	ProcessList::const_iterator it, end = enabledProcesses.end();
-	for (it = enabledProcesses.begin(); it != end; it++) {
-		Process *process = it->get();
-		if (process->getStickySessionId() == id) {
-			return process;
-		}
+	int index = enabledProcessRoutingTable.findStickySessionId(id);
+	if (index == -1) {
+		return NULL;
+	} else {
+		return enabledProcesses[index].get();
 	}
-	return NULL;
 }
 
-Process *
-Group::findProcessWithStickySessionIdOrLowestBusyness(unsigned int id) const {
-	int leastBusyProcessIndex = -1;
-	int lowestBusyness = 0;
-	unsigned int i, size = enabledProcessBusynessLevels.size();
-	const int *enabledProcessBusynessLevels = &this->enabledProcessBusynessLevels[0];
+/**
+ * Returns the index of the enabled process with the given sticky session ID,
+ * or if there is no such process, that of the least busy enabled process.
+ * There must be at least one enabled process.
+ */
+unsigned int
+Group::findEnabledProcessIndexWithStickySessionIdOrLowestBusyness(unsigned int id) const {
+	int index = enabledProcessRoutingTable.findStickySessionId(id);
+	if (index == -1) {
+		return findEnabledProcessIndexWithLowestBusyness();
+	} else {
+		return index;
+	}
+}
 
-	for (i = 0; i < size; i++) {
-		Process *process = enabledProcesses[i].get();
-		if (process->getStickySessionId() == id) {
-			return process;
-		} else if (leastBusyProcessIndex == -1 || enabledProcessBusynessLevels[i] < lowestBusyness) {
-			leastBusyProcessIndex = i;
-			lowestBusyness = enabledProcessBusynessLevels[i];
-		}
+/**
+ * Returns the index of the least busy enabled process.
+ * There must be at least one enabled process.
+ */
+unsigned int
+Group::findEnabledProcessIndexWithLowestBusyness() const {
+	return enabledProcessBusynessLevels.top();
+}
+
+/**
+ * Picks two random enabled processes and returns the index of the least busy one.
+ * Falls back to the least busy enabled process if that one cannot be routed to,
+ * so that a routable process is returned whenever one exists.
+ */
+unsigned int
+Group::findEnabledProcessIndexWithPowerOfTwoChoices() const {
+	unsigned int size = enabledProcesses.size();
+	if (size <= 2) {
+		return findEnabledProcessIndexWithLowestBusyness();
 	}
 
-	if (leastBusyProcessIndex == -1) {
-		return NULL;
+	unsigned int a = nextRoutingRandomNumber() % size;
+	unsigned int b = nextRoutingRandomNumber() % (size - 1);
+	if (b >= a) {
+		b++;
+	}
+	if (enabledProcessBusynessLevels[b] < enabledProcessBusynessLevels[a]) {
+		a = b;
+	}
+
+	if (enabledProcessRoutingTable.canBeRoutedTo(a)) {
+		return a;
 	} else {
-		return enabledProcesses[leastBusyProcessIndex].get();
+		return findEnabledProcessIndexWithLowestBusyness();
 	}
 }
 
-Process *
-Group::findProcessWithLowestBusyness(const ProcessList &processes) const {
-	if (processes.empty()) {
-		return NULL;
+/**
+ * Returns the index of the routable enabled process with the lowest
+ * `expectedLatency()`. Processes that have no recorded response times yet are
+ * assumed to be as fast as the average of the other processes. Ties are broken
+ * by busyness. If no response times have been recorded at all, or if no process
+ * can be routed to, then this behaves like
+ * `findEnabledProcessIndexWithLowestBusyness()`.
+ */
+unsigned int
+Group::findEnabledProcessIndexWithLowestExpectedLatency(unsigned long long now) const {
+	unsigned int i, size = enabledProcesses.size();
+	double totalResponseTime = 0;
+	unsigned int nMeasured = 0;
+
+	for (i = 0; i < size; i++) {
+		const Process *process = enabledProcesses[i].get();
+		if (process->responseTimeAverage.available()) {
+			totalResponseTime += process->responseTimeAverage.average(now);
+			nMeasured++;
+		}
+	}
+	if (nMeasured == 0) {
+		return findEnabledProcessIndexWithLowestBusyness();
 	}
 
-	int lowestBusyness = -1;
-	Process *leastBusyProcess = NULL;
-	ProcessList::const_iterator it;
-	ProcessList::const_iterator end = processes.end();
-	for (it = processes.begin(); it != end; it++) {
-		Process *process = (*it).get();
-		int busyness = process->busyness();
-		if (lowestBusyness == -1 || lowestBusyness > busyness) {
-			lowestBusyness = busyness;
-			leastBusyProcess = process;
+	double fallback = totalResponseTime / nMeasured;
+	int bestIndex = -1;
+	double lowestLatency = 0;
+	for (i = 0; i < size; i++) {
+		if (!enabledProcessRoutingTable.canBeRoutedTo(i)) {
+			continue;
 		}
+		double latency = enabledProcesses[i]->expectedLatency(fallback, now);
+		if (bestIndex == -1
+		 || latency < lowestLatency
+		 || (latency == lowestLatency
+		     && enabledProcessBusynessLevels[i] < enabledProcessBusynessLevels[bestIndex]))
+		{
+			bestIndex = i;
+			lowestLatency = latency;
+		}
+	}
+
+	if (bestIndex != -1) {
+		return bestIndex;
+	} else {
+		return findEnabledProcessIndexWithLowestBusyness();
 	}
-	return leastBusyProcess;
 }
 
 /**
- * Cache-optimized version of findProcessWithLowestBusyness() for the common case.
+ * Selects an enabled process according to the routing policy, and returns its
+ * index. There must be at least one enabled process. The selected process may
+ * only be totally busy if all enabled processes are.
  */
-Process *
-Group::findEnabledProcessWithLowestBusyness() const {
-	if (enabledProcesses.empty()) {
-		return NULL;
+unsigned int
+Group::findEnabledProcessIndexToRouteTo(unsigned long long now) const {
+	switch (this->options.routingPolicy) {
+	case RP_POWER_OF_TWO_CHOICES:
+		return findEnabledProcessIndexWithPowerOfTwoChoices();
+	case RP_LEAST_EXPECTED_LATENCY:
+		return findEnabledProcessIndexWithLowestExpectedLatency(
+			(now != 0) ? now : SystemTime::getUsec());
+	default:
+		return findEnabledProcessIndexWithLowestBusyness();
 	}
+}
 
-	int leastBusyProcessIndex = -1;
-	int lowestBusyness = 0;
-	unsigned int i, size = enabledProcessBusynessLevels.size();
-	const int *enabledProcessBusynessLevels = &this->enabledProcessBusynessLevels[0];
+/** A xorshift32 generator. Statistical quality doesn't matter much here. */
+unsigned int
+Group::nextRoutingRandomNumber() const {
+	boost::uint32_t x = routingRandomState;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	routingRandomState = x;
+	return x;
+}
 
-	for (i = 0; i < size; i++) {
-		if (leastBusyProcessIndex == -1 || enabledProcessBusynessLevels[i] < lowestBusyness) {
-			leastBusyProcessIndex = i;
-			lowestBusyness = enabledProcessBusynessLevels[i];
-		}
+/**
+ * Must be called after the number of sessions of the given process has changed.
+ */
+void
+Group::updateRoutingState(const Process *process) {
+	if (process->enabled == Process::ENABLED) {
+		enabledProcessBusynessLevels.set(process->getIndex(), process->busyness());
+		enabledProcessRoutingTable.setSessions(process->getIndex(), process->sessions);
+	} else if (process->enabled == Process::DISABLING) {
+		disablingProcessRoutingTable.setSessions(process->getIndex(), process->sessions);
 	}
-	return enabledProcesses[leastBusyProcessIndex].get();
 }
 
 /**
@@ -139,12 +213,14 @@ Group::addProcessToList(const ProcessPtr &process, ProcessList &destination) {
 		process->enabled = Process::ENABLED;
 		enabledCount++;
 		enabledProcessBusynessLevels.push_back(process->busyness());
+		enabledProcessRoutingTable.push_back(process.get());
 		if (process->isTotallyBusy()) {
 			nEnabledProcessesTotallyBusy++;
 		}
 	} else if (&destination == &disablingProcesses) {
 		process->enabled = Process::DISABLING;
 		disablingCount++;
+		disablingProcessRoutingTable.push_back(process.get());
 	} else if (&destination == &disabledProcesses) {
 		assert(process->sessions == 0);
 		process->enabled = Process::DISABLED;
@@ -173,7 +249,8 @@ void
 Group::removeProcessFromList(const ProcessPtr &process, ProcessList &source) {
 	ProcessPtr p = process; // Keep an extra reference count just in case.
 
-	source.erase(source.begin() + process->getIndex());
+	int index = process->getIndex();
+	source.erase(source.begin() + index);
 	process->setIndex(-1);
 
 	switch (process->enabled) {
@@ -207,14 +284,14 @@ Group::removeProcessFromList(const ProcessPtr &process, ProcessList &source) {
 		process->setIndex(i);
 	}
 
-	// Rebuild enabledProcessBusynessLevels
 	if (&source == &enabledProcesses) {
-		enabledProcessBusynessLevels.clear();
-		for (it = source.begin(); it != end; it++, i++) {
-			const ProcessPtr &process = *it;
-			enabledProcessBusynessLevels.push_back(process->busyness());
-		}
+		enabledProcessBusynessLevels.erase(index);
 		enabledProcessBusynessLevels.shrink_to_fit();
+		enabledProcessRoutingTable.erase(index);
+		enabledProcessRoutingTable.shrink_to_fit();
+	} else if (&source == &disablingProcesses) {
+		disablingProcessRoutingTable.erase(index);
+		disablingProcessRoutingTable.shrink_to_fit();
 	}
 }
 
@@ -301,7 +378,7 @@ Group::detachedProcessesCheckerMain(GroupPtr self) {
 		debug->messages->recv("Proceed with starting detached processes checker");
 	}
 
-	boost::unique_lock<boost::mutex> lock(pool->syncher);
+	PoolScopedLock lock(pool->syncher);
 	while (true) {
 		assert(detachedProcessesCheckerActive);
 
@@ -525,6 +602,8 @@ Group::detachAll(boost::container::vector<Callback> &postLockActions) {
 	disablingProcesses.clear();
 	disabledProcesses.clear();
 	enabledProcessBusynessLevels.clear();
+	enabledProcessRoutingTable.clear();
+	disablingProcessRoutingTable.clear();
 	enabledCount = 0;
 	disablingCount = 0;
 	disabledCount = 0;
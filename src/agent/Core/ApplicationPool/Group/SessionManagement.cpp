@@ -55,35 +55,33 @@ using namespace boost;
  * until more processes have been spawned.
  */
 Group::RouteResult
-Group::route(const Options &options) const {
+Group::route(unsigned int stickySessionId, unsigned long long now) const {
 	if (OXT_LIKELY(enabledCount > 0)) {
-		if (options.stickySessionId == 0) {
-			Process *process = findEnabledProcessWithLowestBusyness();
-			if (process->canBeRoutedTo()) {
-				return RouteResult(process);
+		if (stickySessionId == 0) {
+			unsigned int index = findEnabledProcessIndexToRouteTo(now);
+			if (enabledProcessRoutingTable.canBeRoutedTo(index)) {
+				return RouteResult(enabledProcesses[index].get());
 			} else {
 				return RouteResult(NULL, true);
 			}
 		} else {
-			Process *process = findProcessWithStickySessionIdOrLowestBusyness(
-				options.stickySessionId);
-			if (process != NULL) {
-				if (process->canBeRoutedTo()) {
-					return RouteResult(process);
-				} else {
-					return RouteResult(NULL, false);
-				}
+			unsigned int index = findEnabledProcessIndexWithStickySessionIdOrLowestBusyness(
+				stickySessionId);
+			if (enabledProcessRoutingTable.canBeRoutedTo(index)) {
+				return RouteResult(enabledProcesses[index].get());
 			} else {
-				return RouteResult(NULL, true);
+				return RouteResult(NULL, false);
 			}
 		}
-	} else {
-		Process *process = findProcessWithLowestBusyness(disablingProcesses);
-		if (process->canBeRoutedTo()) {
-			return RouteResult(process);
+	} else if (disablingCount > 0) {
+		unsigned int index = disablingProcessRoutingTable.findLowestBusyness();
+		if (disablingProcessRoutingTable.canBeRoutedTo(index)) {
+			return RouteResult(disablingProcesses[index].get());
 		} else {
 			return RouteResult(NULL, true);
 		}
+	} else {
+		return RouteResult(NULL, true);
 	}
 }
 
@@ -93,8 +91,8 @@ Group::newSession(Process *process, unsigned long long now) {
 	SessionPtr session = process->newSession(now);
 	session->onInitiateFailure = _onSessionInitiateFailure;
 	session->onClose   = _onSessionClose;
+	updateRoutingState(process);
 	if (process->enabled == Process::ENABLED) {
-		enabledProcessBusynessLevels[process->getIndex()] = process->busyness();
 		if (!wasTotallyBusy && process->isTotallyBusy()) {
 			nEnabledProcessesTotallyBusy++;
 		}
@@ -123,7 +121,7 @@ Group::onSessionInitiateFailure(Process *process, Session *session) {
 	TRACE_POINT();
 	// Standard resource management boilerplate stuff...
 	Pool *pool = getPool();
-	boost::unique_lock<boost::mutex> lock(pool->syncher);
+	PoolScopedLock lock(pool->syncher);
 	assert(process->isAlive());
 	assert(isAlive() || getLifeStatus() == SHUTTING_DOWN);
 
@@ -139,27 +137,20 @@ Group::onSessionInitiateFailure(Process *process, Session *session) {
 }
 
 OXT_FORCE_INLINE void
-Group::onSessionClose(Process *process, Session *session) {
-	TRACE_POINT();
-	// Standard resource management boilerplate stuff...
-	Pool *pool = getPool();
-	boost::unique_lock<boost::mutex> lock(pool->syncher);
-	assert(process->isAlive());
-	assert(isAlive() || getLifeStatus() == SHUTTING_DOWN);
-
-	P_TRACE(2, "Session closed for process " << process->inspect());
-	verifyInvariants();
-	UPDATE_TRACE_POINT();
-
+Group::updateStatisticsAfterSessionClose(Process *process, Session *session) {
 	/* Update statistics. */
 	bool wasTotallyBusy = process->isTotallyBusy();
-	process->sessionClosed(session);
+	if (options.routingPolicy == RP_LEAST_EXPECTED_LATENCY) {
+		process->sessionClosed(session, SystemTime::getUsec());
+	} else {
+		process->sessionClosed(session);
+	}
 	assert(process->getLifeStatus() == Process::ALIVE);
 	assert(process->enabled == Process::ENABLED
 		|| process->enabled == Process::DISABLING
 		|| process->enabled == Process::DETACHED);
+	updateRoutingState(process);
 	if (process->enabled == Process::ENABLED) {
-		enabledProcessBusynessLevels[process->getIndex()] = process->busyness();
 		if (wasTotallyBusy) {
 			assert(nEnabledProcessesTotallyBusy >= 1);
 			nEnabledProcessesTotallyBusy--;
@@ -170,6 +161,56 @@ Group::onSessionClose(Process *process, Session *session) {
 	 * totally busy.
 	 */
 	assert(!process->isTotallyBusy());
+}
+
+/* Whether closing a session on the given process involves nothing more than
+ * updating the statistics, so that it can be done while holding the pool lock
+ * in shared mode plus `syncher`. This is the case unless closing the session
+ * could cause the process to be detached, disabled or put into out-of-band
+ * work, or could allow a waiting client to be served. The state checked here
+ * is either modified under the exclusive pool lock, or under `syncher`.
+ */
+bool
+Group::canCloseSessionQuickly(const Process *process) const {
+	return getWaitlist.empty()
+		&& process->enabled == Process::ENABLED
+		&& process->oobwStatus != Process::OOBW_REQUESTED
+		&& (options.maxRequests == 0 || process->processed + 1 < options.maxRequests)
+		&& (process->sessions > 1
+			|| (getPool()->getWaitlist.empty() && !anotherGroupIsWaitingForCapacity()));
+}
+
+OXT_FORCE_INLINE void
+Group::onSessionClose(Process *process, Session *session) {
+	TRACE_POINT();
+	// Standard resource management boilerplate stuff...
+	Pool *pool = getPool();
+
+	{
+		/* Common case: only the statistics have to be updated. This
+		 * does not affect other Groups, so the pool only needs to be
+		 * locked in shared mode.
+		 */
+		PoolSharedLock sharedLock(pool->syncher);
+		boost::lock_guard<boost::mutex> groupLock(syncher);
+		if (OXT_LIKELY(canCloseSessionQuickly(process))) {
+			assert(process->isAlive());
+			assert(isAlive() || getLifeStatus() == SHUTTING_DOWN);
+			P_TRACE(2, "Session closed for process " << process->inspect());
+			updateStatisticsAfterSessionClose(process, session);
+			return;
+		}
+	}
+
+	PoolScopedLock lock(pool->syncher);
+	assert(process->isAlive());
+	assert(isAlive() || getLifeStatus() == SHUTTING_DOWN);
+
+	P_TRACE(2, "Session closed for process " << process->inspect());
+	verifyInvariants();
+	UPDATE_TRACE_POINT();
+
+	updateStatisticsAfterSessionClose(process, session);
 
 	bool detachingBecauseOfMaxRequests = false;
 	bool detachingBecauseCapacityNeeded = false;
@@ -304,10 +345,9 @@ Group::get(const Options &newOptions, const GetCallback &callback,
 		assert(m_spawning || restarting() || poolAtFullCapacity());
 
 		if (disablingCount > 0 && !restarting()) {
-			Process *process = findProcessWithLowestBusyness(disablingProcesses);
-			assert(process != NULL);
-			if (!process->isTotallyBusy()) {
-				return newSession(process, newOptions.currentTime);
+			unsigned int index = disablingProcessRoutingTable.findLowestBusyness();
+			if (disablingProcessRoutingTable.canBeRoutedTo(index)) {
+				return newSession(disablingProcesses[index].get(), newOptions.currentTime);
 			}
 		}
 
@@ -316,7 +356,7 @@ Group::get(const Options &newOptions, const GetCallback &callback,
 		}
 		return SessionPtr();
 	} else {
-		RouteResult result = route(newOptions);
+		RouteResult result = route(newOptions.stickySessionId, newOptions.currentTime);
 		if (result.process == NULL) {
 			/* Looks like all processes are totally busy.
 			 * Wait until a new one has been spawned or until
@@ -333,6 +373,41 @@ Group::get(const Options &newOptions, const GetCallback &callback,
 	}
 }
 
+/**
+ * Fast path for get(). Pool::asyncGet() calls this while holding the pool lock
+ * in shared mode, plus `syncher`. A session is only checked out if that does
+ * not involve anything besides routing the request to a process, i.e. no
+ * spawning, restarting or queueing. Otherwise NULL is returned, and the caller
+ * must fall back to get() while holding the pool lock exclusively.
+ *
+ * The per-request fields of `newOptions` are ignored in favor of those in
+ * `requestOptions`.
+ */
+SessionPtr
+Group::getQuickly(const Options &newOptions, const PerRequestOptions &requestOptions) {
+	if (OXT_UNLIKELY(!isAlive()
+		|| restarting()
+		|| newOptions.noop
+		|| restartFileCheckDue(newOptions, requestOptions.currentTime)))
+	{
+		return SessionPtr();
+	}
+
+	mergeOptions(newOptions);
+	options.maxRequests = requestOptions.maxRequests;
+	if (OXT_UNLIKELY(shouldSpawnForGetAction())) {
+		return SessionPtr();
+	}
+
+	RouteResult result = route(requestOptions.stickySessionId, requestOptions.currentTime);
+	if (result.process == NULL) {
+		return SessionPtr();
+	} else {
+		P_DEBUG("Session checked out from process " << result.process->inspect());
+		return newSession(result.process, requestOptions.currentTime);
+	}
+}
+
 
 } // namespace ApplicationPool2
 } // namespace Passenger
@@ -112,7 +112,7 @@ Group::spawnThreadRealMain(const SpawningKit::SpawnerPtr &spawner,
 
 		UPDATE_TRACE_POINT();
 		ScopeGuard guard(boost::bind(Process::forceTriggerShutdownAndCleanup, process));
-		boost::unique_lock<boost::mutex> lock(pool->syncher);
+		PoolScopedLock lock(pool->syncher);
 
 		if (!isAlive()) {
 			if (process != NULL) {
@@ -238,7 +238,7 @@ Group::finalizeRestart(GroupPtr self,
 		debug->messages->recv("Finish restarting");
 	}
 
-	ScopedLock l(pool->syncher);
+	PoolScopedLock l(pool->syncher);
 	if (!isAlive()) {
 		P_DEBUG("Group " << getName() << " is shutting down, so aborting restart");
 		return;
@@ -407,6 +407,29 @@ Group::needsRestart(const Options &options) {
 	}
 }
 
+/**
+ * Whether the next needsRestart() call would look at the restart files on
+ * disk (and thus possibly change state), instead of returning false without
+ * doing anything.
+ */
+bool
+Group::restartFileCheckDue(const Options &options, unsigned long long currentTime) const {
+	if (m_restarting) {
+		return false;
+	} else if (lastRestartFileCheckTime == 0 || alwaysRestartFileExists) {
+		return true;
+	} else {
+		time_t now;
+
+		if (currentTime != 0) {
+			now = currentTime / 1000000;
+		} else {
+			now = SystemTime::get();
+		}
+		return lastRestartFileCheckTime <= now - (time_t) options.statThrottleRate;
+	}
+}
+
 /**
  * Attempts to increase the number of processes by one, while respecting the
  * resource limits. That is, this method will ensure that there are at least
@@ -263,6 +263,8 @@ Group::inspectConfigInAdminPanelFormat(Json::Value &result) const {
 		(Json::UInt) DEFAULT_MAX_REQUEST_QUEUE_SIZE);
 	result["max_requests"] = VAL((Json::UInt) options.maxRequests, 0u);
 	result["abort_websockets_on_process_shutdown"] = VAL(options.abortWebsocketsOnProcessShutdown);
+	result["routing_policy"] = SVAL(StaticString(getRoutingPolicyName(options.routingPolicy)),
+		P_STATIC_STRING("least-busy"));
 	result["force_max_concurrent_requests_per_process"] = VAL(options.forceMaxConcurrentRequestsPerProcess, -1);
 	result["restart_dir"] = NON_EMPTY_SVAL(options.restartDir);
 
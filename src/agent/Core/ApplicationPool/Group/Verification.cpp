@@ -91,6 +91,9 @@ Group::verifyInvariants() const {
 
 	// Verify list sizes.
 	assert((int) enabledProcesses.size() == enabledCount);
+	assert(enabledProcessBusynessLevels.size() == enabledProcesses.size());
+	assert(enabledProcessRoutingTable.size() == enabledProcesses.size());
+	assert(disablingProcessRoutingTable.size() == disablingProcesses.size());
 	assert((int) disablingProcesses.size() == disablingCount);
 	assert((int) disabledProcesses.size() == disabledCount);
 	assert(nEnabledProcessesTotallyBusy <= enabledCount);
@@ -115,6 +118,12 @@ Group::verifyExpensiveInvariants() const {
 		assert(process->isAlive());
 		assert(process->oobwStatus == Process::OOBW_NOT_ACTIVE
 			|| process->oobwStatus == Process::OOBW_REQUESTED);
+		assert(enabledProcessBusynessLevels[process->getIndex()] == process->busyness());
+		assert(enabledProcessRoutingTable.getStickySessionId(process->getIndex())
+			== process->getStickySessionId());
+		assert(enabledProcessRoutingTable.getSessions(process->getIndex()) == process->sessions);
+		assert(enabledProcessRoutingTable.getConcurrency(process->getIndex())
+			== process->getConcurrency());
 	}
 
 	end = disablingProcesses.end();
@@ -124,6 +133,7 @@ Group::verifyExpensiveInvariants() const {
 		assert(process->isAlive());
 		assert(process->oobwStatus == Process::OOBW_NOT_ACTIVE
 			|| process->oobwStatus == Process::OOBW_IN_PROGRESS);
+		assert(disablingProcessRoutingTable.getSessions(process->getIndex()) == process->sessions);
 	}
 
 	end = disabledProcesses.end();
@@ -147,7 +157,7 @@ Group::verifyNoRequestsOnGetWaitlistAreRoutable() const {
 	deque<GetWaiter>::const_iterator it, end = getWaitlist.end();
 
 	for (it = getWaitlist.begin(); it != end; it++) {
-		if (route(it->options).process != NULL) {
+		if (route(it->options.stickySessionId, it->options.currentTime).process != NULL) {
 			return false;
 		}
 	}
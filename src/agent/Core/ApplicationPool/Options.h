@@ -46,6 +46,58 @@ namespace ApplicationPool2 {
 using namespace std;
 using namespace boost;
 
+/**
+ * Determines which enabled process a Group routes a request to. Requests with
+ * a sticky session ID are always routed to the process with that ID if it
+ * exists, regardless of the routing policy.
+ */
+enum RoutingPolicy {
+	/** Route to the process with the lowest `busyness()`. */
+	RP_LEAST_BUSY,
+	/**
+	 * Pick two random processes and route to the least busy one. This spreads
+	 * requests over processes with equal busyness instead of always favoring
+	 * the oldest one.
+	 */
+	RP_POWER_OF_TWO_CHOICES,
+	/**
+	 * Route to the process whose recent response times, multiplied by the
+	 * number of sessions the request has to share it with, is lowest. This
+	 * avoids processes that are temporarily slow, e.g. because of a garbage
+	 * collection pause.
+	 */
+	RP_LEAST_EXPECTED_LATENCY,
+
+	RP_UNKNOWN
+};
+
+inline RoutingPolicy
+parseRoutingPolicy(const StaticString &name) {
+	if (name == P_STATIC_STRING("least-busy")) {
+		return RP_LEAST_BUSY;
+	} else if (name == P_STATIC_STRING("power-of-two-choices")) {
+		return RP_POWER_OF_TWO_CHOICES;
+	} else if (name == P_STATIC_STRING("least-expected-latency")) {
+		return RP_LEAST_EXPECTED_LATENCY;
+	} else {
+		return RP_UNKNOWN;
+	}
+}
+
+inline const char *
+getRoutingPolicyName(RoutingPolicy policy) {
+	switch (policy) {
+	case RP_LEAST_BUSY:
+		return "least-busy";
+	case RP_POWER_OF_TWO_CHOICES:
+		return "power-of-two-choices";
+	case RP_LEAST_EXPECTED_LATENCY:
+		return "least-expected-latency";
+	default:
+		return "unknown";
+	}
+}
+
 /**
  * This struct encapsulates information for ApplicationPool::get() and for
  * Spawner::spawn(), such as which application is to be spawned.
@@ -369,6 +421,9 @@ public:
 	 */
 	bool abortWebsocketsOnProcessShutdown;
 
+	/** How requests are distributed over the group's processes. */
+	RoutingPolicy routingPolicy;
+
 	/**
 	 * The Union Station key to use in case analytics logging is enabled.
 	 * It is used by Pool::collectAnalytics() and other administrative
@@ -495,6 +550,7 @@ public:
 		  maxOutOfBandWorkInstances(1),
 		  maxRequestQueueSize(DEFAULT_MAX_REQUEST_QUEUE_SIZE),
 		  abortWebsocketsOnProcessShutdown(true),
+		  routingPolicy(RP_LEAST_BUSY),
 
 		  stickySessionId(0),
 		  statThrottleRate(DEFAULT_STAT_THROTTLE_RATE),
@@ -712,6 +768,86 @@ public:
 	}
 };
 
+/**
+ * The Options fields that a caller may change on a per-request basis.
+ *
+ * Most of an Options object is the same for all requests to a group. A caller
+ * that handles many requests can therefore keep a single, immutable Options
+ * object per group, share it between requests by reference counting, and store
+ * only the fields that differ per request in a PerRequestOptions object. Both
+ * are passed to Pool::asyncGet(), which only combines them into a full Options
+ * object if the request cannot be handled through the fast path.
+ */
+class PerRequestOptions {
+public:
+	/** See Options::transaction. */
+	UnionStation::TransactionPtr transaction;
+
+	/** See Options::environmentVariables. */
+	StaticString environmentVariables;
+
+	/** See Options::unionStationKey. */
+	StaticString unionStationKey;
+
+	/** See Options::maxRequests. */
+	unsigned long maxRequests;
+
+	/** See Options::currentTime. */
+	unsigned long long currentTime;
+
+	/** See Options::stickySessionId. */
+	unsigned int stickySessionId;
+
+	/** See Options::analytics. */
+	bool analytics;
+
+	PerRequestOptions()
+		: maxRequests(0),
+		  currentTime(0),
+		  stickySessionId(0),
+		  analytics(false)
+		{ }
+
+	/**
+	 * Creates a PerRequestOptions object whose fields have the same values as
+	 * the corresponding fields in the given Options object.
+	 */
+	explicit PerRequestOptions(const Options &options)
+		: transaction(options.transaction),
+		  environmentVariables(options.environmentVariables),
+		  unionStationKey(options.unionStationKey),
+		  maxRequests(options.maxRequests),
+		  currentTime(options.currentTime),
+		  stickySessionId(options.stickySessionId),
+		  analytics(options.analytics)
+		{ }
+
+	/**
+	 * Resets all fields to the values of the corresponding fields in the
+	 * given Options object.
+	 */
+	void reset(const Options &options) {
+		transaction = options.transaction;
+		environmentVariables = options.environmentVariables;
+		unionStationKey = options.unionStationKey;
+		maxRequests = options.maxRequests;
+		currentTime = options.currentTime;
+		stickySessionId = options.stickySessionId;
+		analytics = options.analytics;
+	}
+
+	/** Overwrites the corresponding fields in the given Options object. */
+	void applyTo(Options &options) const {
+		options.transaction = transaction;
+		options.environmentVariables = environmentVariables;
+		options.unionStationKey = unionStationKey;
+		options.maxRequests = maxRequests;
+		options.currentTime = currentTime;
+		options.stickySessionId = stickySessionId;
+		options.analytics = analytics;
+	}
+};
+
 } // namespace ApplicationPool2
 } // namespace Passenger
 
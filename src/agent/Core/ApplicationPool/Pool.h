@@ -33,6 +33,7 @@
 #include <sstream>
 #include <iomanip>
 #include <boost/thread.hpp>
+#include <boost/atomic.hpp>
 #include <boost/bind.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
@@ -206,7 +207,7 @@ public:
 	friend class Process;
 	friend struct tut::ApplicationPool2_PoolTest;
 
-	mutable boost::mutex syncher;
+	mutable PoolMutex syncher;
 	unsigned int max;
 	unsigned long long maxIdleTime;
 	bool selfchecking;
@@ -235,6 +236,13 @@ public:
 	mutable GroupMap groups;
 	psg_pool_t *palloc;
 
+	/**
+	 * Incremented every time a Group is detached from the pool. Lets holders
+	 * of Group handles (see asyncGet()) find out cheaply, without grabbing
+	 * the pool lock, that some of their handles may have gone stale.
+	 */
+	boost::atomic<unsigned int> groupDetachGeneration;
+
 	/**
 	 * get() requests that...
 	 * - cannot be immediately satisfied because the pool is at full
@@ -346,7 +354,7 @@ public:
 		boost::container::vector<Callback> actions;
 	};
 
-	boost::condition_variable garbageCollectionCond;
+	boost::condition_variable_any garbageCollectionCond;
 
 	void initializeGarbageCollection();
 	static void garbageCollect(PoolPtr self);
@@ -440,6 +448,18 @@ public:
 	void inspectProcessList(const InspectOptions &options, stringstream &result,
 		const Group *group, const ProcessList &processes) const;
 
+
+	/****** Miscellaneous ******/
+
+	UnionStation::StopwatchLog *createAsyncGetStopwatchLog(
+		const UnionStation::TransactionPtr &transaction,
+		const Group *existingGroup) const;
+	bool asyncGetQuickly(const Options &options, const PerRequestOptions &requestOptions,
+		const GetCallback &callback, UnionStation::StopwatchLog **stopwatchLog,
+		GroupPtr *groupHandle);
+	void asyncGetSlowly(const Options &options, const GetCallback &callback, bool lockNow,
+		UnionStation::StopwatchLog **stopwatchLog);
+
 public:
 	typedef void (*AbortLongRunningConnectionsCallback)(const ProcessPtr &process);
 	AbortLongRunningConnectionsCallback abortLongRunningConnectionsCallback;
@@ -495,6 +515,7 @@ public:
 	bool atFullCapacity() const;
 	unsigned int getProcessCount(bool lock = true) const;
 	unsigned int getGroupCount() const;
+	unsigned int getGroupDetachGeneration() const;
 	string inspect(const InspectOptions &options = InspectOptions::makeAuthorized(),
 		bool lock = true) const;
 	string toXml(const ToXmlOptions &options = ToXmlOptions::makeAuthorized(),
@@ -505,7 +526,11 @@ public:
 
 	/****** Miscellaneous ******/
 
-	void asyncGet(const Options &options, const GetCallback &callback, bool lockNow = true, UnionStation::StopwatchLog **stopwatchLog = NULL);
+	void asyncGet(const Options &options, const GetCallback &callback, bool lockNow = true,
+		UnionStation::StopwatchLog **stopwatchLog = NULL, GroupPtr *groupHandle = NULL);
+	void asyncGet(const Options &groupOptions, const PerRequestOptions &requestOptions,
+		const GetCallback &callback, bool lockNow = true,
+		UnionStation::StopwatchLog **stopwatchLog = NULL, GroupPtr *groupHandle = NULL);
 	SessionPtr get(const Options &options, Ticket *ticket);
 	void setMax(unsigned int max);
 	void setMaxIdleTime(unsigned long long value);
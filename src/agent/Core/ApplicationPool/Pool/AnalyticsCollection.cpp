@@ -158,13 +158,13 @@ Pool::realCollectAnalytics() {
 	// Collect all the PIDs.
 	{
 		UPDATE_TRACE_POINT();
-		LockGuard l(syncher);
+		PoolLockGuard l(syncher);
 		max = this->max;
 	}
 	pids.reserve(max);
 	{
 		UPDATE_TRACE_POINT();
-		LockGuard l(syncher);
+		PoolLockGuard l(syncher);
 		GroupMap::ConstIterator g_it(groups);
 
 		while (*g_it != NULL) {
@@ -201,7 +201,7 @@ Pool::realCollectAnalytics() {
 		vector<UnionStationLogEntry> logEntries;
 		vector<ProcessPtr> processesToDetach;
 		boost::container::vector<Callback> actions;
-		ScopedLock l(syncher);
+		PoolScopedLock l(syncher);
 		GroupMap::ConstIterator g_it(groups);
 
 		UPDATE_TRACE_POINT();
@@ -51,7 +51,7 @@ void
 Pool::garbageCollect(PoolPtr self) {
 	TRACE_POINT();
 	{
-		ScopedLock lock(self->syncher);
+		PoolScopedLock lock(self->syncher);
 		self->garbageCollectionCond.timed_wait(lock,
 			posix_time::seconds(5));
 	}
@@ -60,7 +60,7 @@ Pool::garbageCollect(PoolPtr self) {
 			UPDATE_TRACE_POINT();
 			unsigned long long sleepTime = self->realGarbageCollect();
 			UPDATE_TRACE_POINT();
-			ScopedLock lock(self->syncher);
+			PoolScopedLock lock(self->syncher);
 			self->garbageCollectionCond.timed_wait(lock,
 				posix_time::microseconds(sleepTime));
 		} catch (const thread_interrupted &) {
@@ -141,7 +141,7 @@ Pool::maybeCleanPreloader(GarbageCollectorState &state, const GroupPtr &group) {
 unsigned long long
 Pool::realGarbageCollect() {
 	TRACE_POINT();
-	ScopedLock lock(syncher);
+	PoolScopedLock lock(syncher);
 	GroupMap::ConstIterator g_it(groups);
 	GarbageCollectorState state;
 	state.now = SystemTime::getUsec();
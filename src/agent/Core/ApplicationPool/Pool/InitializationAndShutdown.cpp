@@ -40,7 +40,8 @@ using namespace boost;
 
 Pool::Pool(const SpawningKit::FactoryPtr &spawningKitFactory,
 	const Json::Value &agentConfig)
-	: abortLongRunningConnectionsCallback(NULL)
+	: groupDetachGeneration(0),
+	  abortLongRunningConnectionsCallback(NULL)
 {
 	context.setSpawningKitFactory(spawningKitFactory);
 	context.finalize();
@@ -76,14 +77,14 @@ Pool::~Pool() {
 /** Must be called right after construction. */
 void
 Pool::initialize() {
-	LockGuard l(syncher);
+	PoolLockGuard l(syncher);
 	initializeAnalyticsCollection();
 	initializeGarbageCollection();
 }
 
 void
 Pool::initDebugging() {
-	LockGuard l(syncher);
+	PoolLockGuard l(syncher);
 	debugSupport = boost::make_shared<DebugSupport>();
 }
 
@@ -97,7 +98,7 @@ Pool::initDebugging() {
 void
 Pool::prepareForShutdown() {
 	TRACE_POINT();
-	ScopedLock lock(syncher);
+	PoolScopedLock lock(syncher);
 	assert(lifeStatus == ALIVE);
 	lifeStatus = PREPARED_FOR_SHUTDOWN;
 	if (abortLongRunningConnectionsCallback != NULL) {
@@ -114,7 +115,7 @@ Pool::prepareForShutdown() {
 void
 Pool::destroy() {
 	TRACE_POINT();
-	ScopedLock lock(syncher);
+	PoolScopedLock lock(syncher);
 	assert(lifeStatus == ALIVE || lifeStatus == PREPARED_FOR_SHUTDOWN);
 
 	lifeStatus = SHUTTING_DOWN;
@@ -38,11 +38,90 @@ using namespace std;
 using namespace boost;
 
 
-// 'lockNow == false' may only be used during unit tests. Normally we
-// should never call the callback while holding the lock.
+UnionStation::StopwatchLog *
+Pool::createAsyncGetStopwatchLog(const UnionStation::TransactionPtr &transaction,
+	const Group *existingGroup) const
+{
+	// Log some essentials stats about what this request is facing in its upcoming journey through the queue:
+	// 1) position in the queue upon entry, and 2) whether spawning activity is occurring (which takes cycles
+	// but also indicates the server has headroom to handle the load).
+	Json::Value data;
+	if (!existingGroup) {
+		data["message"] = "spawning.."; // the first of this group, so keep it simple (also: we don't know maxQ yet)
+	} else {
+		char queueMaxStr[10];
+		int queueMax = existingGroup->options.maxRequestQueueSize;
+		if (queueMax > 0) {
+			snprintf(queueMaxStr, sizeof(queueMaxStr), "%d", queueMax);
+		}
+		char message[50];
+		snprintf(message, sizeof(message), "queue: %zu / %s, spawning: %s", existingGroup->getWaitlist.size(),
+				(queueMax == 0 ? "inf" : queueMaxStr),
+				(existingGroup->processesBeingSpawned == 0 ? "no" : "yes"));
+		data["message"] = message;
+	}
+	Json::Value json;
+	json["data"] = data;
+	json["data_type"] = "generic";
+	json["name"] = "Await available process";
+
+	return new UnionStation::StopwatchLog(transaction, "Pool::asyncGet", stringifyJson(json).c_str());
+}
+
+/**
+ * Tries to check out a session while holding the pool lock in shared mode only,
+ * so that checkouts on different Groups can proceed in parallel. This succeeds
+ * if the Group exists and has a process that can handle the request right
+ * away. Returns false if the caller must fall back to the exclusive code path.
+ *
+ * If `groupHandle` is given and refers to a Group that is still alive, then
+ * that Group is used without looking it up. Otherwise, the Group is looked up
+ * and `groupHandle` is updated to refer to it.
+ *
+ * `options` only has to contain valid per-group fields; the per-request
+ * fields are taken from `requestOptions`.
+ */
+bool
+Pool::asyncGetQuickly(const Options &options, const PerRequestOptions &requestOptions,
+	const GetCallback &callback, UnionStation::StopwatchLog **stopwatchLog,
+	GroupPtr *groupHandle)
+{
+	SessionPtr session;
+	{
+		PoolSharedLock lock(syncher);
+		Group *group;
+		if (groupHandle != NULL && *groupHandle != NULL && (*groupHandle)->isAlive()) {
+			// An alive Group is guaranteed to still be in `groups`.
+			group = groupHandle->get();
+		} else {
+			group = findMatchingGroup(options);
+			if (OXT_UNLIKELY(group == NULL)) {
+				return false;
+			}
+			if (groupHandle != NULL) {
+				*groupHandle = group->shared_from_this();
+			}
+		}
+
+		boost::lock_guard<boost::mutex> groupLock(group->syncher);
+		session = group->getQuickly(options, requestOptions);
+		if (session == NULL) {
+			return false;
+		}
+		if (stopwatchLog != NULL) {
+			*stopwatchLog = createAsyncGetStopwatchLog(requestOptions.transaction, group);
+		}
+	}
+	P_TRACE(2, "asyncGet() finished through the fast path");
+	callback(session, ExceptionPtr());
+	return true;
+}
+
 void
-Pool::asyncGet(const Options &options, const GetCallback &callback, bool lockNow, UnionStation::StopwatchLog **stopwatchLog) {
-	DynamicScopedLock lock(syncher, lockNow);
+Pool::asyncGetSlowly(const Options &options, const GetCallback &callback, bool lockNow,
+	UnionStation::StopwatchLog **stopwatchLog)
+{
+	DynamicPoolScopedLock lock(syncher, lockNow);
 
 	assert(lifeStatus == ALIVE || lifeStatus == PREPARED_FOR_SHUTDOWN);
 	verifyInvariants();
@@ -51,30 +130,7 @@ Pool::asyncGet(const Options &options, const GetCallback &callback, bool lockNow
 
 	Group *existingGroup = findMatchingGroup(options);
 	if (stopwatchLog != NULL) {
-		// Log some essentials stats about what this request is facing in its upcoming journey through the queue:
-		// 1) position in the queue upon entry, and 2) whether spawning activity is occurring (which takes cycles
-		// but also indicates the server has headroom to handle the load).
-		Json::Value data;
-		if (!existingGroup) {
-			data["message"] = "spawning.."; // the first of this group, so keep it simple (also: we don't know maxQ yet)
-		} else {
-			char queueMaxStr[10];
-			int queueMax = existingGroup->options.maxRequestQueueSize;
-			if (queueMax > 0) {
-				snprintf(queueMaxStr, sizeof(queueMaxStr), "%d", queueMax);
-			}
-			char message[50];
-			snprintf(message, sizeof(message), "queue: %zu / %s, spawning: %s", existingGroup->getWaitlist.size(),
-					(queueMax == 0 ? "inf" : queueMaxStr),
-					(existingGroup->processesBeingSpawned == 0 ? "no" : "yes"));
-			data["message"] = message;
-		}
-		Json::Value json;
-		json["data"] = data;
-		json["data_type"] = "generic";
-		json["name"] = "Await available process";
-
-		*stopwatchLog = new UnionStation::StopwatchLog(options.transaction, "Pool::asyncGet", stringifyJson(json).c_str());
+		*stopwatchLog = createAsyncGetStopwatchLog(options.transaction, existingGroup);
 	}
 
 	if (OXT_LIKELY(existingGroup != NULL)) {
@@ -164,6 +220,42 @@ Pool::asyncGet(const Options &options, const GetCallback &callback, bool lockNow
 	}
 }
 
+// 'lockNow == false' may only be used during unit tests. Normally we
+// should never call the callback while holding the lock.
+void
+Pool::asyncGet(const Options &options, const GetCallback &callback, bool lockNow,
+	UnionStation::StopwatchLog **stopwatchLog, GroupPtr *groupHandle)
+{
+	if (OXT_LIKELY(lockNow) && asyncGetQuickly(options, PerRequestOptions(options),
+		callback, stopwatchLog, groupHandle))
+	{
+		return;
+	}
+	asyncGetSlowly(options, callback, lockNow, stopwatchLog);
+}
+
+/**
+ * Like `asyncGet(options, ...)`, but with the per-request fields taken from
+ * `requestOptions` instead of from `groupOptions`. This allows the caller to
+ * share a single `groupOptions` object between all requests to a group.
+ * A full Options object is only assembled if the fast path cannot be taken.
+ */
+void
+Pool::asyncGet(const Options &groupOptions, const PerRequestOptions &requestOptions,
+	const GetCallback &callback, bool lockNow,
+	UnionStation::StopwatchLog **stopwatchLog, GroupPtr *groupHandle)
+{
+	if (OXT_LIKELY(lockNow) && asyncGetQuickly(groupOptions, requestOptions,
+		callback, stopwatchLog, groupHandle))
+	{
+		return;
+	}
+
+	Options options(groupOptions);
+	requestOptions.applyTo(options);
+	asyncGetSlowly(options, callback, lockNow, stopwatchLog);
+}
+
 // TODO: 'ticket' should be a boost::shared_ptr for interruption-safety.
 SessionPtr
 Pool::get(const Options &options, Ticket *ticket) {
@@ -193,7 +285,7 @@ Pool::get(const Options &options, Ticket *ticket) {
 
 void
 Pool::setMax(unsigned int max) {
-	ScopedLock l(syncher);
+	PoolScopedLock l(syncher);
 	assert(max > 0);
 	fullVerifyInvariants();
 	bool bigger = max > this->max;
@@ -222,14 +314,14 @@ Pool::setMax(unsigned int max) {
 
 void
 Pool::setMaxIdleTime(unsigned long long value) {
-	LockGuard l(syncher);
+	PoolLockGuard l(syncher);
 	maxIdleTime = value;
 	wakeupGarbageCollector();
 }
 
 void
 Pool::enableSelfChecking(bool enabled) {
-	LockGuard l(syncher);
+	PoolLockGuard l(syncher);
 	selfchecking = enabled;
 }
 
@@ -238,7 +330,7 @@ Pool::enableSelfChecking(bool enabled) {
  */
 bool
 Pool::isSpawning(bool lock) const {
-	DynamicScopedLock l(syncher, lock);
+	DynamicPoolScopedLock l(syncher, lock);
 	GroupMap::ConstIterator g_it(groups);
 	while (*g_it != NULL) {
 		const GroupPtr &group = g_it.getValue();
@@ -252,7 +344,7 @@ Pool::isSpawning(bool lock) const {
 
 void
 Pool::setAgentConfig(const Json::Value &agentConfig) {
-	LockGuard l(syncher);
+	PoolLockGuard l(syncher);
 	this->agentConfig = agentConfig;
 }
 
@@ -267,7 +359,7 @@ Pool::authorizeByUid(uid_t uid, bool lock) const {
 		return true;
 	}
 
-	DynamicScopedLock l(syncher, lock);
+	DynamicPoolScopedLock l(syncher, lock);
 	GroupMap::ConstIterator g_it(groups);
 	while (*g_it != NULL) {
 		const GroupPtr &group = g_it.getValue();
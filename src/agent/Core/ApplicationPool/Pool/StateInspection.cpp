@@ -125,7 +125,7 @@ Pool::inspectProcessList(const InspectOptions &options, stringstream &result,
 
 string
 Pool::inspect(const InspectOptions &options, bool lock) const {
-	DynamicScopedLock l(syncher, lock);
+	DynamicPoolScopedLock l(syncher, lock);
 	stringstream result;
 	const char *headerColor = maybeColorize(options, ANSI_COLOR_YELLOW ANSI_COLOR_BLUE_BG ANSI_COLOR_BOLD);
 	const char *resetColor  = maybeColorize(options, ANSI_COLOR_RESET);
@@ -191,7 +191,7 @@ Pool::inspect(const InspectOptions &options, bool lock) const {
 
 string
 Pool::toXml(const ToXmlOptions &options, bool lock) const {
-	DynamicScopedLock l(syncher, lock);
+	DynamicPoolScopedLock l(syncher, lock);
 	stringstream result;
 	GroupMap::ConstIterator g_it(groups);
 	ProcessList::const_iterator p_it;
@@ -260,7 +260,7 @@ Pool::toXml(const ToXmlOptions &options, bool lock) const {
 
 Json::Value
 Pool::inspectPropertiesInAdminPanelFormat(const ToJsonOptions &options) const {
-	ScopedLock l(syncher);
+	PoolScopedLock l(syncher);
 	Json::Value result(Json::objectValue);
 	GroupMap::ConstIterator g_it(groups);
 	ProcessList::const_iterator p_it;
@@ -301,7 +301,7 @@ Pool::inspectPropertiesInAdminPanelFormat(const ToJsonOptions &options) const {
 
 Json::Value
 Pool::inspectConfigInAdminPanelFormat(const ToJsonOptions &options) const {
-	ScopedLock l(syncher);
+	PoolScopedLock l(syncher);
 	Json::Value result(Json::objectValue);
 	GroupMap::ConstIterator g_it(groups);
 	ProcessList::const_iterator p_it;
@@ -390,13 +390,13 @@ Pool::makeSingleNonEmptyStrValueJsonConfigFormat(const StaticString &val) {
 
 unsigned int
 Pool::capacityUsed() const {
-	LockGuard l(syncher);
+	PoolLockGuard l(syncher);
 	return capacityUsedUnlocked();
 }
 
 bool
 Pool::atFullCapacity() const {
-	LockGuard l(syncher);
+	PoolLockGuard l(syncher);
 	return atFullCapacityUnlocked();
 }
 
@@ -407,7 +407,7 @@ Pool::atFullCapacity() const {
  */
 unsigned int
 Pool::getProcessCount(bool lock) const {
-	DynamicScopedLock l(syncher, lock);
+	DynamicPoolScopedLock l(syncher, lock);
 	unsigned int result = 0;
 	GroupMap::ConstIterator g_it(groups);
 	while (*g_it != NULL) {
@@ -420,10 +420,19 @@ Pool::getProcessCount(bool lock) const {
 
 unsigned int
 Pool::getGroupCount() const {
-	LockGuard l(syncher);
+	PoolLockGuard l(syncher);
 	return groups.size();
 }
 
+/**
+ * Returns a number that changes every time a Group is detached from the pool.
+ * Does not grab the pool lock.
+ */
+unsigned int
+Pool::getGroupDetachGeneration() const {
+	return groupDetachGeneration.load(boost::memory_order_acquire);
+}
+
 
 } // namespace ApplicationPool2
 } // namespace Passenger
@@ -47,6 +47,7 @@
 #include <Utils/StrIntUtils.h>
 #include <Utils/Lock.h>
 #include <Utils/ProcessMetricsCollector.h>
+#include <Algorithms/MovingAverage.h>
 #include <Core/ApplicationPool/Common.h>
 #include <Core/ApplicationPool/Socket.h>
 #include <Core/ApplicationPool/Session.h>
@@ -368,6 +369,13 @@ public:
 	int sessions;
 	/** Number of sessions opened so far. */
 	unsigned int processed;
+	/**
+	 * Moving average of the durations (in microseconds) of closed sessions.
+	 * Only updated if the Group's routing policy needs it. Data decays by half
+	 * per second, so that a process that was slow at some point is considered
+	 * again soon after.
+	 */
+	DiscExpMovingAverage<500> responseTimeAverage;
 	/** Do not access directly, always use `isAlive()`/`isDead()`/`getLifeStatus()` or
 	 * through `lifetimeSyncher`. */
 	enum LifeStatus {
@@ -625,6 +633,10 @@ public:
 		return info.stickySessionId;
 	}
 
+	int getConcurrency() const {
+		return concurrency;
+	}
+
 	unsigned long long getSpawnerCreationTime() const {
 		return spawnerCreationTime;
 	}
@@ -700,7 +712,7 @@ public:
 		}
 	}
 
-	int busyness() const {
+	static int calculateBusyness(int sessions, int concurrency) {
 		/* Different processes within a Group may have different
 		 * 'concurrency' values. We want:
 		 * - the process with the smallest busyness to be be picked for routing.
@@ -719,12 +731,20 @@ public:
 		}
 	}
 
+	static bool calculateTotallyBusy(int sessions, int concurrency) {
+		return concurrency != 0 && sessions >= concurrency;
+	}
+
+	int busyness() const {
+		return calculateBusyness(sessions, concurrency);
+	}
+
 	/**
 	 * Whether we've reached the maximum number of concurrent sessions for this
 	 * process.
 	 */
 	bool isTotallyBusy() const {
-		return concurrency != 0 && sessions >= concurrency;
+		return calculateTotallyBusy(sessions, concurrency);
 	}
 
 	/**
@@ -760,11 +780,11 @@ public:
 			} else {
 				lastUsed = SystemTime::getUsec();
 			}
-			return createSessionObject(socket);
+			return createSessionObject(socket, lastUsed);
 		}
 	}
 
-	SessionPtr createSessionObject(Socket *socket) {
+	SessionPtr createSessionObject(Socket *socket, unsigned long long startTime = 0) {
 		struct Guard {
 			Context *context;
 			Session *session;
@@ -789,12 +809,16 @@ public:
 		LockGuard l(context->getMmSyncher());
 		Session *session = context->getSessionObjectPool().malloc();
 		Guard guard(context, session);
-		session = new (session) Session(context, &info, socket);
+		session = new (session) Session(context, &info, socket, startTime);
 		guard.clear();
 		return SessionPtr(session, false);
 	}
 
-	void sessionClosed(Session *session) {
+	/**
+	 * If `now` (in microseconds) is non-zero, then the session's duration is
+	 * recorded in `responseTimeAverage`.
+	 */
+	void sessionClosed(Session *session, unsigned long long now = 0) {
 		Socket *socket = session->getSocket();
 
 		assert(socket->sessions > 0);
@@ -803,9 +827,25 @@ public:
 		socket->sessions--;
 		this->sessions--;
 		processed++;
+		if (now != 0 && now > session->getStartTime()) {
+			responseTimeAverage.update(now - session->getStartTime(), now);
+		}
 		assert(!isTotallyBusy());
 	}
 
+	/**
+	 * The expected time (in microseconds) that a new session would take if it
+	 * were opened now, based on the recent response times of this process and
+	 * the number of sessions the new session would share the process with.
+	 * `fallback` is used as the response time if none has been recorded yet.
+	 */
+	double expectedLatency(double fallback, unsigned long long now) const {
+		double responseTime = responseTimeAverage.available()
+			? responseTimeAverage.average(now)
+			: fallback;
+		return responseTime * (sessions + 1);
+	}
+
 	/**
 	 * Returns the uptime of this process so far, as a string.
 	 */
@@ -829,6 +869,10 @@ public:
 		stream << "<sessions>" << sessions << "</sessions>";
 		stream << "<busyness>" << busyness() << "</busyness>";
 		stream << "<processed>" << processed << "</processed>";
+		if (responseTimeAverage.available()) {
+			stream << "<response_time_average>" << (unsigned long long) responseTimeAverage.average()
+				<< "</response_time_average>";
+		}
 		stream << "<spawner_creation_time>" << spawnerCreationTime << "</spawner_creation_time>";
 		stream << "<spawn_start_time>" << spawnStartTime << "</spawn_start_time>";
 		stream << "<spawn_end_time>" << spawnEndTime << "</spawn_end_time>";
@@ -0,0 +1,153 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_APPLICATION_POOL2_PROCESS_ROUTING_TABLE_H_
+#define _PASSENGER_APPLICATION_POOL2_PROCESS_ROUTING_TABLE_H_
+
+#include <boost/container/vector.hpp>
+#include <cassert>
+#include <Core/ApplicationPool/Process.h>
+
+namespace Passenger {
+namespace ApplicationPool2 {
+
+using namespace std;
+
+
+/**
+ * A copy of the routing-relevant state of the processes in a ProcessList,
+ * indexed in the same way as that list. Process objects are large and
+ * individually allocated, so looping through a ProcessList and inspecting
+ * each Process touches at least one cache line per process. This table
+ * stores the same information as a struct of arrays instead, so that a
+ * search for a sticky session ID or a routable process only reads a few
+ * contiguous cache lines.
+ *
+ * Group is responsible for keeping this table in sync with the list and
+ * with the processes' session counts.
+ */
+class ProcessRoutingTable {
+private:
+	boost::container::vector<unsigned int> stickySessionIds;
+	boost::container::vector<int> sessions;
+	boost::container::vector<int> concurrencies;
+
+public:
+	unsigned int size() const {
+		return sessions.size();
+	}
+
+	bool empty() const {
+		return sessions.empty();
+	}
+
+	void push_back(const Process *process) {
+		stickySessionIds.push_back(process->getStickySessionId());
+		sessions.push_back(process->sessions);
+		concurrencies.push_back(process->getConcurrency());
+	}
+
+	void erase(unsigned int index) {
+		stickySessionIds.erase(stickySessionIds.begin() + index);
+		sessions.erase(sessions.begin() + index);
+		concurrencies.erase(concurrencies.begin() + index);
+	}
+
+	void clear() {
+		stickySessionIds.clear();
+		sessions.clear();
+		concurrencies.clear();
+	}
+
+	void shrink_to_fit() {
+		stickySessionIds.shrink_to_fit();
+		sessions.shrink_to_fit();
+		concurrencies.shrink_to_fit();
+	}
+
+	/** Must be called whenever the session count of the process at `index` changes. */
+	void setSessions(unsigned int index, int value) {
+		sessions[index] = value;
+	}
+
+	unsigned int getStickySessionId(unsigned int index) const {
+		return stickySessionIds[index];
+	}
+
+	int getSessions(unsigned int index) const {
+		return sessions[index];
+	}
+
+	int getConcurrency(unsigned int index) const {
+		return concurrencies[index];
+	}
+
+	int busyness(unsigned int index) const {
+		return Process::calculateBusyness(sessions[index], concurrencies[index]);
+	}
+
+	bool canBeRoutedTo(unsigned int index) const {
+		return !Process::calculateTotallyBusy(sessions[index], concurrencies[index]);
+	}
+
+	/** Returns the index of the process with the given sticky session ID, or -1. */
+	int findStickySessionId(unsigned int id) const {
+		const unsigned int *ids = stickySessionIds.data();
+		unsigned int i, size = stickySessionIds.size();
+
+		for (i = 0; i < size; i++) {
+			if (ids[i] == id) {
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	/**
+	 * Returns the index of the first process with the lowest busyness.
+	 * The table must not be empty.
+	 */
+	unsigned int findLowestBusyness() const {
+		unsigned int i, result = 0, size = sessions.size();
+		int lowestBusyness;
+
+		assert(!empty());
+		lowestBusyness = busyness(0);
+		for (i = 1; i < size; i++) {
+			int b = busyness(i);
+			if (b < lowestBusyness) {
+				lowestBusyness = b;
+				result = i;
+			}
+		}
+		return result;
+	}
+};
+
+
+} // namespace ApplicationPool2
+} // namespace Passenger
+
+#endif /* _PASSENGER_APPLICATION_POOL2_PROCESS_ROUTING_TABLE_H_ */
@@ -86,6 +86,8 @@ using namespace std;
  *   api_server_file_buffered_channel_max_disk_chunk_read_size       unsigned integer   -          default(0)
  *   api_server_file_buffered_channel_threshold                      unsigned integer   -          default(131072)
  *   api_server_mbuf_block_chunk_size                                unsigned integer   -          default(4096),read_only
+ *   api_server_mbuf_large_block_chunk_size                          unsigned integer   -          default(65536),read_only
+ *   api_server_mbuf_slabs                                           boolean            -          default(false),read_only
  *   api_server_min_spare_clients                                    unsigned integer   -          default(0)
  *   api_server_request_freelist_limit                               unsigned integer   -          default(1024)
  *   api_server_start_reading_after_accept                           boolean            -          default(true)
@@ -102,8 +104,11 @@ using namespace std;
  *   controller_file_buffered_channel_max_disk_chunk_read_size       unsigned integer   -          default(0)
  *   controller_file_buffered_channel_threshold                      unsigned integer   -          default(131072)
  *   controller_mbuf_block_chunk_size                                unsigned integer   -          default(4096),read_only
+ *   controller_mbuf_large_block_chunk_size                          unsigned integer   -          default(65536),read_only
+ *   controller_mbuf_slabs                                           boolean            -          default(false),read_only
  *   controller_min_spare_clients                                    unsigned integer   -          default(0)
  *   controller_request_freelist_limit                               unsigned integer   -          default(1024)
+ *   controller_reuse_port                                           boolean            -          default(false),read_only
  *   controller_secure_headers_password                              any                -          secret
  *   controller_socket_backlog                                       unsigned integer   -          default(2048),read_only
  *   controller_start_reading_after_accept                           boolean            -          default(true)
@@ -123,6 +128,7 @@ using namespace std;
  *   default_nodejs                                                  string             -          default("node")
  *   default_python                                                  string             -          default("python")
  *   default_ruby                                                    string             -          default("ruby")
+ *   default_sendfile_root                                           string             -          -
  *   default_server_name                                             string             -          default
  *   default_server_port                                             unsigned integer   -          default
  *   default_spawn_method                                            string             -          default("smart")
@@ -144,6 +150,7 @@ using namespace std;
  *   pool_selfchecks                                                 boolean            -          default(false)
  *   prestart_urls                                                   array of strings   -          default([]),read_only
  *   response_buffer_high_watermark                                  unsigned integer   -          default(134217728)
+ *   response_splicing                                               boolean            -          default(true)
  *   security_update_checker_certificate_path                        string             -          -
  *   security_update_checker_disabled                                boolean            -          default(false)
  *   security_update_checker_interval                                unsigned integer   -          default(86400)
@@ -156,6 +163,13 @@ using namespace std;
  *   single_app_mode_startup_file                                    string             -          read_only
  *   standalone_engine                                               string             -          default
  *   stat_throttle_rate                                              unsigned integer   -          default(10)
+ *   turbocache_compression                                          boolean            -          default(true),read_only
+ *   turbocache_fetch_threshold                                      unsigned integer   -          default(20),read_only
+ *   turbocache_max_body_size                                        unsigned integer   -          default(32768),read_only
+ *   turbocache_max_memory                                           unsigned integer   -          default(4194304),read_only
+ *   turbocache_min_hit_ratio                                        float              -          default(0.5),read_only
+ *   turbocache_shared                                               boolean            -          default(false),read_only
+ *   turbocache_shared_max_memory                                    unsigned integer   -          default(33554432),read_only
  *   turbocaching                                                    boolean            -          default(true),read_only
  *   user_switching                                                  boolean            -          default(true)
  *   ust_router_address                                              string             -          -
@@ -448,6 +462,9 @@ public:
 		add("controller_addresses", STRING_ARRAY_TYPE, OPTIONAL | READ_ONLY, getDefaultControllerAddresses());
 		add("api_server_addresses", STRING_ARRAY_TYPE, OPTIONAL | READ_ONLY, Json::arrayValue);
 		add("controller_cpu_affine", BOOL_TYPE, OPTIONAL | READ_ONLY, false);
+		add("controller_reuse_port", BOOL_TYPE, OPTIONAL | READ_ONLY, false);
+		add("turbocache_shared", BOOL_TYPE, OPTIONAL | READ_ONLY, false);
+		add("turbocache_shared_max_memory", UINT_TYPE, OPTIONAL | READ_ONLY, DEFAULT_TURBOCACHE_SHARED_MAX_MEMORY);
 		add("file_descriptor_ulimit", UINT_TYPE, OPTIONAL | READ_ONLY, 0);
 
 		addValidator(validateMultiAppMode);
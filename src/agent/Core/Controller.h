@@ -53,6 +53,10 @@
 
 #include <sys/types.h>
 #include <sys/uio.h>
+#include <fcntl.h>
+#ifdef __linux__
+	#include <sys/sendfile.h>
+#endif
 #include <utility>
 #include <typeinfo>
 #include <cstdio>
@@ -65,6 +69,7 @@
 #include <MessageReadersWriters.h>
 #include <Constants.h>
 #include <ConfigKit/ConfigKit.h>
+#include <uv.h>
 #include <ServerKit/Errors.h>
 #include <ServerKit/HttpServer.h>
 #include <ServerKit/HttpHeaderParser.h>
@@ -83,6 +88,7 @@
 #include <Core/Controller/Client.h>
 #include <Core/Controller/AppResponse.h>
 #include <Core/Controller/TurboCaching.h>
+#include <Core/Controller/ResponseHeaderTemplates.h>
 #include <Core/UnionStation/Context.h>
 
 namespace Passenger {
@@ -113,10 +119,36 @@ private:
 	// If you change this value, make sure that Request::sessionCheckoutTry
 	// has enough bits.
 	static const unsigned int MAX_SESSION_CHECKOUT_TRY = 10;
+	// The maximum number of pieces of chunk data that are taken from a chunked
+	// app response body at once.
+	static const unsigned int MAX_CHUNKED_BODY_SLICES = 16;
+	// App response bodies are only spliced to the client if at least
+	// this many bytes remain (or, for bodies that end at EOF, have
+	// already been forwarded).
+	static const unsigned int MIN_SPLICE_BODY_SIZE = 64 * 1024;
+	// The maximum number of bytes that are moved per splice() call, and
+	// the maximum number of such moves per event loop iteration.
+	static const unsigned int MAX_SPLICE_SIZE = 64 * 1024;
+	static const unsigned int SPLICE_BURST_COUNT = 16;
+	// The maximum number of bytes of an X-Sendfile file that are sent per
+	// sendfile() call, and the maximum number of such calls per event
+	// loop iteration.
+	static const unsigned int MAX_SENDFILE_SIZE = 128 * 1024;
+	static const unsigned int SENDFILE_BURST_COUNT = 16;
 
 	ControllerMainConfig mainConfig;
 	ControllerRequestConfigPtr requestConfig;
 	StringKeyTable< boost::shared_ptr<Options> > poolOptionsCache;
+	/**
+	 * Handles to the Groups that this thread checked out sessions from,
+	 * by app group name. Allows Pool::asyncGet() to skip looking up the
+	 * Group in the pool. See Pool::asyncGetQuickly().
+	 *
+	 * Flushed whenever the pool has detached a Group since the last
+	 * checkout, so that handles don't keep detached Groups alive.
+	 */
+	StringKeyTable<GroupPtr> groupHandleCache;
+	unsigned int groupHandleCacheGeneration;
 
 	HashedStaticString PASSENGER_APP_GROUP_NAME;
 	HashedStaticString PASSENGER_ENV_VARS;
@@ -125,6 +157,7 @@ private:
 	HashedStaticString PASSENGER_STICKY_SESSIONS;
 	HashedStaticString PASSENGER_STICKY_SESSIONS_COOKIE_NAME;
 	HashedStaticString PASSENGER_REQUEST_OOB_WORK;
+	HashedStaticString PASSENGER_SENDFILE_ROOT;
 	HashedStaticString UNION_STATION_SUPPORT;
 	HashedStaticString REMOTE_ADDR;
 	HashedStaticString REMOTE_PORT;
@@ -139,13 +172,28 @@ private:
 	HashedStaticString HTTP_CONNECTION;
 	HashedStaticString HTTP_STATUS;
 	HashedStaticString HTTP_TRANSFER_ENCODING;
+	HashedStaticString HTTP_RANGE;
+	HashedStaticString HTTP_IF_RANGE;
+	HashedStaticString HTTP_ACCEPT_RANGES;
 
 	friend class TurboCaching<Request>;
 	friend class ResponseCache<Request>;
 	struct ev_check checkWatcher;
 	TurboCaching<Request> turboCaching;
+	ResponseHeaderTemplates responseHeaderTemplates;
 	ConfigKit::Store *singleAppModeConfig;
 
+	/**
+	 * The pipe through which app response bodies are spliced from app
+	 * sockets to client sockets. Created on first use. It is always empty
+	 * between event loop callbacks. See spliceAppResponseBody().
+	 */
+	Pipe splicePipe;
+	boost::uint64_t responseBodyBytesSpliced;
+	boost::uint64_t responseBodyBytesCopied;
+	boost::uint64_t filesSent;
+	boost::uint64_t fileBytesSent;
+
 	#ifdef DEBUG_CC_EVENT_LOOP_BLOCKING
 		struct ev_prepare prepareWatcher;
 		ev_tstamp timeBeforeBlocking;
@@ -163,6 +211,16 @@ private:
 
 	void initializeFlags(Client *client, Request *req, RequestAnalysis &analysis);
 	bool respondFromTurboCache(Client *client, Request *req);
+	bool respondFromTurboCacheOnError(Client *client, Request *req);
+	void respondFromTurboCacheAfterRevalidation(Client *client, Request *req);
+	void respondWithTurboCacheEntry(Client *client, Request *req,
+		ResponseCache<Request>::Entry &entry);
+	void endTurboCacheCoalescing(Request *req);
+	static void resumeTurboCacheWaiters(Request *firstWaiter);
+	void resumeTurboCacheWaiter(Client *client, Request *req);
+	void analyzeRequest(Request *req, RequestAnalysis &analysis);
+	void continueInitializingRequest(Client *client, Request *req,
+		RequestAnalysis &analysis);
 	void initializePoolOptions(Client *client, Request *req, RequestAnalysis &analysis);
 	void fillPoolOptionsFromConfigCaches(Options &options, psg_pool_t *pool,
 		const ControllerRequestConfigPtr &requestConfigCache);
@@ -178,6 +236,8 @@ private:
 		const HashedStaticString &name);
 	static void fillPoolOption(Request *req, long &field,
 		const HashedStaticString &name);
+	static void fillPoolOption(Request *req, RoutingPolicy &field,
+		const HashedStaticString &name);
 	static void fillPoolOptionSecToMsec(Request *req, unsigned int &field,
 		const HashedStaticString &name);
 	void createNewPoolOptions(Client *client, Request *req,
@@ -264,8 +324,6 @@ private:
 		unsigned int maxbuffers, unsigned int & restrict_ref nbuffers,
 		unsigned int & restrict_ref dataSize,
 		unsigned int & restrict_ref nCacheableBuffers);
-	unsigned int constructDateHeaderBuffersForResponse(char *dateStr,
-		unsigned int bufsize);
 	bool sendResponseHeaderWithWritev(Client *client, Request *req,
 		ssize_t &bytesWritten);
 	void sendResponseHeaderWithBuffering(Client *client, Request *req,
@@ -286,6 +344,13 @@ private:
 	void markResponsePartForTurboCaching(Client *client, Request *req,
 		const MemoryKit::mbuf &buffer);
 	void maybeThrottleAppSource(Client *client, Request *req);
+	bool shouldSpliceAppResponseBody(Client *client, Request *req);
+	bool prepareSplicePipe();
+	void beginSplicingAppResponseBody(Client *client, Request *req);
+	static void _onAppSocketSpliceable(EV_P_ struct ev_io *io, int revents);
+	void spliceAppResponseBody(Client *client, Request *req);
+	void stopSplicingAppResponseBody(Client *client, Request *req);
+	bool copySplicePipeToClientOutput(Client *client, Request *req, size_t size);
 	static void _outputBuffersFlushed(FileBufferedChannel *_channel);
 	void outputBuffersFlushed(Client *client, Request *req);
 	static void _outputDataFlushed(FileBufferedChannel *_channel);
@@ -294,6 +359,49 @@ private:
 	OXT_FORCE_INLINE void keepAliveAppConnection(Client *client, Request *req);
 	void storeAppResponseInTurboCache(Client *client, Request *req);
 	void finalizeUnionStationWithSuccess(Client *client, Request *req);
+	void sendResponseHeader(Client *client, Request *req);
+
+
+	/****** Stage: send file named by X-Sendfile or X-Accel-Redirect ******/
+
+	/**
+	 * Describes the file that an app response's X-Sendfile or
+	 * X-Accel-Redirect header refers to. Filled in on the libuv thread pool
+	 * by lookUpFileToSend(), so it must not reference the request's pool.
+	 */
+	struct FileToSend {
+		uv_work_t work;
+		Request *req;
+		string root;
+		string path;
+		int fd;
+		int errcode;
+		bool outsideRoot;
+		boost::uint64_t size;
+	};
+
+	enum RangeParseResult {
+		RANGE_NONE,
+		RANGE_SATISFIABLE,
+		RANGE_UNSATISFIABLE
+	};
+
+	StaticString getSendfileRoot(Request *req);
+	void beginSendingFile(Client *client, Request *req, const StaticString &root);
+	static void lookUpFileToSend(uv_work_t *work);
+	static void _onFileToSendLookedUp(uv_work_t *work, int status);
+	void onFileToSendLookedUp(Client *client, Request *req, FileToSend *file);
+	void endRequestWithFileToSendError(Client **client, Request **req,
+		const FileToSend *file);
+	RangeParseResult parseRequestedRange(Request *req, boost::uint64_t size,
+		boost::uint64_t &start, boost::uint64_t &end);
+	void prepareFileResponseHeader(Client *client, Request *req,
+		boost::uint64_t size);
+	static void _onClientSocketWritableForSendfile(EV_P_ struct ev_io *io, int revents);
+	void sendFileToClient(Client *client, Request *req);
+	bool copyFileToClientOutput(Client *client, Request *req, size_t size);
+	void waitToSendMoreOfFile(Client *client, Request *req);
+	void endSendingFile(Client *client, Request *req);
 
 
 	/***** Hooks ******/
@@ -371,6 +479,8 @@ public:
 	ResourceLocator *resourceLocator;
 	PoolPtr appPool;
 	UnionStation::ContextPtr unionStationContext;
+	// Optional. Shared by all Controllers.
+	SharedResponseCache *sharedResponseCache;
 
 
 	/****** Initialization and shutdown ******/
@@ -388,10 +498,17 @@ public:
 		  mainConfig(config),
 		  requestConfig(new ControllerRequestConfig(config)),
 		  poolOptionsCache(4),
+		  groupHandleCache(4),
+		  groupHandleCacheGeneration(0),
 
 		  turboCaching(),
 		  singleAppModeConfig(NULL),
-		  resourceLocator(NULL)
+		  responseBodyBytesSpliced(0),
+		  responseBodyBytesCopied(0),
+		  filesSent(0),
+		  fileBytesSent(0),
+		  resourceLocator(NULL),
+		  sharedResponseCache(NULL)
 		  /**************************/
 	{
 		if (mainConfig.singleAppMode) {
@@ -124,6 +124,7 @@ Controller::whenBufferingBody_onRequestBody(Client *client, Request *req,
 
 			header->hash = HashedStaticString("content-length",
 				sizeof("content-length") - 1).hash();
+			header->id = ServerKit::HTTP_HEADER_CONTENT_LENGTH;
 
 			req->headers.erase(HTTP_TRANSFER_ENCODING);
 			req->headers.insert(&header, req->pool);
@@ -49,10 +49,9 @@ using namespace boost;
 void
 Controller::checkoutSession(Client *client, Request *req) {
 	GetCallback callback;
-	Options &options = req->options;
 
 	CC_BENCHMARK_POINT(client, req, BM_BEFORE_CHECKOUT);
-	SKC_TRACE(client, 2, "Checking out session: appRoot=" << options.appRoot);
+	SKC_TRACE(client, 2, "Checking out session: appRoot=" << req->options->appRoot);
 	req->state = Request::CHECKING_OUT_SESSION;
 
 	if (req->requestBodyBuffering) {
@@ -64,7 +63,7 @@ Controller::checkoutSession(Client *client, Request *req) {
 	callback.func = sessionCheckedOut;
 	callback.userData = req;
 
-	options.currentTime = SystemTime::getUsec();
+	req->requestOptions.currentTime = SystemTime::getUsec();
 
 	refRequest(req, __FILE__, __LINE__);
 	#ifdef DEBUG_CC_EVENT_LOOP_BLOCKING
@@ -83,10 +82,22 @@ Controller::checkoutSession(Client *client, Request *req) {
 
 void
 Controller::asyncGetFromApplicationPool(Request *req, ApplicationPool2::GetCallback callback) {
-	appPool->asyncGet(req->options, callback, true,
+	HashedStaticString appGroupName(req->options->getAppGroupName());
+	GroupPtr *groupHandle;
+	unsigned int generation = appPool->getGroupDetachGeneration();
+
+	if (OXT_UNLIKELY(generation != groupHandleCacheGeneration)) {
+		groupHandleCache.clear();
+		groupHandleCacheGeneration = generation;
+	}
+	if (!groupHandleCache.lookup(appGroupName, &groupHandle)) {
+		groupHandle = &groupHandleCache.insert(appGroupName, GroupPtr())->value;
+	}
+	appPool->asyncGet(*req->options, req->requestOptions, callback, true,
 		req->useUnionStation()
 		? &req->stopwatchLogs.getFromPool
-		: NULL);
+		: NULL,
+		groupHandle);
 }
 
 void
@@ -233,6 +244,9 @@ Controller::reportSessionCheckoutError(Client *client, Request *req,
 	const ExceptionPtr &e)
 {
 	TRACE_POINT();
+	if (respondFromTurboCacheOnError(client, req)) {
+		return;
+	}
 	{
 		boost::shared_ptr<RequestQueueFullException> e2 =
 			dynamic_pointer_cast<RequestQueueFullException>(e);
@@ -355,7 +369,7 @@ Controller::endRequestWithErrorResponse(Client **c, Request **r, const StaticStr
 
 	if (friendlyErrorPagesEnabled(req)) {
 		try {
-			data = renderer.renderWithDetails(message, req->options, e);
+			data = renderer.renderWithDetails(message, *req->options, e);
 		} catch (const SystemException &e2) {
 			SKC_ERROR(client, "Cannot render an error page: " << e2.what() <<
 				"\n" << e2.backtrace());
@@ -379,7 +393,7 @@ Controller::friendlyErrorPagesEnabled(Request *req) {
 	bool defaultValue;
 	const StaticString &defaultStr = req->config->defaultFriendlyErrorPages;
 	if (defaultStr == "auto") {
-		defaultValue = (req->options.environment == "development");
+		defaultValue = (req->options->environment == "development");
 	} else {
 		defaultValue = defaultStr == "true";
 	}
@@ -99,6 +99,7 @@ parseControllerBenchmarkMode(const StaticString &mode) {
  *   default_nodejs                                      string             -          default("node")
  *   default_python                                      string             -          default("python")
  *   default_ruby                                        string             -          default("ruby")
+ *   default_sendfile_root                               string             -          -
  *   default_server_name                                 string             required   -
  *   default_server_port                                 unsigned integer   required   -
  *   default_spawn_method                                string             -          default("smart")
@@ -111,11 +112,17 @@ parseControllerBenchmarkMode(const StaticString &mode) {
  *   multi_app                                           boolean            -          default(true),read_only
  *   request_freelist_limit                              unsigned integer   -          default(1024)
  *   response_buffer_high_watermark                      unsigned integer   -          default(134217728)
+ *   response_splicing                                   boolean            -          default(true)
  *   server_software                                     string             -          default("Phusion_Passenger/5.1.13")
  *   show_version_in_header                              boolean            -          default(true)
  *   start_reading_after_accept                          boolean            -          default(true)
  *   stat_throttle_rate                                  unsigned integer   -          default(10)
  *   thread_number                                       unsigned integer   required   read_only
+ *   turbocache_compression                              boolean            -          default(true),read_only
+ *   turbocache_fetch_threshold                          unsigned integer   -          default(20),read_only
+ *   turbocache_max_body_size                            unsigned integer   -          default(32768),read_only
+ *   turbocache_max_memory                               unsigned integer   -          default(4194304),read_only
+ *   turbocache_min_hit_ratio                            float              -          default(0.5),read_only
  *   turbocaching                                        boolean            -          default(true),read_only
  *   user_switching                                      boolean            -          default(true)
  *   ust_router_address                                  string             -          -
@@ -132,12 +139,18 @@ private:
 		add("thread_number", UINT_TYPE, REQUIRED | READ_ONLY);
 		add("multi_app", BOOL_TYPE, OPTIONAL | READ_ONLY, true);
 		add("turbocaching", BOOL_TYPE, OPTIONAL | READ_ONLY, true);
+		add("turbocache_max_memory", UINT_TYPE, OPTIONAL | READ_ONLY, DEFAULT_TURBOCACHE_MAX_MEMORY);
+		add("turbocache_max_body_size", UINT_TYPE, OPTIONAL | READ_ONLY, DEFAULT_TURBOCACHE_MAX_BODY_SIZE);
+		add("turbocache_fetch_threshold", UINT_TYPE, OPTIONAL | READ_ONLY, DEFAULT_TURBOCACHE_FETCH_THRESHOLD);
+		add("turbocache_min_hit_ratio", FLOAT_TYPE, OPTIONAL | READ_ONLY, DEFAULT_TURBOCACHE_MIN_HIT_RATIO);
+		add("turbocache_compression", BOOL_TYPE, OPTIONAL | READ_ONLY, true);
 		add("integration_mode", STRING_TYPE, OPTIONAL | READ_ONLY, DEFAULT_INTEGRATION_MODE);
 
 		add("user_switching", BOOL_TYPE, OPTIONAL, true);
 		add("stat_throttle_rate", UINT_TYPE, OPTIONAL, DEFAULT_STAT_THROTTLE_RATE);
 		add("show_version_in_header", BOOL_TYPE, OPTIONAL, true);
 		add("response_buffer_high_watermark", UINT_TYPE, OPTIONAL, DEFAULT_RESPONSE_BUFFER_HIGH_WATERMARK);
+		add("response_splicing", BOOL_TYPE, OPTIONAL, true);
 		add("graceful_exit", BOOL_TYPE, OPTIONAL, true);
 		add("benchmark_mode", STRING_TYPE, OPTIONAL);
 
@@ -154,6 +167,7 @@ private:
 		add("default_server_port", UINT_TYPE, REQUIRED);
 		add("default_sticky_sessions", BOOL_TYPE, OPTIONAL, false);
 		add("default_sticky_sessions_cookie_name", STRING_TYPE, OPTIONAL, DEFAULT_STICKY_SESSIONS_COOKIE_NAME);
+		add("default_sendfile_root", STRING_TYPE, OPTIONAL);
 		add("server_software", STRING_TYPE, OPTIONAL, SERVER_TOKEN_NAME "/" PASSENGER_VERSION);
 		add("vary_turbocache_by_cookie", STRING_TYPE, OPTIONAL);
 
@@ -316,6 +330,7 @@ public:
 	bool userSwitching: 1;
 	bool defaultStickySessions: 1;
 	bool gracefulExit: 1;
+	bool responseSplicing: 1;
 
 	/*******************/
 	/*******************/
@@ -332,7 +347,8 @@ public:
 		  singleAppMode(!config["multi_app"].asBool()),
 		  userSwitching(config["user_switching"].asBool()),
 		  defaultStickySessions(config["default_sticky_sessions"].asBool()),
-		  gracefulExit(config["graceful_exit"].asBool())
+		  gracefulExit(config["graceful_exit"].asBool()),
+		  responseSplicing(config["response_splicing"].asBool())
 
 		  /*******************/
 	{
@@ -362,6 +378,7 @@ public:
 		SWAP_BITFIELD(bool, userSwitching);
 		SWAP_BITFIELD(bool, defaultStickySessions);
 		SWAP_BITFIELD(bool, gracefulExit);
+		SWAP_BITFIELD(bool, responseSplicing);
 
 		/*******************/
 
@@ -396,6 +413,7 @@ public:
 	StaticString serverSoftware;
 	StaticString defaultStickySessionsCookieName;
 	StaticString defaultVaryTurbocacheByCookie;
+	StaticString defaultSendfileRoot;
 
 	StaticString defaultFriendlyErrorPages;
 	StaticString defaultEnvironment;
@@ -430,6 +448,7 @@ public:
 		  serverSoftware(psg_pstrdup(pool, config["server_software"].asString())),
 		  defaultStickySessionsCookieName(psg_pstrdup(pool, config["default_sticky_sessions_cookie_name"].asString())),
 		  defaultVaryTurbocacheByCookie(psg_pstrdup(pool, config["vary_turbocache_by_cookie"].asString())),
+		  defaultSendfileRoot(psg_pstrdup(pool, config["default_sendfile_root"].asString())),
 
 		  defaultFriendlyErrorPages(psg_pstrdup(pool, config["default_friendly_error_pages"].asString())),
 		  defaultEnvironment(psg_pstrdup(pool, config["default_environment"].asString())),
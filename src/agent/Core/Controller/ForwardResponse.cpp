@@ -165,6 +165,8 @@ Controller::onAppSourceData(Client *client, Request *req, const MemoryKit::mbuf
 						SKC_TRACE(client, 2, "End of application response body reached");
 						handleAppResponseBodyEnd(client, req);
 						endRequest(&client, &req);
+					} else if (shouldSpliceAppResponseBody(client, req)) {
+						beginSplicingAppResponseBody(client, req);
 					} else {
 						maybeThrottleAppSource(client, req);
 					}
@@ -204,23 +206,30 @@ Controller::onAppSourceData(Client *client, Request *req, const MemoryKit::mbuf
 			SKC_TRACE(client, 3, "Processing " << buffer.size() <<
 				" bytes of application data: \"" << cEscapeString(StaticString(
 					buffer.start, buffer.size())) << "\"");
+			MemoryKit::mbuf slices[MAX_CHUNKED_BODY_SLICES];
+			unsigned int i, nslices;
 			ServerKit::HttpChunkedEvent event(createAppResponseChunkedBodyParser(req)
-				.feed(buffer));
+				.feedMultiple(buffer, slices, MAX_CHUNKED_BODY_SLICES, nslices));
 			resp->bodyAlreadyRead += event.consumed;
 
 			if (req->dechunkResponse) {
 				UPDATE_TRACE_POINT();
+				for (i = 0; i < nslices && !req->ended(); i++) {
+					writeResponseAndMarkForTurboCaching(client, req, slices[i]);
+				}
 				switch (event.type) {
 				case ServerKit::HttpChunkedEvent::NONE:
-					assert(!event.end);
-					return Channel::Result(event.consumed, false);
 				case ServerKit::HttpChunkedEvent::DATA:
 					assert(!event.end);
-					writeResponseAndMarkForTurboCaching(client, req, event.data);
-					maybeThrottleAppSource(client, req);
+					if (nslices > 0) {
+						maybeThrottleAppSource(client, req);
+					}
 					return Channel::Result(event.consumed, false);
 				case ServerKit::HttpChunkedEvent::END:
 					assert(event.end);
+					if (req->ended()) {
+						return Channel::Result(event.consumed, true);
+					}
 					SKC_TRACE(client, 2, "End of application response body reached");
 					resp->aux.bodyInfo.endReached = true;
 					handleAppResponseBodyEnd(client, req);
@@ -237,12 +246,15 @@ Controller::onAppSourceData(Client *client, Request *req, const MemoryKit::mbuf
 				}
 			} else {
 				UPDATE_TRACE_POINT();
+				for (i = 0; i < nslices; i++) {
+					markResponsePartForTurboCaching(client, req, slices[i]);
+				}
 				switch (event.type) {
 				case ServerKit::HttpChunkedEvent::NONE:
 				case ServerKit::HttpChunkedEvent::DATA:
 					assert(!event.end);
+					responseBodyBytesCopied += event.consumed;
 					writeResponse(client, MemoryKit::mbuf(buffer, 0, event.consumed));
-					markResponsePartForTurboCaching(client, req, event.data);
 					maybeThrottleAppSource(client, req);
 					return Channel::Result(event.consumed, false);
 				case ServerKit::HttpChunkedEvent::END:
@@ -250,6 +262,7 @@ Controller::onAppSourceData(Client *client, Request *req, const MemoryKit::mbuf
 					SKC_TRACE(client, 2, "End of application response body reached");
 					resp->aux.bodyInfo.endReached = true;
 					handleAppResponseBodyEnd(client, req);
+					responseBodyBytesCopied += event.consumed;
 					writeResponse(client, MemoryKit::mbuf(buffer, 0, event.consumed));
 					if (!req->ended()) {
 						endRequest(&client, &req);
@@ -289,7 +302,11 @@ Controller::onAppSourceData(Client *client, Request *req, const MemoryKit::mbuf
 					buffer.start, buffer.size())) << "\"");
 			resp->bodyAlreadyRead += buffer.size();
 			writeResponseAndMarkForTurboCaching(client, req, buffer);
-			maybeThrottleAppSource(client, req);
+			if (shouldSpliceAppResponseBody(client, req)) {
+				beginSplicingAppResponseBody(client, req);
+			} else {
+				maybeThrottleAppSource(client, req);
+			}
 			return Channel::Result(buffer.size(), false);
 		} else if (errcode == 0 || errcode == ECONNRESET) {
 			// EOF
@@ -316,7 +333,7 @@ void
 Controller::onAppResponseBegin(Client *client, Request *req) {
 	TRACE_POINT();
 	AppResponse *resp = &req->appResponse;
-	ssize_t bytesWritten;
+	StaticString sendfileRoot;
 	bool oobw;
 
 	#ifdef DEBUG_CC_EVENT_LOOP_BLOCKING
@@ -362,12 +379,29 @@ Controller::onAppResponseBegin(Client *client, Request *req) {
 	{
 		// If X-Sendfile or X-Accel-Redirect is set, then HttpHeaderParser
 		// treats the app response as having no body, and removes the
-		// Content-Length and Transfer-Encoding headers. Because of this,
-		// the response that we output also doesn't Content-Length
-		// or Transfer-Encoding. So we should disable keep-alive.
-		req->wantKeepAlive = false;
+		// Content-Length and Transfer-Encoding headers. If we serve the
+		// file ourselves then we output a proper Content-Length.
+		// Otherwise, the response that we output also doesn't have
+		// Content-Length or Transfer-Encoding, so we should disable
+		// keep-alive.
+		sendfileRoot = getSendfileRoot(req);
+		if (sendfileRoot.empty()) {
+			req->wantKeepAlive = false;
+		}
 	}
 
+	if (resp->statusCode >= 500 && respondFromTurboCacheOnError(client, req)) {
+		return;
+	}
+	if (resp->statusCode == 304 && req->turboCacheRevalidationEntry.valid()) {
+		respondFromTurboCacheAfterRevalidation(client, req);
+		return;
+	}
+	if (!sendfileRoot.empty()) {
+		// The response body is not known until the file has been
+		// looked up, so the response is not eligible for turbocaching.
+		req->cacheKey = HashedStaticString();
+	}
 	prepareAppResponseCaching(client, req);
 
 	if (OXT_UNLIKELY(oobw)) {
@@ -377,18 +411,15 @@ Controller::onAppResponseBegin(Client *client, Request *req) {
 		}
 	}
 
-	UPDATE_TRACE_POINT();
-	if (!sendResponseHeaderWithWritev(client, req, bytesWritten)) {
+	if (!sendfileRoot.empty()) {
 		UPDATE_TRACE_POINT();
-		if (bytesWritten >= 0 || errno == EAGAIN || errno == EWOULDBLOCK) {
-			sendResponseHeaderWithBuffering(client, req, bytesWritten);
-		} else {
-			int e = errno;
-			P_ASSERT_EQ(bytesWritten, -1);
-			disconnectWithClientSocketWriteError(&client, e);
-		}
+		beginSendingFile(client, req, sendfileRoot);
+		return;
 	}
 
+	UPDATE_TRACE_POINT();
+	sendResponseHeader(client, req);
+
 	if (!req->ended() && !resp->hasBody() && !resp->upgraded()) {
 		UPDATE_TRACE_POINT();
 		handleAppResponseBodyEnd(client, req);
@@ -406,10 +437,10 @@ Controller::prepareAppResponseCaching(Client *client, Request *req) {
 		 && turboCaching.responseCache.prepareRequestForStoring(req))
 		{
 			if (resp->bodyType == AppResponse::RBT_CONTENT_LENGTH
-			 && resp->aux.bodyInfo.contentLength > ResponseCache<Request>::MAX_BODY_SIZE)
+			 && resp->aux.bodyInfo.contentLength > turboCaching.responseCache.getMaxBodySize())
 			{
 				SKC_DEBUG(client, "Response body larger than " <<
-					ResponseCache<Request>::MAX_BODY_SIZE <<
+					turboCaching.responseCache.getMaxBodySize() <<
 					" bytes, so response is not eligible for turbocaching");
 				// Decrease store success ratio.
 				turboCaching.responseCache.incStores();
@@ -492,102 +523,28 @@ Controller::constructHeaderBuffersForResponse(Request *req, struct iovec *buffer
 			INC_BUFFER_ITER(i); \
 			dataSize += sizeof(str) - 1; \
 		} while (false)
+	#define PUSH_STRING_BUFFER(str) \
+		do { \
+			BEGIN_PUSH_NEXT_BUFFER(); \
+			if (buffers != NULL) { \
+				buffers[i].iov_base = (void *) (str).data(); \
+				buffers[i].iov_len  = (str).size(); \
+			} \
+			INC_BUFFER_ITER(i); \
+			dataSize += (str).size(); \
+		} while (false)
 
 	AppResponse *resp = &req->appResponse;
 	ServerKit::HeaderTable::Iterator it(resp->headers);
 	const LString::Part *part;
-	const char *statusAndReason;
+	ResponseHeaderTemplates::ConnectionHeader connection;
 	unsigned int i = 0;
 
 	nbuffers = 0;
 	dataSize = 0;
 
-	PUSH_STATIC_BUFFER("HTTP/");
-
-	if (buffers != NULL) {
-		BEGIN_PUSH_NEXT_BUFFER();
-		const unsigned int BUFSIZE = 16;
-		char *buf = (char *) psg_pnalloc(req->pool, BUFSIZE);
-		const char *end = buf + BUFSIZE;
-		char *pos = buf;
-		pos += uintToString(req->httpMajor, pos, end - pos);
-		pos = appendData(pos, end, ".", 1);
-		pos += uintToString(req->httpMinor, pos, end - pos);
-		buffers[i].iov_base = (void *) buf;
-		buffers[i].iov_len  = pos - buf;
-		dataSize += pos - buf;
-	} else {
-		char buf[16];
-		const char *end = buf + sizeof(buf);
-		char *pos = buf;
-		pos += uintToString(req->httpMajor, pos, end - pos);
-		pos = appendData(pos, end, ".", 1);
-		pos += uintToString(req->httpMinor, pos, end - pos);
-		dataSize += pos - buf;
-	}
-	INC_BUFFER_ITER(i);
-
-	PUSH_STATIC_BUFFER(" ");
-
-	statusAndReason = getStatusCodeAndReasonPhrase(resp->statusCode);
-	if (statusAndReason != NULL) {
-		size_t len = strlen(statusAndReason);
-		BEGIN_PUSH_NEXT_BUFFER();
-		if (buffers != NULL) {
-			BEGIN_PUSH_NEXT_BUFFER();
-			buffers[i].iov_base = (void *) statusAndReason;
-			buffers[i].iov_len  = len;
-		}
-		INC_BUFFER_ITER(i);
-		dataSize += len;
-
-		PUSH_STATIC_BUFFER("\r\nStatus: ");
-		if (buffers != NULL) {
-			BEGIN_PUSH_NEXT_BUFFER();
-			buffers[i].iov_base = (void *) statusAndReason;
-			buffers[i].iov_len  = len;
-		}
-		INC_BUFFER_ITER(i);
-		dataSize += len;
-
-		PUSH_STATIC_BUFFER("\r\n");
-	} else {
-		if (buffers != NULL) {
-			BEGIN_PUSH_NEXT_BUFFER();
-			const unsigned int BUFSIZE = 8;
-			char *buf = (char *) psg_pnalloc(req->pool, BUFSIZE);
-			const char *end = buf + BUFSIZE;
-			char *pos = buf;
-			unsigned int size = uintToString(resp->statusCode, pos, end - pos);
-			buffers[i].iov_base = (void *) buf;
-			buffers[i].iov_len  = size;
-			INC_BUFFER_ITER(i);
-			dataSize += size;
-
-			PUSH_STATIC_BUFFER(" Unknown Reason-Phrase\r\nStatus: ");
-			BEGIN_PUSH_NEXT_BUFFER();
-			buffers[i].iov_base = (void *) buf;
-			buffers[i].iov_len  = size;
-			INC_BUFFER_ITER(i);
-			dataSize += size;
-
-			PUSH_STATIC_BUFFER("\r\n");
-		} else {
-			char buf[8];
-			const char *end = buf + sizeof(buf);
-			char *pos = buf;
-			unsigned int size = uintToString(resp->statusCode, pos, end - pos);
-			INC_BUFFER_ITER(i);
-			dataSize += size;
-
-			dataSize += sizeof(" Unknown Reason-Phrase\r\nStatus: ") - 1;
-			INC_BUFFER_ITER(i);
-			dataSize += size;
-			INC_BUFFER_ITER(i);
-			dataSize += sizeof("\r\n");
-			INC_BUFFER_ITER(i);
-		}
-	}
+	PUSH_STRING_BUFFER(responseHeaderTemplates.getStatusLine(req->pool,
+		req->httpMajor, req->httpMinor, resp->statusCode));
 
 	while (*it != NULL) {
 		dataSize += it->header->origKey.size + sizeof(": ") - 1;
@@ -632,23 +589,7 @@ Controller::constructHeaderBuffersForResponse(Request *req, struct iovec *buffer
 
 	// Add Date header. https://code.google.com/p/phusion-passenger/issues/detail?id=485
 	if (resp->date == NULL) {
-		unsigned int size;
-
-		if (buffers != NULL) {
-			BEGIN_PUSH_NEXT_BUFFER();
-			const unsigned int BUFSIZE = 60;
-			char *dateStr = (char *) psg_pnalloc(req->pool, BUFSIZE);
-			size = constructDateHeaderBuffersForResponse(dateStr, BUFSIZE);
-			buffers[i].iov_base = dateStr;
-			buffers[i].iov_len  = size;
-		} else {
-			char dateStr[60];
-			size = constructDateHeaderBuffersForResponse(dateStr, sizeof(dateStr));
-		}
-		INC_BUFFER_ITER(i);
-		dataSize += size;
-
-		PUSH_STATIC_BUFFER("\r\n");
+		PUSH_STRING_BUFFER(responseHeaderTemplates.getDateHeader(ev_now(getLoop())));
 	}
 
 	if (resp->setCookie != NULL) {
@@ -675,44 +616,29 @@ Controller::constructHeaderBuffersForResponse(Request *req, struct iovec *buffer
 	nCacheableBuffers = i;
 
 	if (resp->bodyType == AppResponse::RBT_CONTENT_LENGTH) {
-		PUSH_STATIC_BUFFER("Content-Length: ");
 		if (buffers != NULL) {
 			BEGIN_PUSH_NEXT_BUFFER();
-			const unsigned int BUFSIZE = 16;
+			const unsigned int BUFSIZE = sizeof("Content-Length: \r\n") + 20;
 			char *buf = (char *) psg_pnalloc(req->pool, BUFSIZE);
-			unsigned int size = integerToOtherBase<boost::uint64_t, 10>(
-				resp->aux.bodyInfo.contentLength, buf, BUFSIZE);
+			const char *end = buf + BUFSIZE;
+			char *pos = buf;
+			pos = appendData(pos, end, "Content-Length: ");
+			pos += integerToOtherBase<boost::uint64_t, 10>(
+				resp->aux.bodyInfo.contentLength, pos, end - pos);
+			pos = appendData(pos, end, "\r\n");
 			buffers[i].iov_base = (void *) buf;
-			buffers[i].iov_len  = size;
-			dataSize += size;
-		} else {
-			dataSize += integerSizeInOtherBase<boost::uint64_t, 10>(
-				resp->aux.bodyInfo.contentLength);
+			buffers[i].iov_len  = pos - buf;
 		}
 		INC_BUFFER_ITER(i);
-		PUSH_STATIC_BUFFER("\r\n");
+		dataSize += sizeof("Content-Length: \r\n") - 1
+			+ integerSizeInOtherBase<boost::uint64_t, 10>(
+				resp->aux.bodyInfo.contentLength);
 	} else if (resp->bodyType == AppResponse::RBT_CHUNKED && !req->dechunkResponse) {
 		PUSH_STATIC_BUFFER("Transfer-Encoding: chunked\r\n");
 	}
 
-	if (resp->bodyType == AppResponse::RBT_UPGRADE) {
-		PUSH_STATIC_BUFFER("Connection: upgrade\r\n");
-	} else if (canKeepAlive(req)) {
-		unsigned int httpVersion = req->httpMajor * 1000 + req->httpMinor * 10;
-		if (httpVersion < 1010) {
-			// HTTP < 1.1 defaults to "Connection: close"
-			PUSH_STATIC_BUFFER("Connection: keep-alive\r\n");
-		}
-	} else {
-		unsigned int httpVersion = req->httpMajor * 1000 + req->httpMinor * 10;
-		if (httpVersion >= 1010) {
-			// HTTP 1.1 defaults to "Connection: keep-alive"
-			PUSH_STATIC_BUFFER("Connection: close\r\n");
-		}
-	}
-
 	if (req->stickySession) {
-		StaticString baseURI = req->options.baseURI;
+		StaticString baseURI = req->options->baseURI;
 		if (baseURI.empty()) {
 			baseURI = P_STATIC_STRING("/");
 		}
@@ -767,19 +693,24 @@ Controller::constructHeaderBuffersForResponse(Request *req, struct iovec *buffer
 		PUSH_STATIC_BUFFER("\r\n");
 	}
 
-	if (req->config->showVersionInHeader) {
-		#ifdef PASSENGER_IS_ENTERPRISE
-			PUSH_STATIC_BUFFER("X-Powered-By: " PROGRAM_NAME " Enterprise " PASSENGER_VERSION "\r\n\r\n");
-		#else
-			PUSH_STATIC_BUFFER("X-Powered-By: " PROGRAM_NAME " " PASSENGER_VERSION "\r\n\r\n");
-		#endif
+	if (resp->bodyType == AppResponse::RBT_UPGRADE) {
+		connection = ResponseHeaderTemplates::CONNECTION_UPGRADE;
 	} else {
-		#ifdef PASSENGER_IS_ENTERPRISE
-			PUSH_STATIC_BUFFER("X-Powered-By: " PROGRAM_NAME " Enterprise\r\n\r\n");
-		#else
-			PUSH_STATIC_BUFFER("X-Powered-By: " PROGRAM_NAME "\r\n\r\n");
-		#endif
+		unsigned int httpVersion = req->httpMajor * 1000 + req->httpMinor * 10;
+		if (canKeepAlive(req)) {
+			// HTTP < 1.1 defaults to "Connection: close"
+			connection = (httpVersion < 1010)
+				? ResponseHeaderTemplates::CONNECTION_KEEP_ALIVE
+				: ResponseHeaderTemplates::NO_CONNECTION_HEADER;
+		} else {
+			// HTTP 1.1 defaults to "Connection: keep-alive"
+			connection = (httpVersion >= 1010)
+				? ResponseHeaderTemplates::CONNECTION_CLOSE
+				: ResponseHeaderTemplates::NO_CONNECTION_HEADER;
+		}
 	}
+	PUSH_STRING_BUFFER(ResponseHeaderTemplates::getHeaderEnd(connection,
+		req->config->showVersionInHeader));
 
 	nbuffers = i;
 	return true;
@@ -787,19 +718,7 @@ Controller::constructHeaderBuffersForResponse(Request *req, struct iovec *buffer
 	#undef BEGIN_PUSH_NEXT_BUFFER
 	#undef INC_BUFFER_ITER
 	#undef PUSH_STATIC_BUFFER
-}
-
-unsigned int
-Controller::constructDateHeaderBuffersForResponse(char *dateStr, unsigned int bufsize) {
-	char *pos = dateStr;
-	const char *end = dateStr + bufsize - 1;
-	time_t the_time = (time_t) ev_now(getContext()->libev->getLoop());
-	struct tm the_tm;
-
-	pos = appendData(pos, end, "Date: ");
-	gmtime_r(&the_time, &the_tm);
-	pos += strftime(pos, end - pos, "%a, %d %b %Y %H:%M:%S GMT", &the_tm);
-	return pos - dateStr;
+	#undef PUSH_STRING_BUFFER
 }
 
 bool
@@ -807,12 +726,6 @@ Controller::sendResponseHeaderWithWritev(Client *client, Request *req,
 	ssize_t &bytesWritten)
 {
 	TRACE_POINT();
-
-	if (OXT_UNLIKELY(mainConfig.benchmarkMode == BM_RESPONSE_BEGIN)) {
-		writeBenchmarkResponse(&client, &req, false);
-		return true;
-	}
-
 	unsigned int maxbuffers = std::min<unsigned int>(
 		8 + req->appResponse.headers.size() * 4 + 11, IOV_MAX);
 	struct iovec *buffers = (struct iovec *) psg_palloc(req->pool,
@@ -823,6 +736,13 @@ Controller::sendResponseHeaderWithWritev(Client *client, Request *req,
 		maxbuffers, nbuffers, dataSize, nCacheableBuffers))
 	{
 		UPDATE_TRACE_POINT();
+		if (OXT_UNLIKELY(mainConfig.benchmarkMode == BM_RESPONSE_BEGIN)) {
+			// The response header is constructed but not sent, so that
+			// this benchmark mode includes the cost of constructing it.
+			writeBenchmarkResponse(&client, &req, false);
+			return true;
+		}
+
 		SKC_TRACE(client, 2, "Sending response headers using writev()");
 		logResponseHeaders(client, req, buffers, nbuffers, dataSize);
 		markHeaderBuffersForTurboCaching(client, req, buffers, nCacheableBuffers);
@@ -984,6 +904,7 @@ Controller::writeResponseAndMarkForTurboCaching(Client *client, Request *req,
 	const MemoryKit::mbuf &buffer)
 {
 	if (OXT_LIKELY(mainConfig.benchmarkMode != BM_RESPONSE_BEGIN)) {
+		responseBodyBytesCopied += buffer.size();
 		writeResponse(client, buffer);
 	}
 	markResponsePartForTurboCaching(client, req, buffer);
@@ -995,9 +916,9 @@ Controller::markResponsePartForTurboCaching(Client *client, Request *req,
 {
 	if (!req->ended() && turboCaching.isEnabled() && !req->cacheKey.empty()) {
 		unsigned int totalSize = req->appResponse.bodyCacheBuffer.size + buffer.size();
-		if (totalSize > ResponseCache<Request>::MAX_BODY_SIZE) {
+		if (totalSize > turboCaching.responseCache.getMaxBodySize()) {
 			SKC_DEBUG(client, "Response body larger than " <<
-				ResponseCache<Request>::MAX_HEADER_SIZE <<
+				turboCaching.responseCache.getMaxBodySize() <<
 				" bytes, so response is not eligible for turbocaching");
 			// Decrease store success ratio.
 			turboCaching.responseCache.incStores();
@@ -1072,9 +993,270 @@ void
 Controller::outputDataFlushed(Client *client, Request *req) {
 	if (!req->ended()) {
 		assert(!req->appSource.isStarted());
-		SKC_TRACE(client, 2, "The client is ready to receive more data. Resuming application socket");
 		client->output.setDataFlushedCallback(getClientOutputDataFlushedCallback());
-		req->appSource.start();
+		if (req->sendfileFd != -1) {
+			SKC_TRACE(client, 2, "The client is ready to receive more data. Resuming sending file");
+			sendFileToClient(client, req);
+		} else {
+			SKC_TRACE(client, 2, "The client is ready to receive more data. Resuming application socket");
+			req->appSource.start();
+		}
+	}
+}
+
+/**
+ * Whether the rest of the app response body should be spliced from the app
+ * socket to the client socket, through a pipe, instead of being copied
+ * through mbufs. Splicing is only possible if nothing needs to look at the
+ * body data (i.e. the body isn't dechunked, turbocached or logged), and
+ * if all response data that has been written so far has been flushed
+ * to the client, because spliced data would overtake buffered data.
+ */
+bool
+Controller::shouldSpliceAppResponseBody(Client *client, Request *req) {
+	#ifdef __linux__
+		const AppResponse *resp = &req->appResponse;
+
+		if (!mainConfig.responseSplicing
+		 || req->ended()
+		 || !req->cacheKey.empty()
+		 || OXT_UNLIKELY(mainConfig.benchmarkMode == BM_RESPONSE_BEGIN)
+		 || OXT_UNLIKELY(LoggingKit::getLevel() >= LoggingKit::INFO + 3))
+		{
+			return false;
+		}
+
+		switch (resp->httpState) {
+		case AppResponse::PARSING_BODY_WITH_LENGTH:
+			if (resp->aux.bodyInfo.contentLength - resp->bodyAlreadyRead
+				< MIN_SPLICE_BODY_SIZE)
+			{
+				return false;
+			}
+			break;
+		case AppResponse::PARSING_BODY_UNTIL_EOF:
+			if (resp->bodyAlreadyRead < MIN_SPLICE_BODY_SIZE) {
+				return false;
+			}
+			break;
+		default:
+			return false;
+		}
+
+		return client->output.isFlushed() && prepareSplicePipe();
+	#else
+		return false;
+	#endif
+}
+
+bool
+Controller::prepareSplicePipe() {
+	if (splicePipe.first != -1) {
+		return true;
+	}
+
+	try {
+		splicePipe = createPipe(__FILE__, __LINE__);
+	} catch (const SystemException &e) {
+		P_DEBUG("Cannot create a pipe for splicing response bodies, "
+			"copying them instead: " << e.what());
+		return false;
+	}
+	setNonBlocking(splicePipe.first);
+	setNonBlocking(splicePipe.second);
+	return true;
+}
+
+void
+Controller::beginSplicingAppResponseBody(Client *client, Request *req) {
+	SKC_TRACE(client, 2, "Splicing the rest of the application response body to the client");
+	req->appSource.stop();
+	ev_io_set(&req->appSpliceWatcher, req->session->fd(), EV_READ);
+	ev_io_start(getLoop(), &req->appSpliceWatcher);
+}
+
+void
+Controller::_onAppSocketSpliceable(EV_P_ struct ev_io *io, int revents) {
+	Request *req = static_cast<Request *>(io->data);
+	Client *client = static_cast<Client *>(req->client);
+	Controller *self = static_cast<Controller *>(getServerFromClient(client));
+	ServerKit::RefGuard guard(&req->hooks, req, __FILE__, __LINE__);
+
+	SKC_LOG_EVENT_FROM_STATIC(self, Controller, client, "onAppSocketSpliceable");
+	self->spliceAppResponseBody(client, req);
+}
+
+/**
+ * Moves app response body data from the app socket to the client socket
+ * in the kernel, through `splicePipe`. If the client socket cannot accept
+ * everything that was read from the app socket, then the remainder is
+ * copied from the pipe into the client output channel, and we fall back
+ * to forwarding the body through `req->appSource`.
+ */
+void
+Controller::spliceAppResponseBody(Client *client, Request *req) {
+	#ifdef __linux__
+	TRACE_POINT();
+	AppResponse *resp = &req->appResponse;
+	unsigned int i;
+	ssize_t ret;
+	size_t size, remaining;
+	int e;
+
+	for (i = 0; i < SPLICE_BURST_COUNT; i++) {
+		size = MAX_SPLICE_SIZE;
+		if (resp->httpState == AppResponse::PARSING_BODY_WITH_LENGTH) {
+			size = std::min<boost::uint64_t>(size,
+				resp->aux.bodyInfo.contentLength - resp->bodyAlreadyRead);
+		}
+
+		do {
+			ret = splice(req->appSpliceWatcher.fd, NULL, splicePipe.second, NULL,
+				size, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+		} while (OXT_UNLIKELY(ret == -1 && errno == EINTR));
+
+		if (ret == -1) {
+			e = errno;
+			if (e == EAGAIN || e == EWOULDBLOCK) {
+				// Wait until the app socket is readable again.
+				return;
+			} else if (e == EINVAL) {
+				// The app socket does not support splicing.
+				SKC_DEBUG(client, "Application socket does not support splicing; "
+					"copying the rest of the application response body");
+				stopSplicingAppResponseBody(client, req);
+				return;
+			} else if (e != ECONNRESET) {
+				UPDATE_TRACE_POINT();
+				ev_io_stop(getLoop(), &req->appSpliceWatcher);
+				endRequestWithAppSocketReadError(&client, &req, e);
+				return;
+			}
+		}
+
+		if (ret <= 0) {
+			// EOF
+			UPDATE_TRACE_POINT();
+			ev_io_stop(getLoop(), &req->appSpliceWatcher);
+			if (resp->httpState == AppResponse::PARSING_BODY_WITH_LENGTH) {
+				SKC_WARN(client, "Application sent EOF before finishing response body: " <<
+					resp->bodyAlreadyRead << " bytes already read, " <<
+					resp->aux.bodyInfo.contentLength << " bytes expected");
+				endRequestWithAppSocketIncompleteResponse(&client, &req);
+			} else {
+				SKC_TRACE(client, 2, "Application sent EOF");
+				SKC_TRACE(client, 2, "Not keep-aliving application session connection");
+				req->session->close(true, false);
+				endRequest(&client, &req);
+			}
+			return;
+		}
+
+		resp->bodyAlreadyRead += ret;
+		size = remaining = ret;
+		while (remaining > 0) {
+			ret = splice(splicePipe.first, NULL, client->getFd(), NULL,
+				remaining, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+			if (ret > 0) {
+				remaining -= ret;
+				responseBodyBytesSpliced += ret;
+			} else if (ret == -1 && errno == EINTR) {
+				continue;
+			} else {
+				break;
+			}
+		}
+		if (remaining < size) {
+			req->lastDataSendTime = ev_now(getLoop());
+		}
+
+		if (remaining > 0) {
+			UPDATE_TRACE_POINT();
+			e = (ret == -1) ? errno : EAGAIN;
+			if (e != EAGAIN && e != EWOULDBLOCK) {
+				// The pipe still contains data, so don't reuse it.
+				splicePipe = Pipe();
+				ev_io_stop(getLoop(), &req->appSpliceWatcher);
+				disconnectWithClientSocketWriteError(&client, e);
+				return;
+			}
+
+			SKC_TRACE(client, 2, "Client socket is not writable. Copying the remaining "
+				<< remaining << " spliced bytes to the client output channel");
+			if (!copySplicePipeToClientOutput(client, req, remaining)) {
+				return;
+			}
+			if (resp->bodyFullyRead()) {
+				SKC_TRACE(client, 2, "End of application response body reached");
+				ev_io_stop(getLoop(), &req->appSpliceWatcher);
+				handleAppResponseBodyEnd(client, req);
+				endRequest(&client, &req);
+			} else {
+				stopSplicingAppResponseBody(client, req);
+				maybeThrottleAppSource(client, req);
+			}
+			return;
+		}
+
+		if (resp->bodyFullyRead()) {
+			UPDATE_TRACE_POINT();
+			SKC_TRACE(client, 2, "End of application response body reached");
+			ev_io_stop(getLoop(), &req->appSpliceWatcher);
+			handleAppResponseBodyEnd(client, req);
+			endRequest(&client, &req);
+			return;
+		}
+	}
+	#endif
+}
+
+/**
+ * Resumes forwarding the app response body through `req->appSource`.
+ */
+void
+Controller::stopSplicingAppResponseBody(Client *client, Request *req) {
+	SKC_TRACE(client, 2, "Stopped splicing the application response body");
+	ev_io_stop(getLoop(), &req->appSpliceWatcher);
+	req->appSource.start();
+}
+
+bool
+Controller::copySplicePipeToClientOutput(Client *client, Request *req, size_t size) {
+	MemoryKit::mbuf buffer(MemoryKit::mbuf_get_with_size(&getContext()->mbuf_pool, size));
+	size_t offset = 0;
+	ssize_t ret;
+	int e;
+
+	if (OXT_UNLIKELY(buffer.is_null())) {
+		e = ENOMEM;
+		goto error;
+	}
+
+	while (offset < size) {
+		do {
+			ret = ::read(splicePipe.first, buffer.start + offset, size - offset);
+		} while (OXT_UNLIKELY(ret == -1 && errno == EINTR));
+		if (ret <= 0) {
+			e = (ret == -1) ? errno : EIO;
+			goto error;
+		}
+		offset += ret;
+	}
+
+	responseBodyBytesCopied += size;
+	writeResponse(client, buffer);
+	return !req->ended();
+
+	error:
+	{
+		string message = "cannot copy data from the response splicing pipe: ";
+		message.append(ServerKit::getErrorDesc(e));
+		message.append(" (errno=" + toString(e) + ")");
+		// The pipe may still contain data, so don't reuse it.
+		splicePipe = Pipe();
+		ev_io_stop(getLoop(), &req->appSpliceWatcher);
+		disconnectWithError(&client, message);
+		return false;
 	}
 }
 
@@ -1128,17 +1310,20 @@ Controller::storeAppResponseInTurboCache(Client *client, Request *req) {
 			SKC_TRACE(client, 2, "Turbocache entries:\n" << turboCaching.responseCache.inspect());
 
 			gatherBuffers(entry.body->httpHeaderData,
-				ResponseCache<Request>::MAX_HEADER_SIZE,
+				entry.body->httpHeaderSize,
 				resp->headerCacheBuffers, resp->nHeaderCacheBuffers);
 
 			char *pos = entry.body->httpBodyData;
 			const char *end = entry.body->httpBodyData
-				+ ResponseCache<Request>::MAX_BODY_SIZE;
+				+ entry.body->httpBodySize;
 			const LString::Part *part = resp->bodyCacheBuffer.start;
 			while (part != NULL) {
 				pos = appendData(pos, end, part->data, part->size);
 				part = part->next;
 			}
+
+			turboCaching.responseCache.publish(entry);
+			turboCaching.compressInBackground(entry);
 		} else {
 			SKC_DEBUG(client, "Could not store app response for turbocaching");
 		}
@@ -1151,6 +1336,23 @@ Controller::finalizeUnionStationWithSuccess(Client *client, Request *req) {
 	req->endStopwatchLog(&req->stopwatchLogs.requestProcessing, true);
 }
 
+void
+Controller::sendResponseHeader(Client *client, Request *req) {
+	TRACE_POINT();
+	ssize_t bytesWritten;
+
+	if (!sendResponseHeaderWithWritev(client, req, bytesWritten)) {
+		UPDATE_TRACE_POINT();
+		if (bytesWritten >= 0 || errno == EAGAIN || errno == EWOULDBLOCK) {
+			sendResponseHeaderWithBuffering(client, req, bytesWritten);
+		} else {
+			int e = errno;
+			P_ASSERT_EQ(bytesWritten, -1);
+			disconnectWithClientSocketWriteError(&client, e);
+		}
+	}
+}
+
 
 } // namespace Core
 } // namespace Passenger
@@ -104,6 +104,12 @@ Controller::onRequestObjectCreated(Client *client, Request *req) {
 	req->appSource.setHooks(&req->hooks);
 	req->appSource.setDataCallback(_onAppSourceData);
 
+	ev_io_init(&req->appSpliceWatcher, _onAppSocketSpliceable, -1, EV_READ);
+	req->appSpliceWatcher.data = req;
+
+	ev_io_init(&req->sendfileWatcher, _onClientSocketWritableForSendfile, -1, EV_WRITE);
+	req->sendfileWatcher.data = req;
+
 	req->bodyBuffer.setContext(getContext());
 	req->bodyBuffer.setHooks(&req->hooks);
 	req->bodyBuffer.setDataCallback(onBodyBufferData);
@@ -134,12 +140,18 @@ Controller::reinitializeRequest(Client *client, Request *req) {
 	req->appResponseInitialized = false;
 	req->strip100ContinueHeader = false;
 	req->hasPragmaHeader = false;
+	req->turboCacheRole = Request::TURBOCACHE_NO_ROLE;
 	req->host = NULL;
 	req->config = requestConfig;
 	req->bodyBytesBuffered = 0;
+	req->sendfileFd = -1;
+	req->sendfileOffset = 0;
+	req->sendfileEnd = 0;
 	req->cacheKey = HashedStaticString();
 	req->cacheControl = NULL;
 	req->varyCookie = NULL;
+	req->nextTurboCacheWaiter = NULL;
+	req->turboCacheRevalidationEntry = ResponseCache<Request>::Entry();
 	req->envvars = NULL;
 
 	#ifdef DEBUG_CC_EVENT_LOOP_BLOCKING
@@ -162,14 +174,31 @@ Controller::deinitializeRequest(Client *client, Request *req) {
 	req->endStopwatchLog(&req->stopwatchLogs.requestProxying, false);
 	req->endStopwatchLog(&req->stopwatchLogs.requestProcessing, false);
 
-	req->options.transaction.reset();
+	req->options.reset();
+	req->requestOptions.transaction.reset();
 
 	req->appSink.setConsumedCallback(NULL);
 	req->appSink.deinitialize();
 	req->appSource.deinitialize();
+	if (ev_is_active(&req->appSpliceWatcher)) {
+		ev_io_stop(getLoop(), &req->appSpliceWatcher);
+	}
+	if (req->sendfileFd != -1) {
+		if (ev_is_active(&req->sendfileWatcher)) {
+			ev_io_stop(getLoop(), &req->sendfileWatcher);
+		}
+		safelyClose(req->sendfileFd, true);
+		req->sendfileFd = -1;
+	}
 	req->bodyBuffer.clearBuffersFlushedCallback();
 	req->bodyBuffer.deinitialize();
 
+	if (req->turboCacheRole == Request::TURBOCACHE_LEADER
+	 || req->turboCacheRole == Request::TURBOCACHE_WAITING)
+	{
+		endTurboCacheCoalescing(req);
+	}
+
 	/***************/
 	/***************/
 
@@ -30,6 +30,7 @@
 #include <Core/Controller/CheckoutSession.cpp>
 #include <Core/Controller/SendRequest.cpp>
 #include <Core/Controller/ForwardResponse.cpp>
+#include <Core/Controller/SendFile.cpp>
 #include <Core/Controller/Hooks.cpp>
 #include <Core/Controller/InitializationAndShutdown.cpp>
 #include <Core/Controller/InternalUtils.cpp>
@@ -110,28 +110,174 @@ Controller::respondFromTurboCache(Client *client, Request *req) {
 	SKC_TRACE(client, 2, "Turbocache entries:\n" << turboCaching.responseCache.inspect());
 
 	if (turboCaching.responseCache.requestAllowsFetching(req)) {
-		ResponseCache<Request>::Entry entry(turboCaching.responseCache.fetch(req,
-			ev_now(getLoop())));
+		ev_tstamp now = ev_now(getLoop());
+		ResponseCache<Request>::Entry entry(turboCaching.responseCache.fetch(req, now));
 		if (entry.valid()) {
 			SKC_TRACE(client, 2, "Turbocaching: cache hit (key \"" <<
 				cEscapeString(req->cacheKey) << "\")");
-			turboCaching.writeResponse(this, client, req, entry);
-			if (!req->ended()) {
-				endRequest(&client, &req);
+			respondWithTurboCacheEntry(client, req, entry);
+			return true;
+		}
+
+		SKC_TRACE(client, 2, "Turbocaching: cache miss: " <<
+			entry.getCacheMissReasonString() <<
+			" (key \"" << cEscapeString(req->cacheKey) << "\")");
+		if (req->turboCacheRole == Request::TURBOCACHE_RESUMED) {
+			return false;
+		}
+
+		int fetchIndex = turboCaching.findInFlightFetch(req->cacheKey);
+		if (fetchIndex != -1) {
+			entry = turboCaching.responseCache.fetchStale(req, now,
+				ResponseCache<Request>::STALE_WHILE_REVALIDATE);
+			if (entry.valid()) {
+				SKC_TRACE(client, 2, "Turbocaching: serving stale entry while it's"
+					" being revalidated (key \"" << cEscapeString(req->cacheKey) << "\")");
+				turboCaching.incStaleResponses();
+				respondWithTurboCacheEntry(client, req, entry);
+			} else {
+				// Resumed by resumeTurboCacheWaiters() after the leader has ended.
+				SKC_TRACE(client, 2, "Turbocaching: waiting for in-flight fetch"
+					" (key \"" << cEscapeString(req->cacheKey) << "\")");
+				refRequest(req, __FILE__, __LINE__);
+				turboCaching.addWaiter(fetchIndex, req);
 			}
 			return true;
-		} else {
-			SKC_TRACE(client, 2, "Turbocaching: cache miss: " <<
-				entry.getCacheMissReasonString() <<
+		} else if (entry.cacheMissReason == ResponseCache<Request>::Entry::NOT_FRESH
+			&& turboCaching.responseCache.requestAllowsStoring(req))
+		{
+			// Only coalesce requests for entries that are known to be
+			// cacheable, so that requests for uncacheable resources
+			// never wait for each other.
+			SKC_TRACE(client, 2, "Turbocaching: fetching expired entry from app"
 				" (key \"" << cEscapeString(req->cacheKey) << "\")");
-			return false;
+			turboCaching.beginFetch(req);
+			if (!turboCaching.responseCache.requestHasConditions(req)) {
+				entry = turboCaching.responseCache.fetchForRevalidation(req, now);
+				if (entry.valid()) {
+					SKC_TRACE(client, 2, "Turbocaching: revalidating expired entry"
+						" with a conditional request (key \"" <<
+						cEscapeString(req->cacheKey) << "\")");
+					req->turboCacheRevalidationEntry =
+						ResponseCache<Request>::copyEntry(entry, req->pool);
+					turboCaching.responseCache.addRevalidationConditions(req,
+						req->turboCacheRevalidationEntry);
+				}
+			}
 		}
+		return false;
 	} else {
 		SKC_TRACE(client, 2, "Turbocaching: request not eligible for caching");
 		return false;
 	}
 }
 
+/**
+ * Called when the app failed to handle the request. If the turbocache has
+ * an expired entry for this request that may be served upon errors, then
+ * responds with that entry and returns true.
+ */
+bool
+Controller::respondFromTurboCacheOnError(Client *client, Request *req) {
+	if (!turboCaching.isEnabled() || req->cacheKey.empty() || req->responseBegun
+	 || !turboCaching.responseCache.requestAllowsFetching(req))
+	{
+		return false;
+	}
+
+	ResponseCache<Request>::Entry entry(turboCaching.responseCache.fetchStale(req,
+		ev_now(getLoop()), ResponseCache<Request>::STALE_IF_ERROR));
+	if (entry.valid()) {
+		SKC_DEBUG(client, "Turbocaching: app failed, serving stale entry instead"
+			" (key \"" << cEscapeString(req->cacheKey) << "\")");
+		turboCaching.incStaleIfErrorResponses();
+		respondWithTurboCacheEntry(client, req, entry);
+		return true;
+	} else {
+		return false;
+	}
+}
+
+/**
+ * Called when the app responded with 304 Not Modified to a request that
+ * revalidates an expired turbocache entry. Renews the entry and responds
+ * with it.
+ */
+void
+Controller::respondFromTurboCacheAfterRevalidation(Client *client, Request *req) {
+	SKC_DEBUG(client, "Turbocaching: app revalidated expired entry"
+		" (key \"" << cEscapeString(req->cacheKey) << "\")");
+	ResponseCache<Request>::Entry entry(turboCaching.responseCache.revalidate(req,
+		req->turboCacheRevalidationEntry, ev_now(getLoop())));
+	turboCaching.incRevalidations();
+	respondWithTurboCacheEntry(client, req, entry);
+}
+
+void
+Controller::respondWithTurboCacheEntry(Client *client, Request *req,
+	ResponseCache<Request>::Entry &entry)
+{
+	// The conditions of a revalidation request were added by us,
+	// not by the client.
+	bool notModified = !req->turboCacheRevalidationEntry.valid()
+		&& turboCaching.responseCache.requestIsNotModified(req, entry);
+	turboCaching.writeResponse(this, client, req, entry, notModified);
+	if (!req->ended()) {
+		endRequest(&client, &req);
+	}
+}
+
+/**
+ * Called when a request that is a turbocache fetch leader or waiter is
+ * deinitialized.
+ */
+void
+Controller::endTurboCacheCoalescing(Request *req) {
+	if (req->turboCacheRole == Request::TURBOCACHE_LEADER) {
+		Request *firstWaiter = turboCaching.endFetch(req);
+		if (firstWaiter != NULL) {
+			// We're in the middle of ending the leader, so resume
+			// the waiters in the next event loop iteration.
+			getContext()->libev->runLater(boost::bind(resumeTurboCacheWaiters,
+				firstWaiter));
+		}
+	} else {
+		assert(req->turboCacheRole == Request::TURBOCACHE_WAITING);
+		turboCaching.removeWaiter(req);
+		unrefRequest(req, __FILE__, __LINE__);
+	}
+}
+
+void
+Controller::resumeTurboCacheWaiters(Request *firstWaiter) {
+	Request *req = firstWaiter;
+
+	while (req != NULL) {
+		Request *next = req->nextTurboCacheWaiter;
+		Client *client = static_cast<Client *>(req->client);
+		Controller *self = static_cast<Controller *>(
+			Controller::getServerFromClient(client));
+		SKC_LOG_EVENT_FROM_STATIC(self, Controller, client, "resumeTurboCacheWaiters");
+
+		req->nextTurboCacheWaiter = NULL;
+		if (!req->ended()) {
+			self->resumeTurboCacheWaiter(client, req);
+		}
+		self->unrefRequest(req, __FILE__, __LINE__);
+		req = next;
+	}
+}
+
+void
+Controller::resumeTurboCacheWaiter(Client *client, Request *req) {
+	SKC_TRACE(client, 2, "Turbocaching: in-flight fetch ended, resuming request");
+	if (!respondFromTurboCache(client, req)) {
+		RequestAnalysis analysis;
+		analyzeRequest(req, analysis);
+		continueInitializingRequest(client, req, analysis);
+	}
+}
+
 void
 Controller::initializePoolOptions(Client *client, Request *req, RequestAnalysis &analysis) {
 	boost::shared_ptr<Options> *options;
@@ -139,7 +285,7 @@ Controller::initializePoolOptions(Client *client, Request *req, RequestAnalysis
 	if (mainConfig.singleAppMode) {
 		P_ASSERT_EQ(poolOptionsCache.size(), 1);
 		poolOptionsCache.lookupRandom(NULL, &options);
-		req->options = **options;
+		req->options = *options;
 	} else {
 		ServerKit::HeaderTable::Cell *appGroupNameCell = analysis.appGroupNameCell;
 		if (appGroupNameCell != NULL && appGroupNameCell->header->val.size > 0) {
@@ -152,7 +298,7 @@ Controller::initializePoolOptions(Client *client, Request *req, RequestAnalysis
 			poolOptionsCache.lookup(hAppGroupName, &options);
 
 			if (options != NULL) {
-				req->options = **options;
+				req->options = *options;
 			} else {
 				createNewPoolOptions(client, req, hAppGroupName);
 			}
@@ -162,18 +308,20 @@ Controller::initializePoolOptions(Client *client, Request *req, RequestAnalysis
 	}
 
 	if (!req->ended()) {
+		req->requestOptions.reset(*req->options);
+
 		// See comment for req->envvars to learn how it is different
-		// from req->options.environmentVariables.
+		// from req->requestOptions.environmentVariables.
 		req->envvars = req->secureHeaders.lookup(PASSENGER_ENV_VARS);
 		if (req->envvars != NULL && req->envvars->size > 0) {
 			req->envvars = psg_lstr_make_contiguous(req->envvars, req->pool);
-			req->options.environmentVariables = StaticString(
+			req->requestOptions.environmentVariables = StaticString(
 				req->envvars->start->data,
 				req->envvars->size);
 		}
 
 		// Allow certain options to be overridden on a per-request basis
-		fillPoolOption(req, req->options.maxRequests, PASSENGER_MAX_REQUESTS);
+		fillPoolOption(req, req->requestOptions.maxRequests, PASSENGER_MAX_REQUESTS);
 	}
 }
 
@@ -274,6 +422,18 @@ Controller::fillPoolOption(Request *req, long &field,
 	}
 }
 
+void
+Controller::fillPoolOption(Request *req, RoutingPolicy &field,
+	const HashedStaticString &name)
+{
+	const LString *value = req->secureHeaders.lookup(name);
+	if (value != NULL && value->size > 0) {
+		value = psg_lstr_make_contiguous(value, req->pool);
+		// Unknown values are passed on so that the Group can warn about them.
+		field = parseRoutingPolicy(StaticString(value->start->data, value->size));
+	}
+}
+
 void
 Controller::fillPoolOptionSecToMsec(Request *req, unsigned int &field,
 	const HashedStaticString &name)
@@ -290,12 +450,10 @@ Controller::createNewPoolOptions(Client *client, Request *req,
 	const HashedStaticString &appGroupName)
 {
 	ServerKit::HeaderTable &secureHeaders = req->secureHeaders;
-	Options &options = req->options;
+	Options options;
 
 	SKC_TRACE(client, 2, "Creating new pool options: app group name=" << appGroupName);
 
-	options = Options();
-
 	const LString *scriptName = secureHeaders.lookup("!~SCRIPT_NAME");
 	const LString *appRoot = secureHeaders.lookup("!~PASSENGER_APP_ROOT");
 	if (scriptName == NULL || scriptName->size == 0) {
@@ -369,6 +527,7 @@ Controller::createNewPoolOptions(Client *client, Request *req,
 	fillPoolOption(req, options.maxPreloaderIdleTime, "!~PASSENGER_MAX_PRELOADER_IDLE_TIME");
 	fillPoolOption(req, options.maxRequestQueueSize, "!~PASSENGER_MAX_REQUEST_QUEUE_SIZE");
 	fillPoolOption(req, options.abortWebsocketsOnProcessShutdown, "!~PASSENGER_ABORT_WEBSOCKETS_ON_PROCESS_SHUTDOWN");
+	fillPoolOption(req, options.routingPolicy, "!~PASSENGER_ROUTING_POLICY");
 	fillPoolOption(req, options.forceMaxConcurrentRequestsPerProcess, "!~PASSENGER_FORCE_MAX_CONCURRENT_REQUESTS_PER_PROCESS");
 	fillPoolOption(req, options.restartDir, "!~PASSENGER_RESTART_DIR");
 	fillPoolOption(req, options.startupFile, "!~PASSENGER_STARTUP_FILE");
@@ -382,13 +541,14 @@ Controller::createNewPoolOptions(Client *client, Request *req,
 	optionsCopy->persist(options);
 	optionsCopy->clearPerRequestFields();
 	optionsCopy->detachFromUnionStationTransaction();
-	poolOptionsCache.insert(options.getAppGroupName(), optionsCopy);
+	poolOptionsCache.insert(optionsCopy->getAppGroupName(), optionsCopy);
+	req->options = optionsCopy;
 }
 
 void
 Controller::initializeUnionStation(Client *client, Request *req, RequestAnalysis &analysis) {
 	if (analysis.unionStationSupport) {
-		Options &options = req->options;
+		PerRequestOptions &options = req->requestOptions;
 		ServerKit::HeaderTable &headers = req->secureHeaders;
 
 		const LString *key = headers.lookup("!~UNION_STATION_KEY");
@@ -404,7 +564,7 @@ Controller::initializeUnionStation(Client *client, Request *req, RequestAnalysis
 		}
 
 		options.transaction = unionStationContext->newTransaction(
-			options.getAppGroupName(), "requests",
+			req->options->getAppGroupName(), "requests",
 			string(key->start->data, key->size),
 			(filters != NULL)
 				? string(filters->start->data, filters->size)
@@ -436,7 +596,7 @@ Controller::setStickySessionId(Client *client, Request *req) {
 			foreach (cookie, cookies) {
 				if (psg_lstr_cmp(cookieName, cookie.first)) {
 					// This cookie matches the one we're looking for.
-					req->options.stickySessionId = stringToUint(cookie.second);
+					req->requestOptions.stickySessionId = stringToUint(cookie.second);
 					return;
 				}
 			}
@@ -469,41 +629,55 @@ Controller::onRequestBegin(Client *client, Request *req) {
 
 	CC_BENCHMARK_POINT(client, req, BM_AFTER_ACCEPT);
 
-	{
-		// Perform hash table operations as close to header parsing as possible,
-		// and localize them as much as possible, for better CPU caching.
-		RequestAnalysis analysis;
-		analysis.flags = req->secureHeaders.lookup(FLAGS);
-		analysis.appGroupNameCell = mainConfig.singleAppMode
-			? NULL
-			: req->secureHeaders.lookupCell(PASSENGER_APP_GROUP_NAME);
-		analysis.unionStationSupport = unionStationContext != NULL
-			&& getBoolOption(req, UNION_STATION_SUPPORT, false);
-		req->stickySession = getBoolOption(req, PASSENGER_STICKY_SESSIONS,
-			mainConfig.defaultStickySessions);
-		req->host = req->headers.lookup(HTTP_HOST);
-
-		/***************/
-		/***************/
-
-		SKC_TRACE(client, 2, "Initiating request");
-		req->startedAt = ev_now(getLoop());
-		req->bodyChannel.stop();
-
-		initializeFlags(client, req, analysis);
-		if (respondFromTurboCache(client, req)) {
-			return;
-		}
-		initializePoolOptions(client, req, analysis);
-		if (req->ended()) {
-			return;
-		}
-		initializeUnionStation(client, req, analysis);
-		if (req->ended()) {
-			return;
-		}
-		setStickySessionId(client, req);
+	// Perform hash table operations as close to header parsing as possible,
+	// and localize them as much as possible, for better CPU caching.
+	RequestAnalysis analysis;
+	analyzeRequest(req, analysis);
+	req->stickySession = getBoolOption(req, PASSENGER_STICKY_SESSIONS,
+		mainConfig.defaultStickySessions);
+	req->host = req->headers.lookup(HTTP_HOST);
+
+	/***************/
+	/***************/
+
+	SKC_TRACE(client, 2, "Initiating request");
+	req->startedAt = ev_now(getLoop());
+	req->bodyChannel.stop();
+
+	initializeFlags(client, req, analysis);
+	if (respondFromTurboCache(client, req)) {
+		return;
+	}
+	continueInitializingRequest(client, req, analysis);
+}
+
+void
+Controller::analyzeRequest(Request *req, RequestAnalysis &analysis) {
+	analysis.flags = req->secureHeaders.lookup(FLAGS);
+	analysis.appGroupNameCell = mainConfig.singleAppMode
+		? NULL
+		: req->secureHeaders.lookupCell(PASSENGER_APP_GROUP_NAME);
+	analysis.unionStationSupport = unionStationContext != NULL
+		&& getBoolOption(req, UNION_STATION_SUPPORT, false);
+}
+
+/**
+ * Continues initializing a request that could not be served from the
+ * turbocache, and sends it on its way to the app.
+ */
+void
+Controller::continueInitializingRequest(Client *client, Request *req,
+	RequestAnalysis &analysis)
+{
+	initializePoolOptions(client, req, analysis);
+	if (req->ended()) {
+		return;
+	}
+	initializeUnionStation(client, req, analysis);
+	if (req->ended()) {
+		return;
 	}
+	setStickySessionId(client, req);
 
 	if (!req->hasBody() || !req->requestBodyBuffering) {
 		req->requestBodyBuffering = false;
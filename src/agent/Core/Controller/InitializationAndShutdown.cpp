@@ -46,6 +46,8 @@ using namespace boost;
 
 Controller::~Controller() {
 	ev_check_stop(getLoop(), &checkWatcher);
+	// The cached Groups must not outlive the Pool.
+	groupHandleCache.clear();
 	delete singleAppModeConfig;
 }
 
@@ -71,6 +73,7 @@ Controller::preinitialize() {
 	PASSENGER_STICKY_SESSIONS = "!~PASSENGER_STICKY_SESSIONS";
 	PASSENGER_STICKY_SESSIONS_COOKIE_NAME = "!~PASSENGER_STICKY_SESSIONS_COOKIE_NAME";
 	PASSENGER_REQUEST_OOB_WORK = "!~Request-OOB-Work";
+	PASSENGER_SENDFILE_ROOT = "!~PASSENGER_SENDFILE_ROOT";
 	UNION_STATION_SUPPORT = "!~UNION_STATION_SUPPORT";
 	REMOTE_ADDR = "!~REMOTE_ADDR";
 	REMOTE_PORT = "!~REMOTE_PORT";
@@ -85,6 +88,9 @@ Controller::preinitialize() {
 	HTTP_CONNECTION = "connection";
 	HTTP_STATUS = "status";
 	HTTP_TRANSFER_ENCODING = "transfer-encoding";
+	HTTP_RANGE = "range";
+	HTTP_IF_RANGE = "if-range";
+	HTTP_ACCEPT_RANGES = "accept-ranges";
 
 	/**************************/
 }
@@ -103,7 +109,16 @@ Controller::initialize() {
 	}
 
 	ParentClass::initialize();
-	turboCaching.initialize(config["turbocaching"].asBool());
+	turboCaching.initialize(config["turbocaching"].asBool(),
+		config["turbocache_max_memory"].asUInt(),
+		config["turbocache_max_body_size"].asUInt(),
+		config["turbocache_fetch_threshold"].asUInt(),
+		config["turbocache_min_hit_ratio"].asDouble(),
+		config["turbocache_compression"].asBool());
+	if (sharedResponseCache != NULL) {
+		turboCaching.responseCache.setSharedCache(sharedResponseCache,
+			mainConfig.threadNumber - 1);
+	}
 
 	if (mainConfig.singleAppMode) {
 		boost::shared_ptr<Options> options = boost::make_shared<Options>();
@@ -59,8 +59,8 @@ Controller::disconnectLongRunningConnections(const StaticString &gupid) {
 			Request *req = client->currentRequest;
 			if (req->httpState >= Request::COMPLETE
 			 && req->upgraded()
-			 && req->options.abortWebsocketsOnProcessShutdown
 			 && req->session != NULL
+			 && req->options->abortWebsocketsOnProcessShutdown
 			 && req->session->getGupid() == gupid)
 			{
 				if (LoggingKit::getLevel() >= LoggingKit::INFO) {
@@ -38,6 +38,7 @@
 #include <Core/UnionStation/Context.h>
 #include <Core/UnionStation/Transaction.h>
 #include <Core/UnionStation/StopwatchLog.h>
+#include <Core/ResponseCache.h>
 #include <Core/Controller/Config.h>
 #include <Core/Controller/AppResponse.h>
 
@@ -67,6 +68,17 @@ public:
 		HALF_CLOSE_PERFORMED
 	};
 
+	// The request's role in turbocache request coalescing. See TurboCaching.
+	enum TurboCacheRole {
+		TURBOCACHE_NO_ROLE,
+		// Fetching an expired entry from the app, while others wait.
+		TURBOCACHE_LEADER,
+		// Waiting for a leader to fetch the entry.
+		TURBOCACHE_WAITING,
+		// Done waiting. Won't wait again, even if the cache still misses.
+		TURBOCACHE_RESUMED
+	};
+
 	ev_tstamp startedAt;
 
 	State state: 3;
@@ -81,16 +93,34 @@ public:
 	bool appResponseInitialized: 1;
 	bool strip100ContinueHeader: 1;
 	bool hasPragmaHeader: 1;
+	TurboCacheRole turboCacheRole: 2;
 
-	Options options;
+	// The pool options shared by all requests to this request's app group.
+	// The fields that may differ per request are in `requestOptions` instead.
+	boost::shared_ptr<const Options> options;
+	PerRequestOptions requestOptions;
 	AbstractSessionPtr session;
 	const LString *host;
 	ControllerRequestConfigPtr config;
 
 	ServerKit::FdSinkChannel appSink;
 	ServerKit::FdSourceChannel appSource;
+	// Active while the app response body is being spliced to the client,
+	// during which `appSource` is stopped. See
+	// Controller::spliceAppResponseBody().
+	ev_io appSpliceWatcher;
 	AppResponse appResponse;
 
+	// The file named by the app response's X-Sendfile or X-Accel-Redirect
+	// header, while it is being sent to the client. Bytes
+	// [sendfileOffset, sendfileEnd) remain to be sent. `sendfileWatcher`
+	// is active while waiting for the client socket to become writable.
+	// See Controller::sendFileToClient().
+	int sendfileFd;
+	boost::uint64_t sendfileOffset;
+	boost::uint64_t sendfileEnd;
+	ev_io sendfileWatcher;
+
 	ServerKit::FileBufferedChannel bodyBuffer;
 	boost::uint64_t bodyBytesBuffered; // After dechunking
 
@@ -104,10 +134,18 @@ public:
 	HashedStaticString cacheKey;
 	LString *cacheControl;
 	LString *varyCookie;
+	// Next request in the list of requests waiting for the same
+	// turbocache fetch.
+	Request *nextTurboCacheWaiter;
+	// If this request revalidates an expired turbocache entry with a
+	// conditional request, then this is a copy of that entry in the
+	// request's pool, which is served if the app responds with
+	// 304 Not Modified. Otherwise, it's invalid.
+	ResponseCache<Request>::Entry turboCacheRevalidationEntry;
 	// Value of the `!~PASSENGER_ENV_VARS` header. This is different
-	// from `options.environmentVariables`. If `!~PASSENGER_ENV_VARS`
+	// from `requestOptions.environmentVariables`. If `!~PASSENGER_ENV_VARS`
 	// is not set or is empty, then `envvars` is NULL, while
-	// `options.environmentVariables` retains a previous value.
+	// `requestOptions.environmentVariables` retains the app group's value.
 	//
 	// This value is guaranteed to be contiguous.
 	LString *envvars;
@@ -146,12 +184,12 @@ public:
 	}
 
 	bool useUnionStation() const {
-		return options.transaction != NULL;
+		return requestOptions.transaction != NULL;
 	}
 
 	void beginStopwatchLog(UnionStation::StopwatchLog **stopwatchLog, const char *id, const char *nameAndData = NULL) {
-		if (options.transaction != NULL) {
-			*stopwatchLog = new UnionStation::StopwatchLog(options.transaction, id, nameAndData);
+		if (requestOptions.transaction != NULL) {
+			*stopwatchLog = new UnionStation::StopwatchLog(requestOptions.transaction, id, nameAndData);
 		}
 	}
 
@@ -164,7 +202,7 @@ public:
 	}
 
 	void logMessage(const StaticString &message) {
-		options.transaction->message(message);
+		requestOptions.transaction->message(message);
 	}
 
 	DEFINE_SERVER_KIT_BASE_HTTP_REQUEST_FOOTER(Passenger::Core::Request);
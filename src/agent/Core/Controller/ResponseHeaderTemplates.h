@@ -0,0 +1,208 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_CORE_CONTROLLER_RESPONSE_HEADER_TEMPLATES_H_
+#define _PASSENGER_CORE_CONTROLLER_RESPONSE_HEADER_TEMPLATES_H_
+
+#include <boost/noncopyable.hpp>
+#include <oxt/macros.hpp>
+#include <ev++.h>
+#include <ctime>
+#include <cstring>
+#include <MemoryKit/palloc.h>
+#include <StaticString.h>
+#include <Constants.h>
+#include <Utils/StrIntUtils.h>
+#include <Utils/HttpConstants.h>
+
+namespace Passenger {
+namespace Core {
+
+
+/**
+ * Caches the parts of response headers that are the same for many responses,
+ * so that Controller::constructHeaderBuffersForResponse() can point to them
+ * instead of formatting them for every response:
+ *
+ *  - The Date header. It's formatted at most once per second.
+ *  - Status lines ("HTTP/1.1 200 OK\r\nStatus: 200 OK\r\n"), which are interned
+ *    per HTTP version and status code the first time they're needed.
+ *  - The block at the end of the header, consisting of the Connection header,
+ *    the X-Powered-By header and the empty line.
+ *
+ * Each Controller has its own instance, so it's only accessed from a single
+ * thread and needs no locking.
+ */
+class ResponseHeaderTemplates: public boost::noncopyable {
+public:
+	enum ConnectionHeader {
+		NO_CONNECTION_HEADER,
+		CONNECTION_KEEP_ALIVE,
+		CONNECTION_CLOSE,
+		CONNECTION_UPGRADE
+	};
+
+private:
+	static const int MIN_STATUS_CODE = 100;
+	static const int MAX_STATUS_CODE = 599;
+
+	psg_pool_t *pool;
+	/** Interned status lines for HTTP/1.0 and HTTP/1.1, by status code. */
+	StaticString statusLines[2][MAX_STATUS_CODE - MIN_STATUS_CODE + 1];
+	char dateHeader[64];
+	unsigned int dateHeaderSize;
+	time_t dateHeaderTime;
+
+public:
+	ResponseHeaderTemplates()
+		: pool(psg_create_pool(PSG_DEFAULT_POOL_SIZE)),
+		  dateHeaderSize(0),
+		  dateHeaderTime((time_t) -1)
+		{ }
+
+	~ResponseHeaderTemplates() {
+		psg_destroy_pool(pool);
+	}
+
+	/**
+	 * Returns the status line and Status header for the given HTTP version
+	 * and status code. Status lines for HTTP/1.0 and 1.1 with status codes
+	 * between 100 and 599 are interned; others are formatted into `reqPool`.
+	 */
+	StaticString getStatusLine(psg_pool_t *reqPool, unsigned int httpMajor,
+		unsigned int httpMinor, int statusCode)
+	{
+		if (httpMajor == 1 && httpMinor <= 1
+		 && statusCode >= MIN_STATUS_CODE && statusCode <= MAX_STATUS_CODE)
+		{
+			StaticString &result = statusLines[httpMinor][statusCode - MIN_STATUS_CODE];
+			if (OXT_UNLIKELY(result.empty())) {
+				result = formatStatusLine(pool, httpMajor, httpMinor, statusCode);
+			}
+			return result;
+		} else {
+			return formatStatusLine(reqPool, httpMajor, httpMinor, statusCode);
+		}
+	}
+
+	/**
+	 * Returns the Date header for the given time, including the trailing
+	 * CRLF. The result points to a buffer that is overwritten when the
+	 * time reaches the next second. The new contents always have the same
+	 * length, so iovecs that point to the buffer stay valid.
+	 */
+	StaticString getDateHeader(ev_tstamp now) {
+		time_t the_time = (time_t) now;
+		if (the_time != dateHeaderTime) {
+			char *pos = dateHeader;
+			const char *end = dateHeader + sizeof(dateHeader);
+			struct tm the_tm;
+
+			gmtime_r(&the_time, &the_tm);
+			pos = appendData(pos, end, "Date: ");
+			pos += strftime(pos, end - pos, "%a, %d %b %Y %H:%M:%S GMT", &the_tm);
+			pos = appendData(pos, end, "\r\n");
+			dateHeaderSize = pos - dateHeader;
+			dateHeaderTime = the_time;
+		}
+		return StaticString(dateHeader, dateHeaderSize);
+	}
+
+	/**
+	 * Returns the Connection header (if any), the X-Powered-By header and
+	 * the empty line that ends the response header.
+	 */
+	static StaticString getHeaderEnd(ConnectionHeader connection, bool showVersion) {
+		#ifdef PASSENGER_IS_ENTERPRISE
+			#define X_POWERED_BY_WITHOUT_VERSION \
+				"X-Powered-By: " PROGRAM_NAME " Enterprise\r\n\r\n"
+			#define X_POWERED_BY_WITH_VERSION \
+				"X-Powered-By: " PROGRAM_NAME " Enterprise " PASSENGER_VERSION "\r\n\r\n"
+		#else
+			#define X_POWERED_BY_WITHOUT_VERSION \
+				"X-Powered-By: " PROGRAM_NAME "\r\n\r\n"
+			#define X_POWERED_BY_WITH_VERSION \
+				"X-Powered-By: " PROGRAM_NAME " " PASSENGER_VERSION "\r\n\r\n"
+		#endif
+		#define RETURN_HEADER_END(connectionHeader) \
+			do { \
+				if (showVersion) { \
+					return P_STATIC_STRING(connectionHeader X_POWERED_BY_WITH_VERSION); \
+				} else { \
+					return P_STATIC_STRING(connectionHeader X_POWERED_BY_WITHOUT_VERSION); \
+				} \
+			} while (false)
+
+		switch (connection) {
+		case CONNECTION_KEEP_ALIVE:
+			RETURN_HEADER_END("Connection: keep-alive\r\n");
+		case CONNECTION_CLOSE:
+			RETURN_HEADER_END("Connection: close\r\n");
+		case CONNECTION_UPGRADE:
+			RETURN_HEADER_END("Connection: upgrade\r\n");
+		default:
+			RETURN_HEADER_END("");
+		}
+
+		#undef RETURN_HEADER_END
+		#undef X_POWERED_BY_WITH_VERSION
+		#undef X_POWERED_BY_WITHOUT_VERSION
+	}
+
+	static StaticString formatStatusLine(psg_pool_t *pool, unsigned int httpMajor,
+		unsigned int httpMinor, int statusCode)
+	{
+		const char *statusAndReason = getStatusCodeAndReasonPhrase(statusCode);
+		const unsigned int BUFSIZE = 128;
+		char *buf = (char *) psg_pnalloc(pool, BUFSIZE);
+		const char *end = buf + BUFSIZE;
+		char *pos = buf;
+
+		pos = appendData(pos, end, "HTTP/");
+		pos += uintToString(httpMajor, pos, end - pos);
+		pos = appendData(pos, end, ".");
+		pos += uintToString(httpMinor, pos, end - pos);
+		pos = appendData(pos, end, " ");
+		if (statusAndReason != NULL) {
+			pos = appendData(pos, end, statusAndReason);
+			pos = appendData(pos, end, "\r\nStatus: ");
+			pos = appendData(pos, end, statusAndReason);
+		} else {
+			char *code = pos;
+			pos += uintToString(statusCode, pos, end - pos);
+			unsigned int codeSize = pos - code;
+			pos = appendData(pos, end, " Unknown Reason-Phrase\r\nStatus: ");
+			pos = appendData(pos, end, code, codeSize);
+		}
+		pos = appendData(pos, end, "\r\n");
+		return StaticString(buf, pos - buf);
+	}
+};
+
+
+} // namespace Core
+} // namespace Passenger
+
+#endif /* _PASSENGER_CORE_CONTROLLER_RESPONSE_HEADER_TEMPLATES_H_ */
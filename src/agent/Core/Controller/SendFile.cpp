@@ -0,0 +1,533 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#include <Core/Controller.h>
+
+/*************************************************************************
+ *
+ * Implements Core::Controller methods pertaining serving the file that
+ * an application response's X-Sendfile or X-Accel-Redirect header
+ * refers to, instead of letting the web server do that. This only
+ * happens if a sendfile root is configured, and only for files inside
+ * that root.
+ *
+ *************************************************************************/
+
+namespace Passenger {
+namespace Core {
+
+using namespace std;
+using namespace boost;
+
+
+/****************************
+ *
+ * Private methods
+ *
+ ****************************/
+
+
+StaticString
+Controller::getSendfileRoot(Request *req) {
+	const LString *value = req->secureHeaders.lookup(PASSENGER_SENDFILE_ROOT);
+	if (value != NULL && value->size > 0) {
+		value = psg_lstr_make_contiguous(value, req->pool);
+		return StaticString(value->start->data, value->size);
+	} else {
+		return req->config->defaultSendfileRoot;
+	}
+}
+
+/**
+ * Looks up the file on the libuv thread pool, so that slow file systems
+ * don't block the event loop. The app session is no longer needed, so
+ * it is released right away.
+ */
+void
+Controller::beginSendingFile(Client *client, Request *req, const StaticString &root) {
+	TRACE_POINT();
+	AppResponse *resp = &req->appResponse;
+	FileToSend *file = new FileToSend();
+	const LString *value;
+	int ret;
+
+	file->work.data = file;
+	file->req = req;
+	file->root.assign(root.data(), root.size());
+	file->fd = -1;
+	file->errcode = 0;
+	file->outsideRoot = false;
+	file->size = 0;
+
+	value = resp->headers.lookup(ServerKit::HTTP_X_SENDFILE);
+	if (value != NULL) {
+		value = psg_lstr_make_contiguous(value, req->pool);
+		file->path.assign(value->start->data, value->size);
+		if (!startsWith(file->path, "/")) {
+			file->path = file->root + "/" + file->path;
+		}
+	} else {
+		// X-Accel-Redirect contains a URI, which is mapped to
+		// a path inside the sendfile root.
+		value = resp->headers.lookup(ServerKit::HTTP_X_ACCEL_REDIRECT);
+		value = psg_lstr_make_contiguous(value, req->pool);
+		StaticString uri(value->start->data, value->size);
+		string::size_type pos = uri.find('?');
+		if (pos != string::npos) {
+			uri = uri.substr(0, pos);
+		}
+		file->path = file->root + "/" + urldecode(uri);
+	}
+	resp->headers.erase(ServerKit::HTTP_X_SENDFILE);
+	resp->headers.erase(ServerKit::HTTP_X_ACCEL_REDIRECT);
+
+	SKC_DEBUG(client, "Sending file on behalf of the application: " << file->path);
+	handleAppResponseBodyEnd(client, req);
+
+	UPDATE_TRACE_POINT();
+	refRequest(req, __FILE__, __LINE__);
+	ret = uv_queue_work(getContext()->libuv, &file->work, lookUpFileToSend,
+		_onFileToSendLookedUp);
+	if (OXT_UNLIKELY(ret != 0)) {
+		unrefRequest(req, __FILE__, __LINE__);
+		file->errcode = -ret;
+		endRequestWithFileToSendError(&client, &req, file);
+		delete file;
+	}
+}
+
+/**
+ * Runs on the libuv thread pool. Resolves symlinks so that a file is only
+ * sent if it's really inside the sendfile root.
+ */
+void
+Controller::lookUpFileToSend(uv_work_t *work) {
+	FileToSend *file = static_cast<FileToSend *>(work->data);
+	char *realRoot, *realPath;
+	size_t rootLen;
+	struct stat buf;
+
+	realRoot = realpath(file->root.c_str(), NULL);
+	if (realRoot == NULL) {
+		file->errcode = errno;
+		return;
+	}
+	realPath = realpath(file->path.c_str(), NULL);
+	if (realPath == NULL) {
+		file->errcode = errno;
+		free(realRoot);
+		return;
+	}
+
+	rootLen = strlen(realRoot);
+	if (strncmp(realPath, realRoot, rootLen) != 0
+	 || (rootLen > 1 && realPath[rootLen] != '/'))
+	{
+		file->outsideRoot = true;
+		file->errcode = EACCES;
+		free(realRoot);
+		free(realPath);
+		return;
+	}
+
+	file->fd = open(realPath, O_RDONLY | O_NOFOLLOW);
+	if (file->fd == -1) {
+		file->errcode = errno;
+	} else if (fstat(file->fd, &buf) == -1) {
+		file->errcode = errno;
+	} else if (!S_ISREG(buf.st_mode)) {
+		file->errcode = EISDIR;
+	} else {
+		file->size = buf.st_size;
+	}
+	if (file->errcode != 0 && file->fd != -1) {
+		close(file->fd);
+		file->fd = -1;
+	}
+
+	free(realRoot);
+	free(realPath);
+}
+
+void
+Controller::_onFileToSendLookedUp(uv_work_t *work, int status) {
+	FileToSend *file = static_cast<FileToSend *>(work->data);
+	Request *req = file->req;
+	Client *client = static_cast<Client *>(req->client);
+	Controller *self = static_cast<Controller *>(getServerFromClient(client));
+
+	SKC_LOG_EVENT_FROM_STATIC(self, Controller, client, "onFileToSendLookedUp");
+	if (status != 0 && file->errcode == 0) {
+		file->errcode = -status;
+	}
+	self->onFileToSendLookedUp(client, req, file);
+	self->unrefRequest(req, __FILE__, __LINE__);
+	delete file;
+}
+
+void
+Controller::onFileToSendLookedUp(Client *client, Request *req, FileToSend *file) {
+	if (req->ended()) {
+		if (file->fd != -1) {
+			safelyClose(file->fd, true);
+		}
+		return;
+	}
+
+	TRACE_POINT();
+	if (file->errcode != 0) {
+		endRequestWithFileToSendError(&client, &req, file);
+		return;
+	}
+
+	// From now on, deinitializeRequest() closes the file.
+	req->sendfileFd = file->fd;
+	prepareFileResponseHeader(client, req, file->size);
+	sendResponseHeader(client, req);
+	if (req->ended()) {
+		return;
+	}
+
+	UPDATE_TRACE_POINT();
+	if (req->method == HTTP_HEAD || req->sendfileOffset == req->sendfileEnd) {
+		endSendingFile(client, req);
+	} else {
+		sendFileToClient(client, req);
+	}
+}
+
+void
+Controller::endRequestWithFileToSendError(Client **client, Request **req,
+	const FileToSend *file)
+{
+	int e = file->errcode;
+
+	if (file->outsideRoot) {
+		SKC_WARN(*client, "Refusing to send file " << file->path <<
+			" on behalf of the application: it is not inside the sendfile root "
+			<< file->root);
+		endRequestWithSimpleResponse(client, req, "<h2>Forbidden</h2>", 403);
+		return;
+	}
+
+	SKC_WARN(*client, "Cannot send file " << file->path <<
+		" on behalf of the application: " << ServerKit::getErrorDesc(e) <<
+		" (errno=" << e << ")");
+	switch (e) {
+	case ENOENT:
+	case ENOTDIR:
+	case ENAMETOOLONG:
+		endRequestWithSimpleResponse(client, req, "<h2>Not Found</h2>", 404);
+		break;
+	case EACCES:
+	case EPERM:
+	case ELOOP:
+	case EISDIR:
+		endRequestWithSimpleResponse(client, req, "<h2>Forbidden</h2>", 403);
+		break;
+	default:
+		endRequestWithSimpleResponse(client, req,
+			"<h2>Internal Server Error</h2>", 500);
+		break;
+	}
+}
+
+static bool
+parseBytePosition(const StaticString &str, boost::uint64_t &result) {
+	// 19 digits always fit in 64 bits.
+	if (str.empty() || str.size() > 19) {
+		return false;
+	}
+	for (string::size_type i = 0; i < str.size(); i++) {
+		if (str[i] < '0' || str[i] > '9') {
+			return false;
+		}
+	}
+	result = stringToULL(str);
+	return true;
+}
+
+/**
+ * Parses a single byte range from the Range request header. Requests for
+ * multiple ranges, syntactically invalid ranges and conditional range
+ * requests are answered with the entire file.
+ *
+ * @post If the result is RANGE_SATISFIABLE: start < end <= size.
+ */
+Controller::RangeParseResult
+Controller::parseRequestedRange(Request *req, boost::uint64_t size,
+	boost::uint64_t &start, boost::uint64_t &end)
+{
+	const LString *value;
+	string::size_type pos;
+	boost::uint64_t first, last;
+
+	if (req->method != HTTP_GET
+	 || req->headers.lookup(HTTP_IF_RANGE) != NULL)
+	{
+		return RANGE_NONE;
+	}
+	value = req->headers.lookup(HTTP_RANGE);
+	if (value == NULL) {
+		return RANGE_NONE;
+	}
+
+	value = psg_lstr_make_contiguous(value, req->pool);
+	StaticString spec(value->start->data, value->size);
+	if (!startsWith(spec, "bytes=")) {
+		return RANGE_NONE;
+	}
+	spec = spec.substr(sizeof("bytes=") - 1);
+	pos = spec.find('-');
+	if (pos == string::npos || spec.find(',') != string::npos) {
+		return RANGE_NONE;
+	}
+
+	if (pos == 0) {
+		// bytes=-N: the last N bytes.
+		if (!parseBytePosition(spec.substr(1), last)) {
+			return RANGE_NONE;
+		} else if (last == 0 || size == 0) {
+			return RANGE_UNSATISFIABLE;
+		}
+		start = size - std::min(last, size);
+		end = size;
+		return RANGE_SATISFIABLE;
+	}
+
+	if (!parseBytePosition(spec.substr(0, pos), first)) {
+		return RANGE_NONE;
+	}
+	if (pos == spec.size() - 1) {
+		// bytes=N-: everything from byte N.
+		last = size;
+	} else if (!parseBytePosition(spec.substr(pos + 1), last) || last < first) {
+		return RANGE_NONE;
+	} else {
+		last = std::min(last + 1, size);
+	}
+	if (first >= size) {
+		return RANGE_UNSATISFIABLE;
+	}
+	start = first;
+	end = last;
+	return RANGE_SATISFIABLE;
+}
+
+/**
+ * Turns the app response header into one that describes the file
+ * (or the requested part of it), and determines which bytes to send.
+ */
+void
+Controller::prepareFileResponseHeader(Client *client, Request *req,
+	boost::uint64_t size)
+{
+	AppResponse *resp = &req->appResponse;
+	boost::uint64_t start = 0, end = size;
+	const unsigned int BUFSIZE = 64;
+	char *buf;
+	int len;
+
+	if (resp->statusCode == 200) {
+		switch (parseRequestedRange(req, size, start, end)) {
+		case RANGE_SATISFIABLE:
+			SKC_TRACE(client, 2, "Sending bytes " << start << "-" << (end - 1) <<
+				" of " << size);
+			buf = (char *) psg_pnalloc(req->pool, BUFSIZE);
+			len = snprintf(buf, BUFSIZE, "bytes %llu-%llu/%llu",
+				(unsigned long long) start, (unsigned long long) end - 1,
+				(unsigned long long) size);
+			resp->statusCode = 206;
+			resp->headers.insert(req->pool, "Content-Range", StaticString(buf, len));
+			break;
+		case RANGE_UNSATISFIABLE:
+			SKC_TRACE(client, 2, "Requested range not satisfiable");
+			buf = (char *) psg_pnalloc(req->pool, BUFSIZE);
+			len = snprintf(buf, BUFSIZE, "bytes */%llu", (unsigned long long) size);
+			resp->statusCode = 416;
+			resp->headers.insert(req->pool, "Content-Range", StaticString(buf, len));
+			start = end = 0;
+			break;
+		default:
+			break;
+		}
+	}
+	if (resp->headers.lookup(HTTP_ACCEPT_RANGES) == NULL) {
+		resp->headers.insert(req->pool, "Accept-Ranges", "bytes");
+	}
+
+	resp->bodyType = AppResponse::RBT_CONTENT_LENGTH;
+	resp->aux.bodyInfo.contentLength = end - start;
+	req->sendfileOffset = start;
+	req->sendfileEnd = end;
+}
+
+void
+Controller::_onClientSocketWritableForSendfile(EV_P_ struct ev_io *io, int revents) {
+	Request *req = static_cast<Request *>(io->data);
+	Client *client = static_cast<Client *>(req->client);
+	Controller *self = static_cast<Controller *>(getServerFromClient(client));
+	ServerKit::RefGuard guard(&req->hooks, req, __FILE__, __LINE__);
+
+	SKC_LOG_EVENT_FROM_STATIC(self, Controller, client, "onClientSocketWritableForSendfile");
+	ev_io_stop(self->getLoop(), io);
+	self->sendFileToClient(client, req);
+}
+
+/**
+ * Sends the file to the client socket with sendfile(). Data that is still
+ * buffered in the client output channel must be sent first, so until that
+ * channel is flushed, file data is copied into it instead.
+ */
+void
+Controller::sendFileToClient(Client *client, Request *req) {
+	TRACE_POINT();
+	unsigned int i;
+	size_t size;
+
+	for (i = 0; i < SENDFILE_BURST_COUNT && req->sendfileOffset < req->sendfileEnd; i++) {
+		size = (size_t) std::min<boost::uint64_t>(MAX_SENDFILE_SIZE,
+			req->sendfileEnd - req->sendfileOffset);
+
+		if (!client->output.isFlushed()) {
+			if (client->output.passedThreshold()) {
+				waitToSendMoreOfFile(client, req);
+				return;
+			} else if (!copyFileToClientOutput(client, req, size)) {
+				return;
+			}
+			continue;
+		}
+
+		#ifdef __linux__
+			off_t offset = req->sendfileOffset;
+			ssize_t ret;
+			int e;
+
+			do {
+				ret = sendfile(client->getFd(), req->sendfileFd, &offset, size);
+			} while (OXT_UNLIKELY(ret == -1 && errno == EINTR));
+
+			if (ret == -1) {
+				e = errno;
+				if (e == EAGAIN || e == EWOULDBLOCK) {
+					waitToSendMoreOfFile(client, req);
+					return;
+				} else if (e == EINVAL || e == ENOSYS) {
+					// The file does not support sendfile().
+					if (!copyFileToClientOutput(client, req, size)) {
+						return;
+					}
+					continue;
+				} else {
+					UPDATE_TRACE_POINT();
+					disconnectWithClientSocketWriteError(&client, e);
+					return;
+				}
+			} else if (ret == 0) {
+				UPDATE_TRACE_POINT();
+				disconnectWithError(&client, "the file being sent was truncated");
+				return;
+			}
+
+			req->sendfileOffset += ret;
+			req->lastDataSendTime = ev_now(getLoop());
+			fileBytesSent += ret;
+		#else
+			if (!copyFileToClientOutput(client, req, size)) {
+				return;
+			}
+		#endif
+	}
+
+	UPDATE_TRACE_POINT();
+	if (req->sendfileOffset == req->sendfileEnd) {
+		endSendingFile(client, req);
+	} else {
+		waitToSendMoreOfFile(client, req);
+	}
+}
+
+bool
+Controller::copyFileToClientOutput(Client *client, Request *req, size_t size) {
+	MemoryKit::mbuf buffer(MemoryKit::mbuf_get_with_size(&getContext()->mbuf_pool, size));
+	ssize_t ret;
+	int e;
+
+	if (OXT_UNLIKELY(buffer.is_null())) {
+		e = ENOMEM;
+		goto error;
+	}
+
+	do {
+		ret = pread(req->sendfileFd, buffer.start, size, req->sendfileOffset);
+	} while (OXT_UNLIKELY(ret == -1 && errno == EINTR));
+	if (ret == -1) {
+		e = errno;
+		goto error;
+	} else if (ret == 0) {
+		disconnectWithError(&client, "the file being sent was truncated");
+		return false;
+	}
+
+	req->sendfileOffset += ret;
+	fileBytesSent += ret;
+	writeResponse(client, MemoryKit::mbuf(buffer, 0, ret));
+	return !req->ended();
+
+	error:
+	{
+		string message = "cannot read from the file being sent: ";
+		message.append(ServerKit::getErrorDesc(e));
+		message.append(" (errno=" + toString(e) + ")");
+		disconnectWithError(&client, message);
+		return false;
+	}
+}
+
+void
+Controller::waitToSendMoreOfFile(Client *client, Request *req) {
+	if (client->output.isFlushed()) {
+		ev_io_set(&req->sendfileWatcher, client->getFd(), EV_WRITE);
+		ev_io_start(getLoop(), &req->sendfileWatcher);
+	} else {
+		SKC_TRACE(client, 2, "Waiting until buffered response data has been sent "
+			"before sending more of the file");
+		client->output.setDataFlushedCallback(_outputDataFlushed);
+	}
+}
+
+void
+Controller::endSendingFile(Client *client, Request *req) {
+	SKC_TRACE(client, 2, "Done sending file");
+	filesSent++;
+	safelyClose(req->sendfileFd, true);
+	req->sendfileFd = -1;
+	endRequest(&client, &req);
+}
+
+
+} // namespace Core
+} // namespace Passenger
@@ -323,10 +323,10 @@ Controller::determineHeaderSizeForSessionProtocol(Request *req,
 	unsigned int dataSize = sizeof(boost::uint32_t);
 
 	state.path        = req->getPathWithoutQueryString();
-	state.hasBaseURI  = req->options.baseURI != P_STATIC_STRING("/")
-		&& startsWith(state.path, req->options.baseURI);
+	state.hasBaseURI  = req->options->baseURI != P_STATIC_STRING("/")
+		&& startsWith(state.path, req->options->baseURI);
 	if (state.hasBaseURI) {
-		state.path = state.path.substr(req->options.baseURI.size());
+		state.path = state.path.substr(req->options->baseURI.size());
 		if (state.path.empty()) {
 			state.path = P_STATIC_STRING("/");
 		}
@@ -366,7 +366,7 @@ Controller::determineHeaderSizeForSessionProtocol(Request *req,
 
 	dataSize += sizeof("SCRIPT_NAME");
 	if (state.hasBaseURI) {
-		dataSize += req->options.baseURI.size();
+		dataSize += req->options->baseURI.size();
 	} else {
 		dataSize += sizeof("");
 	}
@@ -446,9 +446,9 @@ Controller::determineHeaderSizeForSessionProtocol(Request *req,
 		dataSize += sizeof("on");
 	}
 
-	if (req->options.analytics) {
+	if (req->requestOptions.analytics) {
 		dataSize += sizeof("PASSENGER_TXN_ID");
-		dataSize += req->options.transaction->getTxnId().size() + 1;
+		dataSize += req->requestOptions.transaction->getTxnId().size() + 1;
 
 		dataSize += sizeof("PASSENGER_DELTA_MONOTONIC");
 		dataSize += delta_monotonic.size() + 1;
@@ -492,7 +492,7 @@ Controller::constructHeaderForSessionProtocol(Request *req, char * restrict buff
 
 	pos = appendData(pos, end, P_STATIC_STRING_WITH_NULL("SCRIPT_NAME"));
 	if (state.hasBaseURI) {
-		pos = appendData(pos, end, req->options.baseURI);
+		pos = appendData(pos, end, req->options->baseURI);
 		pos = appendData(pos, end, "", 1);
 	} else {
 		pos = appendData(pos, end, P_STATIC_STRING_WITH_NULL(""));
@@ -564,9 +564,9 @@ Controller::constructHeaderForSessionProtocol(Request *req, char * restrict buff
 		pos = appendData(pos, end, P_STATIC_STRING_WITH_NULL("on"));
 	}
 
-	if (req->options.analytics) {
+	if (req->requestOptions.analytics) {
 		pos = appendData(pos, end, P_STATIC_STRING_WITH_NULL("PASSENGER_TXN_ID"));
-		pos = appendData(pos, end, req->options.transaction->getTxnId());
+		pos = appendData(pos, end, req->requestOptions.transaction->getTxnId());
 		pos = appendData(pos, end, "", 1);
 
 		pos = appendData(pos, end, P_STATIC_STRING_WITH_NULL("PASSENGER_DELTA_MONOTONIC"));
@@ -583,17 +583,24 @@ Controller::constructHeaderForSessionProtocol(Request *req, char * restrict buff
 	while (*it != NULL) {
 		// This header-skipping is not accounted for in determineHeaderSizeForSessionProtocol(), but
 		// since we are only reducing the size it just wastes some mem bytes.
-		if ((
-				(it->header->hash == HTTP_CONTENT_LENGTH.hash()
-						|| it->header->hash == HTTP_CONTENT_TYPE.hash()
-						|| it->header->hash == HTTP_CONNECTION.hash()
-				) && (psg_lstr_cmp(&it->header->key, P_STATIC_STRING("content-type"))
-						|| psg_lstr_cmp(&it->header->key, P_STATIC_STRING("content-length"))
-						|| psg_lstr_cmp(&it->header->key, P_STATIC_STRING("connection"))
-				)
-			) || containsNonAlphaNumDash(it->header->key)
-		   )
-		{
+		// Well-known header names other than Passenger's secure headers
+		// consist of alphanumerical characters and dashes only, so only
+		// unknown names need to be checked.
+		bool skip;
+		switch (it->header->id) {
+		case ServerKit::HTTP_HEADER_CONTENT_LENGTH:
+		case ServerKit::HTTP_HEADER_CONTENT_TYPE:
+		case ServerKit::HTTP_HEADER_CONNECTION:
+			skip = true;
+			break;
+		case ServerKit::HTTP_HEADER_UNKNOWN:
+			skip = containsNonAlphaNumDash(it->header->key);
+			break;
+		default:
+			skip = ServerKit::isSecureHttpHeaderId(it->header->id);
+			break;
+		}
+		if (skip) {
 			it.next();
 			continue;
 		}
@@ -772,10 +779,8 @@ Controller::constructHeaderBuffersForHttpProtocol(Request *req, struct iovec *bu
 	}
 
 	while (*it != NULL) {
-		if ((it->header->hash == HTTP_CONNECTION.hash()
-		  || it->header->hash == ServerKit::HTTP_SET_COOKIE.hash())
-		 && (psg_lstr_cmp(&it->header->key, P_STATIC_STRING("connection"))
-		  || psg_lstr_cmp(&it->header->key, ServerKit::HTTP_SET_COOKIE)))
+		if (it->header->id == ServerKit::HTTP_HEADER_CONNECTION
+		 || it->header->id == ServerKit::HTTP_HEADER_SET_COOKIE)
 		{
 			it.next();
 			continue;
@@ -863,16 +868,16 @@ Controller::constructHeaderBuffersForHttpProtocol(Request *req, struct iovec *bu
 		PUSH_STATIC_BUFFER("\r\n");
 	}
 
-	if (req->options.analytics) {
+	if (req->requestOptions.analytics) {
 		PUSH_STATIC_BUFFER("!~Passenger-Txn-Id: ");
 
 		if (buffers != NULL) {
 			BEGIN_PUSH_NEXT_BUFFER();
-			buffers[i].iov_base = (void *) req->options.transaction->getTxnId().data();
-			buffers[i].iov_len  = req->options.transaction->getTxnId().size();
+			buffers[i].iov_base = (void *) req->requestOptions.transaction->getTxnId().data();
+			buffers[i].iov_len  = req->requestOptions.transaction->getTxnId().size();
 		}
 		INC_BUFFER_ITER(i);
-		dataSize += req->options.transaction->getTxnId().size();
+		dataSize += req->requestOptions.transaction->getTxnId().size();
 
 		PUSH_STATIC_BUFFER("\r\n");
 	}
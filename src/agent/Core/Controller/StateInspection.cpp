@@ -54,14 +54,60 @@ Controller::getThreadNumber() const {
 Json::Value
 Controller::inspectStateAsJson() const {
 	Json::Value doc = ParentClass::inspectStateAsJson();
-	if (turboCaching.isEnabled()) {
+	Json::Value responseBodies;
+	responseBodies["bytes_spliced"] = byteSizeToJson(responseBodyBytesSpliced);
+	responseBodies["bytes_copied"] = byteSizeToJson(responseBodyBytesCopied);
+	doc["response_bodies"] = responseBodies;
+	Json::Value sendfile;
+	sendfile["files_sent"] = (Json::UInt64) filesSent;
+	sendfile["bytes_sent"] = byteSizeToJson(fileBytesSent);
+	doc["sendfile"] = sendfile;
+	if (turboCaching.getState() != TurboCaching<Request>::DISABLED) {
 		Json::Value subdoc;
+		subdoc["state"] = turboCaching.getStateString();
+		subdoc["last_state_change"] = timeToJson(turboCaching.getLastStateChange() * 1000000.0);
+		subdoc["disabled_due_to_hit_ratio"] = turboCaching.getDisablesDueToHitRatio();
+		subdoc["disabled_due_to_store_success_ratio"] =
+			turboCaching.getDisablesDueToStoreSuccessRatio();
+		subdoc["reenabled"] = turboCaching.getReenables();
+		subdoc["fetch_threshold"] = turboCaching.getFetchThreshold();
+		subdoc["min_hit_ratio"] = turboCaching.getMinHitRatio();
 		subdoc["fetches"] = turboCaching.responseCache.getFetches();
 		subdoc["hits"] = turboCaching.responseCache.getHits();
 		subdoc["hit_ratio"] = turboCaching.responseCache.getHitRatio();
 		subdoc["stores"] = turboCaching.responseCache.getStores();
 		subdoc["store_successes"] = turboCaching.responseCache.getStoreSuccesses();
 		subdoc["store_success_ratio"] = turboCaching.responseCache.getStoreSuccessRatio();
+		subdoc["entries"] = turboCaching.responseCache.getEntryCount();
+		subdoc["memory_usage"] = (Json::UInt64) turboCaching.responseCache.getMemoryUsage();
+		subdoc["max_memory"] = (Json::UInt64) turboCaching.responseCache.getMaxMemory();
+		subdoc["evictions"] = turboCaching.responseCache.getEvictions();
+		subdoc["expirations"] = turboCaching.responseCache.getExpirations();
+		subdoc["in_flight_fetches"] = turboCaching.getInFlightFetchCount();
+		subdoc["coalesced_requests"] = turboCaching.getCoalescedRequests();
+		subdoc["stale_hits"] = turboCaching.responseCache.getStaleHits();
+		subdoc["stale_while_revalidate_responses"] = turboCaching.getStaleResponses();
+		subdoc["stale_if_error_responses"] = turboCaching.getStaleIfErrorResponses();
+		subdoc["not_modified_responses"] = turboCaching.getNotModifiedResponses();
+		subdoc["revalidations"] = turboCaching.getRevalidations();
+		if (turboCaching.isCompressionEnabled()) {
+			subdoc["compressions"] = turboCaching.getCompressions();
+			subdoc["compressed_responses"] = turboCaching.getCompressedResponses();
+		}
+		SharedResponseCache *sharedCache = turboCaching.responseCache.getSharedCache();
+		if (sharedCache != NULL) {
+			Json::Value shared;
+			shared["fetches"] = turboCaching.responseCache.getSharedFetches();
+			shared["hits"] = turboCaching.responseCache.getSharedHits();
+			shared["hit_ratio"] = turboCaching.responseCache.getSharedHitRatio();
+			shared["combined_hit_ratio"] = turboCaching.responseCache.getCombinedHitRatio();
+			shared["entries"] = sharedCache->getEntryCount();
+			shared["memory_usage"] = (Json::UInt64) sharedCache->getMemoryUsage();
+			shared["max_memory"] = (Json::UInt64) sharedCache->getMaxMemory();
+			shared["stores"] = sharedCache->getStores();
+			shared["evictions"] = sharedCache->getEvictions();
+			subdoc["shared"] = shared;
+		}
 		doc["turbocaching"] = subdoc;
 	}
 	return doc;
@@ -85,7 +131,7 @@ Controller::inspectRequestStateAsJson(const Request *req) const {
 	}
 	doc["state"] = req->getStateString();
 	if (req->stickySession) {
-		doc["sticky_session_id"] = req->options.stickySessionId;
+		doc["sticky_session_id"] = req->requestOptions.stickySessionId;
 	}
 	doc["sticky_session"] = req->stickySession;
 	doc["session_checkout_try"] = req->sessionCheckoutTry;
@@ -30,13 +30,16 @@
 #include <ev++.h>
 #include <ctime>
 #include <cstddef>
+#include <cstring>
 #include <cassert>
+#include <boost/container/vector.hpp>
 #include <MemoryKit/mbuf.h>
 #include <ServerKit/Context.h>
 #include <Constants.h>
 #include <LoggingKit/LoggingKit.h>
 #include <Utils/StrIntUtils.h>
 #include <Core/ResponseCache.h>
+#include <Core/ResponseCompressor.h>
 
 namespace Passenger {
 namespace Core {
@@ -45,6 +48,27 @@ namespace Core {
 using namespace std;
 
 
+/**
+ * Besides managing the response cache's state, this class coalesces requests
+ * for expired entries. When a request finds an entry that has expired, it
+ * becomes the *leader* for that cache key and is forwarded to the app, while
+ * subsequent requests for the same key either get the stale entry (if the
+ * response allowed `stale-while-revalidate`) or wait for the leader to finish.
+ * This prevents a thundering herd of identical requests from reaching the app
+ * whenever a popular entry expires. Waiting requests are linked through
+ * `Request::nextTurboCacheWaiter`; the controller resumes them after the
+ * leader has ended.
+ *
+ * Conditional requests are answered with 304 Not Modified straight from the
+ * cache if they match the entry's validators. Conversely, if an expired
+ * entry has validators, then the leader revalidates it with a conditional
+ * request, so that the app can respond with 304 Not Modified instead of
+ * generating the whole response again.
+ *
+ * If compression is enabled, the bodies of stored entries with a textual
+ * content type are gzip-compressed by a ResponseCompressor in the background,
+ * and the compressed variant is served to clients that accept it.
+ */
 template<typename Request>
 class TurboCaching {
 public:
@@ -53,12 +77,15 @@ public:
 	/** The interval of the timer while we're in the TEMPORARILY_DISABLED state. */
 	static const unsigned int TEMPORARY_DISABLE_TIMEOUT = 10;
 	/** Only consider temporarily disabling turbocaching if the number of
-	 * fetches/stores in the current interval have reached these thresholds.
+	 * stores in the current interval has reached this threshold. The
+	 * threshold for the number of fetches is configurable.
 	 */
-	static const unsigned int FETCH_THRESHOLD = 20;
 	static const unsigned int STORE_THRESHOLD = 20;
+	/** The number of cache slots that updateState() examines for expired
+	 * entries per event loop iteration.
+	 */
+	static const unsigned int EXPIRY_SWEEP_SIZE = 16;
 
-	OXT_FORCE_INLINE static double MIN_HIT_RATIO() { return 0.5; }
 	OXT_FORCE_INLINE static double MIN_STORE_SUCCESS_RATIO() { return 0.5; }
 
 	enum State {
@@ -83,8 +110,42 @@ public:
 	typedef typename ResponseCache<Request>::Entry ResponseCacheEntryType;
 
 private:
+	struct InFlightFetch {
+		// Points into the leader's memory pool, so it's valid until the
+		// leader is deinitialized, which ends the fetch.
+		HashedStaticString cacheKey;
+		Request *leader;
+		Request *firstWaiter;
+		Request *lastWaiter;
+	};
+
 	State state;
 	ev_tstamp lastTimeout, nextTimeout;
+	/** Only consider temporarily disabling turbocaching if the number of
+	 * fetches in the current interval has reached this threshold, and the
+	 * hit ratio is below `minHitRatio`.
+	 */
+	unsigned int fetchThreshold;
+	double minHitRatio;
+	// Counters of state transitions, for monitoring.
+	ev_tstamp lastStateChange;
+	unsigned int disablesDueToHitRatio;
+	unsigned int disablesDueToStoreSuccessRatio;
+	unsigned int reenables;
+	// Usually very small, so a linear search is the fastest way to find a
+	// fetch. Keys are also only valid for as long as their leader lives,
+	// which makes them unsuitable for a hash table that retains keys.
+	boost::container::vector<InFlightFetch> inFlightFetches;
+	unsigned int coalescedRequests;
+	unsigned int staleResponses;
+	unsigned int staleIfErrorResponses;
+	unsigned int notModifiedResponses;
+	unsigned int revalidations;
+	bool compression;
+	ResponseCompressor compressor;
+	boost::container::vector<ResponseCompressor::Job> compressorResults;
+	unsigned int compressions;
+	unsigned int compressedResponses;
 
 	struct ResponsePreparation {
 		Request *req;
@@ -95,14 +156,34 @@ private:
 		unsigned int ageValueSize;
 		unsigned int contentLengthStrSize;
 		bool showVersionInHeader;
+		bool stale;
+		bool notModified;
+		bool hasCompressedBody;
+		// Whether to serve the compressed body.
+		bool gzip;
+		// If non-empty, replaces the value of the entry's ETag header.
+		StaticString gzipEntityTag;
+		const char *bodyData;
+		unsigned int bodySize;
 	};
 
 	template<typename Server>
 	void prepareResponseHeader(ResponsePreparation &prep, Server *server,
-		Request *req, const ResponseCacheEntryType &entry)
+		Request *req, const ResponseCacheEntryType &entry, bool notModified)
 	{
 		prep.req   = req;
 		prep.entry = &entry;
+		prep.notModified = notModified;
+		prep.hasCompressedBody = entry.body->gzipBodyData != NULL;
+		prep.gzip  = responseCache.requestGetsCompressedBody(req, entry);
+		if (prep.gzip) {
+			prep.bodyData = entry.body->gzipBodyData;
+			prep.bodySize = entry.body->gzipBodySize;
+			prep.gzipEntityTag = responseCache.getEntityTag(req, entry, true);
+		} else {
+			prep.bodyData = entry.body->httpBodyData;
+			prep.bodySize = entry.body->httpBodySize;
+		}
 		prep.now   = (time_t) ev_now(server->getLoop());
 
 		if (prep.now >= entry.header->date) {
@@ -112,8 +193,116 @@ private:
 		}
 
 		prep.ageValueSize = integerSizeInOtherBase<time_t, 10>(prep.age);
-		prep.contentLengthStrSize = uintSizeAsString(entry.body->httpBodySize);
+		prep.contentLengthStrSize = uintSizeAsString(prep.bodySize);
 		prep.showVersionInHeader = req->config->showVersionInHeader;
+		prep.stale = prep.now >= entry.body->expiryDate;
+	}
+
+	/**
+	 * Builds the given header line of the entry. The ETag header of the gzip
+	 * variant is replaced by that variant's own entity tag.
+	 */
+	unsigned int buildEntryHeaderLine(const ResponsePreparation &prep, char *&pos,
+		const char *end, bool write, const char *lineStart, const char *lineEnd)
+	{
+		static const StaticString etagName = P_STATIC_STRING("etag");
+
+		if (!prep.gzipEntityTag.empty()
+		 && ResponseCacheType::headerLineHasName(lineStart, lineEnd, &etagName, 1))
+		{
+			if (write) {
+				pos = appendData(pos, end, "ETag: ", sizeof("ETag: ") - 1);
+				pos = appendData(pos, end, prep.gzipEntityTag);
+				pos = appendData(pos, end, "\r\n", 2);
+			}
+			return sizeof("ETag: \r\n") - 1 + prep.gzipEntityTag.size();
+		} else {
+			if (write) {
+				pos = appendData(pos, end, lineStart, lineEnd + 1 - lineStart);
+			}
+			return lineEnd + 1 - lineStart;
+		}
+	}
+
+	/**
+	 * Builds the entry's header data, which consists of the status line and
+	 * the headers as the app sent them.
+	 */
+	unsigned int buildEntryHeader(const ResponsePreparation &prep, char *&pos,
+		const char *end, bool write)
+	{
+		const char *data = prep.entry->body->httpHeaderData;
+		const char *dataEnd = data + prep.entry->body->httpHeaderSize;
+
+		if (prep.gzipEntityTag.empty()) {
+			if (write) {
+				pos = appendData(pos, end, data, dataEnd - data);
+			}
+			return dataEnd - data;
+		}
+
+		unsigned int result = 0;
+		const char *lineStart = data;
+		const char *lineEnd;
+		while ((lineEnd = (const char *) memchr(lineStart, '\n', dataEnd - lineStart)) != NULL) {
+			result += buildEntryHeaderLine(prep, pos, end, write, lineStart, lineEnd);
+			lineStart = lineEnd + 1;
+		}
+		if (write) {
+			pos = appendData(pos, end, lineStart, dataEnd - lineStart);
+		}
+		return result + (dataEnd - lineStart);
+	}
+
+	/**
+	 * Builds the status line of a 304 response, followed by those of the
+	 * entry's headers that a 304 response must contain (RFC 7232 section 4.1).
+	 * Vary is not among them because responses with Vary are not cached.
+	 */
+	unsigned int buildNotModifiedHeader(const ResponsePreparation &prep, char *&pos,
+		const char *end, bool write)
+	{
+		static const StaticString names[] = {
+			P_STATIC_STRING("cache-control"),
+			P_STATIC_STRING("content-location"),
+			P_STATIC_STRING("date"),
+			P_STATIC_STRING("etag"),
+			P_STATIC_STRING("expires"),
+			P_STATIC_STRING("last-modified")
+		};
+		const char *data = prep.entry->body->httpHeaderData;
+		const char *dataEnd = data + prep.entry->body->httpHeaderSize;
+		char version[16];
+		unsigned int versionSize, result = 0;
+
+		versionSize = uintToString(prep.req->httpMajor, version, sizeof(version));
+		version[versionSize++] = '.';
+		versionSize += uintToString(prep.req->httpMinor, version + versionSize,
+			sizeof(version) - versionSize);
+
+		result += sizeof("HTTP/") - 1 + versionSize
+			+ sizeof(" 304 Not Modified\r\nStatus: 304 Not Modified\r\n") - 1;
+		if (write) {
+			pos = appendData(pos, end, "HTTP/", sizeof("HTTP/") - 1);
+			pos = appendData(pos, end, version, versionSize);
+			pos = appendData(pos, end,
+				" 304 Not Modified\r\nStatus: 304 Not Modified\r\n",
+				sizeof(" 304 Not Modified\r\nStatus: 304 Not Modified\r\n") - 1);
+		}
+
+		// Skip the status line.
+		const char *lineEnd = (const char *) memchr(data, '\n', dataEnd - data);
+		while (lineEnd != NULL) {
+			const char *lineStart = lineEnd + 1;
+			lineEnd = (const char *) memchr(lineStart, '\n', dataEnd - lineStart);
+			if (lineEnd != NULL && ResponseCacheType::headerLineHasName(lineStart,
+				lineEnd, names, sizeof(names) / sizeof(StaticString)))
+			{
+				result += buildEntryHeaderLine(prep, pos, end, write, lineStart, lineEnd);
+			}
+		}
+
+		return result;
 	}
 
 	template<typename Server>
@@ -128,7 +317,6 @@ private:
 				} \
 			} while (false)
 
-		const ResponseCacheEntryType *entry = prep.entry;
 		Request *req = prep.req;
 
 		unsigned int httpVersion = req->httpMajor * 1000 + req->httpMinor * 10;
@@ -136,19 +324,29 @@ private:
 		char *pos = output;
 		const char *end = output + outputSize;
 
-		result += entry->body->httpHeaderSize;
-		if (output != NULL) {
-			pos = appendData(pos, end, entry->body->httpHeaderData,
-				entry->body->httpHeaderSize);
+		if (prep.notModified) {
+			result += buildNotModifiedHeader(prep, pos, end, output != NULL);
+		} else {
+			result += buildEntryHeader(prep, pos, end, output != NULL);
+
+			PUSH_STATIC_STRING("Content-Length: ");
+			result += prep.contentLengthStrSize;
+			if (output != NULL) {
+				uintToString(prep.bodySize, pos, end - pos);
+				pos += prep.contentLengthStrSize;
+			}
+			PUSH_STATIC_STRING("\r\n");
+
+			if (prep.gzip) {
+				PUSH_STATIC_STRING("Content-Encoding: gzip\r\n");
+			}
 		}
 
-		PUSH_STATIC_STRING("Content-Length: ");
-		result += prep.contentLengthStrSize;
-		if (output != NULL) {
-			uintToString(entry->body->httpBodySize, pos, end - pos);
-			pos += prep.contentLengthStrSize;
+		if (prep.hasCompressedBody) {
+			// Responses with Vary are never cached, so the entry's
+			// header data doesn't contain a Vary header already.
+			PUSH_STATIC_STRING("Vary: Accept-Encoding\r\n");
 		}
-		PUSH_STATIC_STRING("\r\n");
 
 		PUSH_STATIC_STRING("Age: ");
 		result += prep.ageValueSize;
@@ -158,6 +356,10 @@ private:
 		}
 		PUSH_STATIC_STRING("\r\n");
 
+		if (prep.stale) {
+			PUSH_STATIC_STRING("Warning: 110 - \"Response is Stale\"\r\n");
+		}
+
 		if (prep.showVersionInHeader) {
 			PUSH_STATIC_STRING("X-Powered-By: " PROGRAM_NAME " " PASSENGER_VERSION "\r\n");
 		} else {
@@ -195,42 +397,91 @@ public:
 	TurboCaching()
 		: state(ENABLED),
 		  lastTimeout(0),
-		  nextTimeout(0)
+		  nextTimeout(0),
+		  fetchThreshold(DEFAULT_TURBOCACHE_FETCH_THRESHOLD),
+		  minHitRatio(DEFAULT_TURBOCACHE_MIN_HIT_RATIO),
+		  lastStateChange(0),
+		  disablesDueToHitRatio(0),
+		  disablesDueToStoreSuccessRatio(0),
+		  reenables(0),
+		  coalescedRequests(0),
+		  staleResponses(0),
+		  staleIfErrorResponses(0),
+		  notModifiedResponses(0),
+		  revalidations(0),
+		  compression(true),
+		  compressions(0),
+		  compressedResponses(0)
 		{ }
 
-	void initialize(bool initiallyEnabled) {
+	void initialize(bool initiallyEnabled,
+		size_t maxMemory = DEFAULT_TURBOCACHE_MAX_MEMORY,
+		unsigned int maxBodySize = DEFAULT_TURBOCACHE_MAX_BODY_SIZE,
+		unsigned int _fetchThreshold = DEFAULT_TURBOCACHE_FETCH_THRESHOLD,
+		double _minHitRatio = DEFAULT_TURBOCACHE_MIN_HIT_RATIO,
+		bool _compression = true)
+	{
 		state = initiallyEnabled ? ENABLED : DISABLED;
+		responseCache.configure(maxMemory, maxBodySize);
+		fetchThreshold = _fetchThreshold;
+		minHitRatio = _minHitRatio;
+		compression = _compression;
 		lastTimeout = (ev_tstamp) time(NULL);
 		nextTimeout = (ev_tstamp) time(NULL) + ENABLED_TIMEOUT;
+		lastStateChange = lastTimeout;
 	}
 
 	bool isEnabled() const {
 		return state == ENABLED;
 	}
 
+	State getState() const {
+		return state;
+	}
+
+	const char *getStateString() const {
+		switch (state) {
+		case DISABLED:
+			return "DISABLED";
+		case ENABLED:
+			return "ENABLED";
+		case TEMPORARILY_DISABLED:
+			return "TEMPORARILY_DISABLED";
+		default:
+			return "UNKNOWN";
+		}
+	}
+
 	// Call when the event loop multiplexer returns.
 	void updateState(ev_tstamp now) {
 		if (OXT_UNLIKELY(state == DISABLED)) {
 			return;
 		}
 
+		// Instead of periodically clearing the whole cache, we expire
+		// entries a few at a time, so that fresh entries stay cached.
+		responseCache.expireEntries(now, EXPIRY_SWEEP_SIZE);
+		collectCompressedBodies();
+
 		if (OXT_LIKELY(now < nextTimeout)) {
 			return;
 		}
 
 		switch (state) {
 		case ENABLED:
-			if (responseCache.getFetches() >= FETCH_THRESHOLD
-				&& responseCache.getHitRatio() < MIN_HIT_RATIO())
+			if (responseCache.getFetches() >= fetchThreshold
+				&& responseCache.getCombinedHitRatio() < minHitRatio)
 			{
 				P_INFO("Poor turbocaching hit ratio detected (" <<
-					responseCache.getHits() << " hits, " <<
+					(responseCache.getHits() + responseCache.getSharedHits()) << " hits, " <<
 					responseCache.getFetches() << " fetches, " <<
-					(int) (responseCache.getHitRatio() * 100) <<
+					(int) (responseCache.getCombinedHitRatio() * 100) <<
 					"%). Temporarily disabling turbocaching "
 					"for " << TEMPORARY_DISABLE_TIMEOUT << " seconds");
 				state = TEMPORARILY_DISABLED;
 				nextTimeout = now + TEMPORARY_DISABLE_TIMEOUT;
+				lastStateChange = now;
+				disablesDueToHitRatio++;
 			} else if (responseCache.getStores() >= STORE_THRESHOLD
 				&& responseCache.getStoreSuccessRatio() < MIN_STORE_SUCCESS_RATIO())
 			{
@@ -242,17 +493,19 @@ public:
 					"for " << TEMPORARY_DISABLE_TIMEOUT << " seconds");
 				state = TEMPORARILY_DISABLED;
 				nextTimeout = now + TEMPORARY_DISABLE_TIMEOUT;
+				lastStateChange = now;
+				disablesDueToStoreSuccessRatio++;
 			} else {
-				P_DEBUG("Clearing turbocache");
 				nextTimeout = now + ENABLED_TIMEOUT;
 			}
 			responseCache.resetStatistics();
-			responseCache.clear();
 			break;
 		case TEMPORARILY_DISABLED:
 			P_INFO("Re-enabling turbocaching");
 			state = ENABLED;
 			nextTimeout = now + ENABLED_TIMEOUT;
+			lastStateChange = now;
+			reenables++;
 			break;
 		default:
 			P_BUG("Unknown state " << (int) state);
@@ -262,32 +515,253 @@ public:
 		lastTimeout = now;
 	}
 
+	/**
+	 * Returns the index of the in-flight fetch for the given key, or -1.
+	 */
+	int findInFlightFetch(const HashedStaticString &cacheKey) const {
+		unsigned int i, size = inFlightFetches.size();
+		for (i = 0; i < size; i++) {
+			const HashedStaticString &key = inFlightFetches[i].cacheKey;
+			if (key.hash() == cacheKey.hash() && key == cacheKey) {
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	/**
+	 * Registers the given request as the leader that fetches its cache key
+	 * from the app. There must not be another fetch for that key yet.
+	 */
+	void beginFetch(Request *leader) {
+		InFlightFetch fetch;
+
+		assert(findInFlightFetch(leader->cacheKey) == -1);
+		fetch.cacheKey = leader->cacheKey;
+		fetch.leader = leader;
+		fetch.firstWaiter = NULL;
+		fetch.lastWaiter = NULL;
+		inFlightFetches.push_back(fetch);
+		leader->turboCacheRole = Request::TURBOCACHE_LEADER;
+	}
+
+	/** Lets the given request wait for the in-flight fetch at `index`. */
+	void addWaiter(unsigned int index, Request *req) {
+		InFlightFetch &fetch = inFlightFetches[index];
+
+		req->turboCacheRole = Request::TURBOCACHE_WAITING;
+		req->nextTurboCacheWaiter = NULL;
+		if (fetch.lastWaiter == NULL) {
+			fetch.firstWaiter = req;
+		} else {
+			fetch.lastWaiter->nextTurboCacheWaiter = req;
+		}
+		fetch.lastWaiter = req;
+		coalescedRequests++;
+	}
+
+	/** Stops a waiting request from waiting, e.g. because it was disconnected. */
+	void removeWaiter(Request *req) {
+		int index = findInFlightFetch(req->cacheKey);
+		assert(index != -1);
+		InFlightFetch &fetch = inFlightFetches[index];
+		Request *prev = NULL;
+		Request *current = fetch.firstWaiter;
+
+		while (current != req) {
+			assert(current != NULL);
+			prev = current;
+			current = current->nextTurboCacheWaiter;
+		}
+		if (prev == NULL) {
+			fetch.firstWaiter = req->nextTurboCacheWaiter;
+		} else {
+			prev->nextTurboCacheWaiter = req->nextTurboCacheWaiter;
+		}
+		if (fetch.lastWaiter == req) {
+			fetch.lastWaiter = prev;
+		}
+		req->nextTurboCacheWaiter = NULL;
+		req->turboCacheRole = Request::TURBOCACHE_NO_ROLE;
+	}
+
+	/**
+	 * Ends the given leader's fetch. Returns the list of requests that were
+	 * waiting for it, which are marked as resumed so that they won't wait
+	 * again. The caller is responsible for resuming them.
+	 */
+	Request *endFetch(Request *leader) {
+		unsigned int i, size = inFlightFetches.size();
+
+		for (i = 0; i < size; i++) {
+			if (inFlightFetches[i].leader == leader) {
+				break;
+			}
+		}
+		assert(i < size);
+
+		Request *firstWaiter = inFlightFetches[i].firstWaiter;
+		inFlightFetches[i] = inFlightFetches.back();
+		inFlightFetches.pop_back();
+		leader->turboCacheRole = Request::TURBOCACHE_NO_ROLE;
+
+		Request *waiter = firstWaiter;
+		while (waiter != NULL) {
+			waiter->turboCacheRole = Request::TURBOCACHE_RESUMED;
+			waiter = waiter->nextTurboCacheWaiter;
+		}
+		return firstWaiter;
+	}
+
+	/**
+	 * Lets the compressor compress the given, just stored entry's body in
+	 * the background, if compression is enabled and worthwhile.
+	 */
+	void compressInBackground(const ResponseCacheEntryType &entry) {
+		if (compression && responseCache.isCompressible(entry)) {
+			compressor.submit(entry.index, entry.body->id,
+				StaticString(entry.body->httpBodyData, entry.body->httpBodySize));
+		}
+	}
+
+	/** Attaches the bodies that the compressor has finished to their entries. */
+	void collectCompressedBodies() {
+		compressor.takeResults(compressorResults);
+		for (unsigned int i = 0; i < compressorResults.size(); i++) {
+			const ResponseCompressor::Job &job = compressorResults[i];
+			if (responseCache.setCompressedBody(job.slot, job.entryId, job.data)) {
+				compressions++;
+			}
+		}
+		compressorResults.clear();
+	}
+
+	unsigned int getFetchThreshold() const {
+		return fetchThreshold;
+	}
+
+	double getMinHitRatio() const {
+		return minHitRatio;
+	}
+
+	/** The time at which the state last changed. */
+	ev_tstamp getLastStateChange() const {
+		return lastStateChange;
+	}
+
+	/** The number of times that turbocaching was temporarily disabled
+	 * because of a poor hit ratio.
+	 */
+	unsigned int getDisablesDueToHitRatio() const {
+		return disablesDueToHitRatio;
+	}
+
+	/** The number of times that turbocaching was temporarily disabled
+	 * because of a poor store success ratio.
+	 */
+	unsigned int getDisablesDueToStoreSuccessRatio() const {
+		return disablesDueToStoreSuccessRatio;
+	}
+
+	unsigned int getReenables() const {
+		return reenables;
+	}
+
+	unsigned int getInFlightFetchCount() const {
+		return inFlightFetches.size();
+	}
+
+	/** The number of requests that waited for another request's fetch. */
+	unsigned int getCoalescedRequests() const {
+		return coalescedRequests;
+	}
+
+	/** The number of stale responses served while revalidating. */
+	unsigned int getStaleResponses() const {
+		return staleResponses;
+	}
+
+	/** The number of stale responses served because the app failed. */
+	unsigned int getStaleIfErrorResponses() const {
+		return staleIfErrorResponses;
+	}
+
+	void incStaleResponses() {
+		staleResponses++;
+	}
+
+	void incStaleIfErrorResponses() {
+		staleIfErrorResponses++;
+	}
+
+	/** The number of 304 responses that were answered from the cache. */
+	unsigned int getNotModifiedResponses() const {
+		return notModifiedResponses;
+	}
+
+	/** The number of expired entries that the app revalidated with a 304 response. */
+	unsigned int getRevalidations() const {
+		return revalidations;
+	}
+
+	void incRevalidations() {
+		revalidations++;
+	}
+
+	bool isCompressionEnabled() const {
+		return compression;
+	}
+
+	/** The number of entries to which a compressed body was attached. */
+	unsigned int getCompressions() const {
+		return compressions;
+	}
+
+	/** The number of responses that were served compressed. */
+	unsigned int getCompressedResponses() const {
+		return compressedResponses;
+	}
+
+	/**
+	 * Writes the given entry as a response. If `notModified` is true, then a
+	 * 304 Not Modified response without a body is written instead.
+	 */
 	template<typename Server, typename Client>
-	void writeResponse(Server *server, Client *client, Request *req, ResponseCacheEntryType &entry) {
+	void writeResponse(Server *server, Client *client, Request *req, ResponseCacheEntryType &entry,
+		bool notModified = false)
+	{
 		MemoryKit::mbuf_pool &mbuf_pool = server->getContext()->mbuf_pool;
 		const unsigned int MBUF_MAX_SIZE = mbuf_pool_data_size(&mbuf_pool);
 		ResponsePreparation prep;
-		unsigned int headerSize;
+		unsigned int headerSize, bodySize;
 
-		prepareResponseHeader(prep, server, req, entry);
+		prepareResponseHeader(prep, server, req, entry, notModified);
 		headerSize = buildResponseHeader(prep, server, NULL, 0);
+		if (notModified) {
+			bodySize = 0;
+			notModifiedResponses++;
+		} else {
+			bodySize = prep.bodySize;
+			if (prep.gzip) {
+				compressedResponses++;
+			}
+		}
 
-		if (headerSize + entry.body->httpBodySize <= MBUF_MAX_SIZE) {
+		if (headerSize + bodySize <= MBUF_MAX_SIZE) {
 			// Header and body fit inside a single mbuf
 			MemoryKit::mbuf buffer(MemoryKit::mbuf_get(&mbuf_pool));
-			buffer = MemoryKit::mbuf(buffer, 0, headerSize + entry.body->httpBodySize);
+			buffer = MemoryKit::mbuf(buffer, 0, headerSize + bodySize);
 
 			buildResponseHeader(prep, server, buffer.start, buffer.size());
-			memcpy(buffer.start + headerSize, entry.body->httpBodyData, entry.body->httpBodySize);
+			memcpy(buffer.start + headerSize, prep.bodyData, bodySize);
 
 			server->writeResponse(client, buffer);
 		} else {
-			char *buffer = (char *) psg_pnalloc(req->pool, headerSize + entry.body->httpBodySize);
-			buildResponseHeader(prep, server, buffer,
-				headerSize + entry.body->httpBodySize);
-			memcpy(buffer + headerSize, entry.body->httpBodyData, entry.body->httpBodySize);
+			char *buffer = (char *) psg_pnalloc(req->pool, headerSize + bodySize);
+			buildResponseHeader(prep, server, buffer, headerSize + bodySize);
+			memcpy(buffer + headerSize, prep.bodyData, bodySize);
 
-			server->writeResponse(client, buffer, headerSize + entry.body->httpBodySize);
+			server->writeResponse(client, buffer, headerSize + bodySize);
 		}
 	}
 };
@@ -94,6 +94,7 @@
 #include <Utils/VariantMap.h>
 #include <Core/OptionParser.h>
 #include <Core/Controller.h>
+#include <Core/SharedResponseCache.h>
 #include <Core/ApiServer.h>
 #include <Core/Config.h>
 #include <Core/ConfigChange.h>
@@ -139,6 +140,10 @@ namespace Core {
 
 	struct WorkingObjects {
 		int serverFds[SERVER_KIT_MAX_SERVER_ENDPOINTS];
+		// In reuse port mode, each controller thread gets its own server socket
+		// for every TCP address: reusePortServerFds[address index][thread index].
+		// The corresponding serverFds entry is then -1.
+		vector<int> reusePortServerFds[SERVER_KIT_MAX_SERVER_ENDPOINTS];
 		int apiServerFds[SERVER_KIT_MAX_SERVER_ENDPOINTS];
 		string controllerSecureHeadersPassword;
 
@@ -150,6 +155,7 @@ namespace Core {
 		SpawningKit::ConfigPtr spawningKitConfig;
 		SpawningKit::FactoryPtr spawningKitFactory;
 		PoolPtr appPool;
+		SharedResponseCache *sharedResponseCache;
 		Json::Value singleAppModeConfig;
 
 		ServerKit::AcceptLoadBalancer<Controller> loadBalancer;
@@ -175,6 +181,7 @@ namespace Core {
 			  allClientsDisconnectedEvent(__FILE__, __LINE__, "WorkingObjects: allClientsDisconnectedEvent"),
 			  terminationCount(0),
 			  shutdownCounter(0),
+			  sharedResponseCache(NULL),
 			  prestarterThread(NULL),
 			  securityUpdateChecker(NULL),
 			  adminPanelConnector(NULL),
@@ -206,6 +213,8 @@ namespace Core {
 			delete apiWorkingObjects.apiServer;
 			delete apiWorkingObjects.serverKitContext;
 			delete apiWorkingObjects.bgloop;
+
+			delete sharedResponseCache;
 		}
 	};
 } // namespace Core
@@ -406,6 +415,57 @@ makeFileWorldReadableAndWritable(const string &path) {
 	}
 #endif
 
+/**
+ * Whether every controller thread should listen on its own SO_REUSEPORT
+ * socket for the given address, instead of having the AcceptLoadBalancer
+ * distribute clients. Unix domain sockets are always load balanced because
+ * the kernel does not distribute connections over SO_REUSEPORT Unix sockets.
+ */
+static bool
+shouldUseReusePort(const string &address) {
+	return coreConfig->get("controller_reuse_port").asBool()
+		&& coreConfig->get("controller_threads").asUInt() > 1
+		&& getSocketAddressType(address) == SAT_TCP;
+}
+
+static void
+createReusePortServers(unsigned int index, const string &address) {
+	TRACE_POINT();
+	WorkingObjects *wo = workingObjects;
+	unsigned int nthreads = coreConfig->get("controller_threads").asUInt();
+	string host;
+	unsigned short port;
+
+	parseTcpSocketAddress(address, host, port);
+	wo->reusePortServerFds[index].reserve(nthreads);
+	for (unsigned int i = 0; i < nthreads; i++) {
+		int fd = createReusePortTcpServer(host.c_str(), port,
+			coreConfig->get("controller_socket_backlog").asUInt(),
+			__FILE__, __LINE__);
+		wo->reusePortServerFds[index].push_back(fd);
+		P_LOG_FILE_DESCRIPTOR_PURPOSE(fd, "Server address: " << address
+			<< " (thread " << (i + 1) << ")");
+	}
+
+	#ifdef SUPPORTS_PER_THREAD_CPU_AFFINITY
+		// When threads are pinned to CPUs, steer each connection to the
+		// thread that runs on the CPU that handled the connection's interrupt.
+		// Thread i is pinned to CPU (i % maxCpus), see mainLoop().
+		unsigned int maxCpus = boost::thread::hardware_concurrency();
+		if (coreConfig->get("controller_cpu_affine").asBool() && maxCpus <= CPU_SETSIZE) {
+			try {
+				attachReusePortCpuFilter(wo->reusePortServerFds[index][0],
+					std::min(nthreads, maxCpus));
+			} catch (const SystemException &e) {
+				P_WARN("Cannot steer connections on " << address
+					<< " to CPU-local threads: " << e.what()
+					<< ". Connections will be distributed by the kernel's"
+					" default SO_REUSEPORT hashing instead");
+			}
+		}
+	#endif
+}
+
 static void
 startListening() {
 	TRACE_POINT();
@@ -422,6 +482,14 @@ startListening() {
 	#endif
 
 	for (it = addresses.begin(), i = 0; it != addresses.end(); it++, i++) {
+		if (shouldUseReusePort(it->asString())) {
+			#ifdef USE_SELINUX
+				resetSelinuxSocketContext();
+			#endif
+			createReusePortServers(i, it->asString());
+			continue;
+		}
+
 		wo->serverFds[i] = createServer(it->asString(),
 			coreConfig->get("controller_socket_backlog").asUInt(), true,
 			__FILE__, __LINE__);
@@ -543,6 +611,7 @@ printInfoInThread() {
 	cerr << "nfree_mbuf_blockq    : " << stats.nfree_mbuf_blockq << "\n";
 	cerr << "nactive_mbuf_blockq  : " << stats.nactive_mbuf_blockq << "\n";
 	cerr << "mbuf_block_chunk_size: " << stats.mbuf_block_chunk_size << "\n";
+	cerr << "nslabs               : " << stats.nslabs << "\n";
 	cerr << "\n";
 	cerr.flush();
 
@@ -690,6 +759,11 @@ initializeNonPrivilegedWorkingObjects() {
 
 	UPDATE_TRACE_POINT();
 	unsigned int nthreads = coreConfig->get("controller_threads").asUInt();
+	if (coreConfig->get("turbocaching").asBool() && coreConfig->get("turbocache_shared").asBool()) {
+		wo->sharedResponseCache = new SharedResponseCache(
+			coreConfig->get("turbocache_shared_max_memory").asUInt(), nthreads);
+	}
+
 	BackgroundEventLoop *firstLoop = NULL; // Avoid compiler warning
 	wo->threadWorkingObjects.reserve(nthreads);
 	for (unsigned int i = 0; i < nthreads; i++) {
@@ -728,6 +802,7 @@ initializeNonPrivilegedWorkingObjects() {
 		two.controller->resourceLocator = &wo->resourceLocator;
 		two.controller->appPool = wo->appPool;
 		two.controller->unionStationContext = wo->unionStationContext;
+		two.controller->sharedResponseCache = wo->sharedResponseCache;
 		two.controller->shutdownFinishCallback = controllerShutdownFinished;
 		two.controller->initialize();
 		wo->shutdownCounter.fetch_add(1, boost::memory_order_relaxed);
@@ -785,7 +860,12 @@ initializeNonPrivilegedWorkingObjects() {
 	 * This is especially noticeable on systems that heavily swap.
 	 */
 	for (unsigned int i = 0; i < addresses.size(); i++) {
-		if (nthreads == 1) {
+		if (!wo->reusePortServerFds[i].empty()) {
+			for (unsigned int j = 0; j < nthreads; j++) {
+				ThreadWorkingObjects *two = &wo->threadWorkingObjects[j];
+				two->controller->listen(wo->reusePortServerFds[i][j]);
+			}
+		} else if (nthreads == 1) {
 			ThreadWorkingObjects *two = &wo->threadWorkingObjects[0];
 			two->controller->listen(wo->serverFds[i]);
 		} else {
@@ -1047,7 +1127,7 @@ mainLoop() {
 	if (wo->apiWorkingObjects.apiServer != NULL) {
 		wo->apiWorkingObjects.bgloop->start("API event loop", 0);
 	}
-	if (wo->threadWorkingObjects.size() > 1) {
+	if (wo->threadWorkingObjects.size() > 1 && wo->loadBalancer.hasEndpoints()) {
 		wo->loadBalancer.start();
 	}
 	waitForExitEvent();
@@ -1217,6 +1297,9 @@ cleanup() {
 		if (wo->serverFds[i] != -1) {
 			close(wo->serverFds[i]);
 		}
+		for (unsigned int j = 0; j < wo->reusePortServerFds[i].size(); j++) {
+			close(wo->reusePortServerFds[i][j]);
+		}
 		if (wo->apiServerFds[i] != -1) {
 			close(wo->apiServerFds[i]);
 		}
@@ -167,8 +167,39 @@ coreUsage() {
 	printf("                            Default: " DEFAULT_STICKY_SESSIONS_COOKIE_NAME "\n");
 	printf("      --vary-turbocache-by-cookie NAME\n");
 	printf("                            Vary the turbocache by the cookie of the given name\n");
+	printf("      --sendfile-root PATH  Serve files named by X-Sendfile and\n");
+	printf("                            X-Accel-Redirect response headers, if they are\n");
+	printf("                            located inside this directory\n");
 	printf("      --disable-turbocaching\n");
 	printf("                            Disable turbocaching\n");
+	printf("      --turbocache-max-memory BYTES\n");
+	printf("                            Maximum amount of memory that each turbocache\n");
+	printf("                            may use. Default: %d\n",
+		DEFAULT_TURBOCACHE_MAX_MEMORY);
+	printf("      --turbocache-max-body-size BYTES\n");
+	printf("                            Largest response body that may be turbocached.\n");
+	printf("                            Default: %d\n",
+		DEFAULT_TURBOCACHE_MAX_BODY_SIZE);
+	printf("      --turbocache-fetch-threshold NUMBER\n");
+	printf("                            Minimum number of turbocache fetches per 2\n");
+	printf("                            seconds before turbocaching may be temporarily\n");
+	printf("                            disabled due to a poor hit ratio. Default: %d\n",
+		DEFAULT_TURBOCACHE_FETCH_THRESHOLD);
+	printf("      --turbocache-min-hit-ratio RATIO\n");
+	printf("                            Temporarily disable turbocaching if the hit\n");
+	printf("                            ratio drops below this value. Default: %.1f\n",
+		DEFAULT_TURBOCACHE_MIN_HIT_RATIO);
+	printf("      --disable-turbocache-compression\n");
+	printf("                            Do not serve gzip-compressed turbocache entries\n");
+	printf("      --turbocache-shared   Back the per-thread turbocaches with a cache\n");
+	printf("                            that is shared by all threads\n");
+	printf("      --turbocache-shared-max-memory BYTES\n");
+	printf("                            Maximum amount of memory that the shared\n");
+	printf("                            turbocache may use. Default: %d\n",
+		DEFAULT_TURBOCACHE_SHARED_MAX_MEMORY);
+	printf("      --disable-response-splicing\n");
+	printf("                            Always copy application response bodies through\n");
+	printf("                            user space instead of splicing them to clients\n");
 	printf("      --no-abort-websockets-on-process-shutdown\n");
 	printf("                            Do not abort WebSocket connections on process\n");
 	printf("                            shutdown or restart\n");
@@ -198,6 +229,11 @@ coreUsage() {
 	printf("                            Default: number of CPU cores (%d)\n",
 		boost::thread::hardware_concurrency());
 	printf("      --cpu-affine          Enable per-thread CPU affinity (Linux only)\n");
+	printf("      --reuse-port          Give every thread its own SO_REUSEPORT server\n");
+	printf("                            socket instead of load balancing clients from\n");
+	printf("                            a single accept thread (TCP addresses only)\n");
+	printf("      --mbuf-slabs          Allocate I/O buffers from 2 MB slabs backed by\n");
+	printf("                            huge pages, on the thread's NUMA node\n");
 	printf("      --core-file-descriptor-ulimit NUMBER\n");
 	printf("                            Set custom file descriptor ulimit for the core\n");
 	printf("      --admin-panel-url URL\n");
@@ -336,9 +372,36 @@ parseCoreOption(int argc, const char *argv[], int &i, Json::Value &updates) {
 	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--vary-turbocache-by-cookie")) {
 		updates["vary_turbocache_by_cookie"] = argv[i + 1];
 		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--sendfile-root")) {
+		updates["default_sendfile_root"] = argv[i + 1];
+		i += 2;
 	} else if (p.isFlag(argv[i], '\0', "--disable-turbocaching")) {
 		updates["turbocaching"] = false;
 		i++;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--turbocache-max-memory")) {
+		updates["turbocache_max_memory"] = atoi(argv[i + 1]);
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--turbocache-max-body-size")) {
+		updates["turbocache_max_body_size"] = atoi(argv[i + 1]);
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--turbocache-fetch-threshold")) {
+		updates["turbocache_fetch_threshold"] = atoi(argv[i + 1]);
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--turbocache-min-hit-ratio")) {
+		updates["turbocache_min_hit_ratio"] = atof(argv[i + 1]);
+		i += 2;
+	} else if (p.isFlag(argv[i], '\0', "--disable-turbocache-compression")) {
+		updates["turbocache_compression"] = false;
+		i++;
+	} else if (p.isFlag(argv[i], '\0', "--turbocache-shared")) {
+		updates["turbocache_shared"] = true;
+		i++;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--turbocache-shared-max-memory")) {
+		updates["turbocache_shared_max_memory"] = atoi(argv[i + 1]);
+		i += 2;
+	} else if (p.isFlag(argv[i], '\0', "--disable-response-splicing")) {
+		updates["response_splicing"] = false;
+		i++;
 	} else if (p.isFlag(argv[i], '\0', "--no-abort-websockets-on-process-shutdown")) {
 		updates["default_abort_websockets_on_process_shutdown"] = false;
 		i++;
@@ -390,6 +453,12 @@ parseCoreOption(int argc, const char *argv[], int &i, Json::Value &updates) {
 	} else if (p.isFlag(argv[i], '\0', "--cpu-affine")) {
 		updates["controller_cpu_affine"] = true;
 		i++;
+	} else if (p.isFlag(argv[i], '\0', "--reuse-port")) {
+		updates["controller_reuse_port"] = true;
+		i++;
+	} else if (p.isFlag(argv[i], '\0', "--mbuf-slabs")) {
+		updates["controller_mbuf_slabs"] = true;
+		i++;
 	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--core-file-descriptor-ulimit")) {
 		updates["file_descriptor_ulimit"] = atoi(argv[i + 1]);
 		i += 2;
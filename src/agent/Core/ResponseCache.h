@@ -27,9 +27,13 @@
 #define _PASSENGER_RESPONSE_CACHE_H_
 
 #include <boost/cstdint.hpp>
+#include <boost/container/vector.hpp>
 #include <time.h>
 #include <cassert>
+#include <cstddef>
 #include <cstring>
+#include <Constants.h>
+#include <Core/SharedResponseCache.h>
 #include <DataStructures/HashedStaticString.h>
 #include <ServerKit/http_parser.h>
 #include <ServerKit/CookieUtils.h>
@@ -43,25 +47,62 @@ namespace Passenger {
  * Relevant RFCs:
  * https://tools.ietf.org/html/rfc7234    HTTP 1.1 Caching
  * https://tools.ietf.org/html/rfc2109    HTTP State Management Mechanism
+ *
+ * The cache holds as many entries as fit in a configurable memory budget.
+ * Entries live in slots. For each slot there is a small Header, stored in a
+ * contiguous array, and a Body, stored in a separate array, which points to
+ * the entry's key and HTTP data. Entries are found through an open addressing
+ * hash table (with linear probing) that maps key hashes to slots, so that a
+ * lookup usually only touches one index bucket and one Body. When the memory
+ * budget is exhausted, entries are evicted using the CLOCK algorithm: fetching
+ * an entry marks it as referenced, and the clock hand sweeps over the slots,
+ * evicting the first entry that has not been referenced since the previous
+ * sweep.
+ *
+ * Expired entries are dropped when they are fetched, and in the background
+ * by expireEntries(), which the owner should call regularly. But if the
+ * response specified `stale-while-revalidate` or `stale-if-error`, the
+ * entry is kept until that window has passed as well, so that it can be
+ * served by fetchStale(). Entries with validators (an ETag or Last-Modified
+ * header) are kept for REVALIDATION_WINDOW seconds after they expire, so
+ * that they can be revalidated with a conditional request to the app instead
+ * of being fetched again in full. See fetchForRevalidation().
+ *
+ * An entry may also have a gzip-compressed variant of its body, which is
+ * served to clients that accept it. Variants are created outside the cache
+ * (see ResponseCompressor) and attached with setCompressedBody(), and count
+ * towards the memory budget. Since the variant belongs to the entry, it's
+ * expired, revalidated and invalidated together with it. The variant is a
+ * different representation, so it may not share the entry's entity tag
+ * (RFC 7232 section 2.3.3): see getEntityTag().
+ *
+ * Optionally, the cache can be backed by a SharedResponseCache, in which case
+ * this cache acts as a thread-local first level cache in front of it. See
+ * setSharedCache().
  */
 template<typename Request>
 class ResponseCache {
 public:
-	static const unsigned int MAX_ENTRIES     = 8; // Fits in exactly 2 cache lines
 	static const unsigned int MAX_KEY_LENGTH  = 256;
 	static const unsigned int MAX_HEADER_SIZE = 4096;
-	static const unsigned int MAX_BODY_SIZE   = 1024 * 32;
 	static const unsigned int DEFAULT_HEURISTIC_FRESHNESS = 10;
 	static const unsigned int MIN_HEURISTIC_FRESHNESS = 1;
+	static const unsigned int REVALIDATION_WINDOW = 60;
+	/** Bodies smaller than this are not worth compressing. */
+	static const unsigned int MIN_COMPRESSIBLE_SIZE = 256;
 
 	struct Header {
 		bool valid;
+		// CLOCK reference bit: whether this entry has been fetched since
+		// the last time the clock hand passed it.
+		bool referenced;
 		unsigned short keySize;
 		boost::uint32_t hash;
 		time_t date;
 
 		Header()
 			: valid(false),
+			  referenced(false),
 			  keySize(0),
 			  hash(0),
 			  date(0)
@@ -70,20 +111,48 @@ public:
 
 	struct Body {
 		unsigned short httpHeaderSize;
-		unsigned short httpBodySize;
+		unsigned int httpBodySize;
 		time_t expiryDate;
-		char key[MAX_KEY_LENGTH];
-		char httpHeaderData[MAX_HEADER_SIZE];
-		// This data is dechunked.
-		char httpBodyData[MAX_BODY_SIZE];
+		// The number of seconds after expiryDate during which the entry may
+		// still be served while it is being revalidated, respectively when
+		// revalidating it fails. Taken from the `stale-while-revalidate` and
+		// `stale-if-error` Cache-Control extensions (RFC 5861).
+		unsigned int staleWhileRevalidate;
+		unsigned int staleIfError;
+		// Whether the response has an ETag or Last-Modified header.
+		bool hasValidators;
+		// Distinguishes this entry from earlier entries in the same slot.
+		boost::uint32_t id;
+		// The gzip-compressed body, if any. This is a separate allocation,
+		// also owned by the ResponseCache.
+		char *gzipBodyData;
+		unsigned int gzipBodySize;
+		// These point into a single allocation of exactly
+		// keySize + httpHeaderSize + httpBodySize bytes, owned
+		// by the ResponseCache. The body data is dechunked.
+		char *key;
+		char *httpHeaderData;
+		char *httpBodyData;
 
 		Body()
 			: httpHeaderSize(0),
 			  httpBodySize(0),
-			  expiryDate(0)
-		{
-			key[0] = httpHeaderData[0] = httpBodyData[0] = '\0';
-		}
+			  expiryDate(0),
+			  staleWhileRevalidate(0),
+			  staleIfError(0),
+			  hasValidators(false),
+			  id(0),
+			  gzipBodyData(NULL),
+			  gzipBodySize(0),
+			  key(NULL),
+			  httpHeaderData(NULL),
+			  httpBodyData(NULL)
+			{ }
+	};
+
+	enum StaleUse {
+		STALE_WHILE_REVALIDATE,
+		STALE_IF_ERROR
 	};
 
 	struct Entry {
@@ -125,6 +194,15 @@ public:
 	};
 
 private:
+	static const boost::uint32_t EMPTY_BUCKET = 0xffffffff;
+	static const unsigned int MIN_INDEX_SIZE = 16;
+
+	struct IndexBucket {
+		boost::uint32_t hash;
+		// Index of the slot, or EMPTY_BUCKET.
+		boost::uint32_t slot;
+	};
+
 	HashedStaticString HOST;
 	HashedStaticString CACHE_CONTROL;
 	HashedStaticString PRAGMA_CONST;
@@ -135,15 +213,35 @@ private:
 	HashedStaticString X_ACCEL_REDIRECT;
 	HashedStaticString EXPIRES;
 	HashedStaticString LAST_MODIFIED;
+	HashedStaticString ETAG;
+	HashedStaticString IF_NONE_MATCH;
+	HashedStaticString IF_MODIFIED_SINCE;
+	HashedStaticString ACCEPT_ENCODING;
 	HashedStaticString LOCATION;
 	HashedStaticString CONTENT_LOCATION;
 	HashedStaticString COOKIE;
 	HashedStaticString PASSENGER_VARY_TURBOCACHE_BY_COOKIE;
 
-	unsigned int fetches, hits, stores, storeSuccesses;
+	unsigned int fetches, hits, stores, storeSuccesses, evictions;
+	unsigned int staleHits, expirations;
+	unsigned int sharedFetches, sharedHits;
+
+	SharedResponseCache *sharedCache;
+	unsigned int sharedCacheReader;
+
+	size_t maxMemory;
+	unsigned int maxBodySize;
+	size_t memoryUsage;
+	unsigned int entryCount;
+	unsigned int clockHand;
+	unsigned int expiryCursor;
+	boost::uint32_t nextEntryId;
 
-	Header headers[MAX_ENTRIES];
-	Body bodies[MAX_ENTRIES];
+	boost::container::vector<Header> headers;
+	boost::container::vector<Body> bodies;
+	boost::container::vector<unsigned int> freeSlots;
+	// Size is 0 or a power of 2.
+	boost::container::vector<IndexBucket> index;
 
 	unsigned int calculateKeyLength(const LString * restrict host,
 		const LString * restrict varyCookie,
@@ -216,35 +314,259 @@ private:
 		}
 	}
 
+	/**
+	 * The amount of memory that an entry accounts for in the memory budget,
+	 * including its share of the slot arrays and of the index (which is kept
+	 * at most half full).
+	 */
+	static size_t calculateEntryMemoryUsage(unsigned int keySize, unsigned int headerSize,
+		unsigned int bodySize)
+	{
+		return sizeof(Header) + sizeof(Body) + 2 * sizeof(IndexBucket)
+			+ keySize + headerSize + bodySize;
+	}
+
+	size_t getEntryMemoryUsage(unsigned int slot) const {
+		return calculateEntryMemoryUsage(headers[slot].keySize,
+			bodies[slot].httpHeaderSize, bodies[slot].httpBodySize)
+			+ bodies[slot].gzipBodySize;
+	}
+
+	OXT_FORCE_INLINE
+	unsigned int getIndexMask() const {
+		return index.size() - 1;
+	}
+
 	Entry lookup(const HashedStaticString &cacheKey) {
-		for (unsigned int i = 0; i < MAX_ENTRIES; i++) {
-			if (headers[i].valid
-			 && headers[i].hash == cacheKey.hash()
-			 && cacheKey == StaticString(bodies[i].key, headers[i].keySize))
+		if (OXT_UNLIKELY(index.empty())) {
+			return Entry();
+		}
+
+		const IndexBucket *buckets = &index[0];
+		unsigned int mask = getIndexMask();
+		unsigned int i = cacheKey.hash() & mask;
+
+		while (buckets[i].slot != EMPTY_BUCKET) {
+			unsigned int slot = buckets[i].slot;
+			if (buckets[i].hash == cacheKey.hash()
+			 && cacheKey == StaticString(bodies[slot].key, headers[slot].keySize))
 			{
-				return Entry(i, &headers[i], &bodies[i]);
+				return Entry(slot, &headers[slot], &bodies[slot]);
 			}
+			i = (i + 1) & mask;
 		}
 		return Entry();
 	}
 
-	Entry lookupInvalidOrOldest() {
-		int oldest = -1;
+	void insertIntoIndex(boost::uint32_t hash, unsigned int slot) {
+		IndexBucket *buckets = &index[0];
+		unsigned int mask = getIndexMask();
+		unsigned int i = hash & mask;
 
-		for (unsigned int i = 0; i < MAX_ENTRIES; i++) {
-			if (!headers[i].valid) {
-				return Entry(i, &headers[i], &bodies[i]);
-			} else if (oldest == -1 || headers[i].date < headers[oldest].date) {
-				oldest = i;
+		while (buckets[i].slot != EMPTY_BUCKET) {
+			i = (i + 1) & mask;
+		}
+		buckets[i].hash = hash;
+		buckets[i].slot = slot;
+	}
+
+	/**
+	 * Removes the given slot from the index. Instead of leaving a tombstone,
+	 * subsequent buckets in the same probe sequence are shifted back, so that
+	 * lookups never have to probe past deleted entries.
+	 */
+	void removeFromIndex(boost::uint32_t hash, unsigned int slot) {
+		IndexBucket *buckets = &index[0];
+		unsigned int mask = getIndexMask();
+		unsigned int i = hash & mask;
+
+		while (buckets[i].slot != slot) {
+			assert(buckets[i].slot != EMPTY_BUCKET);
+			i = (i + 1) & mask;
+		}
+
+		unsigned int j = i;
+		while (true) {
+			buckets[i].slot = EMPTY_BUCKET;
+			unsigned int home;
+			do {
+				j = (j + 1) & mask;
+				if (buckets[j].slot == EMPTY_BUCKET) {
+					return;
+				}
+				home = buckets[j].hash & mask;
+				// Bucket j may only be moved to i if its home bucket
+				// does not lie cyclically in (i, j].
+			} while (i <= j ? (i < home && home <= j) : (i < home || home <= j));
+			buckets[i] = buckets[j];
+			i = j;
+		}
+	}
+
+	void resizeIndex(unsigned int size) {
+		IndexBucket empty;
+		empty.hash = 0;
+		empty.slot = EMPTY_BUCKET;
+
+		index.clear();
+		index.resize(size, empty);
+		for (unsigned int i = 0; i < headers.size(); i++) {
+			if (headers[i].valid) {
+				insertIntoIndex(headers[i].hash, i);
 			}
 		}
+	}
 
-		return Entry(oldest, &headers[oldest], &bodies[oldest]);
+	void erase(unsigned int slot) {
+		Header &header = headers[slot];
+		Body &body = bodies[slot];
+
+		assert(header.valid);
+		removeFromIndex(header.hash, slot);
+		memoryUsage -= getEntryMemoryUsage(slot);
+		delete[] body.key;
+		delete[] body.gzipBodyData;
+		body.key = body.httpHeaderData = body.httpBodyData = NULL;
+		body.gzipBodyData = NULL;
+		body.gzipBodySize = 0;
+		header.valid = false;
+		freeSlots.push_back(slot);
+		entryCount--;
 	}
 
-	OXT_FORCE_INLINE
-	void erase(unsigned int index) {
-		headers[index].valid = false;
+	/**
+	 * Evicts one entry according to the CLOCK algorithm.
+	 * The cache must not be empty.
+	 */
+	void evictOne() {
+		assert(entryCount > 0);
+		while (true) {
+			if (clockHand >= headers.size()) {
+				clockHand = 0;
+			}
+			Header &header = headers[clockHand];
+			if (header.valid) {
+				if (header.referenced) {
+					header.referenced = false;
+				} else {
+					erase(clockHand);
+					clockHand++;
+					evictions++;
+					return;
+				}
+			}
+			clockHand++;
+		}
+	}
+
+	/**
+	 * Allocates a slot for a new entry with the given sizes, evicting other
+	 * entries as necessary to stay within the memory budget.
+	 */
+	Entry allocateEntry(const HashedStaticString &cacheKey, unsigned int headerSize,
+		unsigned int bodySize)
+	{
+		size_t size = calculateEntryMemoryUsage(cacheKey.size(), headerSize, bodySize);
+		unsigned int slot;
+
+		while (memoryUsage + size > maxMemory) {
+			evictOne();
+		}
+
+		if (freeSlots.empty()) {
+			slot = headers.size();
+			headers.push_back(Header());
+			bodies.push_back(Body());
+		} else {
+			slot = freeSlots.back();
+			freeSlots.pop_back();
+		}
+
+		if ((entryCount + 1) * 2 > index.size()) {
+			if (index.empty()) {
+				resizeIndex(MIN_INDEX_SIZE);
+			} else {
+				resizeIndex(index.size() * 2);
+			}
+		}
+
+		Header &header = headers[slot];
+		Body &body = bodies[slot];
+		header.valid = true;
+		header.referenced = false;
+		header.hash = cacheKey.hash();
+		header.keySize = cacheKey.size();
+		body.httpHeaderSize = headerSize;
+		body.httpBodySize = bodySize;
+		body.staleWhileRevalidate = 0;
+		body.staleIfError = 0;
+		body.hasValidators = false;
+		body.id = nextEntryId++;
+		body.gzipBodyData = NULL;
+		body.gzipBodySize = 0;
+		body.key = new char[cacheKey.size() + headerSize + bodySize];
+		body.httpHeaderData = body.key + cacheKey.size();
+		body.httpBodyData = body.httpHeaderData + headerSize;
+		memcpy(body.key, cacheKey.data(), cacheKey.size());
+		insertIntoIndex(header.hash, slot);
+
+		memoryUsage += size;
+		entryCount++;
+		return Entry(slot, &header, &body);
+	}
+
+	bool canStore(const HashedStaticString &cacheKey, unsigned int headerSize,
+		unsigned int bodySize) const
+	{
+		return headerSize <= MAX_HEADER_SIZE && bodySize <= maxBodySize
+			&& calculateEntryMemoryUsage(cacheKey.size(), headerSize, bodySize) <= maxMemory;
+	}
+
+	/**
+	 * Looks up the given key in the shared cache, and if a fresh entry is found,
+	 * copies it into this cache.
+	 */
+	Entry fetchFromSharedCache(const HashedStaticString &cacheKey, ev_tstamp now) {
+		SharedResponseCache::ReadGuard guard(sharedCache, sharedCacheReader);
+		const SharedResponseCache::Entry *sharedEntry = sharedCache->lookup(cacheKey);
+
+		sharedFetches++;
+		if (sharedEntry == NULL || sharedEntry->getExpiryDate() <= now) {
+			return Entry();
+		}
+
+		StaticString httpHeaderData(sharedEntry->getHttpHeaderData());
+		StaticString httpBodyData(sharedEntry->getHttpBodyData());
+		if (!canStore(cacheKey, httpHeaderData.size(), httpBodyData.size())) {
+			return Entry();
+		}
+
+		sharedHits++;
+		Entry entry(lookup(cacheKey));
+		if (entry.valid()) {
+			erase(entry.index);
+		}
+		entry = allocateEntry(cacheKey, httpHeaderData.size(), httpBodyData.size());
+		entry.header->date = sharedEntry->getDate();
+		entry.header->referenced = true;
+		entry.body->expiryDate = sharedEntry->getExpiryDate();
+		entry.body->staleWhileRevalidate = sharedEntry->getStaleWhileRevalidate();
+		entry.body->staleIfError = sharedEntry->getStaleIfError();
+		memcpy(entry.body->httpHeaderData, httpHeaderData.data(), httpHeaderData.size());
+		memcpy(entry.body->httpBodyData, httpBodyData.data(), httpBodyData.size());
+		entry.body->hasValidators = !lookupHeader(entry, P_STATIC_STRING("etag")).empty()
+			|| !lookupHeader(entry, P_STATIC_STRING("last-modified")).empty();
+		return entry;
+	}
+
+	void invalidateKey(const HashedStaticString &cacheKey) {
+		Entry entry(lookup(cacheKey));
+		if (entry.valid()) {
+			erase(entry.index);
+		}
+		if (sharedCache != NULL) {
+			sharedCache->invalidate(cacheKey);
+		}
 	}
 
 	time_t parseDate(psg_pool_t *pool, const LString *date, ev_tstamp now) const {
@@ -265,6 +587,17 @@ private:
 		}
 	}
 
+	static time_t parseHttpDate(const StaticString &value) {
+		struct tm tm;
+		int zone;
+
+		if (parseImfFixdate(value.data(), value.data() + value.size(), tm, zone)) {
+			return parsedDateToTimestamp(tm, zone);
+		} else {
+			return (time_t) -1;
+		}
+	}
+
 	time_t determineExpiryDate(const Request *req, time_t responseDate, ev_tstamp now) const {
 		const LString *value = req->appResponse.expiresHeader;
 		if (value != NULL) {
@@ -317,6 +650,110 @@ private:
 		return entry.body->expiryDate > now;
 	}
 
+	unsigned int getStaleWindow(const Entry &entry, StaleUse use) const {
+		if (use == STALE_WHILE_REVALIDATE) {
+			return entry.body->staleWhileRevalidate;
+		} else {
+			return entry.body->staleIfError;
+		}
+	}
+
+	/**
+	 * Whether an expired entry may still be served for any purpose, and is
+	 * thus worth keeping around.
+	 */
+	bool isUsableWhenStale(const Entry &entry, ev_tstamp now) const {
+		return entry.body->expiryDate
+			+ (time_t) std::max(entry.body->staleWhileRevalidate, entry.body->staleIfError)
+			> now
+			|| isRevalidatable(entry, now);
+	}
+
+	bool isRevalidatable(const Entry &entry, ev_tstamp now) const {
+		return entry.body->hasValidators
+			&& entry.body->expiryDate + (time_t) REVALIDATION_WINDOW > now;
+	}
+
+	/**
+	 * Checks whether the line between `pos` and `end` is a header with
+	 * the given (lowercase) name.
+	 */
+	static bool headerNameMatches(const char *pos, const char *end, const StaticString &name) {
+		if (end - pos <= (ptrdiff_t) name.size() || pos[name.size()] != ':') {
+			return false;
+		}
+		for (unsigned int i = 0; i < name.size(); i++) {
+			char ch = pos[i];
+			if (ch >= 'A' && ch <= 'Z') {
+				ch = ch - 'A' + 'a';
+			}
+			if (ch != name[i]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * Checks whether an If-None-Match value matches the given entity tag,
+	 * using the weak comparison function (RFC 7232 section 2.3.2).
+	 */
+	static bool entityTagListMatches(const StaticString &list, const StaticString &etag) {
+		StaticString opaqueTag = stripWeakEntityTagPrefix(etag);
+		const char *pos = list.data();
+		const char *end = list.data() + list.size();
+
+		while (pos < end) {
+			if (*pos == ' ' || *pos == '\t' || *pos == ',') {
+				pos++;
+			} else if (*pos == '*') {
+				return true;
+			} else {
+				if (end - pos >= 2 && pos[0] == 'W' && pos[1] == '/') {
+					pos += 2;
+				}
+				if (pos == end || *pos != '"') {
+					// Invalid entity tag.
+					return false;
+				}
+				const char *tagEnd = (const char *) memchr(pos + 1, '"', end - pos - 1);
+				if (tagEnd == NULL) {
+					return false;
+				}
+				if (opaqueTag == StaticString(pos, tagEnd - pos + 1)) {
+					return true;
+				}
+				pos = tagEnd + 1;
+			}
+		}
+		return false;
+	}
+
+	static StaticString stripWeakEntityTagPrefix(const StaticString &etag) {
+		if (etag.size() >= 2 && etag[0] == 'W' && etag[1] == '/') {
+			return etag.substr(2);
+		} else {
+			return etag;
+		}
+	}
+
+	/**
+	 * Parses the value of a Cache-Control directive with a delta-seconds
+	 * argument, such as `stale-if-error=60`. Returns 0 if the directive
+	 * is absent.
+	 */
+	static unsigned int parseDeltaSecondsDirective(const StaticString &cacheControl,
+		const StaticString &name)
+	{
+		string::size_type pos = cacheControl.find(name);
+		if (pos == string::npos || cacheControl.size() <= pos + name.size() + 1
+		 || cacheControl[pos + name.size()] != '=')
+		{
+			return 0;
+		}
+		return stringToUint(cacheControl.substr(pos + name.size() + 1));
+	}
+
 	StaticString extractHostNameWithPortFromParsedUrl(struct http_parser_url &url,
 		const LString *value) const
 	{
@@ -402,14 +839,12 @@ private:
 		char *key = (char *) psg_pnalloc(req->pool, keySize);
 		generateKey(https, path, req->host, req->varyCookie, key, keySize);
 
-		Entry entry(lookup(StaticString(key, keySize)));
-		if (entry.valid()) {
-			entry.header->valid = false;
-		}
+		invalidateKey(HashedStaticString(key, keySize));
 	}
 
 public:
-	ResponseCache()
+	ResponseCache(size_t _maxMemory = DEFAULT_TURBOCACHE_MAX_MEMORY,
+		unsigned int _maxBodySize = DEFAULT_TURBOCACHE_MAX_BODY_SIZE)
 		: CACHE_CONTROL("cache-control"),
 		  PRAGMA_CONST("pragma"),
 		  AUTHORIZATION("authorization"),
@@ -419,6 +854,10 @@ public:
 		  X_ACCEL_REDIRECT("x-accel-redirect"),
 		  EXPIRES("expires"),
 		  LAST_MODIFIED("last-modified"),
+		  ETAG("etag"),
+		  IF_NONE_MATCH("if-none-match"),
+		  IF_MODIFIED_SINCE("if-modified-since"),
+		  ACCEPT_ENCODING("accept-encoding"),
 		  LOCATION("location"),
 		  CONTENT_LOCATION("content-location"),
 		  COOKIE("cookie"),
@@ -426,9 +865,79 @@ public:
 		  fetches(0),
 		  hits(0),
 		  stores(0),
-		  storeSuccesses(0)
+		  storeSuccesses(0),
+		  evictions(0),
+		  staleHits(0),
+		  expirations(0),
+		  sharedFetches(0),
+		  sharedHits(0),
+		  sharedCache(NULL),
+		  sharedCacheReader(0),
+		  maxMemory(_maxMemory),
+		  maxBodySize(_maxBodySize),
+		  memoryUsage(0),
+		  entryCount(0),
+		  clockHand(0),
+		  expiryCursor(0),
+		  nextEntryId(0)
 		{ }
 
+	~ResponseCache() {
+		clear();
+	}
+
+	/**
+	 * Changes the memory budget and the maximum body size. This clears the cache.
+	 */
+	void configure(size_t _maxMemory, unsigned int _maxBodySize) {
+		clear();
+		maxMemory = _maxMemory;
+		maxBodySize = _maxBodySize;
+	}
+
+	/**
+	 * Makes this cache a first level cache in front of the given shared cache.
+	 * Cache misses are looked up in the shared cache, stored entries can be
+	 * published to it with publish(), and invalidations are propagated to it.
+	 *
+	 * @param reader This thread's reader number in the shared cache.
+	 */
+	void setSharedCache(SharedResponseCache *cache, unsigned int reader) {
+		assert(cache == NULL || reader < cache->getMaxReaders());
+		sharedCache = cache;
+		sharedCacheReader = reader;
+	}
+
+	OXT_FORCE_INLINE
+	SharedResponseCache *getSharedCache() const {
+		return sharedCache;
+	}
+
+	OXT_FORCE_INLINE
+	size_t getMaxMemory() const {
+		return maxMemory;
+	}
+
+	OXT_FORCE_INLINE
+	unsigned int getMaxBodySize() const {
+		return maxBodySize;
+	}
+
+	OXT_FORCE_INLINE
+	size_t getMemoryUsage() const {
+		return memoryUsage;
+	}
+
+	OXT_FORCE_INLINE
+	unsigned int getEntryCount() const {
+		return entryCount;
+	}
+
+	OXT_FORCE_INLINE
+	unsigned int getEvictions() const {
+		return evictions;
+	}
+
 	OXT_FORCE_INLINE
 	unsigned int getFetches() const {
 		return fetches;
@@ -465,17 +974,168 @@ public:
 		stores++;
 	}
 
+	/** The number of entries returned by fetchStale(). */
+	OXT_FORCE_INLINE
+	unsigned int getStaleHits() const {
+		return staleHits;
+	}
+
+	/**
+	 * The number of entries that were removed because they expired, either
+	 * upon fetching them or by expireEntries().
+	 */
+	OXT_FORCE_INLINE
+	unsigned int getExpirations() const {
+		return expirations;
+	}
+
+	/** The number of fetches that missed this cache and were looked up in the shared cache. */
+	OXT_FORCE_INLINE
+	unsigned int getSharedFetches() const {
+		return sharedFetches;
+	}
+
+	OXT_FORCE_INLINE
+	unsigned int getSharedHits() const {
+		return sharedHits;
+	}
+
+	OXT_FORCE_INLINE
+	double getSharedHitRatio() const {
+		return sharedHits / (double) sharedFetches;
+	}
+
+	/** The ratio of fetches that were hits in either this cache or the shared cache. */
+	OXT_FORCE_INLINE
+	double getCombinedHitRatio() const {
+		return (hits + sharedHits) / (double) fetches;
+	}
+
+	/**
+	 * Looks up a header in an entry's HTTP header data. The header data is not
+	 * indexed, so this is a linear scan. `name` must be lowercase. Returns an
+	 * empty string if the header does not exist.
+	 */
+	static StaticString lookupHeader(const Entry &entry, const StaticString &name) {
+		const char *data = entry.body->httpHeaderData;
+		const char *end = data + entry.body->httpHeaderSize;
+		// Skip the status line.
+		const char *pos = (const char *) memchr(data, '\n', end - data);
+
+		while (pos != NULL) {
+			const char *lineStart = pos + 1;
+			const char *lineEnd;
+
+			pos = (const char *) memchr(lineStart, '\n', end - lineStart);
+			lineEnd = (pos == NULL) ? end : pos;
+			if (headerNameMatches(lineStart, lineEnd, name)) {
+				const char *value = lineStart + name.size() + 1;
+				while (value < lineEnd && (*value == ' ' || *value == '\t')) {
+					value++;
+				}
+				while (lineEnd > value && (lineEnd[-1] == '\r' || lineEnd[-1] == ' ')) {
+					lineEnd--;
+				}
+				return StaticString(value, lineEnd - value);
+			}
+		}
+		return StaticString();
+	}
+
+	/**
+	 * Checks whether the header line in the given range has one of the names
+	 * in `names`, which must be lowercase.
+	 */
+	static bool headerLineHasName(const char *pos, const char *end,
+		const StaticString *names, unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; i++) {
+			if (headerNameMatches(pos, end, names[i])) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * Copies the given entry, including its data, into the given pool.
+	 * The copy remains valid if the entry is removed from the cache.
+	 */
+	static Entry copyEntry(const Entry &entry, psg_pool_t *pool) {
+		unsigned int size = entry.header->keySize + entry.body->httpHeaderSize
+			+ entry.body->httpBodySize;
+		Header *header = (Header *) psg_palloc(pool, sizeof(Header));
+		Body *body = (Body *) psg_palloc(pool, sizeof(Body));
+
+		*header = *entry.header;
+		*body = *entry.body;
+		body->key = (char *) psg_pnalloc(pool, size);
+		body->httpHeaderData = body->key + header->keySize;
+		body->httpBodyData = body->httpHeaderData + body->httpHeaderSize;
+		body->gzipBodyData = NULL;
+		body->gzipBodySize = 0;
+		memcpy(body->key, entry.body->key, size);
+		return Entry(entry.index, header, body);
+	}
+
 	void resetStatistics() {
 		fetches = 0;
 		hits = 0;
 		stores = 0;
 		storeSuccesses = 0;
+		evictions = 0;
+		staleHits = 0;
+		expirations = 0;
+		sharedFetches = 0;
+		sharedHits = 0;
 	}
 
 	void clear() {
-		for (unsigned int i = 0; i < MAX_ENTRIES; i++) {
-			headers[i].valid = false;
+		for (unsigned int i = 0; i < bodies.size(); i++) {
+			delete[] bodies[i].key;
+			delete[] bodies[i].gzipBodyData;
 		}
+		headers.clear();
+		bodies.clear();
+		freeSlots.clear();
+		index.clear();
+		memoryUsage = 0;
+		entryCount = 0;
+		clockHand = 0;
+		expiryCursor = 0;
+	}
+
+	/**
+	 * Removes entries that have expired, and whose stale windows have passed
+	 * as well. To keep the amount of work per call small, this examines at
+	 * most `maxSlots` slots, continuing where the previous call left off.
+	 * Returns the number of removed entries.
+	 */
+	unsigned int expireEntries(ev_tstamp now, unsigned int maxSlots) {
+		unsigned int size = headers.size();
+		unsigned int removed = 0;
+
+		if (entryCount == 0) {
+			return 0;
+		}
+		if (maxSlots > size) {
+			maxSlots = size;
+		}
+		for (unsigned int i = 0; i < maxSlots; i++) {
+			if (expiryCursor >= size) {
+				expiryCursor = 0;
+			}
+			if (headers[expiryCursor].valid
+			 && !isUsableWhenStale(Entry(expiryCursor, &headers[expiryCursor],
+				&bodies[expiryCursor]), now))
+			{
+				erase(expiryCursor);
+				removed++;
+			}
+			expiryCursor++;
+		}
+		expirations += removed;
+		return removed;
 	}
 
 
@@ -547,23 +1207,55 @@ public:
 		}
 
 		Entry entry(lookup(req->cacheKey));
+		Entry result;
 		if (entry.valid()) {
 			hits++;
 			if (isFresh(entry, now)) {
+				entry.header->referenced = true;
 				return entry;
 			} else {
-				erase(entry.index);
-				Entry result;
+				// Expired entries with a stale window are kept,
+				// so that fetchStale() can still return them.
+				if (!isUsableWhenStale(entry, now)) {
+					erase(entry.index);
+					expirations++;
+				}
 				result.cacheMissReason = Entry::NOT_FRESH;
-				return result;
 			}
 		} else {
-			entry.cacheMissReason = Entry::NOT_FOUND;
-			return entry;
+			result.cacheMissReason = Entry::NOT_FOUND;
 		}
+
+		if (sharedCache != NULL) {
+			entry = fetchFromSharedCache(req->cacheKey, now);
+			if (entry.valid()) {
+				return entry;
+			}
+		}
+		return result;
 	}
 
 
+	/**
+	 * Looks up an expired entry that may still be served for the given
+	 * purpose, because it's within the corresponding stale window.
+	 * Fresh entries are not returned: use fetch() for those.
+	 *
+	 * @pre prepareRequest() returned true
+	 */
+	Entry fetchStale(Request *req, ev_tstamp now, StaleUse use) {
+		Entry entry(lookup(req->cacheKey));
+		if (entry.valid() && !isFresh(entry, now)
+		 && entry.body->expiryDate + (time_t) getStaleWindow(entry, use) > now)
+		{
+			entry.header->referenced = true;
+			staleHits++;
+			return entry;
+		} else {
+			return Entry();
+		}
+	}
+
 	// @pre prepareRequest() returned true
 	OXT_FORCE_INLINE
 	bool requestAllowsStoring(Request *req) const {
@@ -630,7 +1322,7 @@ public:
 	Entry store(Request *req, ev_tstamp now, unsigned int headerSize, unsigned int bodySize) {
 		stores++;
 
-		if (headerSize > MAX_HEADER_SIZE || bodySize > MAX_BODY_SIZE) {
+		if (!canStore(req->cacheKey, headerSize, bodySize)) {
 			return Entry();
 		}
 
@@ -646,34 +1338,330 @@ public:
 
 		const HashedStaticString &cacheKey = req->cacheKey;
 		Entry entry(lookup(cacheKey));
-		if (!entry.valid()) {
-			entry = lookupInvalidOrOldest();
-			entry.header->valid   = true;
-			entry.header->hash    = cacheKey.hash();
-			entry.header->keySize = cacheKey.size();
-			memcpy(entry.body->key, cacheKey.data(), cacheKey.size());
+		if (entry.valid()) {
+			erase(entry.index);
 		}
+		entry = allocateEntry(cacheKey, headerSize, bodySize);
 		entry.header->date     = responseDate;
 		entry.body->expiryDate = expiryDate;
-		entry.body->httpHeaderSize = headerSize;
-		entry.body->httpBodySize   = bodySize;
+		if (req->appResponse.cacheControl != NULL) {
+			StaticString cacheControl(req->appResponse.cacheControl->start->data,
+				req->appResponse.cacheControl->size);
+			entry.body->staleWhileRevalidate = parseDeltaSecondsDirective(cacheControl,
+				P_STATIC_STRING("stale-while-revalidate"));
+			entry.body->staleIfError = parseDeltaSecondsDirective(cacheControl,
+				P_STATIC_STRING("stale-if-error"));
+		}
+		entry.body->hasValidators = req->appResponse.headers.lookup(ETAG) != NULL
+			|| req->appResponse.headers.lookup(LAST_MODIFIED) != NULL;
 		storeSuccesses++;
 		return entry;
 	}
 
 
+	/**
+	 * Checks whether the request's If-None-Match or If-Modified-Since header
+	 * matches the given fresh entry, in which case the request may be
+	 * answered with 304 Not Modified (RFC 7232 section 6).
+	 *
+	 * @pre requestAllowsFetching()
+	 */
+	bool requestIsNotModified(Request *req, const Entry &entry) const {
+		if (!entry.body->hasValidators) {
+			return false;
+		}
+
+		const LString *value = req->headers.lookup(IF_NONE_MATCH);
+		if (value != NULL) {
+			// If-Modified-Since must be ignored if If-None-Match is present.
+			StaticString etag = getEntityTag(req, entry,
+				requestGetsCompressedBody(req, entry));
+			if (etag.empty()) {
+				return false;
+			}
+			value = psg_lstr_make_contiguous(value, req->pool);
+			return entityTagListMatches(StaticString(value->start->data, value->size),
+				etag);
+		}
+
+		value = req->headers.lookup(IF_MODIFIED_SINCE);
+		if (value != NULL) {
+			time_t lastModified = parseHttpDate(lookupHeader(entry,
+				P_STATIC_STRING("last-modified")));
+			if (lastModified == (time_t) -1) {
+				return false;
+			}
+			value = psg_lstr_make_contiguous(value, req->pool);
+			time_t since = parseHttpDate(StaticString(value->start->data, value->size));
+			return since != (time_t) -1 && lastModified <= since;
+		}
+
+		return false;
+	}
+
+	// @pre prepareRequest() returned true
+	bool requestHasConditions(Request *req) const {
+		return req->headers.lookup(IF_NONE_MATCH) != NULL
+			|| req->headers.lookup(IF_MODIFIED_SINCE) != NULL;
+	}
+
+	/**
+	 * Looks up an expired entry that can be revalidated with the app, because
+	 * it has validators. Fresh entries are not returned: use fetch() for those.
+	 *
+	 * @pre prepareRequest() returned true
+	 */
+	Entry fetchForRevalidation(Request *req, ev_tstamp now) {
+		Entry entry(lookup(req->cacheKey));
+		if (entry.valid() && !isFresh(entry, now) && isRevalidatable(entry, now)) {
+			entry.header->referenced = true;
+			return entry;
+		} else {
+			return Entry();
+		}
+	}
+
+	/**
+	 * Turns the request into a conditional request that asks the app whether
+	 * the given entry is still valid, by adding If-None-Match and
+	 * If-Modified-Since headers for the entry's validators. The entry's
+	 * data must outlive the request, so pass a copy made by copyEntry().
+	 *
+	 * @pre !requestHasConditions()
+	 */
+	void addRevalidationConditions(Request *req, const Entry &entry) {
+		StaticString value = lookupHeader(entry, P_STATIC_STRING("etag"));
+		if (!value.empty()) {
+			req->headers.insert(req->pool, P_STATIC_STRING("If-None-Match"), value);
+		}
+		value = lookupHeader(entry, P_STATIC_STRING("last-modified"));
+		if (!value.empty()) {
+			req->headers.insert(req->pool, P_STATIC_STRING("If-Modified-Since"), value);
+		}
+	}
+
+	/**
+	 * Called when the app responded with 304 Not Modified to a request that
+	 * revalidated the given entry, which is a copy made by copyEntry().
+	 * Renews the entry's freshness according to the 304 response, storing it
+	 * again if it was removed from the cache in the meantime. Returns the
+	 * entry to respond with, which is either a cache entry or the copy.
+	 */
+	Entry revalidate(Request *req, Entry &copy, ev_tstamp now) {
+		ServerKit::HeaderTable &respHeaders = req->appResponse.headers;
+		time_t expiryDate;
+
+		time_t responseDate = parseDate(req->pool, req->appResponse.date, now);
+		if (responseDate == (time_t) -1) {
+			responseDate = (time_t) now;
+		}
+
+		req->appResponse.cacheControl = respHeaders.lookup(CACHE_CONTROL);
+		req->appResponse.expiresHeader = respHeaders.lookup(EXPIRES);
+		if (req->appResponse.cacheControl == NULL && req->appResponse.expiresHeader == NULL) {
+			// Keep the entry's freshness lifetime.
+			expiryDate = (time_t) now + (copy.body->expiryDate - copy.header->date);
+		} else {
+			if (req->appResponse.cacheControl != NULL) {
+				req->appResponse.cacheControl = psg_lstr_make_contiguous(
+					req->appResponse.cacheControl, req->pool);
+				StaticString cacheControl(req->appResponse.cacheControl->start->data,
+					req->appResponse.cacheControl->size);
+				copy.body->staleWhileRevalidate = parseDeltaSecondsDirective(cacheControl,
+					P_STATIC_STRING("stale-while-revalidate"));
+				copy.body->staleIfError = parseDeltaSecondsDirective(cacheControl,
+					P_STATIC_STRING("stale-if-error"));
+			}
+			if (req->appResponse.expiresHeader != NULL) {
+				req->appResponse.expiresHeader = psg_lstr_make_contiguous(
+					req->appResponse.expiresHeader, req->pool);
+			}
+			expiryDate = determineExpiryDate(req, responseDate, now);
+		}
+
+		copy.header->date = responseDate;
+		if (expiryDate == (time_t) -1 || expiryDate <= now) {
+			// The app no longer allows the entry to be reused, but it
+			// has just been validated, so this request may still use it.
+			invalidateKey(req->cacheKey);
+			copy.body->expiryDate = (time_t) now + 1;
+			return copy;
+		}
+		copy.body->expiryDate = expiryDate;
+
+		const HashedStaticString &cacheKey = req->cacheKey;
+		Entry entry(lookup(cacheKey));
+		if (!entry.valid()) {
+			if (!canStore(cacheKey, copy.body->httpHeaderSize, copy.body->httpBodySize)) {
+				return copy;
+			}
+			entry = allocateEntry(cacheKey, copy.body->httpHeaderSize,
+				copy.body->httpBodySize);
+			memcpy(entry.body->httpHeaderData, copy.body->httpHeaderData,
+				copy.body->httpHeaderSize);
+			memcpy(entry.body->httpBodyData, copy.body->httpBodyData,
+				copy.body->httpBodySize);
+			entry.body->hasValidators = copy.body->hasValidators;
+		}
+		entry.header->date = copy.header->date;
+		entry.header->referenced = true;
+		entry.body->expiryDate = copy.body->expiryDate;
+		entry.body->staleWhileRevalidate = copy.body->staleWhileRevalidate;
+		entry.body->staleIfError = copy.body->staleIfError;
+		publish(entry);
+		return entry;
+	}
+
+
+	/**
+	 * Whether the given entry's body is worth compressing: it's not too small,
+	 * it's not compressed already, and its content type is textual.
+	 */
+	bool isCompressible(const Entry &entry) const {
+		if (entry.body->httpBodySize < MIN_COMPRESSIBLE_SIZE
+		 || entry.body->gzipBodyData != NULL
+		 || !lookupHeader(entry, P_STATIC_STRING("content-encoding")).empty())
+		{
+			return false;
+		}
+
+		StaticString contentType = lookupHeader(entry, P_STATIC_STRING("content-type"));
+		return startsWith(contentType, P_STATIC_STRING("text/"))
+			|| contentType.find(P_STATIC_STRING("json")) != string::npos
+			|| contentType.find(P_STATIC_STRING("javascript")) != string::npos
+			|| contentType.find(P_STATIC_STRING("xml")) != string::npos;
+	}
+
+	/**
+	 * Attaches a gzip-compressed body to the entry in the given slot, evicting
+	 * other entries as necessary to stay within the memory budget. Does nothing
+	 * if the entry has been replaced since `entryId` was obtained. Returns
+	 * whether the compressed body was attached.
+	 */
+	bool setCompressedBody(unsigned int slot, boost::uint32_t entryId,
+		const StaticString &data)
+	{
+		if (slot >= headers.size() || !headers[slot].valid
+		 || bodies[slot].id != entryId || bodies[slot].gzipBodyData != NULL
+		 || data.empty() || data.size() >= bodies[slot].httpBodySize)
+		{
+			return false;
+		}
+
+		// Keep the entry itself from being evicted.
+		headers[slot].referenced = true;
+		while (memoryUsage + data.size() > maxMemory) {
+			evictOne();
+			if (!headers[slot].valid) {
+				return false;
+			}
+		}
+
+		Body &body = bodies[slot];
+		body.gzipBodyData = new char[data.size()];
+		body.gzipBodySize = data.size();
+		memcpy(body.gzipBodyData, data.data(), data.size());
+		memoryUsage += data.size();
+		return true;
+	}
+
+	/**
+	 * Whether the response to the given request should contain the entry's
+	 * gzip-compressed body instead of the original one.
+	 */
+	bool requestGetsCompressedBody(Request *req, const Entry &entry) const {
+		return entry.body->gzipBodyData != NULL && requestAcceptsGzip(req);
+	}
+
+	/**
+	 * Returns the value of the ETag header that a response with the given
+	 * entry must carry, or the empty string if it has none. For the gzip
+	 * variant, "-gzip" is appended to the opaque tag, like Apache's
+	 * mod_deflate does, so that the two representations never match each
+	 * other's entity tags, not even with the weak comparison function.
+	 * Merely marking the tag as weak would not achieve that. The result may
+	 * be allocated from the request's pool.
+	 */
+	StaticString getEntityTag(Request *req, const Entry &entry, bool gzip) const {
+		StaticString etag = lookupHeader(entry, P_STATIC_STRING("etag"));
+		if (!gzip || etag.size() < 2 || etag[etag.size() - 1] != '"') {
+			return etag;
+		}
+
+		char *result = (char *) psg_pnalloc(req->pool,
+			etag.size() + sizeof("-gzip") - 1);
+		char *pos = result;
+		const char *end = result + etag.size() + sizeof("-gzip") - 1;
+		pos = appendData(pos, end, etag.data(), etag.size() - 1);
+		pos = appendData(pos, end, "-gzip\"", sizeof("-gzip\"") - 1);
+		return StaticString(result, pos - result);
+	}
+
+	/**
+	 * Whether the request's Accept-Encoding header allows a gzip-compressed
+	 * response. Only explicit `gzip` tokens count: `*` is rare in practice.
+	 */
+	bool requestAcceptsGzip(Request *req) const {
+		const LString *value = req->headers.lookup(ACCEPT_ENCODING);
+		if (value == NULL) {
+			return false;
+		}
+
+		value = psg_lstr_make_contiguous(value, req->pool);
+		StaticString acceptEncoding(value->start->data, value->size);
+		string::size_type pos = acceptEncoding.find(P_STATIC_STRING("gzip"));
+		if (pos == string::npos) {
+			return false;
+		}
+
+		// Reject `gzip;q=0`, `gzip; q=0.0` and the like.
+		const char *param = acceptEncoding.data() + pos + sizeof("gzip") - 1;
+		const char *end = acceptEncoding.data() + acceptEncoding.size();
+		while (param < end && *param == ' ') {
+			param++;
+		}
+		if (param == end || *param != ';') {
+			return true;
+		}
+		do {
+			param++;
+		} while (param < end && *param == ' ');
+		if (end - param < 3 || param[0] != 'q' || param[1] != '=') {
+			return true;
+		}
+		param += 2;
+		while (param < end && (*param == '0' || *param == '.')) {
+			param++;
+		}
+		return param < end && *param >= '1' && *param <= '9';
+	}
+
+
 	// @pre prepareRequest() returned true
 	// @pre !requestAllowsStoring() || !prepareRequestForStoring()
 	bool requestAllowsInvalidating(Request *req) const {
 		return req->method != HTTP_GET;
 	}
 
+	/**
+	 * Publishes an entry returned by store() to the shared cache, if any.
+	 * Must be called after the entry's HTTP data has been filled in.
+	 */
+	void publish(const Entry &entry) {
+		if (sharedCache != NULL) {
+			sharedCache->store(
+				HashedStaticString(entry.body->key, entry.header->keySize),
+				entry.header->date, entry.body->expiryDate,
+				StaticString(entry.body->httpHeaderData, entry.body->httpHeaderSize),
+				StaticString(entry.body->httpBodyData, entry.body->httpBodySize),
+				entry.body->staleWhileRevalidate, entry.body->staleIfError);
+		}
+	}
+
+
 	// @pre requestAllowsInvalidating()
 	void invalidate(Request *req) {
-		Entry entry(lookup(req->cacheKey));
-		if (entry.valid()) {
-			entry.header->valid = false;
-		}
+		invalidateKey(req->cacheKey);
 
 		invalidateLocation(req, LOCATION);
 		invalidateLocation(req, CONTENT_LOCATION);
@@ -682,7 +1670,10 @@ public:
 
 	string inspect() const {
 		stringstream stream;
-		for (unsigned int i = 0; i < MAX_ENTRIES; i++) {
+		for (unsigned int i = 0; i < headers.size(); i++) {
+			if (!headers[i].valid) {
+				continue;
+			}
 			time_t expiryDate = bodies[i].expiryDate;
 			stream << " #" << i << ": valid=" << headers[i].valid
 				<< ", hash=" << headers[i].hash
@@ -0,0 +1,191 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_RESPONSE_COMPRESSOR_H_
+#define _PASSENGER_RESPONSE_COMPRESSOR_H_
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+#include <boost/container/vector.hpp>
+#include <oxt/thread.hpp>
+#include <oxt/backtrace.hpp>
+#include <zlib.h>
+#include <string>
+#include <cstring>
+#include <StaticString.h>
+
+namespace Passenger {
+
+using namespace std;
+
+
+/**
+ * Compresses response bodies with gzip in a background thread, so that
+ * ResponseCache entries can be served pre-compressed without the event loop
+ * ever spending time on compression.
+ *
+ * Jobs are submitted with submit() and finished jobs are collected with
+ * takeResults(), which the owner should call regularly from its event loop.
+ * The background thread never calls into the event loop, so the owner doesn't
+ * have to worry about callbacks arriving after it has moved on. The thread is
+ * only started once the first job is submitted.
+ */
+class ResponseCompressor: public boost::noncopyable {
+public:
+	/** Jobs beyond this number are dropped instead of queued. */
+	static const unsigned int MAX_PENDING_JOBS = 64;
+
+	struct Job {
+		// Identifies the entry to which the result belongs.
+		unsigned int slot;
+		boost::uint32_t entryId;
+		// The data to compress. Once the job is finished, this contains
+		// the compressed data, or is empty if compression failed or
+		// didn't make the data smaller.
+		string data;
+	};
+
+private:
+	boost::mutex syncher;
+	boost::condition_variable cond;
+	boost::container::vector<Job> pendingJobs;
+	boost::container::vector<Job> finishedJobs;
+	boost::atomic<bool> hasFinishedJobs;
+	oxt::thread *thr;
+
+	void threadMain() {
+		TRACE_POINT();
+		boost::unique_lock<boost::mutex> l(syncher);
+		Job job;
+
+		while (!boost::this_thread::interruption_requested()) {
+			while (pendingJobs.empty()) {
+				// Interruption point.
+				cond.wait(l);
+			}
+			job.slot = pendingJobs.front().slot;
+			job.entryId = pendingJobs.front().entryId;
+			job.data.swap(pendingJobs.front().data);
+			pendingJobs.erase(pendingJobs.begin());
+			l.unlock();
+
+			string compressed;
+			if (!gzip(job.data, compressed) || compressed.size() >= job.data.size()) {
+				compressed.clear();
+			}
+			job.data.swap(compressed);
+
+			l.lock();
+			finishedJobs.push_back(job);
+			hasFinishedJobs.store(true, boost::memory_order_release);
+		}
+	}
+
+public:
+	ResponseCompressor()
+		: hasFinishedJobs(false),
+		  thr(NULL)
+		{ }
+
+	~ResponseCompressor() {
+		TRACE_POINT();
+		if (thr != NULL) {
+			boost::this_thread::disable_interruption di;
+			boost::this_thread::disable_syscall_interruption dsi;
+			thr->interrupt_and_join();
+			delete thr;
+			thr = NULL;
+		}
+	}
+
+	/**
+	 * Queues the given data for compression. Returns false if too many
+	 * jobs are pending.
+	 */
+	bool submit(unsigned int slot, boost::uint32_t entryId, const StaticString &data) {
+		boost::lock_guard<boost::mutex> l(syncher);
+		if (pendingJobs.size() >= MAX_PENDING_JOBS) {
+			return false;
+		}
+		if (thr == NULL) {
+			thr = new oxt::thread(boost::bind(&ResponseCompressor::threadMain, this),
+				"Turbocache compressor", 128 * 1024);
+		}
+		pendingJobs.push_back(Job());
+		pendingJobs.back().slot = slot;
+		pendingJobs.back().entryId = entryId;
+		pendingJobs.back().data.assign(data.data(), data.size());
+		cond.notify_one();
+		return true;
+	}
+
+	/**
+	 * Moves the finished jobs into `result`. This is cheap if there are
+	 * none, so it may be called on every event loop iteration.
+	 */
+	void takeResults(boost::container::vector<Job> &result) {
+		if (!hasFinishedJobs.load(boost::memory_order_acquire)) {
+			return;
+		}
+		boost::lock_guard<boost::mutex> l(syncher);
+		result.swap(finishedJobs);
+		finishedJobs.clear();
+		hasFinishedJobs.store(false, boost::memory_order_relaxed);
+	}
+
+	/** Compresses the given data into the gzip format. */
+	static bool gzip(const StaticString &input, string &output) {
+		z_stream stream;
+
+		memset(&stream, 0, sizeof(stream));
+		// A window size of 15 bits + 16 selects the gzip format.
+		if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+			15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+		{
+			return false;
+		}
+
+		output.resize(deflateBound(&stream, input.size()));
+		stream.next_in = (Bytef *) input.data();
+		stream.avail_in = input.size();
+		stream.next_out = (Bytef *) &output[0];
+		stream.avail_out = output.size();
+		int ret = deflate(&stream, Z_FINISH);
+		deflateEnd(&stream);
+		if (ret != Z_STREAM_END) {
+			return false;
+		}
+		output.resize(stream.total_out);
+		return true;
+	}
+};
+
+
+} // namespace Passenger
+
+#endif /* _PASSENGER_RESPONSE_COMPRESSOR_H_ */
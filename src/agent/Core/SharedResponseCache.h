@@ -0,0 +1,509 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_SHARED_RESPONSE_CACHE_H_
+#define _PASSENGER_SHARED_RESPONSE_CACHE_H_
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread.hpp>
+#include <boost/container/vector.hpp>
+#include <oxt/macros.hpp>
+#include <time.h>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <utility>
+#include <DataStructures/HashedStaticString.h>
+#include <StaticString.h>
+
+namespace Passenger {
+
+using namespace std;
+
+
+/**
+ * A response cache that is shared by all Controller threads. Each Controller's
+ * own ResponseCache acts as a first level cache in front of it: responses that
+ * a thread stores are published here, and responses that miss a thread's own
+ * cache are looked up here and copied into it. This way, a response only has to
+ * miss once per process instead of once per thread.
+ *
+ * Entries are immutable once published. Lookups do not take any locks: a reader
+ * registers the current epoch in its own reader slot for the duration of a
+ * ReadGuard, and writers (which are serialized by a mutex) only free unlinked
+ * entries once no reader can be accessing them anymore, i.e. once all readers
+ * have either left or entered a later epoch. Because lookups may run concurrently
+ * with writers shifting entries around, a lookup may occasionally miss an entry
+ * that is being moved. That is harmless for a cache.
+ *
+ * Like ResponseCache, the memory usage is bounded and entries are evicted using
+ * the CLOCK algorithm. Lookups only set an entry's reference bit.
+ */
+class SharedResponseCache: public boost::noncopyable {
+public:
+	class Entry {
+	private:
+		friend class SharedResponseCache;
+
+		boost::uint32_t hash;
+		unsigned short keySize;
+		unsigned short httpHeaderSize;
+		unsigned int httpBodySize;
+		time_t date;
+		time_t expiryDate;
+		unsigned int staleWhileRevalidate;
+		unsigned int staleIfError;
+		mutable boost::atomic<bool> referenced;
+
+		// The key, the HTTP header data and the HTTP body data follow
+		// the Entry object in the same allocation.
+		char *getData() {
+			return (char *) (this + 1);
+		}
+
+		const char *getData() const {
+			return (const char *) (this + 1);
+		}
+
+	public:
+		StaticString getKey() const {
+			return StaticString(getData(), keySize);
+		}
+
+		StaticString getHttpHeaderData() const {
+			return StaticString(getData() + keySize, httpHeaderSize);
+		}
+
+		StaticString getHttpBodyData() const {
+			return StaticString(getData() + keySize + httpHeaderSize, httpBodySize);
+		}
+
+		time_t getDate() const {
+			return date;
+		}
+
+		time_t getExpiryDate() const {
+			return expiryDate;
+		}
+
+		unsigned int getStaleWhileRevalidate() const {
+			return staleWhileRevalidate;
+		}
+
+		unsigned int getStaleIfError() const {
+			return staleIfError;
+		}
+	};
+
+	/**
+	 * Entries returned by lookup() may only be accessed while
+	 * the ReadGuard that was used for the lookup is alive.
+	 */
+	class ReadGuard: public boost::noncopyable {
+	private:
+		SharedResponseCache *cache;
+		unsigned int reader;
+
+	public:
+		ReadGuard(SharedResponseCache *_cache, unsigned int _reader)
+			: cache(_cache),
+			  reader(_reader)
+		{
+			cache->enterReadSection(reader);
+		}
+
+		~ReadGuard() {
+			cache->leaveReadSection(reader);
+		}
+	};
+
+private:
+	static const unsigned int MIN_BUCKETS = 64;
+	// A rough lower bound on the size of an entry, used for determining
+	// how many buckets we need for the memory budget.
+	static const unsigned int MIN_EXPECTED_ENTRY_SIZE = 256;
+
+	struct ReaderSlot {
+		// 0 if the reader is not in a read section.
+		boost::atomic<boost::uint64_t> epoch;
+		char padding[64 - sizeof(boost::atomic<boost::uint64_t>)];
+
+		ReaderSlot()
+			: epoch(0)
+			{ }
+	};
+
+	// A fixed size open addressing hash table with linear probing.
+	// Size is a power of 2, and at most half of the buckets are in use.
+	boost::atomic<Entry *> *buckets;
+	unsigned int nbuckets;
+
+	ReaderSlot *readerSlots;
+	unsigned int nreaders;
+	boost::atomic<boost::uint64_t> globalEpoch;
+
+	// All fields below are protected by this mutex.
+	boost::mutex syncher;
+	size_t maxMemory;
+	size_t memoryUsage;
+	unsigned int entryCount;
+	unsigned int clockHand;
+	unsigned int stores;
+	unsigned int evictions;
+	// Unlinked entries, and the epoch in which they were unlinked.
+	boost::container::vector< pair<boost::uint64_t, Entry *> > retiredEntries;
+
+
+	static unsigned int calculateBucketCount(size_t maxMemory) {
+		size_t result = MIN_BUCKETS;
+		while (result < 2 * (maxMemory / MIN_EXPECTED_ENTRY_SIZE) && result < 0x40000000) {
+			result *= 2;
+		}
+		return result;
+	}
+
+	static size_t calculateEntryMemoryUsage(const Entry *entry) {
+		return sizeof(Entry) + 2 * sizeof(boost::atomic<Entry *>)
+			+ entry->keySize + entry->httpHeaderSize + entry->httpBodySize;
+	}
+
+	void enterReadSection(unsigned int reader) {
+		assert(reader < nreaders);
+		readerSlots[reader].epoch.store(globalEpoch.load(boost::memory_order_acquire),
+			boost::memory_order_relaxed);
+		// Pairs with the fence in reclaimRetiredEntries(): either the writer sees
+		// that we're in a read section, or we see that the entry has been unlinked.
+		boost::atomic_thread_fence(boost::memory_order_seq_cst);
+	}
+
+	void leaveReadSection(unsigned int reader) {
+		readerSlots[reader].epoch.store(0, boost::memory_order_release);
+	}
+
+	OXT_FORCE_INLINE
+	unsigned int getMask() const {
+		return nbuckets - 1;
+	}
+
+	// @pre syncher is locked
+	int findBucket(const HashedStaticString &key) const {
+		unsigned int mask = getMask();
+		unsigned int i = key.hash() & mask;
+		Entry *entry;
+
+		while ((entry = buckets[i].load(boost::memory_order_relaxed)) != NULL) {
+			if (entry->hash == key.hash() && entry->getKey() == key) {
+				return i;
+			}
+			i = (i + 1) & mask;
+		}
+		return -1;
+	}
+
+	/**
+	 * Unlinks the entry in the given bucket and retires it. Subsequent entries
+	 * in the same probe sequence are shifted back.
+	 *
+	 * @pre syncher is locked
+	 */
+	void removeBucket(unsigned int i) {
+		unsigned int mask = getMask();
+		unsigned int j = i;
+		Entry *entry = buckets[i].load(boost::memory_order_relaxed);
+
+		memoryUsage -= calculateEntryMemoryUsage(entry);
+		entryCount--;
+
+		while (true) {
+			Entry *moved;
+			unsigned int home;
+			do {
+				j = (j + 1) & mask;
+				moved = buckets[j].load(boost::memory_order_relaxed);
+				if (moved == NULL) {
+					buckets[i].store(NULL, boost::memory_order_release);
+					retire(entry);
+					return;
+				}
+				home = moved->hash & mask;
+				// Bucket j may only be moved to i if its home bucket
+				// does not lie cyclically in (i, j].
+			} while (i <= j ? (i < home && home <= j) : (i < home || home <= j));
+			buckets[i].store(moved, boost::memory_order_release);
+			i = j;
+		}
+	}
+
+	// @pre syncher is locked
+	void retire(Entry *entry) {
+		boost::uint64_t epoch = globalEpoch.fetch_add(1, boost::memory_order_acq_rel);
+		retiredEntries.push_back(make_pair(epoch, entry));
+	}
+
+	// @pre syncher is locked
+	void reclaimRetiredEntries() {
+		if (retiredEntries.empty()) {
+			return;
+		}
+
+		boost::atomic_thread_fence(boost::memory_order_seq_cst);
+		boost::uint64_t oldestActiveEpoch = ~(boost::uint64_t) 0;
+		for (unsigned int i = 0; i < nreaders; i++) {
+			boost::uint64_t epoch = readerSlots[i].epoch.load(boost::memory_order_acquire);
+			if (epoch != 0 && epoch < oldestActiveEpoch) {
+				oldestActiveEpoch = epoch;
+			}
+		}
+
+		// A reader in epoch E may have seen entries that were unlinked in epoch E
+		// or later, but not entries that were unlinked before E.
+		unsigned int i = 0;
+		while (i < retiredEntries.size()) {
+			if (retiredEntries[i].first < oldestActiveEpoch) {
+				destroyEntry(retiredEntries[i].second);
+				retiredEntries[i] = retiredEntries.back();
+				retiredEntries.pop_back();
+			} else {
+				i++;
+			}
+		}
+	}
+
+	/**
+	 * Evicts one entry according to the CLOCK algorithm.
+	 *
+	 * @pre syncher is locked
+	 * @pre entryCount > 0
+	 */
+	void evictOne() {
+		assert(entryCount > 0);
+		while (true) {
+			clockHand &= getMask();
+			Entry *entry = buckets[clockHand].load(boost::memory_order_relaxed);
+			if (entry != NULL) {
+				if (entry->referenced.load(boost::memory_order_relaxed)) {
+					entry->referenced.store(false, boost::memory_order_relaxed);
+				} else {
+					removeBucket(clockHand);
+					evictions++;
+					return;
+				}
+			}
+			clockHand++;
+		}
+	}
+
+	static Entry *createEntry(const HashedStaticString &key, time_t date, time_t expiryDate,
+		const StaticString &httpHeaderData, const StaticString &httpBodyData,
+		unsigned int staleWhileRevalidate, unsigned int staleIfError)
+	{
+		size_t size = sizeof(Entry) + key.size() + httpHeaderData.size() + httpBodyData.size();
+		void *memory = malloc(size);
+		if (memory == NULL) {
+			return NULL;
+		}
+
+		Entry *entry = new (memory) Entry();
+		entry->hash = key.hash();
+		entry->keySize = key.size();
+		entry->httpHeaderSize = httpHeaderData.size();
+		entry->httpBodySize = httpBodyData.size();
+		entry->date = date;
+		entry->expiryDate = expiryDate;
+		entry->staleWhileRevalidate = staleWhileRevalidate;
+		entry->staleIfError = staleIfError;
+		entry->referenced.store(false, boost::memory_order_relaxed);
+
+		char *pos = entry->getData();
+		memcpy(pos, key.data(), key.size());
+		pos += key.size();
+		memcpy(pos, httpHeaderData.data(), httpHeaderData.size());
+		pos += httpHeaderData.size();
+		memcpy(pos, httpBodyData.data(), httpBodyData.size());
+		return entry;
+	}
+
+	static void destroyEntry(Entry *entry) {
+		entry->~Entry();
+		free(entry);
+	}
+
+public:
+	/**
+	 * @param maxReaders The number of threads that will perform lookups.
+	 *                   Each of them must use a distinct reader number
+	 *                   in [0, maxReaders).
+	 */
+	SharedResponseCache(size_t _maxMemory, unsigned int maxReaders)
+		: nbuckets(calculateBucketCount(_maxMemory)),
+		  nreaders(maxReaders),
+		  globalEpoch(1),
+		  maxMemory(_maxMemory),
+		  memoryUsage(0),
+		  entryCount(0),
+		  clockHand(0),
+		  stores(0),
+		  evictions(0)
+	{
+		buckets = new boost::atomic<Entry *>[nbuckets];
+		for (unsigned int i = 0; i < nbuckets; i++) {
+			buckets[i].store(NULL, boost::memory_order_relaxed);
+		}
+		readerSlots = new ReaderSlot[nreaders];
+	}
+
+	/** @pre There are no readers. */
+	~SharedResponseCache() {
+		for (unsigned int i = 0; i < nbuckets; i++) {
+			Entry *entry = buckets[i].load(boost::memory_order_relaxed);
+			if (entry != NULL) {
+				destroyEntry(entry);
+			}
+		}
+		for (unsigned int i = 0; i < retiredEntries.size(); i++) {
+			destroyEntry(retiredEntries[i].second);
+		}
+		delete[] buckets;
+		delete[] readerSlots;
+	}
+
+	/**
+	 * Looks up the entry with the given key. Returns NULL if not found.
+	 * Does not check whether the entry is still fresh.
+	 *
+	 * @pre The calling thread holds a ReadGuard.
+	 */
+	const Entry *lookup(const HashedStaticString &key) const {
+		unsigned int mask = getMask();
+		unsigned int i = key.hash() & mask;
+		const Entry *entry;
+
+		while ((entry = buckets[i].load(boost::memory_order_acquire)) != NULL) {
+			if (entry->hash == key.hash() && entry->getKey() == key) {
+				entry->referenced.store(true, boost::memory_order_relaxed);
+				return entry;
+			}
+			i = (i + 1) & mask;
+		}
+		return NULL;
+	}
+
+	/**
+	 * Publishes an entry, replacing any existing entry with the same key and
+	 * evicting other entries as necessary. Returns whether it was stored.
+	 *
+	 * `staleWhileRevalidate` and `staleIfError` are the entry's stale windows
+	 * in seconds, as described in ResponseCache::Body.
+	 */
+	bool store(const HashedStaticString &key, time_t date, time_t expiryDate,
+		const StaticString &httpHeaderData, const StaticString &httpBodyData,
+		unsigned int staleWhileRevalidate = 0, unsigned int staleIfError = 0)
+	{
+		Entry *entry = createEntry(key, date, expiryDate, httpHeaderData, httpBodyData,
+			staleWhileRevalidate, staleIfError);
+		if (entry == NULL) {
+			return false;
+		}
+
+		size_t size = calculateEntryMemoryUsage(entry);
+		boost::lock_guard<boost::mutex> l(syncher);
+		stores++;
+		if (size > maxMemory) {
+			destroyEntry(entry);
+			return false;
+		}
+
+		int existing = findBucket(key);
+		if (existing != -1) {
+			removeBucket(existing);
+		}
+		while (memoryUsage + size > maxMemory || (entryCount + 1) * 2 > nbuckets) {
+			evictOne();
+		}
+
+		unsigned int mask = getMask();
+		unsigned int i = key.hash() & mask;
+		while (buckets[i].load(boost::memory_order_relaxed) != NULL) {
+			i = (i + 1) & mask;
+		}
+		buckets[i].store(entry, boost::memory_order_release);
+		memoryUsage += size;
+		entryCount++;
+
+		reclaimRetiredEntries();
+		return true;
+	}
+
+	void invalidate(const HashedStaticString &key) {
+		boost::lock_guard<boost::mutex> l(syncher);
+		int i = findBucket(key);
+		if (i != -1) {
+			removeBucket(i);
+		}
+		reclaimRetiredEntries();
+	}
+
+	unsigned int getMaxReaders() const {
+		return nreaders;
+	}
+
+	size_t getMaxMemory() const {
+		return maxMemory;
+	}
+
+	size_t getMemoryUsage() {
+		boost::lock_guard<boost::mutex> l(syncher);
+		return memoryUsage;
+	}
+
+	unsigned int getEntryCount() {
+		boost::lock_guard<boost::mutex> l(syncher);
+		return entryCount;
+	}
+
+	unsigned int getStores() {
+		boost::lock_guard<boost::mutex> l(syncher);
+		return stores;
+	}
+
+	unsigned int getEvictions() {
+		boost::lock_guard<boost::mutex> l(syncher);
+		return evictions;
+	}
+
+	/** The number of unlinked entries that are still waiting for readers to leave. */
+	unsigned int getRetiredEntryCount() {
+		boost::lock_guard<boost::mutex> l(syncher);
+		return retiredEntries.size();
+	}
+};
+
+
+} // namespace Passenger
+
+#endif /* _PASSENGER_SHARED_RESPONSE_CACHE_H_ */
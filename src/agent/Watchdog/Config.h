@@ -73,9 +73,12 @@ using namespace std;
  *   controller_file_buffered_channel_max_disk_chunk_read_size                unsigned integer   -          default(0)
  *   controller_file_buffered_channel_threshold                               unsigned integer   -          default(131072)
  *   controller_mbuf_block_chunk_size                                         unsigned integer   -          default(4096),read_only
+ *   controller_mbuf_large_block_chunk_size                                   unsigned integer   -          default(65536),read_only
+ *   controller_mbuf_slabs                                                    boolean            -          default(false),read_only
  *   controller_min_spare_clients                                             unsigned integer   -          default(0)
  *   controller_pid_file                                                      string             -          default,read_only
  *   controller_request_freelist_limit                                        unsigned integer   -          default(1024)
+ *   controller_reuse_port                                                    boolean            -          default(false),read_only
  *   controller_secure_headers_password                                       string             -          default,secret
  *   controller_socket_backlog                                                unsigned integer   -          default(2048),read_only
  *   controller_start_reading_after_accept                                    boolean            -          default(true)
@@ -91,6 +94,8 @@ using namespace std;
  *   core_api_server_file_buffered_channel_max_disk_chunk_read_size           unsigned integer   -          default(0)
  *   core_api_server_file_buffered_channel_threshold                          unsigned integer   -          default(131072)
  *   core_api_server_mbuf_block_chunk_size                                    unsigned integer   -          default(4096),read_only
+ *   core_api_server_mbuf_large_block_chunk_size                              unsigned integer   -          default(65536),read_only
+ *   core_api_server_mbuf_slabs                                               boolean            -          default(false),read_only
  *   core_api_server_min_spare_clients                                        unsigned integer   -          default(0)
  *   core_api_server_request_freelist_limit                                   unsigned integer   -          default(1024)
  *   core_api_server_start_reading_after_accept                               boolean            -          default(true)
@@ -112,6 +117,7 @@ using namespace std;
  *   default_nodejs                                                           string             -          default("node")
  *   default_python                                                           string             -          default("python")
  *   default_ruby                                                             string             -          default("ruby")
+ *   default_sendfile_root                                                    string             -          -
  *   default_server_name                                                      string             -          default
  *   default_server_port                                                      unsigned integer   -          default
  *   default_spawn_method                                                     string             -          default("smart")
@@ -136,6 +142,7 @@ using namespace std;
  *   pool_selfchecks                                                          boolean            -          default(false)
  *   prestart_urls                                                            array of strings   -          default([]),read_only
  *   response_buffer_high_watermark                                           unsigned integer   -          default(134217728)
+ *   response_splicing                                                        boolean            -          default(true)
  *   security_update_checker_certificate_path                                 string             -          -
  *   security_update_checker_disabled                                         boolean            -          default(false)
  *   security_update_checker_interval                                         unsigned integer   -          default(86400)
@@ -150,6 +157,13 @@ using namespace std;
  *   standalone_engine                                                        string             -          default
  *   startup_report_file                                                      string             -          -
  *   stat_throttle_rate                                                       unsigned integer   -          default(10)
+ *   turbocache_compression                                                   boolean            -          default(true),read_only
+ *   turbocache_fetch_threshold                                               unsigned integer   -          default(20),read_only
+ *   turbocache_max_body_size                                                 unsigned integer   -          default(32768),read_only
+ *   turbocache_max_memory                                                    unsigned integer   -          default(4194304),read_only
+ *   turbocache_min_hit_ratio                                                 float              -          default(0.5),read_only
+ *   turbocache_shared                                                        boolean            -          default(false),read_only
+ *   turbocache_shared_max_memory                                             unsigned integer   -          default(33554432),read_only
  *   turbocaching                                                             boolean            -          default(true),read_only
  *   user                                                                     string             -          default,read_only
  *   user_switching                                                           boolean            -          default(true)
@@ -167,6 +181,8 @@ using namespace std;
  *   watchdog_api_server_file_buffered_channel_max_disk_chunk_read_size       unsigned integer   -          default(0)
  *   watchdog_api_server_file_buffered_channel_threshold                      unsigned integer   -          default(131072)
  *   watchdog_api_server_mbuf_block_chunk_size                                unsigned integer   -          default(4096),read_only
+ *   watchdog_api_server_mbuf_large_block_chunk_size                          unsigned integer   -          default(65536),read_only
+ *   watchdog_api_server_mbuf_slabs                                           boolean            -          default(false),read_only
  *   watchdog_api_server_min_spare_clients                                    unsigned integer   -          default(0)
  *   watchdog_api_server_request_freelist_limit                               unsigned integer   -          default(1024)
  *   watchdog_api_server_start_reading_after_accept                           boolean            -          default(true)
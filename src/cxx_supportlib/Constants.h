@@ -59,6 +59,7 @@
 #define DEFAULT_MAX_PRELOADER_IDLE_TIME 300
 #define DEFAULT_MAX_REQUEST_QUEUE_SIZE 100
 #define DEFAULT_MBUF_CHUNK_SIZE 4096
+#define DEFAULT_MBUF_LARGE_CHUNK_SIZE 65536
 #define DEFAULT_NODEJS "node"
 #define DEFAULT_POOL_IDLE_TIME 300
 #define DEFAULT_PYTHON "python"
@@ -69,6 +70,11 @@
 #define DEFAULT_START_TIMEOUT 90000
 #define DEFAULT_STAT_THROTTLE_RATE 10
 #define DEFAULT_STICKY_SESSIONS_COOKIE_NAME "_passenger_route"
+#define DEFAULT_TURBOCACHE_FETCH_THRESHOLD 20
+#define DEFAULT_TURBOCACHE_MAX_BODY_SIZE 32768
+#define DEFAULT_TURBOCACHE_MAX_MEMORY 4194304
+#define DEFAULT_TURBOCACHE_MIN_HIT_RATIO 0.5
+#define DEFAULT_TURBOCACHE_SHARED_MAX_MEMORY 33554432
 #define DEFAULT_WEB_APP_USER "nobody"
 #define ENTERPRISE_URL "https://www.phusionpassenger.com/enterprise"
 #define FEEDBACK_FD 3
@@ -0,0 +1,229 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_DATA_STRUCTURES_INDEXED_MIN_HEAP_H_
+#define _PASSENGER_DATA_STRUCTURES_INDEXED_MIN_HEAP_H_
+
+#include <boost/container/vector.hpp>
+#include <cassert>
+
+namespace Passenger {
+
+
+/**
+ * An array of keys that also keeps track of which element has the smallest key.
+ * Elements are identified by their index in the array, just like in a normal
+ * array. Finding the element with the smallest key is O(1), while changing a key
+ * or appending an element is O(log n).
+ *
+ * If multiple elements have the same smallest key, then the one with the lowest
+ * index is considered the smallest. This makes `top()` return exactly the same
+ * element as a linear scan for the first element with the smallest key would.
+ *
+ * Internally, this is a binary min-heap of element indices, plus a reverse
+ * mapping from element index to heap position so that keys can be changed
+ * in place. Maintaining the heap only pays off for larger arrays though: a
+ * linear scan over a small, contiguous array is faster than updating the heap
+ * on every change. So as long as there are no more than LINEAR_SCAN_THRESHOLD
+ * elements, the heap is not maintained and `top()` performs a linear scan.
+ */
+template<typename Key>
+class IndexedMinHeap {
+public:
+	static const unsigned int LINEAR_SCAN_THRESHOLD = 64;
+
+private:
+	/** Keys, by element index. */
+	boost::container::vector<Key> keys;
+	/** Element indices, in heap order. */
+	boost::container::vector<unsigned int> heap;
+	/** Positions in `heap`, by element index. */
+	boost::container::vector<unsigned int> positions;
+
+	static bool less(const Key *keys, unsigned int a, unsigned int b) {
+		return keys[a] < keys[b] || (!(keys[b] < keys[a]) && a < b);
+	}
+
+	void siftUp(unsigned int pos) {
+		const Key *keys = &this->keys[0];
+		unsigned int *heap = &this->heap[0];
+		unsigned int *positions = &this->positions[0];
+		unsigned int elem = heap[pos];
+
+		while (pos > 0) {
+			unsigned int parent = (pos - 1) / 2;
+			if (!less(keys, elem, heap[parent])) {
+				break;
+			}
+			heap[pos] = heap[parent];
+			positions[heap[pos]] = pos;
+			pos = parent;
+		}
+		heap[pos] = elem;
+		positions[elem] = pos;
+	}
+
+	void siftDown(unsigned int pos) {
+		const Key *keys = &this->keys[0];
+		unsigned int *heap = &this->heap[0];
+		unsigned int *positions = &this->positions[0];
+		unsigned int elem = heap[pos];
+		unsigned int size = this->heap.size();
+
+		while (true) {
+			unsigned int child = 2 * pos + 1;
+			if (child >= size) {
+				break;
+			}
+			if (child + 1 < size && less(keys, heap[child + 1], heap[child])) {
+				child++;
+			}
+			if (!less(keys, heap[child], elem)) {
+				break;
+			}
+			heap[pos] = heap[child];
+			positions[heap[pos]] = pos;
+			pos = child;
+		}
+		heap[pos] = elem;
+		positions[elem] = pos;
+	}
+
+	bool usingHeap() const {
+		return keys.size() > LINEAR_SCAN_THRESHOLD;
+	}
+
+	unsigned int linearScan() const {
+		const Key *keys = &this->keys[0];
+		unsigned int result = 0;
+		unsigned int size = this->keys.size();
+		Key lowest = keys[0];
+
+		for (unsigned int i = 1; i < size; i++) {
+			if (keys[i] < lowest) {
+				result = i;
+				lowest = keys[i];
+			}
+		}
+		return result;
+	}
+
+	void rebuildHeap() {
+		if (!usingHeap()) {
+			heap.clear();
+			positions.clear();
+			return;
+		}
+
+		unsigned int size = keys.size();
+		heap.resize(size);
+		positions.resize(size);
+		for (unsigned int i = 0; i < size; i++) {
+			heap[i] = i;
+			positions[i] = i;
+		}
+		for (unsigned int i = size / 2; i > 0; i--) {
+			siftDown(i - 1);
+		}
+	}
+
+public:
+	unsigned int size() const {
+		return keys.size();
+	}
+
+	bool empty() const {
+		return keys.empty();
+	}
+
+	const Key &operator[](unsigned int index) const {
+		return keys[index];
+	}
+
+	/**
+	 * Returns the index of the element with the smallest key.
+	 * The heap must not be empty.
+	 */
+	unsigned int top() const {
+		assert(!empty());
+		if (usingHeap()) {
+			return heap[0];
+		} else {
+			return linearScan();
+		}
+	}
+
+	/** Appends an element, which gets index `size() - 1`. */
+	void push_back(const Key &key) {
+		unsigned int elem = keys.size();
+		keys.push_back(key);
+		if (keys.size() == LINEAR_SCAN_THRESHOLD + 1) {
+			rebuildHeap();
+		} else if (usingHeap()) {
+			heap.push_back(elem);
+			positions.push_back(elem);
+			siftUp(elem);
+		}
+	}
+
+	void set(unsigned int index, const Key &key) {
+		if (!usingHeap()) {
+			keys[index] = key;
+		} else if (key < keys[index]) {
+			keys[index] = key;
+			siftUp(positions[index]);
+		} else if (keys[index] < key) {
+			keys[index] = key;
+			siftDown(positions[index]);
+		}
+	}
+
+	/**
+	 * Removes the element at the given index. Just like with a normal array,
+	 * the indices of all subsequent elements are decreased by one.
+	 * This is O(n).
+	 */
+	void erase(unsigned int index) {
+		keys.erase(keys.begin() + index);
+		rebuildHeap();
+	}
+
+	void clear() {
+		keys.clear();
+		heap.clear();
+		positions.clear();
+	}
+
+	void shrink_to_fit() {
+		keys.shrink_to_fit();
+		heap.shrink_to_fit();
+		positions.shrink_to_fit();
+	}
+};
+
+
+} // namespace Passenger
+
+#endif /* _PASSENGER_DATA_STRUCTURES_INDEXED_MIN_HEAP_H_ */
@@ -16,6 +16,12 @@
  * limitations under the License.
  */
 
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#ifdef __linux__
+	#include <sys/syscall.h>
+#endif
 #include <cstdlib>
 #include <cstring>
 #include <oxt/macros.hpp>
@@ -44,8 +50,39 @@ namespace MemoryKit {
 	} while (false)
 
 static void mbuf_block_print(struct mbuf_block *mbuf_block, std::ostream &stream);
+static void mbuf_block_free(struct mbuf_block *mbuf_block);
 
 
+static size_t
+_mbuf_pool_chunk_size(struct mbuf_pool *pool, unsigned int size_class)
+{
+	if (size_class == MBUF_LARGE_BLOCK) {
+		return pool->large_mbuf_block_chunk_size;
+	} else {
+		return pool->mbuf_block_chunk_size;
+	}
+}
+
+static size_t
+_mbuf_pool_block_offset(struct mbuf_pool *pool, unsigned int size_class)
+{
+	if (size_class == MBUF_LARGE_BLOCK) {
+		return pool->large_mbuf_block_offset;
+	} else {
+		return pool->mbuf_block_offset;
+	}
+}
+
+static struct mhdr *
+_mbuf_pool_freeq(struct mbuf_pool *pool, unsigned int size_class)
+{
+	if (size_class == MBUF_LARGE_BLOCK) {
+		return &pool->free_large_mbuf_blockq;
+	} else {
+		return &pool->free_mbuf_blockq;
+	}
+}
+
 static void
 _mbuf_block_mark_as_active(struct mbuf_pool *pool, struct mbuf_block *mbuf_block)
 {
@@ -58,10 +95,36 @@ _mbuf_block_mark_as_active(struct mbuf_pool *pool, struct mbuf_block *mbuf_block
 	#endif
 	mbuf_block->refcount = 1;
 	pool->nactive_mbuf_blockq++;
+	if (mbuf_block->size_class == MBUF_LARGE_BLOCK) {
+		pool->nactive_large_mbuf_blockq++;
+	}
+}
+
+static void
+_mbuf_block_mark_as_free(struct mbuf_pool *pool, struct mbuf_block *mbuf_block)
+{
+	pool->nfree_mbuf_blockq++;
+	pool->nactive_mbuf_blockq--;
+	if (mbuf_block->size_class == MBUF_LARGE_BLOCK) {
+		pool->nfree_large_mbuf_blockq++;
+		pool->nactive_large_mbuf_blockq--;
+	}
+}
+
+static void
+_mbuf_block_unmark_as_free(struct mbuf_pool *pool, unsigned int size_class)
+{
+	assert(pool->nfree_mbuf_blockq > 0);
+	pool->nfree_mbuf_blockq--;
+	if (size_class == MBUF_LARGE_BLOCK) {
+		assert(pool->nfree_large_mbuf_blockq > 0);
+		pool->nfree_large_mbuf_blockq--;
+	}
 }
 
 static struct mbuf_block *
-_mbuf_block_init(struct mbuf_pool *pool, char *buf, size_t block_offset)
+_mbuf_block_init(struct mbuf_pool *pool, char *buf, size_t block_offset,
+	unsigned int size_class, struct mbuf_slab *slab)
 {
 	struct mbuf_block *mbuf_block;
 
@@ -73,10 +136,13 @@ _mbuf_block_init(struct mbuf_pool *pool, char *buf, size_t block_offset)
 	 * mbuf_block header is at the tail end of the mbuf_block. The data
 	 * precedes the header. This enables us to catch buffer overrun early
 	 * by asserting on the magic value during get or put operations.
-	 * All normal mbuf_blocks in a pool have the same mbuf_block_offset,
-	 * allowing them to be reused through a freelist.
+	 * All normal mbuf_blocks of the same size class in a pool have the same
+	 * mbuf_block_offset, allowing them to be reused through a freelist.
+	 * Normal mbuf_blocks are either malloc()ed individually, or carved out of
+	 * a slab (see _mbuf_slab_block_get()), in which case 'slab' is set.
 	 *
 	 *   <------------ pool->mbuf_block_chunk_size -------------->
+	 *      (pool->large_mbuf_block_chunk_size for large blocks)
 	 *   +-------------------------------------------------------+
 	 *   |       mbuf_block data          |  mbuf_block header   |
 	 *   |                                |                      |
@@ -113,56 +179,267 @@ _mbuf_block_init(struct mbuf_pool *pool, char *buf, size_t block_offset)
 	mbuf_block = (struct mbuf_block *)(buf + block_offset);
 	mbuf_block->magic = MBUF_BLOCK_MAGIC;
 	mbuf_block->pool  = pool;
+	mbuf_block->slab  = slab;
 	mbuf_block->offset = 0;
+	mbuf_block->size_class = size_class;
 
 	_mbuf_block_mark_as_active(pool, mbuf_block);
 	return mbuf_block;
 }
 
+/*
+ * Binds the given slab arena to the NUMA node of the CPU that the calling
+ * thread runs on. Each pool belongs to a single event loop thread, so this
+ * keeps the pool's buffers local to the CPU that reads and writes them.
+ * This is only a preference: it fails silently on kernels without NUMA
+ * support, in which case the default first-touch policy has the same effect
+ * as long as the thread doesn't migrate.
+ */
+static void
+_mbuf_slab_bind_to_local_numa_node(char *base)
+{
+	#if defined(__linux__) && defined(SYS_getcpu) && defined(SYS_mbind)
+		static const int MPOL_PREFERRED_ = 1;
+		static const unsigned int MAX_NODES = 1024;
+		const unsigned int BITS_PER_LONG = 8 * sizeof(unsigned long);
+		unsigned long nodemask[MAX_NODES / (8 * sizeof(unsigned long))];
+		unsigned int cpu, node;
+
+		if (syscall(SYS_getcpu, &cpu, &node, NULL) != 0 || node >= MAX_NODES) {
+			return;
+		}
+		memset(nodemask, 0, sizeof(nodemask));
+		nodemask[node / BITS_PER_LONG] |= 1UL << (node % BITS_PER_LONG);
+		syscall(SYS_mbind, base, (unsigned long) MBUF_SLAB_SIZE,
+			MPOL_PREFERRED_, nodemask, (unsigned long) MAX_NODES + 1, 0);
+	#endif
+}
+
+/*
+ * Maps an MBUF_SLAB_SIZE arena, aligned to MBUF_SLAB_SIZE. We try an explicit
+ * huge page first. That only works if the administrator reserved huge pages
+ * (vm.nr_hugepages), so we fall back to normal pages and advise the kernel
+ * to back the arena with a transparent huge page.
+ */
+static char *
+_mbuf_slab_map_arena()
+{
+	char *mem, *base, *end;
+
+	#ifdef MAP_HUGETLB
+		mem = (char *) mmap(NULL, MBUF_SLAB_SIZE, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+		if (mem != (char *) MAP_FAILED) {
+			_mbuf_slab_bind_to_local_numa_node(mem);
+			return mem;
+		}
+	#endif
+
+	mem = (char *) mmap(NULL, 2 * MBUF_SLAB_SIZE, PROT_READ | PROT_WRITE,
+		MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (OXT_UNLIKELY(mem == (char *) MAP_FAILED)) {
+		return NULL;
+	}
+	base = (char *) (((size_t) mem + MBUF_SLAB_SIZE - 1)
+		& ~((size_t) MBUF_SLAB_SIZE - 1));
+	end = mem + 2 * MBUF_SLAB_SIZE;
+	if (base > mem) {
+		munmap(mem, base - mem);
+	}
+	if (end > base + MBUF_SLAB_SIZE) {
+		munmap(base + MBUF_SLAB_SIZE, end - (base + MBUF_SLAB_SIZE));
+	}
+
+	#ifdef MADV_HUGEPAGE
+		madvise(base, MBUF_SLAB_SIZE, MADV_HUGEPAGE);
+	#endif
+	_mbuf_slab_bind_to_local_numa_node(base);
+	return base;
+}
+
+static struct mbuf_slab *
+_mbuf_slab_new(struct mbuf_pool *pool, unsigned int size_class)
+{
+	struct mbuf_slab *slab;
+	size_t chunk_size = _mbuf_pool_chunk_size(pool, size_class);
+
+	if (chunk_size > MBUF_SLAB_SIZE) {
+		return NULL;
+	}
+
+	slab = (struct mbuf_slab *) malloc(sizeof(struct mbuf_slab));
+	if (OXT_UNLIKELY(slab == NULL)) {
+		return NULL;
+	}
+	slab->base = _mbuf_slab_map_arena();
+	if (OXT_UNLIKELY(slab->base == NULL)) {
+		free(slab);
+		return NULL;
+	}
+
+	STAILQ_INIT(&slab->free_mbuf_blockq);
+	slab->size_class = size_class;
+	slab->nblocks = MBUF_SLAB_SIZE / chunk_size;
+	slab->ncarved = 0;
+	slab->nactive = 0;
+	pool->nslabs++;
+	return slab;
+}
+
+static void
+_mbuf_slab_free(struct mbuf_pool *pool, struct mbuf_slab *slab)
+{
+	assert(slab->nactive == 0);
+	assert(pool->nslabs > 0);
+
+	/* All blocks carved from this slab are on its freelist. They are counted
+	 * as free blocks, but they disappear together with the arena.
+	 */
+	pool->nfree_mbuf_blockq -= slab->ncarved;
+	if (slab->size_class == MBUF_LARGE_BLOCK) {
+		pool->nfree_large_mbuf_blockq -= slab->ncarved;
+	}
+	pool->nslabs--;
+	munmap(slab->base, MBUF_SLAB_SIZE);
+	free(slab);
+}
+
+/*
+ * Gets a block from a slab. Each size class has a list of slabs that still
+ * have space for at least one block. A slab first hands out blocks that were
+ * put back on its own freelist, and otherwise carves the next block from its
+ * arena, so that pages are only touched when needed. When no slab has space,
+ * we use the spare slab (see _mbuf_slab_block_put()) or map a new one.
+ */
 static struct mbuf_block *
-_mbuf_block_get(struct mbuf_pool *pool)
+_mbuf_slab_block_get(struct mbuf_pool *pool, unsigned int size_class)
 {
+	struct mbuf_slab_list *partial_slabq = &pool->partial_slabq[size_class];
+	struct mbuf_slab *slab = TAILQ_FIRST(partial_slabq);
 	struct mbuf_block *mbuf_block;
-	char *buf;
 
-	if (!STAILQ_EMPTY(&pool->free_mbuf_blockq)) {
-		assert(pool->nfree_mbuf_blockq > 0);
+	if (slab == NULL) {
+		if (pool->spare_slab[size_class] != NULL) {
+			slab = pool->spare_slab[size_class];
+			pool->spare_slab[size_class] = NULL;
+		} else {
+			slab = _mbuf_slab_new(pool, size_class);
+			if (slab == NULL) {
+				return NULL;
+			}
+		}
+		TAILQ_INSERT_HEAD(partial_slabq, slab, partial_q);
+	}
+
+	if (!STAILQ_EMPTY(&slab->free_mbuf_blockq)) {
+		mbuf_block = STAILQ_FIRST(&slab->free_mbuf_blockq);
+		ASSERT_MBUF_BLOCK_PROPERTY(mbuf_block, mbuf_block->magic == MBUF_BLOCK_MAGIC);
+		ASSERT_MBUF_BLOCK_PROPERTY(mbuf_block, mbuf_block->refcount == 0);
+		ASSERT_MBUF_BLOCK_PROPERTY(mbuf_block, mbuf_block->slab == slab);
+
+		STAILQ_REMOVE_HEAD(&slab->free_mbuf_blockq, next);
+		_mbuf_block_unmark_as_free(pool, size_class);
+		_mbuf_block_mark_as_active(pool, mbuf_block);
+	} else {
+		assert(slab->ncarved < slab->nblocks);
+		mbuf_block = _mbuf_block_init(pool,
+			slab->base + slab->ncarved * _mbuf_pool_chunk_size(pool, size_class),
+			_mbuf_pool_block_offset(pool, size_class),
+			size_class, slab);
+		slab->ncarved++;
+	}
 
-		mbuf_block = STAILQ_FIRST(&pool->free_mbuf_blockq);
+	slab->nactive++;
+	if (slab->nactive == slab->nblocks) {
+		TAILQ_REMOVE(partial_slabq, slab, partial_q);
+	}
+	return mbuf_block;
+}
+
+/*
+ * Puts a block back on its slab's freelist. A slab that becomes completely
+ * free is kept as the size class's spare slab if there isn't one yet, and
+ * unmapped otherwise. This gives memory back to the OS one slab at a time
+ * when traffic drops, while the spare slab prevents mapping and unmapping
+ * a slab over and over when the number of active blocks hovers around a
+ * slab boundary.
+ */
+static void
+_mbuf_slab_block_put(struct mbuf_pool *pool, struct mbuf_block *mbuf_block)
+{
+	struct mbuf_slab *slab = mbuf_block->slab;
+	struct mbuf_slab_list *partial_slabq = &pool->partial_slabq[slab->size_class];
+
+	assert(slab->nactive > 0);
+	STAILQ_INSERT_HEAD(&slab->free_mbuf_blockq, mbuf_block, next);
+	if (slab->nactive == slab->nblocks) {
+		TAILQ_INSERT_TAIL(partial_slabq, slab, partial_q);
+	}
+	slab->nactive--;
+
+	if (slab->nactive == 0) {
+		TAILQ_REMOVE(partial_slabq, slab, partial_q);
+		if (pool->spare_slab[slab->size_class] == NULL) {
+			pool->spare_slab[slab->size_class] = slab;
+		} else {
+			_mbuf_slab_free(pool, slab);
+		}
+	}
+}
+
+static struct mbuf_block *
+_mbuf_block_get(struct mbuf_pool *pool, unsigned int size_class)
+{
+	struct mhdr *freeq = _mbuf_pool_freeq(pool, size_class);
+	struct mbuf_block *mbuf_block;
+	char *buf;
+
+	if (!STAILQ_EMPTY(freeq)) {
+		mbuf_block = STAILQ_FIRST(freeq);
 		ASSERT_MBUF_BLOCK_PROPERTY(mbuf_block, mbuf_block->magic == MBUF_BLOCK_MAGIC);
 		ASSERT_MBUF_BLOCK_PROPERTY(mbuf_block, mbuf_block->refcount == 0);
 
-		pool->nfree_mbuf_blockq--;
-		STAILQ_REMOVE_HEAD(&pool->free_mbuf_blockq, next);
+		STAILQ_REMOVE_HEAD(freeq, next);
+		_mbuf_block_unmark_as_free(pool, size_class);
 		_mbuf_block_mark_as_active(pool, mbuf_block);
 		return mbuf_block;
 	}
 
-	buf = (char *) malloc(pool->mbuf_block_chunk_size);
+	if (pool->use_slabs) {
+		mbuf_block = _mbuf_slab_block_get(pool, size_class);
+		if (mbuf_block != NULL) {
+			return mbuf_block;
+		}
+		/* The slab could not be mapped. Fall back to malloc(). */
+	}
+
+	buf = (char *) malloc(_mbuf_pool_chunk_size(pool, size_class));
 	if (OXT_UNLIKELY(buf == NULL)) {
 		return NULL;
 	}
 
-	return _mbuf_block_init(pool, buf, pool->mbuf_block_offset);
+	return _mbuf_block_init(pool, buf, _mbuf_pool_block_offset(pool, size_class),
+		size_class, NULL);
 }
 
-struct mbuf_block *
-mbuf_block_get(struct mbuf_pool *pool)
+static struct mbuf_block *
+_mbuf_block_get_with_size_class(struct mbuf_pool *pool, unsigned int size_class)
 {
 	struct mbuf_block *mbuf_block;
+	size_t block_offset = _mbuf_pool_block_offset(pool, size_class);
 	char *buf;
 
-	mbuf_block = _mbuf_block_get(pool);
+	mbuf_block = _mbuf_block_get(pool, size_class);
 	if (OXT_UNLIKELY(mbuf_block == NULL)) {
 		return NULL;
 	}
 
-	buf = (char *)mbuf_block - pool->mbuf_block_offset;
+	buf = (char *)mbuf_block - block_offset;
 	mbuf_block->start = buf;
-	mbuf_block->end = buf + pool->mbuf_block_offset;
+	mbuf_block->end = buf + block_offset;
 
 	ASSERT_MBUF_BLOCK_PROPERTY(mbuf_block,
-		mbuf_block->end - mbuf_block->start == (int) pool->mbuf_block_offset);
+		mbuf_block->end - mbuf_block->start == (int) block_offset);
 	ASSERT_MBUF_BLOCK_PROPERTY(mbuf_block, mbuf_block->start < mbuf_block->end);
 
 	#ifdef MBUF_DEBUG_REFCOUNTS
@@ -172,6 +449,12 @@ mbuf_block_get(struct mbuf_pool *pool)
 	return mbuf_block;
 }
 
+struct mbuf_block *
+mbuf_block_get(struct mbuf_pool *pool)
+{
+	return _mbuf_block_get_with_size_class(pool, MBUF_SMALL_BLOCK);
+}
+
 struct mbuf_block *
 mbuf_block_new_standalone(struct mbuf_pool *pool, size_t size)
 {
@@ -185,7 +468,7 @@ mbuf_block_new_standalone(struct mbuf_pool *pool, size_t size)
 		return NULL;
 	}
 
-	mbuf_block = _mbuf_block_init(pool, buf, block_offset);
+	mbuf_block = _mbuf_block_init(pool, buf, block_offset, MBUF_SMALL_BLOCK, NULL);
 	mbuf_block->start = buf;
 	mbuf_block->end = buf + size;
 	mbuf_block->offset = block_offset;
@@ -213,6 +496,7 @@ mbuf_block_free(struct mbuf_block *mbuf_block)
 
 	ASSERT_MBUF_BLOCK_PROPERTY(mbuf_block, STAILQ_NEXT(mbuf_block, next) == NULL);
 	ASSERT_MBUF_BLOCK_PROPERTY(mbuf_block, mbuf_block->magic == MBUF_BLOCK_MAGIC);
+	ASSERT_MBUF_BLOCK_PROPERTY(mbuf_block, mbuf_block->slab == NULL);
 
 	#ifdef MBUF_ENABLE_DEBUGGING
 		TAILQ_REMOVE(&mbuf_block->pool->active_mbuf_blockq, mbuf_block, active_q);
@@ -224,7 +508,8 @@ mbuf_block_free(struct mbuf_block *mbuf_block)
 	if (mbuf_block->offset > 0) {
 		buf = (char *) mbuf_block - mbuf_block->offset;
 	} else {
-		buf = (char *) mbuf_block - mbuf_block->pool->mbuf_block_offset;
+		buf = (char *) mbuf_block - _mbuf_pool_block_offset(mbuf_block->pool,
+			mbuf_block->size_class);
 	}
 	free(buf);
 }
@@ -242,13 +527,17 @@ mbuf_block_put(struct mbuf_block *mbuf_block)
 	ASSERT_MBUF_BLOCK_PROPERTY(mbuf_block, mbuf_block->pool->nactive_mbuf_blockq > 0);
 	ASSERT_MBUF_BLOCK_PROPERTY(mbuf_block, mbuf_block->offset == 0);
 
-	mbuf_block->pool->nfree_mbuf_blockq++;
-	mbuf_block->pool->nactive_mbuf_blockq--;
-	STAILQ_INSERT_HEAD(&mbuf_block->pool->free_mbuf_blockq, mbuf_block, next);
-
 	#ifdef MBUF_ENABLE_DEBUGGING
 		TAILQ_REMOVE(&mbuf_block->pool->active_mbuf_blockq, mbuf_block, active_q);
 	#endif
+
+	_mbuf_block_mark_as_free(mbuf_block->pool, mbuf_block);
+	if (mbuf_block->slab != NULL) {
+		_mbuf_slab_block_put(mbuf_block->pool, mbuf_block);
+	} else {
+		STAILQ_INSERT_HEAD(_mbuf_pool_freeq(mbuf_block->pool, mbuf_block->size_class),
+			mbuf_block, next);
+	}
 }
 
 /*
@@ -280,6 +569,47 @@ mbuf_pool_init(struct mbuf_pool *pool)
 	#endif
 
 	pool->mbuf_block_offset = pool->mbuf_block_chunk_size - MBUF_BLOCK_HSIZE;
+
+	pool->nfree_large_mbuf_blockq = 0;
+	pool->nactive_large_mbuf_blockq = 0;
+	STAILQ_INIT(&pool->free_large_mbuf_blockq);
+	pool->large_mbuf_block_chunk_size = 0;
+	pool->large_mbuf_block_offset = 0;
+
+	pool->use_slabs = false;
+	pool->nslabs = 0;
+	for (unsigned int i = 0; i < MBUF_NSIZE_CLASSES; i++) {
+		TAILQ_INIT(&pool->partial_slabq[i]);
+		pool->spare_slab[i] = NULL;
+	}
+}
+
+/*
+ * Enables the large size class, with the given chunk size. Has no effect
+ * if the chunk size is not larger than the small chunk size. Must be called
+ * right after mbuf_pool_init().
+ */
+void
+mbuf_pool_enable_large_blocks(struct mbuf_pool *pool, size_t chunk_size)
+{
+	assert(pool->nactive_mbuf_blockq == 0);
+	assert(pool->nfree_mbuf_blockq == 0);
+	if (chunk_size > pool->mbuf_block_chunk_size) {
+		pool->large_mbuf_block_chunk_size = chunk_size;
+		pool->large_mbuf_block_offset = chunk_size - MBUF_BLOCK_HSIZE;
+	}
+}
+
+/*
+ * Makes the pool carve its blocks out of slabs instead of malloc()ing them
+ * individually. Must be called right after mbuf_pool_init().
+ */
+void
+mbuf_pool_enable_slabs(struct mbuf_pool *pool)
+{
+	assert(pool->nactive_mbuf_blockq == 0);
+	assert(pool->nfree_mbuf_blockq == 0);
+	pool->use_slabs = true;
 }
 
 void
@@ -298,20 +628,41 @@ mbuf_pool_data_size(struct mbuf_pool *pool)
 	return pool->mbuf_block_offset;
 }
 
+/*
+ * Return the data size of large mbuf_blocks, or the data size of small
+ * mbuf_blocks if the large size class is disabled.
+ */
+size_t
+mbuf_pool_large_data_size(struct mbuf_pool *pool)
+{
+	return std::max(pool->large_mbuf_block_offset, pool->mbuf_block_offset);
+}
+
+/*
+ * Frees all free mbuf_blocks, and unmaps all spare slabs. Slabs that still
+ * have active blocks are left alone; their free blocks are kept as well.
+ */
 unsigned int
 mbuf_pool_compact(struct mbuf_pool *pool)
 {
 	unsigned int count = pool->nfree_mbuf_blockq;
 
-	while (!STAILQ_EMPTY(&pool->free_mbuf_blockq)) {
-		struct mbuf_block *mbuf_block = STAILQ_FIRST(&pool->free_mbuf_blockq);
-		mbuf_block_remove(&pool->free_mbuf_blockq, mbuf_block);
-		mbuf_block_free(mbuf_block);
-		pool->nfree_mbuf_blockq--;
+	for (unsigned int i = 0; i < MBUF_NSIZE_CLASSES; i++) {
+		struct mhdr *freeq = _mbuf_pool_freeq(pool, i);
+		while (!STAILQ_EMPTY(freeq)) {
+			struct mbuf_block *mbuf_block = STAILQ_FIRST(freeq);
+			mbuf_block_remove(freeq, mbuf_block);
+			mbuf_block_free(mbuf_block);
+			_mbuf_block_unmark_as_free(pool, i);
+		}
+
+		if (pool->spare_slab[i] != NULL) {
+			_mbuf_slab_free(pool, pool->spare_slab[i]);
+			pool->spare_slab[i] = NULL;
+		}
 	}
-	assert(pool->nfree_mbuf_blockq == 0);
 
-	return count;
+	return count - pool->nfree_mbuf_blockq;
 }
 
 
@@ -385,6 +736,8 @@ mbuf_get_with_size(struct mbuf_pool *pool, size_t size)
 	struct mbuf_block *block;
 	if (size <= mbuf_pool_data_size(pool)) {
 		block = mbuf_block_get(pool);
+	} else if (size <= pool->large_mbuf_block_offset) {
+		block = _mbuf_block_get_with_size_class(pool, MBUF_LARGE_BLOCK);
 	} else {
 		block = mbuf_block_new_standalone(pool, size);
 	}
@@ -408,11 +761,17 @@ mbuf_block_print(struct mbuf_block *mbuf_block, std::ostream &stream)
 			mbuf_block->end - mbuf_block->start)) << "\"\n"
 		"mbuf_block.refcount: " << mbuf_block->refcount << "\n"
 		"mbuf_block.offset: " << mbuf_block->offset << "\n"
+		"mbuf_block.size_class: " << mbuf_block->size_class << "\n"
+		"mbuf_block.slab: " << (void *) mbuf_block->slab << "\n"
 		"mbuf_block.pool: " << (void *) mbuf_block->pool << "\n"
 		"mbuf_block.pool.nfree_mbuf_blockq: " << mbuf_block->pool->nfree_mbuf_blockq << "\n"
 		"mbuf_block.pool.nactive_mbuf_blockq: " << mbuf_block->pool->nactive_mbuf_blockq << "\n"
 		"mbuf_block.pool.mbuf_block_chunk_size: " << mbuf_block->pool->mbuf_block_chunk_size << "\n"
-		"mbuf_block.pool.mbuf_block_offset: " << mbuf_block->pool->mbuf_block_offset << "\n";
+		"mbuf_block.pool.mbuf_block_offset: " << mbuf_block->pool->mbuf_block_offset << "\n"
+		"mbuf_block.pool.nfree_large_mbuf_blockq: " << mbuf_block->pool->nfree_large_mbuf_blockq << "\n"
+		"mbuf_block.pool.nactive_large_mbuf_blockq: " << mbuf_block->pool->nactive_large_mbuf_blockq << "\n"
+		"mbuf_block.pool.large_mbuf_block_chunk_size: " << mbuf_block->pool->large_mbuf_block_chunk_size << "\n"
+		"mbuf_block.pool.nslabs: " << mbuf_block->pool->nslabs << "\n";
 }
 
 
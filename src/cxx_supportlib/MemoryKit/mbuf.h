@@ -54,6 +54,15 @@
  * This approach is similar to how Node.js manages buffer slices.
  * We also got rid of the global variables, and put them in an mbuf_pool
  * struct, which acts like a context structure.
+ *
+ * A pool can optionally have a second, large size class, so that callers
+ * which know they are going to move a lot of data (see mbuf_get_with_size())
+ * need fewer blocks and fewer syscalls, while idle connections keep using
+ * small blocks. A pool can also optionally carve its blocks out of 2 MB
+ * slabs backed by huge pages and bound to the local NUMA node, instead of
+ * malloc()ing every block. Slabs that become completely free are returned
+ * to the OS one at a time, so that memory is given back gradually after a
+ * traffic spike instead of only when the pool is compacted.
  */
 
 //#define MBUF_ENABLE_DEBUGGING
@@ -67,8 +76,16 @@ using namespace boost;
 
 
 struct mbuf_block;
+struct mbuf_slab;
 struct mhdr;
 
+/* Size classes of non-standalone mbuf_blocks. See mbuf_get_with_size(). */
+enum mbuf_size_class {
+	MBUF_SMALL_BLOCK,
+	MBUF_LARGE_BLOCK,
+	MBUF_NSIZE_CLASSES
+};
+
 typedef void (*mbuf_block_copy_t)(struct mbuf_block *, void *);
 
 /* See _mbuf_block_init() for format description */
@@ -84,25 +101,57 @@ struct mbuf_block {
 	char              *start;     /* start of buffer (const) */
 	char              *end;       /* end of buffer (const) */
 	struct mbuf_pool  *pool;      /* containing pool (const) */
+	struct mbuf_slab  *slab;      /* containing slab, or NULL if malloc'ed (const) */
 	boost::uint32_t    refcount;  /* number of references by mbuf subsets */
 	boost::uint32_t    offset;    /* standalone mbuf_block data size */
+	boost::uint32_t    size_class; /* enum mbuf_size_class (const) */
 };
 
 STAILQ_HEAD(mhdr, struct mbuf_block);
+
+/* A slab is an MBUF_SLAB_SIZE arena from which mbuf_blocks of a single size
+ * class are carved. See _mbuf_slab_block_get() for details.
+ */
+struct mbuf_slab {
+	TAILQ_ENTRY(struct mbuf_slab) partial_q; /* prev and next slab with free space */
+	struct mhdr free_mbuf_blockq; /* free mbuf_blocks carved from this slab */
+	char *base;                   /* start of arena (const) */
+	boost::uint32_t size_class;   /* enum mbuf_size_class (const) */
+	boost::uint32_t nblocks;      /* # mbuf_blocks that fit in the arena (const) */
+	boost::uint32_t ncarved;      /* # mbuf_blocks carved so far */
+	boost::uint32_t nactive;      /* # active mbuf_blocks */
+};
+
+TAILQ_HEAD(mbuf_slab_list, struct mbuf_slab);
 #ifdef MBUF_ENABLE_DEBUGGING
 	TAILQ_HEAD(active_mbuf_block_list, struct mbuf_block);
 #endif
 
 struct mbuf_pool {
-	boost::uint32_t nfree_mbuf_blockq;   /* # free mbuf_block */
-	boost::uint32_t nactive_mbuf_blockq; /* # active (non-free) mbuf_block */
-	struct mhdr free_mbuf_blockq; /* free mbuf_block q */
+	boost::uint32_t nfree_mbuf_blockq;   /* # free mbuf_block, all size classes */
+	boost::uint32_t nactive_mbuf_blockq; /* # active (non-free) mbuf_block, all size classes */
+	struct mhdr free_mbuf_blockq; /* free small mbuf_block q */
 	#ifdef MBUF_ENABLE_DEBUGGING
 		struct active_mbuf_block_list active_mbuf_blockq; /* active mbuf_block q */
 	#endif
 
 	size_t mbuf_block_chunk_size; /* mbuf_block chunk size - header + data (const) */
 	size_t mbuf_block_offset;     /* mbuf_block offset in chunk (const) */
+
+	/* Large size class. Disabled (chunk size 0) unless
+	 * mbuf_pool_enable_large_blocks() is called.
+	 */
+	boost::uint32_t nfree_large_mbuf_blockq;   /* # free large mbuf_block */
+	boost::uint32_t nactive_large_mbuf_blockq; /* # active large mbuf_block */
+	struct mhdr free_large_mbuf_blockq; /* free large mbuf_block q */
+	size_t large_mbuf_block_chunk_size; /* (const) */
+	size_t large_mbuf_block_offset;     /* (const) */
+
+	/* Slab allocation. Disabled unless mbuf_pool_enable_slabs() is called. */
+	bool use_slabs;
+	boost::uint32_t nslabs; /* # mapped slabs */
+	struct mbuf_slab_list partial_slabq[MBUF_NSIZE_CLASSES]; /* slabs with free space */
+	struct mbuf_slab *spare_slab[MBUF_NSIZE_CLASSES]; /* completely free slab kept for reuse */
 };
 
 #define MBUF_BLOCK_MAGIC      0xdeadbeef
@@ -110,13 +159,17 @@ struct mbuf_pool {
 #define MBUF_BLOCK_MAX_SIZE   16777216
 #define MBUF_BLOCK_SIZE       16384
 #define MBUF_BLOCK_HSIZE      sizeof(struct mbuf_block)
+#define MBUF_SLAB_SIZE        (2 * 1024 * 1024)
 
 #define MBUF_BLOCK_EMPTY(mbuf_block) ((mbuf_block)->pos  == (mbuf_block)->last)
 #define MBUF_BLOCK_FULL(mbuf_block)  ((mbuf_block)->last == (mbuf_block)->end)
 
 void mbuf_pool_init(struct mbuf_pool *pool);
+void mbuf_pool_enable_large_blocks(struct mbuf_pool *pool, size_t chunk_size);
+void mbuf_pool_enable_slabs(struct mbuf_pool *pool);
 void mbuf_pool_deinit(struct mbuf_pool *pool);
 size_t mbuf_pool_data_size(struct mbuf_pool *pool);
+size_t mbuf_pool_large_data_size(struct mbuf_pool *pool);
 unsigned int mbuf_pool_compact(struct mbuf_pool *pool);
 
 struct mbuf_block *mbuf_block_get(struct mbuf_pool *pool);
@@ -37,6 +37,9 @@ static void psg_deinit_pool(psg_pool_t *pool);
 static void psg_init_pool(psg_pool_t *pool, size_t size);
 static void *psg_palloc_block(psg_pool_t *pool, size_t size);
 static void *psg_palloc_large(psg_pool_t *pool, size_t size);
+static void *psg_alloc_block(psg_pool_cache_t *cache, size_t size);
+static void psg_free_block(psg_pool_cache_t *cache, void *block, size_t size);
+static void psg_free_large(psg_pool_t *pool, psg_pool_large_t *l);
 
 
 static void *
@@ -55,15 +58,16 @@ call_memalign(size_t alignment, size_t size) {
 
 
 psg_pool_t *
-psg_create_pool(size_t size)
+psg_create_pool(size_t size, psg_pool_cache_t *cache)
 {
 	psg_pool_t  *p;
 
-	p = (psg_pool_t *) call_memalign(PSG_POOL_ALIGNMENT, size);
+	p = (psg_pool_t *) psg_alloc_block(cache, size);
 	if (p == NULL) {
 		return NULL;
 	}
 
+	p->cache = cache;
 	psg_init_pool(p, size);
 
 	return p;
@@ -74,7 +78,7 @@ void
 psg_destroy_pool(psg_pool_t *pool)
 {
 	psg_deinit_pool(pool);
-	free(pool);
+	psg_free_block(pool->cache, pool, (size_t) (pool->data.end - (char *) pool));
 }
 
 
@@ -91,6 +95,8 @@ psg_init_pool(psg_pool_t *pool, size_t size)
 
 	pool->current = pool;
 	pool->large = NULL;
+	pool->nlarge = 0;
+	pool->large_size = 0;
 }
 
 
@@ -99,10 +105,11 @@ psg_deinit_pool(psg_pool_t *pool)
 {
 	psg_pool_t          *p;
 	psg_pool_large_t    *l;
+	size_t              psize = (size_t) (pool->data.end - (char *) pool);
 
 	for (l = pool->large; l; l = l->next) {
 		if (l->alloc) {
-			free(l->alloc);
+			psg_free_large(pool, l);
 			l->alloc = NULL;
 		}
 	}
@@ -110,18 +117,63 @@ psg_deinit_pool(psg_pool_t *pool)
 	p = pool->data.next;
 	while (p != NULL) {
 		psg_pool_t *next = p->data.next;
-		free(p);
+		psg_free_block(pool->cache, p, psize);
 		p = next;
 	}
 }
 
 
+/*
+ * Records how much memory the pool used since the last reset (its high
+ * water mark, because nothing is freed in between), and how many large
+ * allocations were made.
+ */
+static void
+psg_record_pool_usage(psg_pool_t *pool)
+{
+	psg_pool_cache_t  *cache = pool->cache;
+	psg_pool_t        *p;
+	uint64_t          used = pool->large_size;
+	unsigned int      i;
+
+	for (p = pool; p; p = p->data.next) {
+		char *start = (char *) p + (p == pool ? sizeof(psg_pool_t) : sizeof(psg_pool_data_t));
+		if (p->data.last > start) {
+			used += p->data.last - start;
+		}
+	}
+	if (used == 0) {
+		// Pool has already been reset.
+		return;
+	}
+
+	// Bucket i contains high water marks of at most 2^i KB.
+	for (i = 0; i < PSG_POOL_HIGH_WATER_MARK_BUCKETS - 1 && used > ((uint64_t) 1024 << i); i++) {
+		// Do nothing.
+	}
+	cache->high_water_marks[i]++;
+
+	// Bucket i > 0 contains counts of at least 2^(i-1).
+	for (i = 0; i < PSG_POOL_LARGE_COUNT_BUCKETS - 1 && (pool->nlarge >> i) > 0; i++) {
+		// Do nothing.
+	}
+	cache->large_counts[i]++;
+}
+
+
 bool
 psg_reset_pool(psg_pool_t *pool, size_t size)
 {
 	psg_pool_t        *p;
 	psg_pool_large_t  *l;
 
+	if (pool->cache != NULL) {
+		psg_record_pool_usage(pool);
+		psg_deinit_pool(pool);
+		psg_init_pool(pool, size);
+		return true;
+	}
+
 	for (l = pool->large; l; l = l->next) {
 		if (l->alloc) {
 			free(l->alloc);
@@ -216,7 +268,7 @@ psg_palloc_block(psg_pool_t *pool, size_t size)
 
 	psize = (size_t) (pool->data.end - (char *) pool);
 
-	m = (char *) call_memalign(PSG_POOL_ALIGNMENT, psize);
+	m = (char *) psg_alloc_block(pool->cache, psize);
 	if (m == NULL) {
 		return NULL;
 	}
@@ -251,23 +303,62 @@ psg_palloc_block(psg_pool_t *pool, size_t size)
 }
 
 
+/*
+ * Returns the cache size class for a large allocation of the given size,
+ * or -1 if it's too big to be cached.
+ */
+static int
+psg_large_size_class(size_t size)
+{
+	int i;
+
+	for (i = 0; i < PSG_POOL_CACHE_LARGE_CLASSES; i++) {
+		if (size <= ((size_t) PSG_POOL_CACHE_MIN_LARGE_SIZE << i)) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+
 static void *
 psg_palloc_large(psg_pool_t *pool, size_t size)
 {
 	void              *p;
 	unsigned int       n;
 	psg_pool_large_t  *large;
-
-	p = malloc(size);
+	psg_pool_cache_t  *cache = pool->cache;
+	size_t             class_size = 0;
+	int                size_class;
+
+	if (cache != NULL && (size_class = psg_large_size_class(size)) != -1) {
+		class_size = (size_t) PSG_POOL_CACHE_MIN_LARGE_SIZE << size_class;
+		if (cache->large[size_class] != NULL) {
+			p = cache->large[size_class];
+			cache->large[size_class] = *(void **) p;
+			cache->nlarge[size_class]--;
+		} else {
+			cache->nmallocs++;
+			p = malloc(class_size);
+		}
+	} else {
+		if (cache != NULL) {
+			cache->nmallocs++;
+		}
+		p = malloc(size);
+	}
 	if (p == NULL) {
 		return NULL;
 	}
 
+	pool->nlarge++;
+	pool->large_size += size;
 	n = 0;
 
 	for (large = pool->large; large; large = large->next) {
 		if (large->alloc == NULL) {
 			large->alloc = p;
+			large->size = class_size;
 			return p;
 		}
 
@@ -283,6 +374,7 @@ psg_palloc_large(psg_pool_t *pool, size_t size)
 	}
 
 	large->alloc = p;
+	large->size = class_size;
 	large->next = pool->large;
 	pool->large = large;
 
@@ -290,12 +382,118 @@ psg_palloc_large(psg_pool_t *pool, size_t size)
 }
 
 
+/* Frees the memory of the given large allocation, or puts it in the cache. */
+static void
+psg_free_large(psg_pool_t *pool, psg_pool_large_t *l)
+{
+	psg_pool_cache_t  *cache = pool->cache;
+	int                size_class;
+
+	if (cache != NULL && l->size > 0) {
+		size_class = psg_large_size_class(l->size);
+		if (cache->nlarge[size_class] < PSG_POOL_CACHE_MAX_LARGE_PER_CLASS) {
+			*(void **) l->alloc = cache->large[size_class];
+			cache->large[size_class] = l->alloc;
+			cache->nlarge[size_class]++;
+			return;
+		}
+	}
+	free(l->alloc);
+}
+
+
+/* Allocates a pool data block, from the cache if possible. */
+static void *
+psg_alloc_block(psg_pool_cache_t *cache, size_t size)
+{
+	void *block;
+
+	if (cache != NULL) {
+		if (cache->blocks != NULL && size == cache->block_size) {
+			block = cache->blocks;
+			cache->blocks = *(void **) block;
+			cache->nblocks--;
+			return block;
+		}
+		cache->nmallocs++;
+	}
+	return call_memalign(PSG_POOL_ALIGNMENT, size);
+}
+
+
+/* Frees a pool data block, or puts it in the cache. */
+static void
+psg_free_block(psg_pool_cache_t *cache, void *block, size_t size)
+{
+	if (cache != NULL && size == cache->block_size
+	 && cache->nblocks < PSG_POOL_CACHE_MAX_BLOCKS)
+	{
+		*(void **) block = cache->blocks;
+		cache->blocks = block;
+		cache->nblocks++;
+	} else {
+		free(block);
+	}
+}
+
+
+void
+psg_pool_cache_init(psg_pool_cache_t *cache, size_t block_size)
+{
+	memset(cache, 0, sizeof(psg_pool_cache_t));
+	cache->block_size = block_size;
+}
+
+
+size_t
+psg_pool_cache_compact(psg_pool_cache_t *cache)
+{
+	size_t  result = psg_pool_cache_size(cache);
+	void   *p;
+	int     i;
+
+	while (cache->blocks != NULL) {
+		p = cache->blocks;
+		cache->blocks = *(void **) p;
+		free(p);
+	}
+	cache->nblocks = 0;
+
+	for (i = 0; i < PSG_POOL_CACHE_LARGE_CLASSES; i++) {
+		while (cache->large[i] != NULL) {
+			p = cache->large[i];
+			cache->large[i] = *(void **) p;
+			free(p);
+		}
+		cache->nlarge[i] = 0;
+	}
+
+	return result;
+}
+
+
+size_t
+psg_pool_cache_size(const psg_pool_cache_t *cache)
+{
+	size_t  result = cache->nblocks * cache->block_size;
+	int     i;
+
+	for (i = 0; i < PSG_POOL_CACHE_LARGE_CLASSES; i++) {
+		result += cache->nlarge[i] * ((size_t) PSG_POOL_CACHE_MIN_LARGE_SIZE << i);
+	}
+	return result;
+}
+
+
 void *
 psg_pmemalign(psg_pool_t *pool, size_t size, size_t alignment)
 {
 	void              *p;
 	psg_pool_large_t  *large;
 
+	if (pool->cache != NULL) {
+		pool->cache->nmallocs++;
+	}
 	p = call_memalign(alignment, size);
 	if (p == NULL) {
 		return NULL;
@@ -307,7 +505,10 @@ psg_pmemalign(psg_pool_t *pool, size_t size, size_t alignment)
 		return NULL;
 	}
 
+	pool->nlarge++;
+	pool->large_size += size;
 	large->alloc = p;
+	large->size = 0;
 	large->next = pool->large;
 	pool->large = large;
 
@@ -334,7 +535,7 @@ psg_pfree(psg_pool_t *pool, void *p)
 
 	for (l = pool->large; l; l = l->next) {
 		if (p == l->alloc) {
-			free(l->alloc);
+			psg_free_large(pool, l);
 			l->alloc = NULL;
 			if (prev != NULL) {
 				prev->next = l->next;
@@ -45,6 +45,13 @@
  * "large memory allocator" and allocated directly using malloc().
  * Except for objects allocated by the large memory allocator,
  * objects can only be freed by freeing the entire pool.
+ *
+ * Pools can optionally be attached to a psg_pool_cache_t when they're created.
+ * Such pools get their data blocks and large allocations from the cache,
+ * and give them back to the cache when they're reset or destroyed, so that
+ * a thread that keeps resetting and reusing pools (e.g. one per request)
+ * doesn't need to call malloc() in the steady state. The cache also keeps
+ * statistics about how much memory the pools used.
  */
 
 #define PSG_ALIGNMENT sizeof(unsigned long) /* platform word */
@@ -68,12 +75,25 @@
 			  PSG_POOL_ALIGNMENT)
 
 
+#define PSG_POOL_CACHE_LARGE_CLASSES        5  /* 4 KB, 8 KB, ..., 64 KB */
+#define PSG_POOL_CACHE_MIN_LARGE_SIZE       (psg_pagesize)
+#define PSG_POOL_CACHE_MAX_BLOCKS           64
+#define PSG_POOL_CACHE_MAX_LARGE_PER_CLASS  16
+
+/* High water mark buckets: <= 1 KB, <= 2 KB, ..., <= 64 KB, more. */
+#define PSG_POOL_HIGH_WATER_MARK_BUCKETS    8
+/* Large allocation count buckets: 0, 1, 2-3, 4-7, 8-15, 16 and more. */
+#define PSG_POOL_LARGE_COUNT_BUCKETS        6
+
+
 typedef struct psg_pool_s        psg_pool_t;
 typedef struct psg_pool_large_s  psg_pool_large_t;
+typedef struct psg_pool_cache_s  psg_pool_cache_t;
 
 typedef struct psg_pool_large_s {
 	psg_pool_large_s     *next;
 	void                 *alloc;
+	size_t                size;     /* Cache size class size, or 0 if not cacheable. */
 } psg_pool_large_t;
 
 typedef struct {
@@ -94,13 +114,51 @@ struct psg_pool_s {
 	size_t                max;      /* Read-only */
 	psg_pool_t           *current;
 	psg_pool_large_t     *large;
+	psg_pool_cache_t     *cache;    /* Read-only */
+	unsigned int          nlarge;   /* Number of large allocations since the last reset. */
+	size_t                large_size; /* Total size of those large allocations. */
+};
+
+/**
+ * A cache of free pool data blocks and large allocations, plus statistics
+ * about the pools that use it. Not thread-safe: it may only be used by
+ * pools that are all reset and destroyed in the same thread.
+ */
+struct psg_pool_cache_s {
+	size_t                block_size;  /* Size of cached data blocks. Read-only */
+	void                 *blocks;
+	unsigned int          nblocks;
+	void                 *large[PSG_POOL_CACHE_LARGE_CLASSES];
+	unsigned int          nlarge[PSG_POOL_CACHE_LARGE_CLASSES];
+
+	/** Number of malloc() calls made on behalf of pools using this cache. */
+	uint64_t              nmallocs;
+	/** Number of pool resets, by the amount of memory used by the pool. */
+	uint64_t              high_water_marks[PSG_POOL_HIGH_WATER_MARK_BUCKETS];
+	/** Number of pool resets, by the number of large allocations made. */
+	uint64_t              large_counts[PSG_POOL_LARGE_COUNT_BUCKETS];
 };
 
 
-psg_pool_t *psg_create_pool(size_t size);
+/** Create a pool with the given size. If `cache` is given, then `size` must
+ * be equal to the cache's block size.
+ */
+psg_pool_t *psg_create_pool(size_t size, psg_pool_cache_t *cache = NULL);
 void psg_destroy_pool(psg_pool_t *pool);
+/** Free everything that was allocated from the pool, so that the pool can
+ * be reused. If the pool has a cache, then its usage is recorded in the cache
+ * statistics and any additional data blocks are put into the cache. The pool
+ * can then always be reused. Otherwise, the pool can only be reused if it
+ * only had one data block, which is indicated by the return value.
+ */
 bool psg_reset_pool(psg_pool_t *pool, size_t size);
 
+void psg_pool_cache_init(psg_pool_cache_t *cache, size_t block_size);
+/** Free all cached memory. Returns the number of bytes freed. */
+size_t psg_pool_cache_compact(psg_pool_cache_t *cache);
+/** Returns the number of bytes held by the cache. */
+size_t psg_pool_cache_size(const psg_pool_cache_t *cache);
+
 /** Allocate `size` bytes from the pool, aligned on platform word size. */
 void *psg_palloc(psg_pool_t *pool, size_t size);
 
@@ -31,12 +31,17 @@
 #include <list>
 #include <memory>
 #include <boost/thread.hpp>
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
 #include <boost/scoped_ptr.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/function.hpp>
 #include <boost/bind.hpp>
 #include <oxt/thread.hpp>
+#include <oxt/macros.hpp>
 #include <LoggingKit/LoggingKit.h>
+#include <Algorithms/MovingAverage.h>
+#include <Utils/SystemTime.h>
 
 namespace Passenger {
 
@@ -46,24 +51,42 @@ using namespace boost;
 
 /**
  * Class for thread-safely using libev.
+ *
+ * Callbacks scheduled from other threads (through runLater(), runSync() etc)
+ * are passed to the event loop thread through an intrusive, lock-free
+ * multiple producer/single consumer queue (the algorithm by Dmitry Vyukov).
+ * Queue nodes are taken from a pre-allocated pool so that scheduling a
+ * callback normally does not involve a mutex or a heap allocation. If the
+ * pool is exhausted then nodes are allocated on the heap.
  */
 class SafeLibev {
 private:
 	// 2^28-1. Command IDs are 28-bit so that we can pack DataSource's state and
 	// its planId in 32-bits total.
 	static const unsigned int MAX_COMMAND_ID = 268435455;
+	static const unsigned int COMMAND_POOL_SIZE = 512;
 
 	typedef boost::function<void ()> Callback;
 
 	struct Command {
+		boost::atomic<Command *> next;
 		Callback callback;
-		unsigned int id: 31;
+		MonotonicTimeUsec enqueueTime;
+		unsigned int id: 28;
+		/** Only accessed from the event loop thread. */
 		bool canceled: 1;
-
-		Command(unsigned int _id, const Callback &_callback)
-			: callback(_callback),
-			  id(_id),
-			  canceled(false)
+		/** Whether this node lives in the pre-allocated pool. */
+		bool pooled: 1;
+		/** Pool index + 1 of the next free pool node, or 0. */
+		boost::atomic<boost::uint32_t> nextFree;
+
+		Command()
+			: next(NULL),
+			  enqueueTime(0),
+			  id(0),
+			  canceled(false),
+			  pooled(false),
+			  nextFree(0)
 			{ }
 	};
 
@@ -73,8 +96,35 @@ private:
 
 	boost::mutex syncher;
 	boost::condition_variable cond;
-	vector<Command> commands;
-	unsigned int nextCommandId;
+	/** Incremented by enqueue() before the command is pushed. */
+	boost::atomic<unsigned int> commandCounter;
+
+	/* The MPSC queue. Producers append at `queueHead`, the event loop thread
+	 * consumes from `queueTail`. `stub` is a dummy node that makes sure the
+	 * queue never becomes entirely empty.
+	 */
+	boost::atomic<Command *> queueHead;
+	Command *queueTail;
+	Command stub;
+
+	/* Free list of pool nodes: a Treiber stack of pool indices. The upper
+	 * 32 bits contain a tag that is incremented on every change in order
+	 * to prevent the ABA problem.
+	 */
+	Command *pool;
+	boost::atomic<boost::uint64_t> freePoolNodes;
+
+	/** Number of commands popped from the queue, modulo 2^32. Only accessed
+	 * from the event loop thread. */
+	unsigned int commandsPopped;
+
+	/* Statistics, only accessed from the event loop thread unless noted otherwise. */
+	boost::uint64_t commandsRun;
+	boost::uint64_t commandsCanceled;
+	/** Accessed from any thread. */
+	boost::atomic<boost::uint64_t> poolMisses;
+	double averageCommandLatency;
+	MonotonicTimeUsec peakCommandLatency;
 
 	static void asyncHandler(EV_P_ ev_async *w, int revents) {
 		SafeLibev *self = (SafeLibev *) w->data;
@@ -86,16 +136,136 @@ private:
 		(*callback)();
 	}
 
+	Command *checkoutCommand() {
+		boost::uint64_t current = freePoolNodes.load(boost::memory_order_acquire);
+		boost::uint64_t replacement;
+		Command *command;
+
+		do {
+			boost::uint32_t index = (boost::uint32_t) current;
+			if (index == 0) {
+				poolMisses.fetch_add(1, boost::memory_order_relaxed);
+				return new Command();
+			}
+			command = &pool[index - 1];
+			replacement = (((current >> 32) + 1) << 32)
+				| command->nextFree.load(boost::memory_order_relaxed);
+		} while (!freePoolNodes.compare_exchange_weak(current, replacement,
+			boost::memory_order_acquire, boost::memory_order_acquire));
+
+		return command;
+	}
+
+	void checkinCommand(Command *command) {
+		if (!command->pooled) {
+			delete command;
+			return;
+		}
+
+		boost::uint32_t index = command - pool + 1;
+		boost::uint64_t current = freePoolNodes.load(boost::memory_order_relaxed);
+		boost::uint64_t replacement;
+
+		do {
+			command->nextFree.store((boost::uint32_t) current,
+				boost::memory_order_relaxed);
+			replacement = (((current >> 32) + 1) << 32) | index;
+		} while (!freePoolNodes.compare_exchange_weak(current, replacement,
+			boost::memory_order_release, boost::memory_order_relaxed));
+	}
+
+	void pushCommand(Command *command) {
+		command->next.store(NULL, boost::memory_order_relaxed);
+		Command *prev = queueHead.exchange(command, boost::memory_order_acq_rel);
+		prev->next.store(command, boost::memory_order_release);
+	}
+
+	/**
+	 * Removes the oldest command from the queue. Returns NULL if the queue
+	 * is empty, or if a producer is halfway through pushing the next command.
+	 * In the latter case the producer will wake up the event loop afterwards.
+	 * Must be called from the event loop thread.
+	 */
+	Command *popCommand() {
+		Command *tail = queueTail;
+		Command *next = tail->next.load(boost::memory_order_acquire);
+
+		if (tail == &stub) {
+			if (next == NULL) {
+				return NULL;
+			}
+			queueTail = tail = next;
+			next = next->next.load(boost::memory_order_acquire);
+		}
+		if (next != NULL) {
+			queueTail = next;
+			return tail;
+		}
+		if (tail != queueHead.load(boost::memory_order_acquire)) {
+			return NULL;
+		}
+		pushCommand(&stub);
+		next = tail->next.load(boost::memory_order_acquire);
+		if (next != NULL) {
+			queueTail = next;
+			return tail;
+		}
+		return NULL;
+	}
+
+	unsigned int enqueue(const Callback &callback) {
+		Command *command = checkoutCommand();
+		// Command IDs range from 1 to MAX_COMMAND_ID.
+		unsigned int id = commandCounter.fetch_add(1, boost::memory_order_relaxed)
+			% MAX_COMMAND_ID + 1;
+		command->callback = callback;
+		command->id = id;
+		command->canceled = false;
+		command->enqueueTime = SystemTime::getMonotonicUsec();
+		pushCommand(command);
+		ev_async_send(loop, &async);
+		return id;
+	}
+
+	void recordCommandLatency(MonotonicTimeUsec enqueueTime) {
+		MonotonicTimeUsec now = SystemTime::getMonotonicUsec();
+		MonotonicTimeUsec latency = (now > enqueueTime) ? now - enqueueTime : 0;
+		averageCommandLatency = expMovingAverage(averageCommandLatency,
+			latency, 0.05);
+		if (latency > peakCommandLatency) {
+			peakCommandLatency = latency;
+		}
+	}
+
 	void runCommands() {
-		boost::unique_lock<boost::mutex> l(syncher);
-		vector<Command> commands = this->commands;
-		this->commands.clear();
-		l.unlock();
-
-		vector<Command>::const_iterator it, end = commands.end();
-		for (it = commands.begin(); it != end; it++) {
-			if (!it->canceled) {
-				it->callback();
+		// Only run as many commands as were scheduled before this point, so
+		// that callbacks that reschedule themselves cannot starve the event
+		// loop. Commands that are counted but not yet fully pushed are
+		// left for the ev_async_send() that their producer does afterwards.
+		unsigned int budget = commandCounter.load(boost::memory_order_acquire)
+			- commandsPopped;
+		Command *command;
+
+		while (budget > 0 && (command = popCommand()) != NULL) {
+			Callback callback;
+
+			budget--;
+			commandsPopped++;
+			if (command->canceled) {
+				commandsCanceled++;
+				command->callback.clear();
+			} else {
+				commandsRun++;
+				recordCommandLatency(command->enqueueTime);
+				callback.swap(command->callback);
+			}
+			// Return the node to the pool before running the callback,
+			// so that the callback may schedule new commands and so that
+			// the node is not lost if the callback throws.
+			checkinCommand(command);
+
+			if (callback) {
+				callback();
 			}
 		}
 	}
@@ -124,20 +294,30 @@ private:
 		cond.notify_all();
 	}
 
-	void incNextCommandId() {
-		if (nextCommandId == MAX_COMMAND_ID) {
-			nextCommandId = 1;
-		} else {
-			nextCommandId++;
-		}
-	}
-
 public:
 	/** SafeLibev takes over ownership of the loop object. */
-	SafeLibev(struct ev_loop *loop) {
+	SafeLibev(struct ev_loop *loop)
+		: commandCounter(0),
+		  queueHead(&stub),
+		  queueTail(&stub),
+		  freePoolNodes(0),
+		  commandsPopped(0),
+		  commandsRun(0),
+		  commandsCanceled(0),
+		  poolMisses(0),
+		  averageCommandLatency(-1),
+		  peakCommandLatency(0)
+	{
 		this->loop = loop;
 		loopThread = pthread_self();
-		nextCommandId = 1;
+
+		pool = new Command[COMMAND_POOL_SIZE];
+		for (unsigned int i = 0; i < COMMAND_POOL_SIZE; i++) {
+			pool[i].pooled = true;
+			pool[i].nextFree.store((i + 1 < COMMAND_POOL_SIZE) ? i + 2 : 0,
+				boost::memory_order_relaxed);
+		}
+		freePoolNodes.store(1, boost::memory_order_release);
 
 		ev_async_init(&async, asyncHandler);
 		ev_set_priority(&async, EV_MAXPRI);
@@ -151,6 +331,14 @@ public:
 		P_LOG_FILE_DESCRIPTOR_CLOSE(ev_loop_get_pipe(loop, 1));
 		P_LOG_FILE_DESCRIPTOR_CLOSE(ev_backend_fd(loop));
 		ev_loop_destroy(loop);
+
+		Command *command;
+		while ((command = popCommand()) != NULL) {
+			if (!command->pooled) {
+				delete command;
+			}
+		}
+		delete[] pool;
 	}
 
 	void destroy() {
@@ -192,13 +380,10 @@ public:
 			watcher.set(loop);
 			watcher.start();
 		} else {
-			boost::unique_lock<boost::mutex> l(syncher);
 			bool done = false;
-			commands.push_back(Command(nextCommandId,
-				boost::bind(&SafeLibev::startWatcherAndNotify<Watcher>,
-					this, &watcher, &done)));
-			incNextCommandId();
-			ev_async_send(loop, &async);
+			enqueue(boost::bind(&SafeLibev::startWatcherAndNotify<Watcher>,
+				this, &watcher, &done));
+			boost::unique_lock<boost::mutex> l(syncher);
 			while (!done) {
 				cond.wait(l);
 			}
@@ -210,13 +395,10 @@ public:
 		if (onEventLoopThread()) {
 			watcher.stop();
 		} else {
-			boost::unique_lock<boost::mutex> l(syncher);
 			bool done = false;
-			commands.push_back(Command(nextCommandId,
-				boost::bind(&SafeLibev::stopWatcherAndNotify<Watcher>,
-					this, &watcher, &done)));
-			incNextCommandId();
-			ev_async_send(loop, &async);
+			enqueue(boost::bind(&SafeLibev::stopWatcherAndNotify<Watcher>,
+				this, &watcher, &done));
+			boost::unique_lock<boost::mutex> l(syncher);
 			while (!done) {
 				cond.wait(l);
 			}
@@ -234,13 +416,10 @@ public:
 
 	void runSync(const Callback &callback) {
 		assert(callback != NULL);
-		boost::unique_lock<boost::mutex> l(syncher);
 		bool done = false;
-		commands.push_back(Command(nextCommandId,
-			boost::bind(&SafeLibev::runAndNotify, this,
-				&callback, &done)));
-		incNextCommandId();
-		ev_async_send(loop, &async);
+		enqueue(boost::bind(&SafeLibev::runAndNotify, this,
+			&callback, &done));
+		boost::unique_lock<boost::mutex> l(syncher);
 		while (!done) {
 			cond.wait(l);
 		}
@@ -264,15 +443,7 @@ public:
 
 	unsigned int runLater(const Callback &callback) {
 		assert(callback != NULL);
-		unsigned int result;
-		{
-			boost::unique_lock<boost::mutex> l(syncher);
-			commands.push_back(Command(nextCommandId, callback));
-			result = nextCommandId;
-			incNextCommandId();
-		}
-		ev_async_send(loop, &async);
-		return result;
+		return enqueue(callback);
 	}
 
 	/**
@@ -281,24 +452,55 @@ public:
 	 * That is, a return value of true guarantees that the callback will not be called
 	 * in the future, while a return value of false means that the callback has already
 	 * been called or is currently being called.
+	 *
+	 * Must be called from the event loop thread.
 	 */
 	bool cancelCommand(unsigned int id) {
 		if (id == 0) {
 			return false;
 		}
 
-		boost::unique_lock<boost::mutex> l(syncher);
-		// TODO: we can do a binary search because the command ID
-		// is monotically increasing except on overflow.
-		vector<Command>::iterator it, end = commands.end();
-		for (it = commands.begin(); it != end; it++) {
-			if (it->id == id) {
-				it->canceled = true;
+		// Only the event loop thread removes nodes from the queue, so
+		// the nodes reachable from the tail stay valid while we walk them.
+		Command *command = queueTail;
+		while (command != NULL) {
+			if (command != &stub && command->id == id && !command->canceled) {
+				command->canceled = true;
 				return true;
 			}
+			command = command->next.load(boost::memory_order_acquire);
 		}
 		return false;
 	}
+
+	/**
+	 * Returns statistics about the commands that other threads scheduled
+	 * on this event loop. Must be called from the event loop thread.
+	 */
+	boost::uint64_t getCommandsRun() const {
+		return commandsRun;
+	}
+
+	boost::uint64_t getCommandsCanceled() const {
+		return commandsCanceled;
+	}
+
+	boost::uint64_t getCommandPoolMisses() const {
+		return poolMisses.load(boost::memory_order_relaxed);
+	}
+
+	/**
+	 * The exponential moving average of the time between scheduling
+	 * a command and running it, in microseconds. -1 if no commands
+	 * have been run yet.
+	 */
+	double getAverageCommandLatency() const {
+		return averageCommandLatency;
+	}
+
+	MonotonicTimeUsec getPeakCommandLatency() const {
+		return peakCommandLatency;
+	}
 };
 
 typedef boost::shared_ptr<SafeLibev> SafeLibevPtr;
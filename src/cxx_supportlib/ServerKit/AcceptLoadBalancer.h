@@ -28,6 +28,7 @@
 
 #include <boost/bind.hpp>
 #include <boost/cstdint.hpp>
+#include <boost/atomic.hpp>
 #include <oxt/thread.hpp>
 #include <oxt/macros.hpp>
 #include <vector>
@@ -55,7 +56,7 @@ using namespace boost;
 
 /**
  * Listens for client connections and load balances them to multiple
- * Server objects in a round-robin manner.
+ * Server objects, preferring the Server with the fewest active clients.
  *
  * Normally, the Server class listens for client connections directly.
  * But this is inefficient in multithreaded situations where you are
@@ -72,25 +73,64 @@ using namespace boost;
  *
  * The AcceptLoadBalancer solves this problem by being the sole entity
  * that listens on the server socket. All client sockets that it
- * accepts are distributed to all registered Server objects, in a
- * round-robin manner.
+ * accepts are distributed to all registered Server objects. Each client
+ * goes to the Server with the fewest active (plus not yet processed)
+ * clients; ties are broken in a round-robin manner.
+ *
+ * Accepted file descriptors are handed over to a Server's event loop
+ * through a lock-free single-producer, single-consumer ring buffer.
+ * The Server's event loop is woken up at most once per accept burst,
+ * and not at all if it hasn't yet processed a previous wakeup.
  *
  * Inside the "PassengerAgent core", we activate AcceptLoadBalancer
  * only if `core_threads > 1`, which is often the case because
  * `core_threads` defaults to the number of CPU cores.
+ *
+ * The load balancer thread can itself become a bottleneck at high
+ * connection rates. For TCP addresses, the core therefore also supports
+ * a "reuse port" mode (`controller_reuse_port`) in which every Server
+ * listens on its own SO_REUSEPORT socket and the kernel distributes
+ * clients. In that mode only the remaining (Unix domain socket)
+ * endpoints are handled by the AcceptLoadBalancer.
  */
 template<typename Server>
 class AcceptLoadBalancer {
 private:
 	static const unsigned int ACCEPT_BURST_COUNT = 16;
+	// Must be a power of 2.
+	static const unsigned int HANDOVER_QUEUE_SIZE = 256;
+
+	/**
+	 * Per-Server handover state. `head` is only written by the load
+	 * balancer thread and `tail` only by the Server's event loop thread.
+	 */
+	struct Target {
+		Server *server;
+		unsigned int number;
+		bool pushedInCurrentBurst;
+		boost::atomic<bool> wakeupPending;
+		boost::atomic<unsigned int> head;
+		boost::atomic<unsigned int> tail;
+		int queue[HANDOVER_QUEUE_SIZE];
+
+		Target(Server *_server, unsigned int _number)
+			: server(_server),
+			  number(_number),
+			  pushedInCurrentBurst(false),
+			  wakeupPending(false),
+			  head(0),
+			  tail(0)
+			{ }
+	};
 
 	int endpoints[SERVER_KIT_MAX_SERVER_ENDPOINTS];
 	struct pollfd pollers[1 + SERVER_KIT_MAX_SERVER_ENDPOINTS];
 	int newClients[ACCEPT_BURST_COUNT];
+	vector<Target *> targets;
 
 	unsigned int nEndpoints;
 	boost::uint8_t newClientCount;
-	boost::uint8_t nextServer;
+	unsigned int nextServer;
 	bool accept4Available;
 	bool quit;
 
@@ -155,21 +195,102 @@ private:
 		}
 	}
 
+	static unsigned int getQueuedClientCount(const Target *target) {
+		return target->head.load(boost::memory_order_relaxed)
+			- target->tail.load(boost::memory_order_relaxed);
+	}
+
+	static unsigned int getBusyness(const Target *target) {
+		return target->server->sharedActiveClientCount.load(boost::memory_order_relaxed)
+			+ getQueuedClientCount(target);
+	}
+
+	Target *selectLeastBusyTarget() {
+		unsigned int count = targets.size();
+		unsigned int best = nextServer;
+		unsigned int bestBusyness = getBusyness(targets[best]);
+
+		// Start scanning at the Server after the previously selected
+		// one, so that ties are broken in a round-robin manner.
+		for (unsigned int i = 1; i < count && bestBusyness > 0; i++) {
+			unsigned int index = (nextServer + i) % count;
+			unsigned int busyness = getBusyness(targets[index]);
+			if (busyness < bestBusyness) {
+				best = index;
+				bestBusyness = busyness;
+			}
+		}
+
+		nextServer = (best + 1) % count;
+		return targets[best];
+	}
+
+	static bool pushNewClient(Target *target, int fd) {
+		unsigned int head = target->head.load(boost::memory_order_relaxed);
+		if (head - target->tail.load(boost::memory_order_acquire) == HANDOVER_QUEUE_SIZE) {
+			return false;
+		}
+		target->queue[head % HANDOVER_QUEUE_SIZE] = fd;
+		target->head.store(head + 1, boost::memory_order_release);
+		return true;
+	}
+
 	void distributeNewClients() {
 		unsigned int i;
 
 		for (i = 0; i < newClientCount; i++) {
-			ServerKit::Context *ctx = servers[nextServer]->getContext();
-			P_TRACE(2, "Feeding client to server thread " << (int) nextServer <<
+			Target *target = selectLeastBusyTarget();
+			P_TRACE(2, "Feeding client to server thread " << target->number <<
 				": file descriptor " << newClients[i]);
-			ctx->libev->runLater(boost::bind(feedNewClient, servers[nextServer],
-				newClients[i]));
-			nextServer = (nextServer + 1) % servers.size();
+			if (OXT_LIKELY(pushNewClient(target, newClients[i]))) {
+				target->pushedInCurrentBurst = true;
+			} else {
+				// The Server isn't keeping up with its queue. Fall back to
+				// handing over this client through a separate command.
+				target->server->getContext()->libev->runLater(
+					boost::bind(feedNewClient, target->server, newClients[i]));
+			}
+		}
+
+		for (i = 0; i < targets.size(); i++) {
+			Target *target = targets[i];
+			if (target->pushedInCurrentBurst) {
+				target->pushedInCurrentBurst = false;
+				if (!target->wakeupPending.exchange(true)) {
+					target->server->getContext()->libev->runLater(
+						boost::bind(processHandoverQueue, target));
+				}
+			}
 		}
 
 		newClientCount = 0;
 	}
 
+	// Runs in the Server's event loop thread.
+	static void processHandoverQueue(Target *target) {
+		int fds[ACCEPT_BURST_COUNT];
+		unsigned int tail, head, count;
+
+		// Must be cleared before reading `head`, otherwise we may
+		// miss clients that are pushed while we're processing.
+		target->wakeupPending.exchange(false);
+		tail = target->tail.load(boost::memory_order_relaxed);
+		head = target->head.load(boost::memory_order_acquire);
+
+		while (tail != head) {
+			count = 0;
+			while (tail != head && count < ACCEPT_BURST_COUNT) {
+				fds[count] = target->queue[tail % HANDOVER_QUEUE_SIZE];
+				tail++;
+				count++;
+			}
+			target->server->feedNewClients(fds, count);
+			// Only advance `tail` after feeding so that getBusyness()
+			// doesn't temporarily underestimate the Server's load.
+			target->tail.store(tail, boost::memory_order_release);
+		}
+	}
+
 	static void feedNewClient(Server *server, int fd) {
 		server->feedNewClients(&fd, 1);
 	}
@@ -273,6 +394,9 @@ public:
 		close(exitPipe[1]);
 		P_LOG_FILE_DESCRIPTOR_CLOSE(exitPipe[0]);
 		P_LOG_FILE_DESCRIPTOR_CLOSE(exitPipe[1]);
+		for (unsigned int i = 0; i < targets.size(); i++) {
+			delete targets[i];
+		}
 	}
 
 	void listen(int fd) {
@@ -300,7 +424,18 @@ public:
 		#undef EXTENSION_EOPNOTSUPP
 	}
 
+	bool hasEndpoints() const {
+		return nEndpoints > 0;
+	}
+
 	void start() {
+		assert(!servers.empty());
+		assert(targets.empty());
+		targets.reserve(servers.size());
+		for (unsigned int i = 0; i < servers.size(); i++) {
+			targets.push_back(new Target(servers[i], i));
+		}
+
 		boost::function<void ()> func = boost::bind(&AcceptLoadBalancer<Server>::mainLoop, this);
 		thread = new oxt::thread(boost::bind(runAndPrintExceptions, func, true),
 			"Load balancer");
@@ -59,6 +59,8 @@ using namespace std;
  *   file_buffered_channel_max_disk_chunk_read_size       unsigned integer   -   default(0)
  *   file_buffered_channel_threshold                      unsigned integer   -   default(131072)
  *   mbuf_block_chunk_size                                unsigned integer   -   default(4096),read_only
+ *   mbuf_large_block_chunk_size                          unsigned integer   -   default(65536),read_only
+ *   mbuf_slabs                                           boolean            -   default(false),read_only
  *   secure_mode_password                                 string             -   secret
  *
  * END
@@ -94,6 +96,9 @@ public:
 
 		add("mbuf_block_chunk_size", UINT_TYPE, OPTIONAL | READ_ONLY,
 			DEFAULT_MBUF_CHUNK_SIZE);
+		add("mbuf_large_block_chunk_size", UINT_TYPE, OPTIONAL | READ_ONLY,
+			DEFAULT_MBUF_LARGE_CHUNK_SIZE);
+		add("mbuf_slabs", BOOL_TYPE, OPTIONAL | READ_ONLY, false);
 		add("secure_mode_password", STRING_TYPE, OPTIONAL | SECRET);
 
 		addNormalizer(normalize);
@@ -84,6 +84,11 @@ public:
 
 		mbuf_pool.mbuf_block_chunk_size = configStore["mbuf_block_chunk_size"].asUInt();
 		MemoryKit::mbuf_pool_init(&mbuf_pool);
+		MemoryKit::mbuf_pool_enable_large_blocks(&mbuf_pool,
+			configStore["mbuf_large_block_chunk_size"].asUInt());
+		if (configStore["mbuf_slabs"].asBool()) {
+			MemoryKit::mbuf_pool_enable_slabs(&mbuf_pool);
+		}
 	}
 
 	bool configure(const Json::Value &updates, vector<ConfigKit::Error> &errors) {
@@ -122,10 +127,21 @@ public:
 		mbufDoc["active_blocks"] = (Json::UInt) mbuf_pool.nactive_mbuf_blockq;
 		mbufDoc["chunk_size"] = (Json::UInt) mbuf_pool.mbuf_block_chunk_size;
 		mbufDoc["offset"] = (Json::UInt) mbuf_pool.mbuf_block_offset;
-		mbufDoc["spare_memory"] = byteSizeToJson(mbuf_pool.nfree_mbuf_blockq
-			* mbuf_pool.mbuf_block_chunk_size);
-		mbufDoc["active_memory"] = byteSizeToJson(mbuf_pool.nactive_mbuf_blockq
-			* mbuf_pool.mbuf_block_chunk_size);
+		mbufDoc["large_free_blocks"] = (Json::UInt) mbuf_pool.nfree_large_mbuf_blockq;
+		mbufDoc["large_active_blocks"] = (Json::UInt) mbuf_pool.nactive_large_mbuf_blockq;
+		mbufDoc["large_chunk_size"] = (Json::UInt) mbuf_pool.large_mbuf_block_chunk_size;
+		mbufDoc["slabs"] = (Json::UInt) mbuf_pool.nslabs;
+		mbufDoc["slab_memory"] = byteSizeToJson((size_t) mbuf_pool.nslabs * MBUF_SLAB_SIZE);
+		mbufDoc["spare_memory"] = byteSizeToJson(
+			(mbuf_pool.nfree_mbuf_blockq - mbuf_pool.nfree_large_mbuf_blockq)
+				* mbuf_pool.mbuf_block_chunk_size
+			+ mbuf_pool.nfree_large_mbuf_blockq
+				* mbuf_pool.large_mbuf_block_chunk_size);
+		mbufDoc["active_memory"] = byteSizeToJson(
+			(mbuf_pool.nactive_mbuf_blockq - mbuf_pool.nactive_large_mbuf_blockq)
+				* mbuf_pool.mbuf_block_chunk_size
+			+ mbuf_pool.nactive_large_mbuf_blockq
+				* mbuf_pool.large_mbuf_block_chunk_size);
 		#ifdef MBUF_ENABLE_DEBUGGING
 			struct MemoryKit::active_mbuf_block_list *list =
 				const_cast<struct MemoryKit::active_mbuf_block_list *>(
@@ -149,6 +165,22 @@ public:
 
 		doc["mbuf_pool"] = mbufDoc;
 
+		if (libev != NULL) {
+			Json::Value commandsDoc;
+			double averageLatency = libev->getAverageCommandLatency();
+
+			commandsDoc["run"] = (Json::UInt64) libev->getCommandsRun();
+			commandsDoc["canceled"] = (Json::UInt64) libev->getCommandsCanceled();
+			commandsDoc["pool_misses"] = (Json::UInt64) libev->getCommandPoolMisses();
+			if (averageLatency >= 0) {
+				commandsDoc["average_latency"] = durationToJson(
+					(unsigned long long) averageLatency);
+			}
+			commandsDoc["peak_latency"] = durationToJson(
+				libev->getPeakCommandLatency());
+			doc["cross_thread_commands"] = commandsDoc;
+		}
+
 		return doc;
 	}
 };
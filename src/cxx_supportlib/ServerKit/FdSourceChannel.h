@@ -46,6 +46,12 @@ class FdSourceChannel: protected Channel {
 private:
 	ev_io watcher;
 	MemoryKit::mbuf buffer;
+	/**
+	 * Whether the last read() filled the entire buffer. If so then there's
+	 * probably a bulk transfer going on, so we read into a large mbuf block
+	 * next time in order to reduce the number of syscalls.
+	 */
+	bool bulkReading;
 
 	static void _onReadable(EV_P_ ev_io *io, int revents) {
 		static_cast<FdSourceChannel *>(io->data)->onReadable(io, revents);
@@ -73,7 +79,12 @@ private:
 
 		for (i = 0; i < burstReadCount && !done; i++) {
 			if (buffer.empty()) {
-				buffer = MemoryKit::mbuf_get(&ctx->mbuf_pool);
+				if (bulkReading) {
+					buffer = MemoryKit::mbuf_get_with_size(&ctx->mbuf_pool,
+						MemoryKit::mbuf_pool_large_data_size(&ctx->mbuf_pool));
+				} else {
+					buffer = MemoryKit::mbuf_get(&ctx->mbuf_pool);
+				}
 			}
 
 			origBufferSize = buffer.size();
@@ -81,6 +92,7 @@ private:
 				ret = ::read(watcher.fd, buffer.start, buffer.size());
 			} while (OXT_UNLIKELY(ret == -1 && errno == EINTR));
 			if (ret > 0) {
+				bulkReading = (size_t) ret == origBufferSize;
 				MemoryKit::mbuf buffer2(buffer, 0, ret);
 				if (size_t(ret) == size_t(buffer.size())) {
 					// Unref mbuf_block
@@ -135,6 +147,7 @@ private:
 
 	void initialize() {
 		burstReadCount = 1;
+		bulkReading = false;
 		watcher.active = false;
 		watcher.fd = -1;
 		watcher.data = this;
@@ -168,6 +181,7 @@ public:
 	void reinitialize(int fd) {
 		Channel::reinitialize();
 		ev_io_init(&watcher, _onReadable, fd, EV_READ);
+		bulkReading = false;
 	}
 
 	void deinitialize() {
@@ -1539,6 +1539,16 @@ public:
 		return Channel::endAcked();
 	}
 
+	/**
+	 * Returns whether all data that has been fed so far has been consumed
+	 * by the underlying channel. If so, then data may be written to the
+	 * underlying channel's destination directly, without getting out of
+	 * order with data that was fed earlier.
+	 */
+	bool isFlushed() const {
+		return readerState == RS_INACTIVE && !ended();
+	}
+
 	bool passedThreshold() const {
 		return bytesBuffered >= config->threshold;
 	}
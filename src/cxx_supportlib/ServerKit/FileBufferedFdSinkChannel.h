@@ -190,6 +190,10 @@ public:
 		return FileBufferedChannel::passedThreshold();
 	}
 
+	bool isFlushed() const {
+		return FileBufferedChannel::isFlushed();
+	}
+
 	void setFd(int fd) {
 		P_ASSERT_EQ(watcher.fd, -1);
 		ev_io_init(&watcher, onWritable, fd, EV_WRITE);
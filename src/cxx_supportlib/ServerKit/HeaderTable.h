@@ -32,7 +32,9 @@
 
 #include <DataStructures/LString.h>
 #include <DataStructures/HashedStaticString.h>
+#include <ServerKit/HttpHeaderIds.h>
 #include <StaticString.h>
+#include <Utils/Hasher.h>
 
 namespace Passenger {
 namespace ServerKit {
@@ -50,6 +52,10 @@ struct Header {
 	LString origKey;
 	LString val;
 	boost::uint32_t hash;
+	/** Identifies well-known header names, so that they can be recognized
+	 * without comparing strings. HTTP_HEADER_UNKNOWN for other names.
+	 */
+	HttpHeaderId id;
 };
 
 
@@ -113,14 +119,12 @@ private:
 
 	OXT_FORCE_INLINE
 	static bool isCookieHeader(const Header *header) {
-		return header->hash == HTTP_COOKIE.hash()
-			&& psg_lstr_cmp(&header->key, HTTP_COOKIE);
+		return header->id == HTTP_HEADER_COOKIE;
 	}
 
 	OXT_FORCE_INLINE
 	static bool isSetCookieHeader(const Header *header) {
-		return header->hash == HTTP_SET_COOKIE.hash()
-			&& psg_lstr_cmp(&header->key, HTTP_SET_COOKIE);
+		return header->id == HTTP_HEADER_SET_COOKIE;
 	}
 
 	void repopulate(unsigned int desiredSize) {
@@ -257,6 +261,8 @@ public:
 	 * HeaderTable takes over ownership of `header`. But you must ensure that the pool
 	 * that the header was allocated from is not destroyed before the HeaderTable
 	 * is destroyed or cleared.
+	 *
+	 * The header's `hash` and `id` fields must already be set.
 	 */
 	void insert(Header **headerPtr, psg_pool_t *pool) {
 		Header *header = *headerPtr;
@@ -307,6 +313,7 @@ public:
 		const StaticString &value)
 	{
 		Header *header = (Header *) psg_palloc(pool, sizeof(Header));
+		Hasher hasher;
 
 		char *downcasedName = (char *) psg_pnalloc(pool, name.size());
 		convertLowerCase((const unsigned char *) name.data(),
@@ -320,7 +327,9 @@ public:
 		psg_lstr_init(&header->val);
 		psg_lstr_append(&header->val, pool, value.data(), value.size());
 
-		header->hash = HashedStaticString(downcasedName, name.size()).hash();
+		hasher.updateLowerCase(name.data(), name.size());
+		header->hash = hasher.finalize();
+		header->id = httpHeaderIdTable.lookup(header->hash, &header->key);
 		insert(&header, pool);
 		return header;
 	}
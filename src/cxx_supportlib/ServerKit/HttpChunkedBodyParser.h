@@ -130,19 +130,39 @@ private:
 			current - bufferStart, true);
 	}
 
-public:
-	HttpChunkedBodyParser(HttpChunkedBodyParserState *_state,
-		LoggingPrefixFormatter formatter, void *_userData)
-		: state(_state),
-		  loggingPrefixFormatter(formatter),
-		  userData(_userData)
-		{ }
+	/**
+	 * Parses a chunk size line without chunk extension (e.g. "1a\r\n") in
+	 * one go, if it's entirely in the buffer. Returns the position after the
+	 * line, or NULL if the line is incomplete or out of the ordinary, in which
+	 * case nothing is changed and the byte-by-byte state machine takes over.
+	 */
+	const char *parseSizeLine(const char *current, const char *end) {
+		const char *pos = current;
+		boost::uint32_t size = 0;
+
+		while (pos < end && isHexDigit(*pos)) {
+			if (pos != current && size >= HttpChunkedBodyParserState::MAX_CHUNK_SIZE) {
+				return NULL;
+			}
+			size = 16 * size + parseHexDigit(*pos);
+			pos++;
+		}
+		if (pos == current || end - pos < 2
+		 || pos[0] != HttpChunkedBodyParserState::CR
+		 || pos[1] != HttpChunkedBodyParserState::LF)
+		{
+			return NULL;
+		}
 
-	void initialize() {
-		state->state = HttpChunkedBodyParserState::EXPECTING_SIZE_FIRST_DIGIT;
+		state->remainingDataSize = size;
+		state->state = HttpChunkedBodyParserState::EXPECTING_DATA;
+		logChunkSize();
+		return pos + 2;
 	}
 
-	HttpChunkedEvent feed(const MemoryKit::mbuf &buffer, bool outputDataEvents = true) {
+	HttpChunkedEvent parse(const MemoryKit::mbuf &buffer, bool outputDataEvents,
+		MemoryKit::mbuf *slices, unsigned int maxSlices, unsigned int *nslices)
+	{
 		// Calling feed() on channels could result in the request being
 		// ended, which modifies the buffer. So we cache the original
 		// buffer start address here.
@@ -169,7 +189,16 @@ public:
 					if (state->remainingDataSize == 0) {
 						state->state = HttpChunkedBodyParserState::EXPECTING_NON_FINAL_CR;
 					}
-					if (outputDataEvents) {
+					if (slices != NULL) {
+						slices[(*nslices)++] = MemoryKit::mbuf(buffer,
+							current - buffer.start, dataSize);
+						current += dataSize;
+						if (*nslices == maxSlices) {
+							return HttpChunkedEvent(HttpChunkedEvent::DATA,
+								current - buffer.start, false);
+						}
+						break;
+					} else if (outputDataEvents) {
 						return HttpChunkedEvent(HttpChunkedEvent::DATA,
 							MemoryKit::mbuf(buffer, current - buffer.start, dataSize),
 							current + dataSize - buffer.start, false);
@@ -181,7 +210,11 @@ public:
 
 			case HttpChunkedBodyParserState::EXPECTING_SIZE_FIRST_DIGIT:
 				CBP_DEBUG("parsing new chunk");
-				if (isHexDigit(*current)) {
+				needle = parseSizeLine(current, end);
+				if (needle != NULL) {
+					current = needle;
+					break;
+				} else if (isHexDigit(*current)) {
 					state->remainingDataSize = parseHexDigit(*current);
 					state->state = HttpChunkedBodyParserState::EXPECTING_SIZE;
 					current++;
@@ -281,6 +314,41 @@ public:
 
 		return HttpChunkedEvent(HttpChunkedEvent::NONE, current - buffer.start, false);
 	}
+
+public:
+	HttpChunkedBodyParser(HttpChunkedBodyParserState *_state,
+		LoggingPrefixFormatter formatter, void *_userData)
+		: state(_state),
+		  loggingPrefixFormatter(formatter),
+		  userData(_userData)
+		{ }
+
+	void initialize() {
+		state->state = HttpChunkedBodyParserState::EXPECTING_SIZE_FIRST_DIGIT;
+	}
+
+	HttpChunkedEvent feed(const MemoryKit::mbuf &buffer, bool outputDataEvents = true) {
+		return parse(buffer, outputDataEvents, NULL, 0, NULL);
+	}
+
+	/**
+	 * Like feed(), but doesn't return after every piece of chunk data. Instead,
+	 * it stores up to `maxSlices` pieces of chunk data in `slices`, as zero-copy
+	 * views into `buffer`, and only returns when the buffer is exhausted, when
+	 * `slices` is full (a DATA event), or upon an END or ERROR event. The number
+	 * of stored slices is written to `nslices`. The slices precede the returned
+	 * event in the stream, so they must be processed first.
+	 *
+	 * This allows consumers to process a buffer containing many small chunks
+	 * at once, instead of once per chunk.
+	 */
+	HttpChunkedEvent feedMultiple(const MemoryKit::mbuf &buffer, MemoryKit::mbuf *slices,
+		unsigned int maxSlices, unsigned int &nslices)
+	{
+		assert(maxSlices > 0);
+		nslices = 0;
+		return parse(buffer, true, slices, maxSlices, &nslices);
+	}
 };
 
 
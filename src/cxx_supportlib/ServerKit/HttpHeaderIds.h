@@ -0,0 +1,276 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_SERVER_KIT_HTTP_HEADER_IDS_H_
+#define _PASSENGER_SERVER_KIT_HTTP_HEADER_IDS_H_
+
+#include <boost/cstdint.hpp>
+#include <StaticString.h>
+#include <DataStructures/LString.h>
+#include <DataStructures/HashedStaticString.h>
+
+namespace Passenger {
+namespace ServerKit {
+
+
+/**
+ * Well-known header names, as they appear in HeaderTable keys: standard
+ * names are downcased, Passenger's secure headers (which start with "!~")
+ * are not. Secure headers must come last, starting with SECURE_HEADERS_MARKER.
+ */
+#define PSG_HTTP_HEADER_IDS(X) \
+	X(ACCEPT, "accept") \
+	X(ACCEPT_CHARSET, "accept-charset") \
+	X(ACCEPT_ENCODING, "accept-encoding") \
+	X(ACCEPT_LANGUAGE, "accept-language") \
+	X(ACCEPT_RANGES, "accept-ranges") \
+	X(ACCESS_CONTROL_ALLOW_CREDENTIALS, "access-control-allow-credentials") \
+	X(ACCESS_CONTROL_ALLOW_HEADERS, "access-control-allow-headers") \
+	X(ACCESS_CONTROL_ALLOW_METHODS, "access-control-allow-methods") \
+	X(ACCESS_CONTROL_ALLOW_ORIGIN, "access-control-allow-origin") \
+	X(ACCESS_CONTROL_EXPOSE_HEADERS, "access-control-expose-headers") \
+	X(ACCESS_CONTROL_MAX_AGE, "access-control-max-age") \
+	X(ACCESS_CONTROL_REQUEST_HEADERS, "access-control-request-headers") \
+	X(ACCESS_CONTROL_REQUEST_METHOD, "access-control-request-method") \
+	X(AGE, "age") \
+	X(ALLOW, "allow") \
+	X(ALT_SVC, "alt-svc") \
+	X(AUTHORIZATION, "authorization") \
+	X(CACHE_CONTROL, "cache-control") \
+	X(CONNECTION, "connection") \
+	X(CONTENT_DISPOSITION, "content-disposition") \
+	X(CONTENT_ENCODING, "content-encoding") \
+	X(CONTENT_LANGUAGE, "content-language") \
+	X(CONTENT_LENGTH, "content-length") \
+	X(CONTENT_LOCATION, "content-location") \
+	X(CONTENT_MD5, "content-md5") \
+	X(CONTENT_RANGE, "content-range") \
+	X(CONTENT_SECURITY_POLICY, "content-security-policy") \
+	X(CONTENT_SECURITY_POLICY_REPORT_ONLY, "content-security-policy-report-only") \
+	X(CONTENT_TYPE, "content-type") \
+	X(COOKIE, "cookie") \
+	X(DATE, "date") \
+	X(DNT, "dnt") \
+	X(ETAG, "etag") \
+	X(EXPECT, "expect") \
+	X(EXPIRES, "expires") \
+	X(FORWARDED, "forwarded") \
+	X(FROM, "from") \
+	X(HOST, "host") \
+	X(IF_MATCH, "if-match") \
+	X(IF_MODIFIED_SINCE, "if-modified-since") \
+	X(IF_NONE_MATCH, "if-none-match") \
+	X(IF_RANGE, "if-range") \
+	X(IF_UNMODIFIED_SINCE, "if-unmodified-since") \
+	X(KEEP_ALIVE, "keep-alive") \
+	X(LAST_MODIFIED, "last-modified") \
+	X(LINK, "link") \
+	X(LOCATION, "location") \
+	X(MAX_FORWARDS, "max-forwards") \
+	X(ORIGIN, "origin") \
+	X(P3P, "p3p") \
+	X(PRAGMA, "pragma") \
+	X(PROXY_AUTHENTICATE, "proxy-authenticate") \
+	X(PROXY_AUTHORIZATION, "proxy-authorization") \
+	X(PROXY_CONNECTION, "proxy-connection") \
+	X(PUBLIC_KEY_PINS, "public-key-pins") \
+	X(RANGE, "range") \
+	X(REFERER, "referer") \
+	X(REFRESH, "refresh") \
+	X(RETRY_AFTER, "retry-after") \
+	X(SEC_WEBSOCKET_ACCEPT, "sec-websocket-accept") \
+	X(SEC_WEBSOCKET_EXTENSIONS, "sec-websocket-extensions") \
+	X(SEC_WEBSOCKET_KEY, "sec-websocket-key") \
+	X(SEC_WEBSOCKET_PROTOCOL, "sec-websocket-protocol") \
+	X(SEC_WEBSOCKET_VERSION, "sec-websocket-version") \
+	X(SERVER, "server") \
+	X(SET_COOKIE, "set-cookie") \
+	X(STATUS, "status") \
+	X(STRICT_TRANSPORT_SECURITY, "strict-transport-security") \
+	X(TE, "te") \
+	X(TRAILER, "trailer") \
+	X(TRANSFER_ENCODING, "transfer-encoding") \
+	X(UPGRADE, "upgrade") \
+	X(UPGRADE_INSECURE_REQUESTS, "upgrade-insecure-requests") \
+	X(USER_AGENT, "user-agent") \
+	X(VARY, "vary") \
+	X(VIA, "via") \
+	X(WARNING, "warning") \
+	X(WWW_AUTHENTICATE, "www-authenticate") \
+	X(X_ACCEL_REDIRECT, "x-accel-redirect") \
+	X(X_CONTENT_TYPE_OPTIONS, "x-content-type-options") \
+	X(X_CSRF_TOKEN, "x-csrf-token") \
+	X(X_FORWARDED_FOR, "x-forwarded-for") \
+	X(X_FORWARDED_HOST, "x-forwarded-host") \
+	X(X_FORWARDED_PROTO, "x-forwarded-proto") \
+	X(X_FRAME_OPTIONS, "x-frame-options") \
+	X(X_POWERED_BY, "x-powered-by") \
+	X(X_REAL_IP, "x-real-ip") \
+	X(X_REQUEST_ID, "x-request-id") \
+	X(X_REQUESTED_WITH, "x-requested-with") \
+	X(X_RUNTIME, "x-runtime") \
+	X(X_SENDFILE, "x-sendfile") \
+	X(X_UA_COMPATIBLE, "x-ua-compatible") \
+	X(X_XSS_PROTECTION, "x-xss-protection") \
+	X(SECURE_HEADERS_MARKER, "!~") \
+	X(DOCUMENT_ROOT, "!~DOCUMENT_ROOT") \
+	X(FLAGS, "!~FLAGS") \
+	X(PASSENGER_ABORT_WEBSOCKETS_ON_PROCESS_SHUTDOWN, "!~PASSENGER_ABORT_WEBSOCKETS_ON_PROCESS_SHUTDOWN") \
+	X(PASSENGER_APP_ENV, "!~PASSENGER_APP_ENV") \
+	X(PASSENGER_APP_FILE_DESCRIPTOR_ULIMIT, "!~PASSENGER_APP_FILE_DESCRIPTOR_ULIMIT") \
+	X(PASSENGER_APP_GROUP_NAME, "!~PASSENGER_APP_GROUP_NAME") \
+	X(PASSENGER_APP_ROOT, "!~PASSENGER_APP_ROOT") \
+	X(PASSENGER_APP_TYPE, "!~PASSENGER_APP_TYPE") \
+	X(PASSENGER_ENV_VARS, "!~PASSENGER_ENV_VARS") \
+	X(PASSENGER_FORCE_MAX_CONCURRENT_REQUESTS_PER_PROCESS, "!~PASSENGER_FORCE_MAX_CONCURRENT_REQUESTS_PER_PROCESS") \
+	X(PASSENGER_FRIENDLY_ERROR_PAGES, "!~PASSENGER_FRIENDLY_ERROR_PAGES") \
+	X(PASSENGER_GROUP, "!~PASSENGER_GROUP") \
+	X(PASSENGER_LOAD_SHELL_ENVVARS, "!~PASSENGER_LOAD_SHELL_ENVVARS") \
+	X(PASSENGER_LVE_MIN_UID, "!~PASSENGER_LVE_MIN_UID") \
+	X(PASSENGER_MAX_PRELOADER_IDLE_TIME, "!~PASSENGER_MAX_PRELOADER_IDLE_TIME") \
+	X(PASSENGER_MAX_PROCESSES, "!~PASSENGER_MAX_PROCESSES") \
+	X(PASSENGER_MAX_REQUESTS, "!~PASSENGER_MAX_REQUESTS") \
+	X(PASSENGER_MAX_REQUEST_QUEUE_SIZE, "!~PASSENGER_MAX_REQUEST_QUEUE_SIZE") \
+	X(PASSENGER_METEOR_APP_SETTINGS, "!~PASSENGER_METEOR_APP_SETTINGS") \
+	X(PASSENGER_MIN_PROCESSES, "!~PASSENGER_MIN_PROCESSES") \
+	X(PASSENGER_NODEJS, "!~PASSENGER_NODEJS") \
+	X(PASSENGER_PYTHON, "!~PASSENGER_PYTHON") \
+	X(PASSENGER_RAISE_INTERNAL_ERROR, "!~PASSENGER_RAISE_INTERNAL_ERROR") \
+	X(PASSENGER_REQUEST_QUEUE_OVERFLOW_STATUS_CODE, "!~PASSENGER_REQUEST_QUEUE_OVERFLOW_STATUS_CODE") \
+	X(PASSENGER_RESTART_DIR, "!~PASSENGER_RESTART_DIR") \
+	X(PASSENGER_ROUTING_POLICY, "!~PASSENGER_ROUTING_POLICY") \
+	X(PASSENGER_RUBY, "!~PASSENGER_RUBY") \
+	X(PASSENGER_SHOW_VERSION_IN_HEADER, "!~PASSENGER_SHOW_VERSION_IN_HEADER") \
+	X(PASSENGER_SPAWN_METHOD, "!~PASSENGER_SPAWN_METHOD") \
+	X(PASSENGER_STARTUP_FILE, "!~PASSENGER_STARTUP_FILE") \
+	X(PASSENGER_START_COMMAND, "!~PASSENGER_START_COMMAND") \
+	X(PASSENGER_START_TIMEOUT, "!~PASSENGER_START_TIMEOUT") \
+	X(PASSENGER_STICKY_SESSIONS, "!~PASSENGER_STICKY_SESSIONS") \
+	X(PASSENGER_STICKY_SESSIONS_COOKIE_NAME, "!~PASSENGER_STICKY_SESSIONS_COOKIE_NAME") \
+	X(PASSENGER_USER, "!~PASSENGER_USER") \
+	X(PASSENGER_VARY_TURBOCACHE_COOKIE, "!~PASSENGER_VARY_TURBOCACHE_COOKIE") \
+	X(REMOTE_ADDR, "!~REMOTE_ADDR") \
+	X(REMOTE_PORT, "!~REMOTE_PORT") \
+	X(REMOTE_USER, "!~REMOTE_USER") \
+	X(REQUEST_OOB_WORK, "!~Request-OOB-Work") \
+	X(SCRIPT_NAME, "!~SCRIPT_NAME") \
+	X(UNION_STATION_FILTERS, "!~UNION_STATION_FILTERS") \
+	X(UNION_STATION_KEY, "!~UNION_STATION_KEY") \
+	X(UNION_STATION_SUPPORT, "!~UNION_STATION_SUPPORT")
+
+enum HttpHeaderId {
+	HTTP_HEADER_UNKNOWN,
+
+	#define PSG_DEFINE_HTTP_HEADER_ID(id, name) HTTP_HEADER_ ## id,
+	PSG_HTTP_HEADER_IDS(PSG_DEFINE_HTTP_HEADER_ID)
+	#undef PSG_DEFINE_HTTP_HEADER_ID
+
+	HTTP_HEADER_ID_COUNT
+};
+
+inline bool
+isSecureHttpHeaderId(HttpHeaderId id) {
+	return id >= HTTP_HEADER_SECURE_HEADERS_MARKER;
+}
+
+struct HttpHeaderName {
+	const char *data;
+	unsigned int size;
+};
+
+/** Indexed by HttpHeaderId. */
+extern const HttpHeaderName httpHeaderNames[HTTP_HEADER_ID_COUNT];
+
+inline StaticString
+getHttpHeaderName(HttpHeaderId id) {
+	return StaticString(httpHeaderNames[id].data, httpHeaderNames[id].size);
+}
+
+
+/**
+ * A perfect hash table that maps the hashes of the names in PSG_HTTP_HEADER_IDS
+ * to their IDs. Each name maps to its own slot, so a lookup always inspects
+ * exactly one slot: it is a hit if the slot's hash is equal to the looked up
+ * hash, and the name is equal to the slot's name.
+ *
+ * It uses the "hash, displace" scheme: names are divided over buckets,
+ * and each bucket has a displacement value that was chosen so that the
+ * bucket's names don't end up in slots that are already taken. The table is
+ * built once, at startup, because the hash values depend on Hasher.
+ */
+class HttpHeaderIdTable {
+public:
+	static const unsigned int BUCKET_COUNT = 64;
+	static const unsigned int SLOT_BITS = 8;
+	static const unsigned int SLOT_COUNT = 1 << SLOT_BITS;
+
+private:
+	boost::uint8_t displacements[BUCKET_COUNT];
+	boost::uint8_t ids[SLOT_COUNT];
+	boost::uint32_t hashes[SLOT_COUNT];
+
+	static unsigned int getSlot(boost::uint32_t hash, boost::uint8_t displacement) {
+		return ((hash ^ (displacement * 0x9e3779b9u)) * 0x85ebca6bu) >> (32 - SLOT_BITS);
+	}
+
+	unsigned int getSlot(boost::uint32_t hash) const {
+		return getSlot(hash, displacements[hash % BUCKET_COUNT]);
+	}
+
+public:
+	HttpHeaderIdTable();
+
+	HttpHeaderId lookup(boost::uint32_t hash, const LString *name) const {
+		unsigned int slot = getSlot(hash);
+		HttpHeaderId id = (HttpHeaderId) ids[slot];
+		if (id != HTTP_HEADER_UNKNOWN && hashes[slot] == hash
+		 && psg_lstr_cmp(name, getHttpHeaderName(id)))
+		{
+			return id;
+		} else {
+			return HTTP_HEADER_UNKNOWN;
+		}
+	}
+
+	HttpHeaderId lookup(const HashedStaticString &name) const {
+		unsigned int slot = getSlot(name.hash());
+		HttpHeaderId id = (HttpHeaderId) ids[slot];
+		if (id != HTTP_HEADER_UNKNOWN && hashes[slot] == name.hash()
+		 && name == getHttpHeaderName(id))
+		{
+			return id;
+		} else {
+			return HTTP_HEADER_UNKNOWN;
+		}
+	}
+};
+
+extern const HttpHeaderIdTable httpHeaderIdTable;
+
+
+} // namespace ServerKit
+} // namespace Passenger
+
+#endif /* _PASSENGER_SERVER_KIT_HTTP_HEADER_IDS_H_ */
@@ -35,6 +35,7 @@
 #include <ServerKit/Context.h>
 #include <ServerKit/HttpRequest.h>
 #include <ServerKit/HttpHeaderParserState.h>
+#include <ServerKit/HttpHeaderIds.h>
 #include <DataStructures/LString.h>
 #include <DataStructures/HashedStaticString.h>
 #include <LoggingKit/LoggingKit.h>
@@ -211,7 +212,7 @@ private:
 				(unsigned char *) downcasedData, len);
 			psg_lstr_append(&self->state->currentHeader->key, self->pool,
 				downcasedData, len);
-			self->state->hasher.update(downcasedData, len);
+			self->state->hasher.updateLowerCase(data, len);
 		}
 
 		return 0;
@@ -230,12 +231,15 @@ private:
 				self->state->state = HttpHeaderParserState::PARSING_HEADER_VALUE;
 			}
 			self->state->currentHeader->hash = self->state->hasher.finalize();
-
+			self->state->currentHeader->id = httpHeaderIdTable.lookup(
+				self->state->currentHeader->hash, &self->state->currentHeader->key);
 		}
 
+		// Only the key is hashed. Values are referenced from the input
+		// buffer and are not touched until someone looks them up or
+		// forwards them.
 		psg_lstr_append(&self->state->currentHeader->val, self->pool,
 			*self->currentBuffer, data, len);
-		self->state->hasher.update(data, len);
 
 		return 0;
 	}
@@ -125,6 +125,11 @@ public:
 
 	FreeRequestList freeRequests;
 	unsigned int freeRequestCount;
+	/**
+	 * Recycles the memory of the request pools, and collects statistics
+	 * about their usage. Only used from the event loop thread.
+	 */
+	psg_pool_cache_t requestPoolCache;
 	unsigned long totalRequestsBegun, lastTotalRequestsBegun;
 	double requestBeginSpeed1m, requestBeginSpeed1h;
 
@@ -923,7 +928,7 @@ protected:
 		if (OXT_UNLIKELY(req->pool == NULL)) {
 			// We assume that most of the time, the pool from the
 			// last request is reset and reused.
-			req->pool = psg_create_pool(PSG_DEFAULT_POOL_SIZE);
+			req->pool = psg_create_pool(PSG_DEFAULT_POOL_SIZE, &requestPoolCache);
 		}
 		psg_lstr_init(&req->path);
 		req->bodyChannel.reinitialize();
@@ -1000,6 +1005,11 @@ public:
 		  headerParserStatePool(16, 256)
 	{
 		STAILQ_INIT(&freeRequests);
+		psg_pool_cache_init(&requestPoolCache, PSG_DEFAULT_POOL_SIZE);
+	}
+
+	~HttpServer() {
+		psg_pool_cache_compact(&requestPoolCache);
 	}
 
 
@@ -1021,9 +1031,11 @@ public:
 			delete request;
 		}
 		assert(freeRequestCount == 0);
+		size_t poolCacheSize = psg_pool_cache_compact(&requestPoolCache);
 
 		SKS_LOG(logLevel, __FILE__, __LINE__,
-			"Freed " << count << " spare request objects");
+			"Freed " << count << " spare request objects and " <<
+			poolCacheSize << " bytes of cached request pool memory");
 	}
 
 
@@ -1267,6 +1279,39 @@ public:
 		doc["request_begin_speed"]["1h"] = averageSpeedToJson(
 			capFloatPrecision(requestBeginSpeed1h * 60),
 			"minute", "1 hour", -1);
+		doc["request_pools"] = inspectRequestPoolsAsJson();
+		return doc;
+	}
+
+	Json::Value inspectRequestPoolsAsJson() const {
+		Json::Value doc;
+		Json::Value highWaterMarks(Json::arrayValue);
+		Json::Value largeCounts(Json::arrayValue);
+		unsigned int i;
+
+		doc["mallocs"] = (Json::UInt64) requestPoolCache.nmallocs;
+		doc["cached_memory"] = byteSizeToJson(psg_pool_cache_size(&requestPoolCache));
+
+		for (i = 0; i < PSG_POOL_HIGH_WATER_MARK_BUCKETS; i++) {
+			Json::Value bucket;
+			if (i < PSG_POOL_HIGH_WATER_MARK_BUCKETS - 1) {
+				bucket["max_size"] = byteSizeToJson(1024 << i);
+			} else {
+				bucket["max_size"] = Json::Value(Json::nullValue);
+			}
+			bucket["count"] = (Json::UInt64) requestPoolCache.high_water_marks[i];
+			highWaterMarks.append(bucket);
+		}
+		doc["high_water_marks"] = highWaterMarks;
+
+		for (i = 0; i < PSG_POOL_LARGE_COUNT_BUCKETS; i++) {
+			Json::Value bucket;
+			bucket["min_allocations"] = i == 0 ? 0 : 1u << (i - 1);
+			bucket["count"] = (Json::UInt64) requestPoolCache.large_counts[i];
+			largeCounts.append(bucket);
+		}
+		doc["large_allocations"] = largeCounts;
+
 		return doc;
 	}
 
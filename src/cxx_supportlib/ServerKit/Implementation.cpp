@@ -23,7 +23,14 @@
  *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  *  THE SOFTWARE.
  */
+#include <boost/cstdint.hpp>
+#include <algorithm>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <DataStructures/HashedStaticString.h>
+#include <ServerKit/HttpHeaderIds.h>
 
 namespace Passenger {
 namespace ServerKit {
@@ -36,6 +43,8 @@ extern const HashedStaticString HTTP_CONTENT_LENGTH;
 extern const HashedStaticString HTTP_TRANSFER_ENCODING;
 extern const HashedStaticString HTTP_X_SENDFILE;
 extern const HashedStaticString HTTP_X_ACCEL_REDIRECT;
+extern const HttpHeaderName httpHeaderNames[HTTP_HEADER_ID_COUNT];
+extern const HttpHeaderIdTable httpHeaderIdTable;
 extern const char DEFAULT_INTERNAL_SERVER_ERROR_RESPONSE[];
 extern const unsigned int DEFAULT_INTERNAL_SERVER_ERROR_RESPONSE_SIZE;
 
@@ -55,6 +64,72 @@ const HashedStaticString HTTP_TRANSFER_ENCODING("transfer-encoding");
 const HashedStaticString HTTP_X_SENDFILE("x-sendfile");
 const HashedStaticString HTTP_X_ACCEL_REDIRECT("x-accel-redirect");
 
+const HttpHeaderName httpHeaderNames[HTTP_HEADER_ID_COUNT] = {
+	{ "", 0 },
+	#define PSG_DEFINE_HTTP_HEADER_NAME(id, name) { name, sizeof(name) - 1 },
+	PSG_HTTP_HEADER_IDS(PSG_DEFINE_HTTP_HEADER_NAME)
+	#undef PSG_DEFINE_HTTP_HEADER_NAME
+};
+
+static bool
+compareBucketSizes(const std::vector<HttpHeaderId> &a, const std::vector<HttpHeaderId> &b) {
+	return a.size() > b.size();
+}
+
+HttpHeaderIdTable::HttpHeaderIdTable() {
+	std::vector< std::vector<HttpHeaderId> > buckets(BUCKET_COUNT);
+	std::vector<unsigned int> bucketIndices(BUCKET_COUNT);
+	unsigned int i, j;
+
+	memset(displacements, 0, sizeof(displacements));
+	memset(ids, 0, sizeof(ids));
+	memset(hashes, 0, sizeof(hashes));
+
+	for (i = HTTP_HEADER_UNKNOWN + 1; i < HTTP_HEADER_ID_COUNT; i++) {
+		HttpHeaderId id = (HttpHeaderId) i;
+		buckets[HashedStaticString(getHttpHeaderName(id)).hash() % BUCKET_COUNT].push_back(id);
+	}
+
+	// Place the fullest buckets first, while most slots are still free.
+	std::stable_sort(buckets.begin(), buckets.end(), compareBucketSizes);
+
+	for (i = 0; i < BUCKET_COUNT && !buckets[i].empty(); i++) {
+		const std::vector<HttpHeaderId> &bucket = buckets[i];
+		boost::uint32_t bucketIndex = HashedStaticString(getHttpHeaderName(bucket[0])).hash()
+			% BUCKET_COUNT;
+		unsigned int displacement;
+		bool placed = false;
+
+		for (displacement = 0; displacement < 256 && !placed; displacement++) {
+			std::vector<unsigned int> slots;
+			placed = true;
+			for (j = 0; j < bucket.size() && placed; j++) {
+				unsigned int slot = getSlot(
+					HashedStaticString(getHttpHeaderName(bucket[j])).hash(),
+					displacement);
+				placed = ids[slot] == HTTP_HEADER_UNKNOWN
+					&& std::find(slots.begin(), slots.end(), slot) == slots.end();
+				slots.push_back(slot);
+			}
+			if (placed) {
+				displacements[bucketIndex] = displacement;
+				for (j = 0; j < bucket.size(); j++) {
+					ids[slots[j]] = bucket[j];
+					hashes[slots[j]] = HashedStaticString(getHttpHeaderName(bucket[j])).hash();
+				}
+			}
+		}
+
+		if (!placed) {
+			// This runs before LoggingKit is initialized, so don't use P_BUG.
+			fprintf(stderr, "BUG: unable to build the perfect hash table for HTTP header names\n");
+			abort();
+		}
+	}
+}
+
+const HttpHeaderIdTable httpHeaderIdTable;
+
 
 } // namespace ServerKit
 } // namespace
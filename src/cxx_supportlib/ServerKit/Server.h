@@ -31,6 +31,7 @@
 #include <boost/cstdint.hpp>
 #include <boost/config.hpp>
 #include <boost/scoped_ptr.hpp>
+#include <boost/atomic.hpp>
 #include <oxt/system_calls.hpp>
 #include <oxt/backtrace.hpp>
 #include <oxt/macros.hpp>
@@ -294,6 +295,11 @@ public:
 	ClientList activeClients, disconnectedClients;
 	unsigned int freeClientCount, activeClientCount, disconnectedClientCount;
 	unsigned int peakActiveClientCount;
+	/**
+	 * A copy of `activeClientCount` that may be read from other threads,
+	 * e.g. by AcceptLoadBalancer when it looks for the least busy Server.
+	 */
+	boost::atomic<unsigned int> sharedActiveClientCount;
 	unsigned long totalClientsAccepted, lastTotalClientsAccepted;
 	unsigned long long totalBytesConsumed;
 	ev_tstamp lastStatisticsUpdateTime;
@@ -365,6 +371,7 @@ private:
 		}
 
 		if (acceptCount > 0) {
+			sharedActiveClientCount.store(activeClientCount, boost::memory_order_relaxed);
 			SKS_DEBUG(acceptCount << " new client(s) accepted; there are now " <<
 				activeClientCount << " active client(s)");
 		}
@@ -741,6 +748,7 @@ public:
 		  activeClientCount(0),
 		  disconnectedClientCount(0),
 		  peakActiveClientCount(0),
+		  sharedActiveClientCount(0),
 		  totalClientsAccepted(0),
 		  lastTotalClientsAccepted(0),
 		  totalBytesConsumed(0),
@@ -865,6 +873,7 @@ public:
 		P_ASSERT_EQ(serverState, ACTIVE);
 
 		activeClientCount += size;
+		sharedActiveClientCount.store(activeClientCount, boost::memory_order_relaxed);
 		totalClientsAccepted += size;
 
 		for (unsigned int i = 0; i < size; i++) {
@@ -1050,6 +1059,7 @@ public:
 		c->setConnState(ClientType::DISCONNECTED);
 		TAILQ_REMOVE(&activeClients, c, nextClient.activeOrDisconnectedClient);
 		activeClientCount--;
+		sharedActiveClientCount.store(activeClientCount, boost::memory_order_relaxed);
 		TAILQ_INSERT_HEAD(&disconnectedClients, c, nextClient.activeOrDisconnectedClient);
 		disconnectedClientCount++;
 
@@ -29,6 +29,14 @@
 #include <string.h>
 #include <limits.h>
 
+#if (defined(__x86_64__) || defined(__i386__)) && \
+  (defined(__clang__) || __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+# define HTTP_PARSER_X86_SIMD 1
+# include <immintrin.h>
+#else
+# define HTTP_PARSER_X86_SIMD 0
+#endif
+
 #ifndef ULLONG_MAX
 # define ULLONG_MAX ((boost::uint64_t) -1) /* 2^64-1 */
 #endif
@@ -573,6 +581,136 @@ parse_url_char(enum state s, const char ch)
   return s_dead;
 }
 
+
+/* Most bytes in an HTTP header belong to the names and values of headers
+ * that the parser has no special interest in (header_state == h_general).
+ * For those, the state machine only has to find where the name or value
+ * ends, so instead of walking through them byte by byte, we scan ahead
+ * with SSE4.2 or AVX2 instructions if the CPU supports them. Scanning
+ * stops at the first byte that may need the state machine's attention,
+ * and never crosses HTTP_MAX_HEADER_SIZE, so the parser behaves exactly
+ * as if all bytes were processed one by one.
+ */
+static enum http_parser_simd detect_simd(void);
+static enum http_parser_simd simd = detect_simd();
+
+static enum http_parser_simd
+detect_simd(void)
+{
+#if HTTP_PARSER_X86_SIMD
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return HTTP_PARSER_SIMD_AVX2;
+  } else if (__builtin_cpu_supports("sse4.2")) {
+    return HTTP_PARSER_SIMD_SSE42;
+  }
+#endif
+  return HTTP_PARSER_SIMD_NONE;
+}
+
+#if HTTP_PARSER_X86_SIMD
+/* Returns a pointer to the first byte in [p, end) that may not be a token
+ * character, or a pointer into the last 16 bytes if all bytes before it are
+ * token characters. The ranges below are a superset of the non-token
+ * characters: they also contain '|' and '~'.
+ */
+__attribute__((target("sse4.2")))
+static const char *
+find_header_field_end_sse42(const char *p, const char *end)
+{
+  static const char ranges[16] = {
+    '\0', ' ', '"', '"', '(', ')', ',', ',',
+    '/', '/', ':', '@', '[', ']', '{', '\xff'
+  };
+  const __m128i r = _mm_loadu_si128((const __m128i *) ranges);
+
+  while (end - p >= 16) {
+    __m128i b = _mm_loadu_si128((const __m128i *) p);
+    int i = _mm_cmpestri(r, sizeof(ranges), b, 16,
+      _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES | _SIDD_LEAST_SIGNIFICANT);
+    if (i != 16) {
+      return p + i;
+    }
+    p += 16;
+  }
+  return p;
+}
+
+/* Returns a pointer to the first CR or LF in [p, end), or a pointer into the
+ * last 16 (SSE4.2) or 32 (AVX2) bytes if there is none before it.
+ */
+__attribute__((target("sse4.2")))
+static const char *
+find_header_value_end_sse42(const char *p, const char *end)
+{
+  const __m128i cr = _mm_set1_epi8(CR);
+  const __m128i lf = _mm_set1_epi8(LF);
+
+  while (end - p >= 16) {
+    __m128i b = _mm_loadu_si128((const __m128i *) p);
+    int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(b, cr),
+      _mm_cmpeq_epi8(b, lf)));
+    if (mask != 0) {
+      return p + __builtin_ctz(mask);
+    }
+    p += 16;
+  }
+  return p;
+}
+
+__attribute__((target("avx2")))
+static const char *
+find_header_value_end_avx2(const char *p, const char *end)
+{
+  const __m256i cr = _mm256_set1_epi8(CR);
+  const __m256i lf = _mm256_set1_epi8(LF);
+
+  while (end - p >= 32) {
+    __m256i b = _mm256_loadu_si256((const __m256i *) p);
+    unsigned int mask = (unsigned int) _mm256_movemask_epi8(_mm256_or_si256(
+      _mm256_cmpeq_epi8(b, cr), _mm256_cmpeq_epi8(b, lf)));
+    if (mask != 0) {
+      return p + __builtin_ctz(mask);
+    }
+    p += 32;
+  }
+  return find_header_value_end_sse42(p, end);
+}
+
+/* The end of the range that may be scanned, given that the byte at 'p'
+ * has already been counted in parser->nread.
+ */
+static const char *
+scan_limit(const http_parser *parser, const char *p, const char *end)
+{
+  size_t room = HTTP_MAX_HEADER_SIZE - parser->nread;
+  if ((size_t) (end - p - 1) > room) {
+    return p + 1 + room;
+  } else {
+    return end;
+  }
+}
+#endif
+
+enum http_parser_simd
+http_parser_simd_supported(void)
+{
+  return detect_simd();
+}
+
+enum http_parser_simd
+http_parser_get_simd(void)
+{
+  return simd;
+}
+
+void
+http_parser_set_simd(enum http_parser_simd level)
+{
+  enum http_parser_simd supported = detect_simd();
+  simd = (level < supported) ? level : supported;
+}
+
 size_t http_parser_execute (http_parser *parser,
                             const http_parser_settings *settings,
                             const char *data,
@@ -1283,6 +1421,14 @@ size_t http_parser_execute (http_parser *parser,
         if (c) {
           switch (parser->header_state) {
             case h_general:
+#if HTTP_PARSER_X86_SIMD
+              if (simd != HTTP_PARSER_SIMD_NONE) {
+                const char *q = find_header_field_end_sse42(p + 1,
+                  scan_limit(parser, p, data + len));
+                parser->nread += q - (p + 1);
+                p = q - 1;
+              }
+#endif
               break;
 
             case h_C:
@@ -1492,6 +1638,16 @@ size_t http_parser_execute (http_parser *parser,
 
         switch (parser->header_state) {
           case h_general:
+#if HTTP_PARSER_X86_SIMD
+            if (simd != HTTP_PARSER_SIMD_NONE) {
+              const char *limit = scan_limit(parser, p, data + len);
+              const char *q = (simd == HTTP_PARSER_SIMD_AVX2)
+                ? find_header_value_end_avx2(p + 1, limit)
+                : find_header_value_end_sse42(p + 1, limit);
+              parser->nread += q - (p + 1);
+              p = q - 1;
+            }
+#endif
             break;
 
           case h_connection:
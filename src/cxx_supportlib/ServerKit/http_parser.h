@@ -324,6 +324,28 @@ void http_parser_pause(http_parser *parser, int paused);
 /* Checks if this is the final chunk of the body. */
 int http_body_is_final(const http_parser *parser);
 
+/* Instruction set extensions that the parser may use to scan through
+ * header names and values.
+ */
+enum http_parser_simd
+  { HTTP_PARSER_SIMD_NONE = 0
+  , HTTP_PARSER_SIMD_SSE42
+  , HTTP_PARSER_SIMD_AVX2
+  };
+
+/* Returns the best extension supported by both this build and the CPU. */
+enum http_parser_simd http_parser_simd_supported(void);
+
+/* Returns the extension that the parser uses. Defaults to
+ * http_parser_simd_supported().
+ */
+enum http_parser_simd http_parser_get_simd(void);
+
+/* Changes the extension that the parser uses, but never to one that is not
+ * supported. Meant for tests and benchmarks; not thread-safe.
+ */
+void http_parser_set_simd(enum http_parser_simd level);
+
 #ifdef __cplusplus
 }
 #endif
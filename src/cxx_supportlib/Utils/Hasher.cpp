@@ -26,10 +26,15 @@
 
 // Implementation is in its own file so that we can enable compiler optimizations for these functions only.
 
+#include <cstring>
 #include <Utils/Hasher.h>
 
 namespace Passenger {
 
+const boost::uint32_t JenkinsHash::EMPTY_STRING_HASH;
+const boost::uint32_t MumHash::EMPTY_STRING_HASH;
+
+
 void
 JenkinsHash::update(const char *data, unsigned int size) {
 	const char *end = data + size;
@@ -50,4 +55,119 @@ JenkinsHash::finalize() {
 	return hash;
 }
 
+
+static const boost::uint64_t MUM_P0 = 0xa0761d6478bd642fULL;
+static const boost::uint64_t MUM_P1 = 0xe7037ed1a0b428dbULL;
+static const boost::uint64_t MUM_P2 = 0x8ebc6af09c88c6e3ULL;
+
+static inline boost::uint64_t
+mum(boost::uint64_t a, boost::uint64_t b) {
+	#ifdef __SIZEOF_INT128__
+		__uint128_t r = (__uint128_t) a * b;
+		return (boost::uint64_t) r ^ (boost::uint64_t) (r >> 64);
+	#else
+		boost::uint64_t aLo = a & 0xffffffff, aHi = a >> 32;
+		boost::uint64_t bLo = b & 0xffffffff, bHi = b >> 32;
+		boost::uint64_t loLo = aLo * bLo, loHi = aLo * bHi;
+		boost::uint64_t hiLo = aHi * bLo, hiHi = aHi * bHi;
+		boost::uint64_t mid = (loLo >> 32) + (loHi & 0xffffffff) + (hiLo & 0xffffffff);
+		boost::uint64_t lo = (mid << 32) | (loLo & 0xffffffff);
+		boost::uint64_t hi = hiHi + (loHi >> 32) + (hiLo >> 32) + (mid >> 32);
+		return lo ^ hi;
+	#endif
+}
+
+static inline boost::uint64_t
+mixWord(boost::uint64_t hash, boost::uint64_t word) {
+	return mum(word ^ MUM_P0, hash ^ MUM_P1);
+}
+
+/** Loads 8 bytes as a little-endian word, so that words assembled byte by byte match. */
+static inline boost::uint64_t
+loadWord(const char *data) {
+	boost::uint64_t word;
+	memcpy(&word, data, sizeof(word));
+	#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+		word = __builtin_bswap64(word);
+	#endif
+	return word;
+}
+
+static inline unsigned char
+lowerCaseByte(unsigned char c) {
+	return (c >= 'A' && c <= 'Z') ? (c | 0x20) : c;
+}
+
+/** Converts the ASCII letters in all 8 bytes of a word to lowercase at once. */
+static inline boost::uint64_t
+lowerCaseWord(boost::uint64_t word) {
+	const boost::uint64_t ones = 0x0101010101010101ULL;
+	boost::uint64_t heptets = word & (0x7f * ones);
+	boost::uint64_t geA = heptets + (0x80 - 'A') * ones;
+	boost::uint64_t gtZ = heptets + (0x80 - 'Z' - 1) * ones;
+	boost::uint64_t isUpper = (geA ^ gtZ) & ~word & (0x80 * ones);
+	return word | (isUpper >> 2);
+}
+
+template<bool lowerCase>
+static inline void
+mumHashUpdate(MumHash &state, const char *data, unsigned int size) {
+	const char *end = data + size;
+	unsigned int tailSize = state.size % 8;
+
+	state.size += size;
+
+	if (tailSize > 0) {
+		// Complete the partial word from the previous update() call first.
+		while (tailSize < 8 && data < end) {
+			unsigned char c = *data;
+			if (lowerCase) {
+				c = lowerCaseByte(c);
+			}
+			state.tail |= (boost::uint64_t) c << (tailSize * 8);
+			tailSize++;
+			data++;
+		}
+		if (tailSize < 8) {
+			return;
+		}
+		state.hash = mixWord(state.hash, state.tail);
+		state.tail = 0;
+	}
+
+	while (end - data >= 8) {
+		boost::uint64_t word = loadWord(data);
+		if (lowerCase) {
+			word = lowerCaseWord(word);
+		}
+		state.hash = mixWord(state.hash, word);
+		data += 8;
+	}
+
+	for (tailSize = 0; data < end; data++, tailSize++) {
+		unsigned char c = *data;
+		if (lowerCase) {
+			c = lowerCaseByte(c);
+		}
+		state.tail |= (boost::uint64_t) c << (tailSize * 8);
+	}
+}
+
+void
+MumHash::update(const char *data, unsigned int size) {
+	mumHashUpdate<false>(*this, data, size);
+}
+
+void
+MumHash::updateLowerCase(const char *data, unsigned int size) {
+	mumHashUpdate<true>(*this, data, size);
+}
+
+boost::uint32_t
+MumHash::finalize() {
+	boost::uint64_t result = mum(tail ^ MUM_P2, hash ^ MUM_P1);
+	result = mum(result ^ size ^ MUM_P0, MUM_P2);
+	return (boost::uint32_t) (result ^ (result >> 32));
+}
+
 } // namespace Passenger
@@ -31,9 +31,10 @@
 namespace Passenger {
 
 
-// TODO: use SpookyHash on x86_64
-// TODO: use streaming murmurhash implementation: https://github.com/c9/murmur3
-
+/**
+ * Bob Jenkins's one-at-a-time hash. Processes one byte at a time. It was
+ * Passenger's string hash before MumHash, and is kept around for comparison.
+ */
 struct JenkinsHash {
 	static const boost::uint32_t EMPTY_STRING_HASH = 0;
 
@@ -51,7 +52,45 @@ struct JenkinsHash {
 	}
 };
 
-typedef JenkinsHash Hasher;
+/**
+ * A streaming string hash that processes input 8 bytes at a time. Each word
+ * is mixed into the state with a 64x64->128 bit multiplication whose halves
+ * are XORed together, like in wyhash and mum-hash.
+ *
+ * Bytes that don't fill a whole word are buffered until the next update()
+ * call or until finalize(). The result therefore doesn't depend on how the
+ * input is split over update() calls. This matters because HttpHeaderParser
+ * hashes header names as they arrive from the network, and the result must
+ * match the hash of the same name in a HashedStaticString.
+ *
+ * updateLowerCase() hashes the input as if its ASCII letters had been
+ * converted to lowercase with convertLowerCase().
+ */
+struct MumHash {
+	static const boost::uint32_t EMPTY_STRING_HASH = 0xe80dda41u;
+
+	boost::uint64_t hash;
+	boost::uint64_t tail;
+	boost::uint64_t size;
+
+	MumHash()
+		: hash(0),
+		  tail(0),
+		  size(0)
+		{ }
+
+	void update(const char *data, unsigned int size);
+	void updateLowerCase(const char *data, unsigned int size);
+	boost::uint32_t finalize();
+
+	void reset() {
+		hash = 0;
+		tail = 0;
+		size = 0;
+	}
+};
+
+typedef MumHash Hasher;
 
 
 } // namespace Passenger
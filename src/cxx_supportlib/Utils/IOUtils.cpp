@@ -56,6 +56,8 @@
 	// For accept4 macros
 	#include <sys/syscall.h>
 	#include <linux/net.h>
+	// For SO_ATTACH_REUSEPORT_CBPF
+	#include <linux/filter.h>
 #endif
 
 #if defined(__APPLE__)
@@ -368,9 +370,9 @@ createUnixServer(const StaticString &filename, unsigned int backlogSize, bool au
 	return fd;
 }
 
-int
-createTcpServer(const char *address, unsigned short port, unsigned int backlogSize,
-	const char *file, unsigned int line)
+static int
+createTcpServerWithOptions(const char *address, unsigned short port, unsigned int backlogSize,
+	bool reusePort, const char *file, unsigned int line)
 {
 	union {
 		struct sockaddr_in v4;
@@ -423,6 +425,19 @@ createTcpServer(const char *address, unsigned short port, unsigned int backlogSi
 	// Ignore SO_REUSEADDR error, it's not fatal.
 
 	FdGuard guard(fd, file, line, true);
+	if (reusePort) {
+		#ifdef SO_REUSEPORT
+			optval = 1;
+			if (syscalls::setsockopt(fd, SOL_SOCKET, SO_REUSEPORT,
+				&optval, sizeof(optval)) == -1)
+			{
+				int e = errno;
+				throw SystemException("Cannot set SO_REUSEPORT on a TCP socket", e);
+			}
+		#else
+			throw SystemException("Cannot set SO_REUSEPORT on a TCP socket", ENOSYS);
+		#endif
+	}
 	if (family == AF_INET) {
 		ret = syscalls::bind(fd, (const struct sockaddr *) &addr.v4, sizeof(struct sockaddr_in));
 	} else {
@@ -454,6 +469,44 @@ createTcpServer(const char *address, unsigned short port, unsigned int backlogSi
 	return fd;
 }
 
+int
+createTcpServer(const char *address, unsigned short port, unsigned int backlogSize,
+	const char *file, unsigned int line)
+{
+	return createTcpServerWithOptions(address, port, backlogSize, false, file, line);
+}
+
+int
+createReusePortTcpServer(const char *address, unsigned short port, unsigned int backlogSize,
+	const char *file, unsigned int line)
+{
+	return createTcpServerWithOptions(address, port, backlogSize, true, file, line);
+}
+
+void
+attachReusePortCpuFilter(int fd, unsigned int groupSize) {
+	#if defined(__linux__) && defined(SO_ATTACH_REUSEPORT_CBPF) && defined(SKF_AD_CPU)
+		// A = current CPU number; A = A % groupSize; return A
+		struct sock_filter code[] = {
+			{ BPF_LD | BPF_W | BPF_ABS, 0, 0, (unsigned int) (SKF_AD_OFF + SKF_AD_CPU) },
+			{ BPF_ALU | BPF_MOD | BPF_K, 0, 0, groupSize },
+			{ BPF_RET | BPF_A, 0, 0, 0 }
+		};
+		struct sock_fprog prog;
+
+		prog.len = sizeof(code) / sizeof(code[0]);
+		prog.filter = code;
+		if (syscalls::setsockopt(fd, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF,
+			&prog, sizeof(prog)) == -1)
+		{
+			int e = errno;
+			throw SystemException("Cannot attach a CPU steering filter to a SO_REUSEPORT socket", e);
+		}
+	#else
+		throw SystemException("Cannot attach a CPU steering filter to a SO_REUSEPORT socket", ENOSYS);
+	#endif
+}
+
 int
 connectToServer(const StaticString &address, const char *file, unsigned int line) {
 	TRACE_POINT();
@@ -208,6 +208,38 @@ int createTcpServer(const char *address = "0.0.0.0",
 	const char *file = __FILE__,
 	unsigned int line = __LINE__);
 
+/**
+ * Like createTcpServer(), but also sets SO_REUSEPORT on the socket. This allows
+ * creating multiple server sockets that are bound to the same address and port,
+ * for example one per thread. The kernel then distributes incoming connections
+ * over all those sockets.
+ *
+ * @throws SystemException Something went wrong while creating the server socket,
+ *                         or the platform does not support SO_REUSEPORT.
+ * @throws ArgumentException The given address cannot be parsed.
+ * @throws boost::thread_interrupted A system call has been interrupted.
+ * @ingroup Support
+ */
+int createReusePortTcpServer(const char *address = "0.0.0.0",
+	unsigned short port = 0,
+	unsigned int backlogSize = 0,
+	const char *file = __FILE__,
+	unsigned int line = __LINE__);
+
+/**
+ * Attaches a BPF program to a SO_REUSEPORT server socket which steers each new
+ * connection to the socket whose index in the reuseport group equals the
+ * number of the CPU that received the connection, modulo `groupSize`.
+ * Only has to be called on one socket in the group. Only supported on Linux >= 4.5.
+ *
+ * @param fd A server socket created with createReusePortTcpServer().
+ * @param groupSize The number of sockets bound to the same address and port.
+ * @throws SystemException The filter cannot be attached, or the platform does not
+ *                         support it (errno = ENOSYS).
+ * @ingroup Support
+ */
+void attachReusePortCpuFilter(int fd, unsigned int groupSize);
+
 /**
  * Connect to a server at the given address in a blocking manner.
  *
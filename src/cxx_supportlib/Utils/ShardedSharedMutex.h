@@ -0,0 +1,142 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_SHARDED_SHARED_MUTEX_H_
+#define _PASSENGER_SHARDED_SHARED_MUTEX_H_
+
+#include <boost/thread.hpp>
+#include <boost/atomic.hpp>
+#include <boost/noncopyable.hpp>
+#include <pthread.h>
+#include <oxt/macros.hpp>
+
+namespace Passenger {
+
+
+/**
+ * A readers-writer lock that is optimized for frequent, short shared-mode
+ * locking from many threads, at the expense of making exclusive locking
+ * more expensive.
+ *
+ * A normal readers-writer lock (like boost::shared_mutex) maintains a single
+ * reader count, so readers on different CPUs still write to the same cache
+ * line. ShardedSharedMutex instead consists of SHARDS independent mutexes,
+ * each on its own cache line. Shared locking only locks the shard that belongs
+ * to the calling thread, so threads that are assigned different shards do not
+ * contend with each other at all. Exclusive locking locks all shards.
+ *
+ * Threads are assigned shards in a round-robin manner the first time they lock
+ * the mutex in shared mode, so as long as there are no more than SHARDS threads
+ * that do so, each one of them gets its own shard.
+ *
+ * Satisfies the Lockable and SharedLockable concepts, so it can be used with
+ * boost::unique_lock, boost::shared_lock and boost::condition_variable_any.
+ * It is not recursive.
+ */
+class ShardedSharedMutex: public boost::noncopyable {
+public:
+	static const unsigned int SHARDS = 16;
+
+private:
+	static const unsigned int CACHE_LINE_SIZE = 64;
+
+	struct Shard {
+		boost::mutex mutex;
+		char padding[CACHE_LINE_SIZE - sizeof(boost::mutex) % CACHE_LINE_SIZE];
+	};
+
+	Shard shards[SHARDS];
+	/** Serializes exclusive lockers, so that they don't deadlock each other
+	 * while locking the shards one by one.
+	 */
+	boost::mutex exclusiveSyncher;
+
+	static unsigned int getShardIndex() {
+		#ifdef OXT_THREAD_LOCAL_KEYWORD_SUPPORTED
+			static __thread unsigned int index = 0;
+			if (OXT_UNLIKELY(index == 0)) {
+				index = assignShardIndex();
+			}
+			return index - 1;
+		#else
+			return ((unsigned long) pthread_self() / sizeof(void *)) % SHARDS;
+		#endif
+	}
+
+	/** Returns a 1-based shard index. */
+	static unsigned int assignShardIndex() {
+		static boost::atomic<unsigned int> counter(0);
+		return counter.fetch_add(1, boost::memory_order_relaxed) % SHARDS + 1;
+	}
+
+public:
+	void lock() {
+		exclusiveSyncher.lock();
+		for (unsigned int i = 0; i < SHARDS; i++) {
+			shards[i].mutex.lock();
+		}
+	}
+
+	bool try_lock() {
+		if (!exclusiveSyncher.try_lock()) {
+			return false;
+		}
+		for (unsigned int i = 0; i < SHARDS; i++) {
+			if (!shards[i].mutex.try_lock()) {
+				while (i > 0) {
+					i--;
+					shards[i].mutex.unlock();
+				}
+				exclusiveSyncher.unlock();
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void unlock() {
+		for (unsigned int i = SHARDS; i > 0; i--) {
+			shards[i - 1].mutex.unlock();
+		}
+		exclusiveSyncher.unlock();
+	}
+
+	void lock_shared() {
+		shards[getShardIndex()].mutex.lock();
+	}
+
+	bool try_lock_shared() {
+		return shards[getShardIndex()].mutex.try_lock();
+	}
+
+	void unlock_shared() {
+		shards[getShardIndex()].mutex.unlock();
+	}
+};
+
+
+} // namespace Passenger
+
+#endif /* _PASSENGER_SHARDED_SHARED_MUTEX_H_ */
@@ -28,6 +28,9 @@
 #include <cstddef>
 #include <oxt/macros.hpp>
 #include <Utils/StrIntUtils.h>
+#ifdef __SSE2__
+	#include <emmintrin.h>
+#endif
 
 namespace Passenger {
 
@@ -112,6 +115,24 @@ convertLowerCase(const unsigned char * restrict data,
 	};
 
 	#if defined(__x86_64__)
+		#ifdef __SSE2__
+			// Convert 16 bytes at a time. Bytes >= 0x80 are negative when
+			// compared as signed chars, so they are never considered upper case.
+			const __m128i beforeA = _mm_set1_epi8('A' - 1);
+			const __m128i afterZ = _mm_set1_epi8('Z' + 1);
+			const __m128i caseBit = _mm_set1_epi8(0x20);
+			while (len >= 16) {
+				__m128i chars = _mm_loadu_si128((const __m128i *) data);
+				__m128i isUpper = _mm_and_si128(_mm_cmpgt_epi8(chars, beforeA),
+					_mm_cmplt_epi8(chars, afterZ));
+				_mm_storeu_si128((__m128i *) output,
+					_mm_or_si128(chars, _mm_and_si128(isUpper, caseBit)));
+				data += 16;
+				output += 16;
+				len -= 16;
+			}
+		#endif
+
 		size_t i;
 		boost::uint64_t eax, ebx;
 		const boost::uint8_t *ustr = (const boost::uint8_t *) data;
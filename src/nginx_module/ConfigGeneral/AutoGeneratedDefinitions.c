@@ -526,6 +526,14 @@
     offsetof(passenger_loc_conf_t, autogenerated.restart_dir),
     NULL
 },
+{
+    ngx_string("passenger_routing_policy"),
+    NGX_HTTP_MAIN_CONF | NGX_HTTP_SRV_CONF | NGX_HTTP_LOC_CONF | NGX_HTTP_LIF_CONF | NGX_CONF_TAKE1,
+    passenger_routing_policy,
+    NGX_HTTP_LOC_CONF_OFFSET,
+    offsetof(passenger_loc_conf_t, autogenerated.routing_policy),
+    NULL
+},
 {
     ngx_string("passenger_app_type"),
     NGX_HTTP_MAIN_CONF | NGX_HTTP_SRV_CONF | NGX_HTTP_LOC_CONF | NGX_HTTP_LIF_CONF | NGX_CONF_TAKE1,
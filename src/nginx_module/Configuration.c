@@ -1124,6 +1124,32 @@ passenger_enabled(ngx_conf_t *cf, ngx_command_t *cmd, void *conf)
     return NGX_CONF_OK;
 }
 
+static char *
+passenger_routing_policy(ngx_conf_t *cf, ngx_command_t *cmd, void *conf)
+{
+    passenger_loc_conf_t *passenger_conf = conf;
+    ngx_str_t            *value;
+
+    passenger_conf->autogenerated.routing_policy_explicitly_set = 1;
+    record_loc_conf_source_location(cf, passenger_conf,
+        &passenger_conf->autogenerated.routing_policy_source_file,
+        &passenger_conf->autogenerated.routing_policy_source_line);
+
+    value = cf->args->elts;
+    if (ngx_strcmp(value[1].data, (u_char *) "least-busy") != 0
+     && ngx_strcmp(value[1].data, (u_char *) "power-of-two-choices") != 0
+     && ngx_strcmp(value[1].data, (u_char *) "least-expected-latency") != 0)
+    {
+        ngx_conf_log_error(NGX_LOG_EMERG, cf, 0,
+            "\"passenger_routing_policy\" must be set to \"least-busy\", "
+            "\"power-of-two-choices\" or \"least-expected-latency\"");
+
+        return NGX_CONF_ERROR;
+    }
+
+    return ngx_conf_set_str_slot(cf, cmd, conf);
+}
+
 static char *
 rails_framework_spawner_idle_time(ngx_conf_t *cf, ngx_command_t *cmd, void *conf)
 {
@@ -82,6 +82,8 @@ passenger_create_autogenerated_loc_conf(passenger_autogenerated_loc_conf_t  *con
     conf->request_queue_overflow_status_code = NGX_CONF_UNSET;
     conf->restart_dir.data = NULL;
     conf->restart_dir.len  = 0;
+    conf->routing_policy.data = NULL;
+    conf->routing_policy.len  = 0;
     conf->app_type.data = NULL;
     conf->app_type.len  = 0;
     conf->startup_file.data = NULL;
@@ -250,6 +252,10 @@ passenger_create_autogenerated_loc_conf(passenger_autogenerated_loc_conf_t  *con
     conf->restart_dir_source_file.len = 0;
     conf->restart_dir_source_line = 0;
     conf->restart_dir_explicitly_set = 0;
+    conf->routing_policy_source_file.data = NULL;
+    conf->routing_policy_source_file.len = 0;
+    conf->routing_policy_source_line = 0;
+    conf->routing_policy_explicitly_set = 0;
     conf->app_type_source_file.data = NULL;
     conf->app_type_source_file.len = 0;
     conf->app_type_source_line = 0;
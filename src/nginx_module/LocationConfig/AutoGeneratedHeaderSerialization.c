@@ -222,6 +222,12 @@ passenger_serialize_autogenerated_loc_conf_to_headers(ngx_conf_t *cf, passenger_
         len += sizeof("\r\n") - 1;
     }
 
+    if (conf->autogenerated.routing_policy.data != NULL) {
+        len += sizeof("!~PASSENGER_ROUTING_POLICY: ") - 1;
+        len += conf->autogenerated.routing_policy.len;
+        len += sizeof("\r\n") - 1;
+    }
+
     if (conf->autogenerated.startup_file.data != NULL) {
         len += sizeof("!~PASSENGER_STARTUP_FILE: ") - 1;
         len += conf->autogenerated.startup_file.len;
@@ -500,6 +506,15 @@ passenger_serialize_autogenerated_loc_conf_to_headers(ngx_conf_t *cf, passenger_
             conf->autogenerated.restart_dir.len);
         pos = ngx_copy(pos, (const u_char *) "\r\n", sizeof("\r\n") - 1);
     }
+    if (conf->autogenerated.routing_policy.data != NULL) {
+        pos = ngx_copy(pos,
+            "!~PASSENGER_ROUTING_POLICY: ",
+            sizeof("!~PASSENGER_ROUTING_POLICY: ") - 1);
+        pos = ngx_copy(pos,
+            conf->autogenerated.routing_policy.data,
+            conf->autogenerated.routing_policy.len);
+        pos = ngx_copy(pos, (const u_char *) "\r\n", sizeof("\r\n") - 1);
+    }
     if (conf->autogenerated.startup_file.data != NULL) {
         pos = ngx_copy(pos,
             "!~PASSENGER_STARTUP_FILE: ",
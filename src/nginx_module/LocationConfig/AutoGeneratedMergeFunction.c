@@ -134,6 +134,9 @@ passenger_merge_autogenerated_loc_conf(passenger_autogenerated_loc_conf_t *conf,
     ngx_conf_merge_str_value(conf->restart_dir,
         prev->restart_dir,
         NULL);
+    ngx_conf_merge_str_value(conf->routing_policy,
+        prev->routing_policy,
+        NULL);
     ngx_conf_merge_str_value(conf->app_type,
         prev->app_type,
         NULL);
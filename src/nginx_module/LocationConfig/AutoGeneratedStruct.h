@@ -70,6 +70,7 @@ typedef struct {
     ngx_str_t nodejs;
     ngx_str_t python;
     ngx_str_t restart_dir;
+    ngx_str_t routing_policy;
     ngx_str_t ruby;
     ngx_str_t spawn_method;
     ngx_str_t startup_file;
@@ -106,6 +107,7 @@ typedef struct {
     ngx_str_t python_source_file;
     ngx_str_t request_queue_overflow_status_code_source_file;
     ngx_str_t restart_dir_source_file;
+    ngx_str_t routing_policy_source_file;
     ngx_str_t ruby_source_file;
     ngx_str_t spawn_method_source_file;
     ngx_str_t start_timeout_source_file;
@@ -153,6 +155,7 @@ typedef struct {
     ngx_uint_t python_source_line;
     ngx_uint_t request_queue_overflow_status_code_source_line;
     ngx_uint_t restart_dir_source_line;
+    ngx_uint_t routing_policy_source_line;
     ngx_uint_t ruby_source_line;
     ngx_uint_t spawn_method_source_line;
     ngx_uint_t start_timeout_source_line;
@@ -200,6 +203,7 @@ typedef struct {
     ngx_int_t python_explicitly_set;
     ngx_int_t request_queue_overflow_status_code_explicitly_set;
     ngx_int_t restart_dir_explicitly_set;
+    ngx_int_t routing_policy_explicitly_set;
     ngx_int_t ruby_explicitly_set;
     ngx_int_t spawn_method_explicitly_set;
     ngx_int_t start_timeout_explicitly_set;
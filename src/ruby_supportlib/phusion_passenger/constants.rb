@@ -66,6 +66,11 @@ module SharedConstants
     DEFAULT_RESPONSE_BUFFER_HIGH_WATERMARK = 1024 * 1024 * 128
     DEFAULT_MAX_REQUEST_QUEUE_SIZE = 100
     DEFAULT_STAT_THROTTLE_RATE = 10
+    DEFAULT_TURBOCACHE_MAX_MEMORY = 1024 * 1024 * 4
+    DEFAULT_TURBOCACHE_MAX_BODY_SIZE = 1024 * 32
+    DEFAULT_TURBOCACHE_SHARED_MAX_MEMORY = 1024 * 1024 * 32
+    DEFAULT_TURBOCACHE_FETCH_THRESHOLD = 20
+    DEFAULT_TURBOCACHE_MIN_HIT_RATIO = 0.5
     DEFAULT_ANALYTICS_LOG_USER = DEFAULT_WEB_APP_USER
     DEFAULT_ANALYTICS_LOG_GROUP = ""
     DEFAULT_ANALYTICS_LOG_PERMISSIONS = "u=rwx,g=rx,o=rx"
@@ -80,6 +85,9 @@ module SharedConstants
     # also introduce context switching and smaller transfer writes. The size is picked
     # to balance this out.
     DEFAULT_MBUF_CHUNK_SIZE = 1024 * 4
+    # Used instead of the normal chunk size for reading from connections that have
+    # just filled a whole buffer, i.e. during bulk transfers.
+    DEFAULT_MBUF_LARGE_CHUNK_SIZE = 1024 * 64
     # Affects input and output buffering (between app and client). Threshold is picked
     # such that it fits most output (i.e. html page size, not assets), and allows for
     # high concurrency with low mem overhead. On the upload side there is a penalty
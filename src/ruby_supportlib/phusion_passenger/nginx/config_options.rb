@@ -411,6 +411,11 @@
     :name  => 'passenger_restart_dir',
     :type  => :string
   },
+  {
+    :name     => 'passenger_routing_policy',
+    :type     => :string,
+    :function => 'passenger_routing_policy'
+  },
   {
     :name   => 'passenger_app_type',
     :type   => :string,
@@ -432,6 +432,14 @@ module Standalone
         :desc      => "Vary the turbocache by the cookie of the\n" \
                       'given name'
       },
+      {
+        :name      => :sendfile_root,
+        :type      => :path,
+        :desc      => "Serve files named by X-Sendfile and\n" \
+                      "X-Accel-Redirect response headers if\n" \
+                      "they are inside this directory (Builtin\n" \
+                      'engine only)'
+      },
       {
         :name      => :turbocaching,
         :type      => :boolean,
@@ -172,6 +172,7 @@ def build_daemon_controller_options
           add_flag_param(command, :sticky_sessions, "--sticky-sessions")
           add_param(command, :vary_turbocache_by_cookie, "--vary-turbocache-by-cookie")
           add_param(command, :sticky_sessions_cookie_name, "--sticky-sessions-cookie-name")
+          add_param(command, :sendfile_root, "--sendfile-root")
           add_param(command, :ruby, "--ruby")
           add_param(command, :python, "--python")
           add_param(command, :nodejs, "--nodejs")
@@ -1,4 +1,6 @@
 #include <TestSupport.h>
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
 #include <jsoncpp/json.h>
 #include <Core/ApplicationPool/Pool.h>
 #include <LoggingKit/Context.h>
@@ -7,6 +9,7 @@
 #include <Utils/StrIntUtils.h>
 #include <MessageReadersWriters.h>
 #include <map>
+#include <set>
 #include <vector>
 #include <cerrno>
 #include <signal.h>
@@ -131,6 +134,35 @@ namespace tut {
 			// destroy old session object outside the lock.
 		}
 
+		void checkoutRepeatedly(Options options, unsigned int count) {
+			Ticket ticket;
+			for (unsigned int i = 0; i < count; i++) {
+				pool->get(options, &ticket).reset();
+			}
+		}
+
+		/**
+		 * Checks out and closes `count` sessions from each of the given
+		 * groups concurrently, using one thread per group. Returns the
+		 * number of checkouts per second.
+		 */
+		double checkoutConcurrently(const vector<string> &groupNames, unsigned int count) {
+			boost::thread_group threads;
+			unsigned long long startTime = SystemTime::getMonotonicUsec();
+
+			for (unsigned int i = 0; i < groupNames.size(); i++) {
+				Options options = createOptions();
+				options.appGroupName = groupNames[i];
+				threads.create_thread(boost::bind(
+					&Core_ApplicationPool_PoolTest::checkoutRepeatedly,
+					this, options, count));
+			}
+			threads.join_all();
+
+			unsigned long long endTime = SystemTime::getMonotonicUsec();
+			return groupNames.size() * count / ((endTime - startTime) / 1000000.0);
+		}
+
 		void sendHeaders(int connection, ...) {
 			va_list ap;
 			const char *arg;
@@ -228,7 +260,7 @@ namespace tut {
 		// as the new process is done spawning.
 		Options options = createOptions();
 
-		ScopedLock l(pool->syncher);
+		PoolScopedLock l(pool->syncher);
 		pool->asyncGet(options, callback, false);
 		ensure_equals("(1)", number, 0);
 		ensure("(2)", pool->getWaitlist.empty());
@@ -263,7 +295,7 @@ namespace tut {
 		ensure(!process->isTotallyBusy());
 
 		// Verify test assertion.
-		ScopedLock l(pool->syncher);
+		PoolScopedLock l(pool->syncher);
 		pool->asyncGet(options, callback, false);
 		ensure_equals("callback is immediately called", number, 2);
 	}
@@ -384,7 +416,7 @@ namespace tut {
 
 		// Now open another session. It should complete immediately
 		// and should not use the first process.
-		ScopedLock l(pool->syncher);
+		PoolScopedLock l(pool->syncher);
 		pool->asyncGet(options, callback, false);
 		ensure_equals("asyncGet() completed immediately", number, 2);
 		SessionPtr session2 = currentSession;
@@ -417,7 +449,7 @@ namespace tut {
 		GroupPtr group = pool->findOrCreateGroup(options);
 		spawningKitConfig->concurrency = 2;
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			group->spawn();
 		}
 		EVENTUALLY(5,
@@ -536,7 +568,7 @@ namespace tut {
 		);
 
 		// The next asyncGet() should spawn a new process and the action should be queued.
-		ScopedLock l(pool->syncher);
+		PoolScopedLock l(pool->syncher);
 		spawningKitConfig->spawnTime = 5000000;
 		pool->asyncGet(options, callback, false);
 		ensure(group->spawning());
@@ -837,7 +869,7 @@ namespace tut {
 		SystemTime::force(2);
 		GroupPtr barGroup = pool->get(options2, &ticket)->getGroup()->shared_from_this();
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals("(1)", barGroup->spawn(), SR_OK);
 		}
 		debug->debugger->recv("Begin spawn loop iteration 1");
@@ -860,7 +892,7 @@ namespace tut {
 		debug->messages->send("Proceed with spawn loop iteration 2");
 		debug->debugger->recv("Spawn loop done");
 		EVENTUALLY(5,
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			vector<ProcessPtr> processes = pool->getProcesses(false);
 			if (processes.size() == 1) {
 				GroupPtr group = processes[0]->getGroup()->shared_from_this();
@@ -922,7 +954,7 @@ namespace tut {
 		debug->messages->send("Proceed with spawn loop iteration 2");
 		debug->debugger->recv("Spawn loop done");
 		EVENTUALLY(5,
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			vector<ProcessPtr> processes = pool->getProcesses(false);
 			if (processes.size() == 1) {
 				GroupPtr group = processes[0]->getGroup()->shared_from_this();
@@ -957,7 +989,7 @@ namespace tut {
 		ProcessPtr process = currentSession->getProcess()->shared_from_this();
 		pool->detachProcess(process);
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure(process->enabled == Process::DETACHED);
 		}
 		EVENTUALLY(5,
@@ -988,13 +1020,13 @@ namespace tut {
 		pool->asyncGet(options, callback);
 
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals(pool->groups.lookupCopy("test")->getWaitlist.size(), 1u);
 		}
 
 		pool->detachProcess(session1->getProcess()->shared_from_this());
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure(pool->groups.lookupCopy("test")->spawning());
 			ensure_equals(pool->groups.lookupCopy("test")->enabledCount, 0);
 			ensure_equals(pool->groups.lookupCopy("test")->getWaitlist.size(), 1u);
@@ -1026,7 +1058,7 @@ namespace tut {
 		spawningKitConfig->spawnTime = 90000;
 		pool->asyncGet(options2, callback);
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals(pool->getWaitlist.size(), 1u);
 		}
 
@@ -1039,7 +1071,7 @@ namespace tut {
 		currentSession.reset();
 		pool->detachProcess(session1->getProcess()->shared_from_this());
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure(pool->groups.lookupCopy("test2") != NULL);
 			ensure_equals(pool->getWaitlist.size(), 0u);
 		}
@@ -1060,7 +1092,7 @@ namespace tut {
 		currentSession.reset();
 		GroupPtr group = process->getGroup()->shared_from_this();
 		pool->detachProcess(process);
-		LockGuard l(pool->syncher);
+		PoolLockGuard l(pool->syncher);
 		ensure_equals(pool->groups.size(), 1u);
 		ensure(group->isAlive());
 		ensure(!group->garbageCollectable());
@@ -1077,18 +1109,18 @@ namespace tut {
 
 		ensure(pool->detachProcess(process));
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals(process->enabled, Process::DETACHED);
 		}
 		SHOULD_NEVER_HAPPEN(100,
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			result = !process->isAlive()
 				|| !process->osProcessExists();
 		);
 
 		session.reset();
 		EVENTUALLY(1,
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			result = process->enabled == Process::DETACHED
 				&& !process->osProcessExists()
 				&& process->isDead();
@@ -1108,7 +1140,7 @@ namespace tut {
 
 		ensure(pool->detachProcess(process));
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals(process->enabled, Process::DETACHED);
 		}
 		EVENTUALLY(1,
@@ -1116,7 +1148,7 @@ namespace tut {
 		);
 
 		SHOULD_NEVER_HAPPEN(100,
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			result = process->isDead()
 				|| !process->osProcessExists();
 		);
@@ -1125,7 +1157,7 @@ namespace tut {
 		g.clear();
 
 		EVENTUALLY(1,
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			result = process->enabled == Process::DETACHED
 				&& !process->osProcessExists()
 				&& process->isDead();
@@ -1155,7 +1187,7 @@ namespace tut {
 		pool->detachProcess(process);
 		debug->debugger->recv("About to start detached processes checker");
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure(process->enabled == Process::DETACHED);
 		}
 
@@ -1187,7 +1219,7 @@ namespace tut {
 		ensure_equals("Disabling succeeds",
 			pool->disableProcess(processes[0]->getGupid()), DR_SUCCESS);
 
-		LockGuard l(pool->syncher);
+		PoolLockGuard l(pool->syncher);
 		ensure(processes[0]->isAlive());
 		ensure_equals("Process is disabled",
 			processes[0]->enabled,
@@ -1261,7 +1293,7 @@ namespace tut {
 		TempThread thr2(boost::bind(&Core_ApplicationPool_PoolTest::disableProcess,
 			this, process2, &code2));
 		EVENTUALLY(5,
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			result = group->enabledCount == 0
 				&& group->disablingCount == 2
 				&& group->disabledCount == 0;
@@ -1280,7 +1312,7 @@ namespace tut {
 			result = code2 == DR_SUCCESS;
 		);
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals(group->enabledCount, 1);
 			ensure_equals(group->disablingCount, 0);
 			ensure_equals(group->disabledCount, 2);
@@ -1308,7 +1340,7 @@ namespace tut {
 			this, session2->getProcess()->shared_from_this(), &code2));
 		EVENTUALLY(2,
 			GroupPtr group = session1->getGroup()->shared_from_this();
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			result = group->enabledCount == 0
 				&& group->disablingCount == 2
 				&& group->disabledCount == 0;
@@ -1327,7 +1359,7 @@ namespace tut {
 		);
 		{
 			GroupPtr group = session1->getGroup()->shared_from_this();
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals(group->enabledCount, 2);
 			ensure_equals(group->disablingCount, 0);
 			ensure_equals(group->disabledCount, 0);
@@ -1386,7 +1418,7 @@ namespace tut {
 		ensure_equals(result, DR_SUCCESS);
 
 		{
-			ScopedLock l(pool->syncher);
+			PoolScopedLock l(pool->syncher);
 			GroupPtr group = processes[0]->getGroup()->shared_from_this();
 			ensure_equals(group->enabledCount, 1);
 			ensure_equals(group->disablingCount, 0);
@@ -1934,7 +1966,7 @@ namespace tut {
 		}
 		ensure_equals(number, 0);
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals(group->getWaitlist.size(),
 				3u);
 		}
@@ -2051,5 +2083,201 @@ namespace tut {
 	}
 
 
+
+	/*********** Concurrency ***********/
+
+	TEST_METHOD(86) {
+		set_test_name("Sessions can be checked out and closed concurrently, on the same"
+			" group as well as on different groups");
+
+		vector<string> groupNames;
+		groupNames.push_back("test1");
+		groupNames.push_back("test1");
+		groupNames.push_back("test2");
+		groupNames.push_back("test2");
+		checkoutConcurrently(groupNames, 2000);
+
+		ensure_equals(pool->getGroupCount(), 2u);
+		unsigned int processed = 0;
+		vector<ProcessPtr> processes = pool->getProcesses();
+		vector<ProcessPtr>::const_iterator it;
+		for (it = processes.begin(); it != processes.end(); it++) {
+			const ProcessPtr &process = *it;
+			ensure_equals(process->sessions, 0);
+			ensure_equals(process->busyness(), 0);
+			processed += process->processed;
+		}
+		ensure_equals(processed, 8000u);
+		ensure(!pool->isSpawning());
+	}
+
+	TEST_METHOD(87) {
+		set_test_name("Benchmark: checkout throughput with one thread per group");
+		ONLY_RUN_IN_BENCHMARK_MODE();
+
+		pool->setMax(8);
+		vector<string> groupNames;
+		for (unsigned int nthreads = 1; nthreads <= 8; nthreads *= 2) {
+			while (groupNames.size() < nthreads) {
+				groupNames.push_back("bench" + toString(groupNames.size()));
+			}
+			// Spawn the processes before measuring.
+			checkoutConcurrently(groupNames, 1);
+			double rate = checkoutConcurrently(groupNames, 200000);
+			fprintf(stderr, "Pool checkouts, %u threads: %.0f checkouts/sec\n",
+				nthreads, rate);
+		}
+	}
+
+	TEST_METHOD(88) {
+		set_test_name("asyncGet() uses the given group handle, and refreshes it"
+			" if the Group it refers to has been detached");
+
+		Options options = createOptions();
+		options.appGroupName = "test";
+		GroupPtr groupHandle;
+
+		// The Group doesn't exist yet, so the handle is not set
+		// during this call.
+		pool->get(options, &ticket).reset();
+		EVENTUALLY(5,
+			result = pool->getProcesses()[0]->sessions == 0;
+		);
+
+		pool->asyncGet(options, callback, true, NULL, &groupHandle);
+		ensure_equals("(1)", number, 1);
+		ensure("(2)", groupHandle != NULL);
+		ensure_equals("(3)", groupHandle.get(), currentSession->getGroup());
+		GroupPtr oldGroup = groupHandle;
+		currentSession.reset();
+
+		pool->asyncGet(options, callback, true, NULL, &groupHandle);
+		ensure_equals("(4)", number, 2);
+		ensure_equals("(5)", groupHandle, oldGroup);
+		currentSession.reset();
+
+		unsigned int generation = pool->getGroupDetachGeneration();
+		ensure("(6)", pool->detachGroupByName("test"));
+		ensure("(7)", pool->getGroupDetachGeneration() != generation);
+		pool->get(options, &ticket).reset();
+		EVENTUALLY(5,
+			result = pool->getProcesses()[0]->sessions == 0;
+		);
+		pool->asyncGet(options, callback, true, NULL, &groupHandle);
+		ensure_equals("(8)", number, 3);
+		ensure("(9)", groupHandle != oldGroup);
+		ensure_equals("(10)", groupHandle.get(), currentSession->getGroup());
+	}
+
+	TEST_METHOD(89) {
+		set_test_name("Benchmark: checkout latency on a warm group with a cached group handle");
+		ONLY_RUN_IN_BENCHMARK_MODE();
+
+		Options options = createOptions();
+		options.appGroupName = "test";
+		GroupPtr groupHandle;
+		pool->get(options, &ticket).reset();
+		EVENTUALLY(5,
+			result = pool->getProcesses()[0]->sessions == 0;
+		);
+
+		const unsigned int count = 1000000;
+		unsigned long long startTime = SystemTime::getMonotonicUsec();
+		for (unsigned int i = 0; i < count; i++) {
+			pool->asyncGet(options, callback, true, NULL, &groupHandle);
+			currentSession.reset();
+		}
+		unsigned long long endTime = SystemTime::getMonotonicUsec();
+		fprintf(stderr, "Pool checkout and close: %.0f ns\n",
+			(endTime - startTime) * 1000.0 / count);
+	}
+
+	TEST_METHOD(90) {
+		set_test_name("The power-of-two-choices routing policy spreads requests"
+			" over equally busy processes");
+
+		Options options = createOptions();
+		options.appGroupName = "test";
+		options.minProcesses = 4;
+		options.routingPolicy = RP_POWER_OF_TWO_CHOICES;
+		pool->setMax(4);
+		GroupPtr group = pool->findOrCreateGroup(options);
+		{
+			PoolLockGuard l(pool->syncher);
+			group->spawn();
+		}
+		EVENTUALLY(5,
+			result = pool->getProcessCount() == 4;
+		);
+
+		set<pid_t> pids;
+		for (int i = 0; i < 50; i++) {
+			pool->asyncGet(options, callback);
+			ensure_equals(number, i + 1);
+			pids.insert(currentSession->getPid());
+			currentSession.reset();
+		}
+		ensure("More than one process was used", pids.size() > 1);
+	}
+
+	TEST_METHOD(91) {
+		set_test_name("The least-expected-latency routing policy prefers processes"
+			" with lower recent response times");
+
+		Options options = createOptions();
+		options.appGroupName = "test";
+		options.minProcesses = 2;
+		options.routingPolicy = RP_LEAST_EXPECTED_LATENCY;
+		pool->setMax(2);
+		GroupPtr group = pool->findOrCreateGroup(options);
+		{
+			PoolLockGuard l(pool->syncher);
+			group->spawn();
+		}
+		EVENTUALLY(5,
+			result = pool->getProcessCount() == 2;
+		);
+
+		pool->asyncGet(options, callback);
+		SessionPtr slowSession = currentSession;
+		pool->asyncGet(options, callback);
+		SessionPtr fastSession = currentSession;
+		currentSession.reset();
+		ensure_equals(number, 2);
+		ensure(slowSession->getPid() != fastSession->getPid());
+		pid_t fastPid = fastSession->getPid();
+
+		fastSession.reset();
+		usleep(50000);
+		slowSession.reset();
+
+		for (int i = 0; i < 10; i++) {
+			pool->asyncGet(options, callback);
+			ensure_equals(currentSession->getPid(), fastPid);
+			currentSession.reset();
+		}
+	}
+
+	TEST_METHOD(92) {
+		set_test_name("An unknown routing policy results in the least-busy routing policy");
+
+		Options options = createOptions();
+		options.appGroupName = "test";
+		options.routingPolicy = RP_POWER_OF_TWO_CHOICES;
+		pool->asyncGet(options, callback);
+		EVENTUALLY(5,
+			result = number == 1;
+		);
+		Group *group = currentSession->getGroup();
+		currentSession.reset();
+		ensure_equals("(1)", group->options.routingPolicy, RP_POWER_OF_TWO_CHOICES);
+
+		options.routingPolicy = RP_UNKNOWN;
+		pool->asyncGet(options, callback);
+		ensure_equals("(2)", number, 2);
+		currentSession.reset();
+		ensure_equals("(3)", group->options.routingPolicy, RP_LEAST_BUSY);
+	}
+
 	/*****************************/
 }
@@ -0,0 +1,281 @@
+#include <TestSupport.h>
+#include <Core/ApplicationPool/ProcessRoutingTable.h>
+#include <boost/make_shared.hpp>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#ifdef __linux__
+	#include <linux/perf_event.h>
+	#include <sys/ioctl.h>
+	#include <sys/syscall.h>
+#endif
+
+using namespace Passenger;
+using namespace Passenger::ApplicationPool2;
+using namespace std;
+
+namespace tut {
+	/**
+	 * Counts hardware cache misses of the calling thread in user space,
+	 * if the kernel and CPU allow it.
+	 */
+	class CacheMissCounter {
+	private:
+		int fd;
+
+	public:
+		CacheMissCounter()
+			: fd(-1)
+		{
+			#ifdef __linux__
+				struct perf_event_attr attr;
+				memset(&attr, 0, sizeof(attr));
+				attr.size = sizeof(attr);
+				attr.type = PERF_TYPE_HARDWARE;
+				attr.config = PERF_COUNT_HW_CACHE_MISSES;
+				attr.disabled = 1;
+				attr.exclude_kernel = 1;
+				attr.exclude_hv = 1;
+				fd = (int) syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+			#endif
+		}
+
+		~CacheMissCounter() {
+			if (fd != -1) {
+				close(fd);
+			}
+		}
+
+		bool available() const {
+			return fd != -1;
+		}
+
+		void start() {
+			#ifdef __linux__
+				if (fd != -1) {
+					ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+				}
+			#endif
+		}
+
+		void stop() {
+			#ifdef __linux__
+				if (fd != -1) {
+					ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+				}
+			#endif
+		}
+
+		unsigned long long read() const {
+			unsigned long long result = 0;
+			if (fd != -1 && ::read(fd, &result, sizeof(result)) != sizeof(result)) {
+				result = 0;
+			}
+			return result;
+		}
+	};
+
+	struct Core_ApplicationPool_ProcessRoutingTableTest {
+		Context context;
+		BasicGroupInfo groupInfo;
+		Json::Value sockets;
+		ProcessList processes;
+		ProcessRoutingTable table;
+		unsigned int lastStickySessionId;
+
+		Core_ApplicationPool_ProcessRoutingTableTest()
+			: lastStickySessionId(0)
+		{
+			SpawningKit::ConfigPtr spawningKitConfig = boost::make_shared<SpawningKit::Config>();
+			spawningKitConfig->resourceLocator = resourceLocator;
+			spawningKitConfig->finalize();
+
+			context.setSpawningKitFactory(boost::make_shared<SpawningKit::Factory>(spawningKitConfig));
+			context.finalize();
+
+			groupInfo.context = &context;
+			groupInfo.group = NULL;
+			groupInfo.name = "test";
+
+			Json::Value socket;
+			socket["name"] = "main";
+			socket["address"] = "tcp://127.0.0.1:1234";
+			socket["protocol"] = "session";
+			socket["concurrency"] = 2;
+			sockets.append(socket);
+		}
+
+		ProcessPtr createProcess() {
+			SpawningKit::Result result;
+
+			result["type"] = "dummy";
+			result["pid"] = 123;
+			result["gupid"] = "123";
+			result["sockets"] = sockets;
+			result["spawner_creation_time"] = 0;
+			result["spawn_start_time"] = 0;
+
+			ProcessPtr process(context.getProcessObjectPool().construct(
+				&groupInfo, result), false);
+			process->shutdownNotRequired();
+			process->initializeStickySessionId(++lastStickySessionId);
+			return process;
+		}
+
+		void addProcesses(unsigned int count) {
+			for (unsigned int i = 0; i < count; i++) {
+				processes.push_back(createProcess());
+				table.push_back(processes.back().get());
+			}
+		}
+
+		static Process *findStickySessionIdInList(const ProcessList &processes,
+			unsigned int id)
+		{
+			ProcessList::const_iterator it, end = processes.end();
+			for (it = processes.begin(); it != end; it++) {
+				Process *process = it->get();
+				if (process->getStickySessionId() == id && process->canBeRoutedTo()) {
+					return process;
+				}
+			}
+			return NULL;
+		}
+
+		static Process *findStickySessionIdInTable(const ProcessList &processes,
+			const ProcessRoutingTable &table, unsigned int id)
+		{
+			int index = table.findStickySessionId(id);
+			if (index != -1 && table.canBeRoutedTo(index)) {
+				return processes[index].get();
+			} else {
+				return NULL;
+			}
+		}
+
+		static unsigned long long getNsec() {
+			struct timespec ts;
+			clock_gettime(CLOCK_MONOTONIC, &ts);
+			return (unsigned long long) ts.tv_sec * 1000000000 + ts.tv_nsec;
+		}
+
+		/** Evicts everything from the CPU caches, as happens between routing
+		 * decisions while the core is busy handling requests.
+		 */
+		static void thrashCaches(vector<char> &buffer) {
+			for (size_t i = 0; i < buffer.size(); i += 64) {
+				buffer[i]++;
+			}
+		}
+
+		/**
+		 * Looks up the last process's sticky session ID `iterations` times with
+		 * cold caches. Returns the time and the number of cache misses per lookup,
+		 * the latter being -1 if it can't be measured.
+		 */
+		pair<double, double> measureColdLookup(bool useTable, unsigned int iterations) {
+			vector<char> buffer(32 * 1024 * 1024);
+			CacheMissCounter counter;
+			unsigned long long totalTime = 0;
+			Process *result = NULL;
+
+			for (unsigned int i = 0; i < iterations; i++) {
+				thrashCaches(buffer);
+				counter.start();
+				unsigned long long startTime = getNsec();
+				if (useTable) {
+					result = findStickySessionIdInTable(processes, table, lastStickySessionId);
+				} else {
+					result = findStickySessionIdInList(processes, lastStickySessionId);
+				}
+				totalTime += getNsec() - startTime;
+				counter.stop();
+				ensure(result == processes.back().get());
+			}
+
+			double misses = -1;
+			if (counter.available()) {
+				misses = counter.read() / (double) iterations;
+			}
+			return make_pair(totalTime / (double) iterations, misses);
+		}
+	};
+
+	DEFINE_TEST_GROUP(Core_ApplicationPool_ProcessRoutingTableTest);
+
+	TEST_METHOD(1) {
+		set_test_name("It mirrors the processes' routing state");
+
+		addProcesses(3);
+		ensure_equals(table.size(), 3u);
+		ensure_equals(table.getStickySessionId(1), processes[1]->getStickySessionId());
+		ensure_equals(table.getConcurrency(1), 2);
+		ensure_equals(table.busyness(1), processes[1]->busyness());
+		ensure(table.canBeRoutedTo(1));
+
+		table.setSessions(1, 2);
+		ensure_equals(table.busyness(1), Process::calculateBusyness(2, 2));
+		ensure(!table.canBeRoutedTo(1));
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("findStickySessionId() returns the index of the process with"
+			" the given sticky session ID, or -1");
+
+		addProcesses(3);
+		ensure_equals(table.findStickySessionId(processes[0]->getStickySessionId()), 0);
+		ensure_equals(table.findStickySessionId(processes[2]->getStickySessionId()), 2);
+		ensure_equals(table.findStickySessionId(12345), -1);
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("findLowestBusyness() returns the first least busy process");
+
+		addProcesses(3);
+		table.setSessions(0, 1);
+		table.setSessions(1, 0);
+		table.setSessions(2, 0);
+		ensure_equals(table.findLowestBusyness(), 1u);
+		table.setSessions(1, 2);
+		ensure_equals(table.findLowestBusyness(), 2u);
+	}
+
+	TEST_METHOD(4) {
+		set_test_name("erase() shifts subsequent entries, like erasing from the ProcessList");
+
+		addProcesses(3);
+		unsigned int id = processes[2]->getStickySessionId();
+		table.setSessions(2, 1);
+		table.erase(1);
+		processes.erase(processes.begin() + 1);
+		ensure_equals(table.size(), 2u);
+		ensure_equals(table.findStickySessionId(id), 1);
+		ensure_equals(table.getSessions(1), 1);
+	}
+
+	TEST_METHOD(5) {
+		set_test_name("Benchmark: sticky session lookup with cold caches, ProcessList"
+			" versus ProcessRoutingTable");
+		ONLY_RUN_IN_BENCHMARK_MODE();
+
+		unsigned int counts[] = { 8, 64, 512 };
+		for (unsigned int i = 0; i < sizeof(counts) / sizeof(unsigned int); i++) {
+			processes.clear();
+			table.clear();
+			addProcesses(counts[i]);
+
+			pair<double, double> listResult = measureColdLookup(false, 200);
+			pair<double, double> tableResult = measureColdLookup(true, 200);
+			if (listResult.second >= 0) {
+				fprintf(stderr, "%u processes: ProcessList %.0f ns, %.1f cache misses;"
+					" ProcessRoutingTable %.0f ns, %.1f cache misses per lookup\n",
+					counts[i], listResult.first, listResult.second, tableResult.first, tableResult.second);
+			} else {
+				fprintf(stderr, "%u processes: ProcessList %.0f ns; ProcessRoutingTable"
+					" %.0f ns per lookup (cache miss counter not available)\n",
+					counts[i], listResult.first, tableResult.first);
+			}
+		}
+	}
+}
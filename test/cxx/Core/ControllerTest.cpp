@@ -18,6 +18,7 @@ namespace tut {
 			virtual void asyncGetFromApplicationPool(Request *req,
 				ApplicationPool2::GetCallback callback)
 			{
+				checkouts++;
 				callback(sessionToReturn, exceptionToReturn);
 				sessionToReturn.reset();
 			}
@@ -25,6 +26,7 @@ namespace tut {
 		public:
 			ApplicationPool2::AbstractSessionPtr sessionToReturn;
 			ApplicationPool2::ExceptionPtr exceptionToReturn;
+			unsigned int checkouts;
 
 			MyController(ServerKit::Context *context,
 				const Core::ControllerSchema &schema,
@@ -32,7 +34,8 @@ namespace tut {
 				const Core::ControllerSingleAppModeSchema &singleAppModeSchema,
 				const Json::Value &singleAppModeConfig)
 				: Core::Controller(context, schema, initialConfig, ConfigKit::DummyTranslator(),
-					&singleAppModeSchema, &singleAppModeConfig, ConfigKit::DummyTranslator())
+					&singleAppModeSchema, &singleAppModeConfig, ConfigKit::DummyTranslator()),
+				  checkouts(0)
 				{ }
 		};
 
@@ -140,12 +143,38 @@ namespace tut {
 			ensure_equals(getTotalBytesConsumed(), totalBytesConsumed + data.size());
 		}
 
-		void useTestSessionObject() {
-			bg.safe->runSync(boost::bind(&Core_ControllerTest::_setTestSessionObject, this));
+		void useTestSessionObject(TestSession *session = NULL) {
+			if (session == NULL) {
+				session = &testSession;
+			}
+			bg.safe->runSync(boost::bind(&Core_ControllerTest::_setTestSessionObject,
+				this, session));
+		}
+
+		void _setTestSessionObject(TestSession *session) {
+			controller->sessionToReturn.reset(session, false);
+		}
+
+		unsigned int getCheckouts() {
+			unsigned int result;
+			bg.safe->runSync(boost::bind(&Core_ControllerTest::_getCheckouts,
+				this, &result));
+			return result;
+		}
+
+		void _getCheckouts(unsigned int *result) {
+			*result = controller->checkouts;
+		}
+
+		Json::Value inspectState() {
+			Json::Value result;
+			bg.safe->runSync(boost::bind(&Core_ControllerTest::_inspectState,
+				this, &result));
+			return result;
 		}
 
-		void _setTestSessionObject() {
-			controller->sessionToReturn.reset(&testSession, false);
+		void _inspectState(Json::Value *result) {
+			*result = controller->inspectStateAsJson();
 		}
 
 		MyController::State getServerState() {
@@ -170,6 +199,17 @@ namespace tut {
 			*result = controller->totalBytesConsumed;
 		}
 
+		boost::uint64_t getRequestPoolMallocs() {
+			boost::uint64_t result;
+			bg.safe->runSync(boost::bind(&Core_ControllerTest::_getRequestPoolMallocs,
+				this, &result));
+			return result;
+		}
+
+		void _getRequestPoolMallocs(boost::uint64_t *result) {
+			*result = controller->requestPoolCache.nmallocs;
+		}
+
 		string readPeerRequestHeader(string *peerRequestHeader = NULL) {
 			if (peerRequestHeader == NULL) {
 				peerRequestHeader = &this->peerRequestHeader;
@@ -258,9 +298,73 @@ namespace tut {
 		string readResponseBody() {
 			return clientConnectionIO.readAll();
 		}
+
+		/**
+		 * Creates a response body of the given size that consists of
+		 * numbered lines, so that reordered data can be detected.
+		 */
+		static string createLargeBody(unsigned int size) {
+			string result;
+			char buf[16];
+			unsigned int i = 0;
+
+			result.reserve(size + sizeof(buf));
+			while (result.size() < size) {
+				snprintf(buf, sizeof(buf), "%08u\n", i++);
+				result.append(buf);
+			}
+			result.resize(size);
+			return result;
+		}
+
+		static string createDateString(time_t time) {
+			struct tm tm;
+			char buf[64];
+			gmtime_r(&time, &tm);
+			size_t size = strftime(buf, sizeof(buf), "%a, %d %b %Y %H:%M:%S GMT", &tm);
+			return string(buf, size);
+		}
+
+		/**
+		 * Lets the app respond to a request for /cached with an entry that
+		 * has just expired, with the given extra Cache-Control directives
+		 * and headers, so that it's stored in the turbocache.
+		 */
+		void populateTurboCacheWithExpiredEntry(const string &cacheControl,
+			const string &extraHeaders = string())
+		{
+			useTestSessionObject();
+			connectToServer();
+			sendRequest(
+				"GET /cached HTTP/1.1\r\n"
+				"Host: localhost\r\n"
+				"Connection: close\r\n"
+				"\r\n");
+			waitUntilSessionInitiated();
+			readPeerRequestHeader();
+			sendPeerResponse(
+				"HTTP/1.1 200 OK\r\n"
+				"Cache-Control: public" + cacheControl + "\r\n"
+				"Expires: " + createDateString(time(NULL) - 1) + "\r\n"
+				+ extraHeaders +
+				"Content-Length: 3\r\n\r\n"
+				"old");
+			ensure(containsSubstring(readResponseHeader(), "HTTP/1.1 200 OK\r\n"));
+			ensure_equals(readResponseBody(), "old");
+		}
+
+		static FileDescriptor sendCachedRequest() {
+			FileDescriptor fd(connectToUnixServer("tmp.server", __FILE__, __LINE__), NULL, 0);
+			writeExact(fd,
+				"GET /cached HTTP/1.1\r\n"
+				"Host: localhost\r\n"
+				"Connection: close\r\n"
+				"\r\n");
+			return fd;
+		}
 	};
 
-	DEFINE_TEST_GROUP(Core_ControllerTest);
+	DEFINE_TEST_GROUP_WITH_LIMIT(Core_ControllerTest, 70);
 
 
 	/***** Passing request information to the app *****/
@@ -392,6 +496,85 @@ namespace tut {
 			"0\r\n\r\n");
 	}
 
+	TEST_METHOD(14) {
+		set_test_name("Chunked response body consisting of many chunks, with dechunking");
+		string chunks, expectedBody;
+
+		for (unsigned int i = 0; i < 40; i++) {
+			string data = toString(i) + "abc";
+			chunks.append(integerToHex(data.size()) + "\r\n" + data + "\r\n");
+			expectedBody.append(data);
+		}
+		chunks.append("0\r\n\r\n");
+
+		init();
+		useTestSessionObject();
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"!~: \r\n"
+			"!~FLAGS: D\r\n"
+			"!~: \r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+
+		readPeerRequestHeader();
+		sendPeerResponse(
+			"HTTP/1.1 200 OK\r\n"
+			"Connection: close\r\n"
+			"Transfer-Encoding: chunked\r\n\r\n"
+			+ chunks);
+
+		string header = readResponseHeader();
+		string body = readResponseBody();
+		ensure("HTTP response OK", containsSubstring(header, "HTTP/1.1 200 OK\r\n"));
+		ensure("Not chunked", !containsSubstring(header, "Transfer-Encoding"));
+		ensure_equals(body, expectedBody);
+	}
+
+	TEST_METHOD(15) {
+		set_test_name("The response header consists of the status line, the app's headers,"
+			" the Date header, the body framing headers, Connection and X-Powered-By");
+
+		init();
+		useTestSessionObject();
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+
+		readPeerRequestHeader();
+		sendPeerResponse(
+			"HTTP/1.1 404 Not Found\r\n"
+			"Content-Type: text/plain\r\n"
+			"Content-Length: 5\r\n\r\n"
+			"hello");
+
+		string header = readResponseHeader();
+		string expectedBegin =
+			"HTTP/1.1 404 Not Found\r\n"
+			"Status: 404 Not Found\r\n"
+			"Content-Type: text/plain\r\n"
+			"Date: ";
+		string expectedEnd =
+			" GMT\r\n"
+			"Content-Length: 5\r\n"
+			"Connection: close\r\n"
+			"X-Powered-By: " PROGRAM_NAME;
+		ensure("(1)", startsWith(header, expectedBegin));
+		ensure("(2)", containsSubstring(header, expectedEnd));
+		ensure_equals("(3)", header.find("\r\n", expectedBegin.size()),
+			expectedBegin.size() + strlen("Wed, 15 Nov 1995 06:25:24 GMT"));
+		ensure_equals(readResponseBody(), "hello");
+	}
+
 	TEST_METHOD(13) {
 		set_test_name("Upgraded response body");
 
@@ -419,6 +602,83 @@ namespace tut {
 		ensure_equals(body, "hello");
 	}
 
+	TEST_METHOD(16) {
+		set_test_name("Large response bodies are spliced to the client");
+
+		init();
+		useTestSessionObject();
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+
+		readPeerRequestHeader();
+		string body = createLargeBody(4 * 1024 * 1024);
+		string response =
+			"HTTP/1.1 200 OK\r\n"
+			"Connection: close\r\n"
+			"Content-Length: " + toString(body.size()) + "\r\n\r\n"
+			+ body;
+		// The client reads while the app writes, so the client
+		// socket is usually writable.
+		boost::thread thr(boost::bind(&Core_ControllerTest::sendPeerResponse,
+			this, StaticString(response)));
+
+		string header = readResponseHeader();
+		string receivedBody = readResponseBody();
+		thr.join();
+		ensure("(1)", containsSubstring(header, "HTTP/1.1 200 OK\r\n"));
+		ensure_equals("(2)", receivedBody.size(), body.size());
+		ensure("(3)", receivedBody == body);
+
+		Json::Value doc = inspectState()["response_bodies"];
+		ensure("(4)", doc["bytes_spliced"]["bytes"].asUInt64() > 0);
+		ensure_equals("(5)", doc["bytes_spliced"]["bytes"].asUInt64()
+			+ doc["bytes_copied"]["bytes"].asUInt64(),
+			(Json::UInt64) body.size());
+	}
+
+	TEST_METHOD(17) {
+		set_test_name("Splicing falls back to copying if the client socket is not writable");
+
+		init();
+		useTestSessionObject();
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+
+		readPeerRequestHeader();
+		string body = createLargeBody(4 * 1024 * 1024);
+		// The client doesn't read until the app has written the entire
+		// response, so the response must be buffered.
+		sendPeerResponse(
+			"HTTP/1.1 200 OK\r\n"
+			"Connection: close\r\n"
+			"Content-Length: " + toString(body.size()) + "\r\n\r\n"
+			+ body);
+
+		string header = readResponseHeader();
+		string receivedBody = readResponseBody();
+		ensure("(1)", containsSubstring(header, "HTTP/1.1 200 OK\r\n"));
+		ensure_equals("(2)", receivedBody.size(), body.size());
+		ensure("(3)", receivedBody == body);
+
+		Json::Value doc = inspectState()["response_bodies"];
+		ensure("(4)", doc["bytes_copied"]["bytes"].asUInt64() > 0);
+		ensure_equals("(5)", doc["bytes_spliced"]["bytes"].asUInt64()
+			+ doc["bytes_copied"]["bytes"].asUInt64(),
+			(Json::UInt64) body.size());
+	}
+
 
 	/***** Application connection keep-alive *****/
 
@@ -499,6 +759,182 @@ namespace tut {
 	}
 
 
+	/***** Serving files named by X-Sendfile or X-Accel-Redirect *****/
+
+	TEST_METHOD(23) {
+		set_test_name("If a sendfile root is configured, then the file named by"
+			" X-Sendfile is served, and the connection may be kept alive");
+
+		TempDir dir("tmp.sendfile");
+		string body = createLargeBody(1024 * 1024 + 123);
+		writeFile("tmp.sendfile/file.txt", body);
+		config["default_sendfile_root"] = "tmp.sendfile";
+		init();
+		useTestSessionObject();
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+
+		readPeerRequestHeader();
+		sendPeerResponse(
+			"HTTP/1.1 200 OK\r\n"
+			"Content-Type: text/plain\r\n"
+			"X-Sendfile: " + absolutizePath("tmp.sendfile/file.txt") + "\r\n\r\n");
+
+		string header = readResponseHeader();
+		ensure("(1)", containsSubstring(header, "HTTP/1.1 200 OK\r\n"));
+		ensure("(2)", containsSubstring(header, "Content-Type: text/plain\r\n"));
+		ensure("(3)", containsSubstring(header, "Content-Length: " + toString(body.size()) + "\r\n"));
+		ensure("(4)", containsSubstring(header, "Accept-Ranges: bytes\r\n"));
+		ensure("(5)", !containsSubstring(header, "Connection: close"));
+		ensure("(6)", !containsSubstring(header, "X-Sendfile"));
+
+		string receivedBody(body.size(), '\0');
+		ensure_equals("(7)", clientConnectionIO.read(&receivedBody[0], body.size()),
+			body.size());
+		ensure("(8)", receivedBody == body);
+
+		Json::Value doc = inspectState()["sendfile"];
+		ensure_equals("(9)", doc["files_sent"].asUInt64(), 1u);
+		ensure_equals("(10)", doc["bytes_sent"]["bytes"].asUInt64(),
+			(Json::UInt64) body.size());
+	}
+
+	TEST_METHOD(24) {
+		set_test_name("X-Accel-Redirect URIs are mapped to files inside the sendfile root,"
+			" and single byte ranges are supported");
+
+		TempDir dir("tmp.sendfile");
+		string body = createLargeBody(1000);
+		makeDirTree("tmp.sendfile/sub");
+		writeFile("tmp.sendfile/sub/file name.txt", body);
+		config["default_sendfile_root"] = "tmp.sendfile";
+		init();
+		useTestSessionObject();
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"Range: bytes=100-199\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+
+		readPeerRequestHeader();
+		sendPeerResponse(
+			"HTTP/1.1 200 OK\r\n"
+			"X-Accel-Redirect: /sub/file%20name.txt?foo=bar\r\n\r\n");
+
+		string header = readResponseHeader();
+		string receivedBody = readResponseBody();
+		ensure("(1)", containsSubstring(header, "HTTP/1.1 206 Partial Content\r\n"));
+		ensure("(2)", containsSubstring(header, "Content-Range: bytes 100-199/1000\r\n"));
+		ensure("(3)", containsSubstring(header, "Content-Length: 100\r\n"));
+		ensure("(4)", !containsSubstring(header, "X-Accel-Redirect"));
+		ensure_equals("(5)", receivedBody, body.substr(100, 100));
+	}
+
+	TEST_METHOD(25) {
+		set_test_name("Unsatisfiable byte ranges result in a 416 response");
+
+		TempDir dir("tmp.sendfile");
+		writeFile("tmp.sendfile/file.txt", "hello world");
+		config["default_sendfile_root"] = "tmp.sendfile";
+		init();
+		useTestSessionObject();
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"Range: bytes=5000-\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+
+		readPeerRequestHeader();
+		sendPeerResponse(
+			"HTTP/1.1 200 OK\r\n"
+			"X-Sendfile: file.txt\r\n\r\n");
+
+		string header = readResponseHeader();
+		string receivedBody = readResponseBody();
+		ensure("(1)", containsSubstring(header, "HTTP/1.1 416 Requested Range Not Satisfiable\r\n"));
+		ensure("(2)", containsSubstring(header, "Content-Range: bytes */11\r\n"));
+		ensure("(3)", containsSubstring(header, "Content-Length: 0\r\n"));
+		ensure_equals("(4)", receivedBody, "");
+	}
+
+	TEST_METHOD(26) {
+		set_test_name("Files outside the sendfile root are not served,"
+			" even through symlinks");
+
+		TempDir dir("tmp.sendfile");
+		TempDir dir2("tmp.sendfile-outside");
+		writeFile("tmp.sendfile-outside/secret.txt", "secret");
+		if (symlink(absolutizePath("tmp.sendfile-outside/secret.txt").c_str(),
+			"tmp.sendfile/link.txt") == -1)
+		{
+			int e = errno;
+			throw FileSystemException("Cannot create symlink", e, "tmp.sendfile/link.txt");
+		}
+		config["default_sendfile_root"] = "tmp.sendfile";
+		init();
+		useTestSessionObject();
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+
+		readPeerRequestHeader();
+		LoggingKit::setLevel(LoggingKit::CRIT);
+		sendPeerResponse(
+			"HTTP/1.1 200 OK\r\n"
+			"X-Accel-Redirect: /link.txt\r\n\r\n");
+
+		string header = readResponseHeader();
+		string receivedBody = readResponseBody();
+		ensure("(1)", containsSubstring(header, "HTTP/1.1 403 Forbidden\r\n"));
+		ensure("(2)", !containsSubstring(receivedBody, "secret"));
+	}
+
+	TEST_METHOD(27) {
+		set_test_name("Without a sendfile root, X-Sendfile responses are forwarded"
+			" as-is and the connection is not kept alive");
+
+		init();
+		useTestSessionObject();
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+
+		readPeerRequestHeader();
+		sendPeerResponse(
+			"HTTP/1.1 200 OK\r\n"
+			"X-Sendfile: /tmp/file.txt\r\n\r\n");
+
+		string header = readResponseHeader();
+		ensure("(1)", containsSubstring(header, "HTTP/1.1 200 OK\r\n"));
+		ensure("(2)", containsSubstring(header, "X-Sendfile: /tmp/file.txt\r\n"));
+		ensure("(3)", containsSubstring(header, "Connection: close\r\n"));
+		ensure("(4)", !containsSubstring(header, "Content-Length"));
+		ensure_equals("(5)", readResponseBody(), "");
+	}
+
+
 	/***** Passing half-close events to the app *****/
 
 	TEST_METHOD(30) {
@@ -865,4 +1301,461 @@ namespace tut {
 		string header = readResponseHeader();
 		ensure(containsSubstring(header, "HTTP/1.1 502"));
 	}
+
+
+	/***** Turbocaching *****/
+
+	TEST_METHOD(45) {
+		set_test_name("Concurrent requests for an expired turbocache entry are"
+			" coalesced into a single app request");
+		const unsigned int herdSize = 10;
+		TestSession herdSession;
+		FileDescriptor herd[herdSize];
+
+		init();
+		// The stale-if-error window keeps the expired entry around, but
+		// doesn't allow serving it while it's being revalidated.
+		populateTurboCacheWithExpiredEntry(", stale-if-error=60");
+
+		useTestSessionObject(&herdSession);
+		for (unsigned int i = 0; i < herdSize; i++) {
+			herd[i] = sendCachedRequest();
+		}
+		EVENTUALLY(5,
+			result = inspectState()["turbocaching"]["coalesced_requests"].asUInt()
+				== herdSize - 1;
+		);
+
+		readScalarMessage(herdSession.peerFd());
+		writeExact(herdSession.peerFd(),
+			"HTTP/1.1 200 OK\r\n"
+			"Cache-Control: public, max-age=60\r\n"
+			"Content-Length: 3\r\n\r\n"
+			"new");
+		herdSession.closePeerFd();
+
+		for (unsigned int i = 0; i < herdSize; i++) {
+			BufferedIO io(herd[i]);
+			ensure(containsSubstring(readHeader(io), "HTTP/1.1 200 OK\r\n"));
+			ensure_equals(io.readAll(), "new");
+		}
+		// One checkout for populating the cache, one for the herd.
+		ensure_equals(getCheckouts(), 2u);
+	}
+
+	TEST_METHOD(46) {
+		set_test_name("With stale-while-revalidate, requests for an entry that's being"
+			" revalidated are immediately served the stale entry");
+		TestSession revalidationSession;
+
+		init();
+		populateTurboCacheWithExpiredEntry(", stale-while-revalidate=60");
+
+		useTestSessionObject(&revalidationSession);
+		FileDescriptor leader(sendCachedRequest());
+		EVENTUALLY(5,
+			result = revalidationSession.fd() != -1;
+		);
+
+		// The app hasn't responded to the leader yet.
+		FileDescriptor other(sendCachedRequest());
+		BufferedIO io(other);
+		string header = readHeader(io);
+		ensure("(1)", containsSubstring(header, "HTTP/1.1 200 OK\r\n"));
+		ensure("(2)", containsSubstring(header, "Warning: 110 - \"Response is Stale\"\r\n"));
+		ensure_equals("(3)", io.readAll(), "old");
+
+		readScalarMessage(revalidationSession.peerFd());
+		writeExact(revalidationSession.peerFd(),
+			"HTTP/1.1 200 OK\r\n"
+			"Cache-Control: public, max-age=60\r\n"
+			"Content-Length: 3\r\n\r\n"
+			"new");
+		revalidationSession.closePeerFd();
+		BufferedIO leaderIO(leader);
+		readHeader(leaderIO);
+		ensure_equals("(4)", leaderIO.readAll(), "new");
+		ensure_equals("(5)", getCheckouts(), 2u);
+	}
+
+	TEST_METHOD(47) {
+		set_test_name("With stale-if-error, the stale entry is served if"
+			" the app responds with an error");
+		TestSession errorSession;
+
+		init();
+		populateTurboCacheWithExpiredEntry(", stale-if-error=60");
+
+		useTestSessionObject(&errorSession);
+		connectToServer();
+		sendRequest(
+			"GET /cached HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		EVENTUALLY(5,
+			result = errorSession.fd() != -1;
+		);
+		readScalarMessage(errorSession.peerFd());
+		writeExact(errorSession.peerFd(),
+			"HTTP/1.1 503 Service Unavailable\r\n"
+			"Content-Length: 5\r\n\r\n"
+			"error");
+		errorSession.closePeerFd();
+
+		string header = readResponseHeader();
+		ensure("(1)", containsSubstring(header, "HTTP/1.1 200 OK\r\n"));
+		ensure("(2)", containsSubstring(header, "Warning: 110 - \"Response is Stale\"\r\n"));
+		ensure_equals("(3)", readResponseBody(), "old");
+	}
+
+	TEST_METHOD(48) {
+		set_test_name("Conditional requests that match a cached entry's validators"
+			" are answered with 304 Not Modified without contacting the app");
+
+		init();
+		useTestSessionObject();
+		connectToServer();
+		sendRequest(
+			"GET /cached HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+		readPeerRequestHeader();
+		sendPeerResponse(
+			"HTTP/1.1 200 OK\r\n"
+			"Cache-Control: public, max-age=60\r\n"
+			"ETag: \"v1\"\r\n"
+			"Content-Type: text/plain\r\n"
+			"Content-Length: 3\r\n\r\n"
+			"old");
+		readResponseHeader();
+		ensure_equals("(1)", readResponseBody(), "old");
+
+		connectToServer();
+		sendRequest(
+			"GET /cached HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"If-None-Match: \"v1\"\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		string header = readResponseHeader();
+		ensure("(2)", containsSubstring(header, "HTTP/1.1 304 Not Modified\r\n"));
+		ensure("(3)", containsSubstring(header, "ETag: \"v1\"\r\n"));
+		ensure("(4)", containsSubstring(header, "Cache-Control: public, max-age=60\r\n"));
+		ensure("(5)", !containsSubstring(header, "Content-Type"));
+		ensure("(6)", !containsSubstring(header, "Content-Length"));
+		ensure_equals("(7)", readResponseBody(), "");
+
+		connectToServer();
+		sendRequest(
+			"GET /cached HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"If-None-Match: \"v2\"\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		ensure("(8)", containsSubstring(readResponseHeader(), "HTTP/1.1 200 OK\r\n"));
+		ensure_equals("(9)", readResponseBody(), "old");
+		ensure_equals("(10)", getCheckouts(), 1u);
+		ensure_equals("(11)", inspectState()["turbocaching"]["not_modified_responses"].asUInt(),
+			1u);
+	}
+
+	TEST_METHOD(49) {
+		set_test_name("An expired entry with validators is revalidated with a conditional"
+			" request, and served if the app responds with 304 Not Modified");
+		TestSession revalidationSession;
+
+		init();
+		populateTurboCacheWithExpiredEntry("", "ETag: \"v1\"\r\n");
+
+		useTestSessionObject(&revalidationSession);
+		connectToServer();
+		sendRequest(
+			"GET /cached HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		EVENTUALLY(5,
+			result = revalidationSession.fd() != -1;
+		);
+		string peerHeader = readScalarMessage(revalidationSession.peerFd());
+		ensure("(1)", containsSubstring(peerHeader,
+			P_STATIC_STRING("HTTP_IF_NONE_MATCH\0\"v1\"\0")));
+		writeExact(revalidationSession.peerFd(),
+			"HTTP/1.1 304 Not Modified\r\n"
+			"Cache-Control: public, max-age=60\r\n"
+			"\r\n");
+		revalidationSession.closePeerFd();
+
+		string header = readResponseHeader();
+		ensure("(2)", containsSubstring(header, "HTTP/1.1 200 OK\r\n"));
+		ensure("(3)", !containsSubstring(header, "Warning"));
+		ensure_equals("(4)", readResponseBody(), "old");
+
+		// The entry is fresh again.
+		connectToServer();
+		sendRequest(
+			"GET /cached HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		ensure("(5)", containsSubstring(readResponseHeader(), "HTTP/1.1 200 OK\r\n"));
+		ensure_equals("(6)", readResponseBody(), "old");
+		ensure_equals("(7)", getCheckouts(), 2u);
+		ensure_equals("(8)", inspectState()["turbocaching"]["revalidations"].asUInt(), 1u);
+	}
+
+	TEST_METHOD(50) {
+		set_test_name("Textual responses are compressed in the background, and the"
+			" compressed variant is served to clients that accept gzip");
+		string body = "{\"message\": \"" + string(500, 'a') + "\"}";
+		string compressedBody;
+
+		init();
+		useTestSessionObject();
+		connectToServer();
+		sendRequest(
+			"GET /cached HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+		readPeerRequestHeader();
+		sendPeerResponse(
+			"HTTP/1.1 200 OK\r\n"
+			"Cache-Control: public, max-age=60\r\n"
+			"Content-Type: application/json\r\n"
+			"Content-Length: " + toString(body.size()) + "\r\n\r\n"
+			+ body);
+		ensure("(1)", containsSubstring(readResponseHeader(), "HTTP/1.1 200 OK\r\n"));
+		ensure_equals("(2)", readResponseBody(), body);
+
+		EVENTUALLY(5,
+			result = inspectState()["turbocaching"]["compressions"].asUInt() == 1;
+		);
+
+		connectToServer();
+		sendRequest(
+			"GET /cached HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Accept-Encoding: deflate, gzip\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		ensure("(3)", ResponseCompressor::gzip(body, compressedBody));
+		string header = readResponseHeader();
+		ensure("(4)", containsSubstring(header, "HTTP/1.1 200 OK\r\n"));
+		ensure("(5)", containsSubstring(header, "Content-Encoding: gzip\r\n"));
+		ensure("(6)", containsSubstring(header, "Vary: Accept-Encoding\r\n"));
+		ensure("(7)", containsSubstring(header,
+			"Content-Length: " + toString(compressedBody.size()) + "\r\n"));
+		ensure("(8)", readResponseBody() == compressedBody);
+
+		connectToServer();
+		sendRequest(
+			"GET /cached HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		header = readResponseHeader();
+		ensure("(9)", !containsSubstring(header, "Content-Encoding"));
+		ensure("(10)", containsSubstring(header, "Vary: Accept-Encoding\r\n"));
+		ensure_equals("(11)", readResponseBody(), body);
+		ensure_equals("(12)", getCheckouts(), 1u);
+		ensure_equals("(13)", inspectState()["turbocaching"]["compressed_responses"].asUInt(), 1u);
+	}
+
+	TEST_METHOD(51) {
+		set_test_name("The compressed variant has its own entity tag, which conditional"
+			" requests are matched against");
+		string body = "{\"message\": \"" + string(500, 'a') + "\"}";
+		string compressedBody;
+
+		init();
+		useTestSessionObject();
+		connectToServer();
+		sendRequest(
+			"GET /cached HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+		readPeerRequestHeader();
+		sendPeerResponse(
+			"HTTP/1.1 200 OK\r\n"
+			"Cache-Control: public, max-age=60\r\n"
+			"Content-Type: application/json\r\n"
+			"ETag: \"v1\"\r\n"
+			"Content-Length: " + toString(body.size()) + "\r\n\r\n"
+			+ body);
+		ensure("(1)", containsSubstring(readResponseHeader(), "ETag: \"v1\"\r\n"));
+		ensure_equals("(2)", readResponseBody(), body);
+		ensure("(3)", ResponseCompressor::gzip(body, compressedBody));
+
+		EVENTUALLY(5,
+			result = inspectState()["turbocaching"]["compressions"].asUInt() == 1;
+		);
+
+		connectToServer();
+		sendRequest(
+			"GET /cached HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Accept-Encoding: gzip\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		string header = readResponseHeader();
+		ensure("(4)", containsSubstring(header, "Content-Encoding: gzip\r\n"));
+		ensure("(5)", !containsSubstring(header, "ETag: \"v1\"\r\n"));
+		ensure("(6)", containsSubstring(header, "ETag: \"v1-gzip\"\r\n"));
+		ensure("(7)", readResponseBody() == compressedBody);
+
+		// The identity variant's entity tag doesn't match the compressed
+		// variant, so the client gets the compressed variant in full.
+		connectToServer();
+		sendRequest(
+			"GET /cached HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Accept-Encoding: gzip\r\n"
+			"If-None-Match: \"v1\"\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		header = readResponseHeader();
+		ensure("(8)", containsSubstring(header, "HTTP/1.1 200 OK\r\n"));
+		ensure("(9)", containsSubstring(header, "Content-Encoding: gzip\r\n"));
+		ensure("(10)", containsSubstring(header, "ETag: \"v1-gzip\"\r\n"));
+		ensure("(11)", readResponseBody() == compressedBody);
+
+		connectToServer();
+		sendRequest(
+			"GET /cached HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Accept-Encoding: gzip\r\n"
+			"If-None-Match: \"v1-gzip\"\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		header = readResponseHeader();
+		ensure("(12)", containsSubstring(header, "HTTP/1.1 304 Not Modified\r\n"));
+		ensure("(13)", containsSubstring(header, "ETag: \"v1-gzip\"\r\n"));
+		ensure_equals("(14)", readResponseBody(), "");
+
+		connectToServer();
+		sendRequest(
+			"GET /cached HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"If-None-Match: \"v1-gzip\"\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		header = readResponseHeader();
+		ensure("(15)", containsSubstring(header, "HTTP/1.1 200 OK\r\n"));
+		ensure("(16)", containsSubstring(header, "ETag: \"v1\"\r\n"));
+		ensure_equals("(17)", readResponseBody(), body);
+		ensure_equals("(18)", getCheckouts(), 1u);
+	}
+
+
+	/***** Request pools *****/
+
+	TEST_METHOD(52) {
+		set_test_name("Once warmed up, request pools don't call malloc(), even for"
+			" requests that need more than one pool block");
+		init();
+		useTestSessionObject();
+		connectToServer();
+		sendRequest(
+			"GET /cached HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+		readPeerRequestHeader();
+		sendPeerResponse(
+			"HTTP/1.1 200 OK\r\n"
+			"Cache-Control: public, max-age=60\r\n"
+			"Content-Length: 3\r\n\r\n"
+			"abc");
+		readResponseHeader();
+		ensure_equals("(1)", readResponseBody(), "abc");
+
+		// Turbocache hits, on a keep-alive connection. The header objects
+		// are allocated from the request pool, so with this many headers
+		// the request pool needs multiple blocks.
+		string request = "GET /cached HTTP/1.1\r\n"
+			"Host: localhost\r\n";
+		for (unsigned int i = 0; i < 400; i++) {
+			request.append("X-Header-" + toString(i) + ": value\r\n");
+		}
+		request.append("\r\n");
+		boost::uint64_t mallocs = 0;
+		char body[3];
+
+		connectToServer();
+		for (unsigned int i = 0; i < 50; i++) {
+			if (i == 10) {
+				mallocs = getRequestPoolMallocs();
+			}
+			sendRequest(request);
+			ensure("(2)", containsSubstring(readResponseHeader(), "HTTP/1.1 200 OK\r\n"));
+			ensure_equals("(3)", clientConnectionIO.read(body, sizeof(body)), 3u);
+		}
+		ensure_equals("(4)", getRequestPoolMallocs(), mallocs);
+		ensure_equals("(5)", getCheckouts(), 1u);
+
+		Json::Value doc = inspectState()["request_pools"];
+		Json::UInt64 total = 0;
+		for (unsigned int i = 0; i < doc["high_water_marks"].size(); i++) {
+			total += doc["high_water_marks"][i]["count"].asUInt64();
+		}
+		ensure("(6)", total >= 50);
+	}
+
+
+	/***** Benchmarks *****/
+
+	TEST_METHOD(60) {
+		set_test_name("Benchmark: request throughput in the 'before_checkout' benchmark mode");
+		ONLY_RUN_IN_BENCHMARK_MODE();
+
+		const unsigned int batchSize = 100;
+		const unsigned int batches = 500;
+		const StaticString request(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: keep-alive\r\n"
+			"\r\n");
+		string batch;
+		for (unsigned int i = 0; i < batchSize; i++) {
+			batch.append(request.data(), request.size());
+		}
+
+		config["benchmark_mode"] = "before_checkout";
+		init();
+		connectToServer();
+
+		// Determine the response size, and warm up.
+		sendRequest(request);
+		string header = readResponseHeader();
+		ensure(containsSubstring(header, "HTTP/1.1 200 OK\r\n"));
+		size_t responseSize = header.size() + strlen("\r\n") + strlen("ok\n");
+		char buf[1024 * 16];
+		ensure_equals(clientConnectionIO.read(buf, strlen("ok\n")), (unsigned int) strlen("ok\n"));
+
+		unsigned long long startTime = SystemTime::getUsec();
+		for (unsigned int i = 0; i < batches; i++) {
+			writeExact(clientConnection, batch);
+			size_t remaining = responseSize * batchSize;
+			while (remaining > 0) {
+				unsigned int size = (unsigned int) std::min(remaining, sizeof(buf));
+				ensure_equals(clientConnectionIO.read(buf, size), size);
+				remaining -= size;
+			}
+		}
+		unsigned long long totalTime = SystemTime::getUsec() - startTime;
+
+		fprintf(stderr, "sizeof(Request) = %u bytes; %u requests in %.3f sec"
+			" (%.0f requests/sec)\n",
+			(unsigned int) sizeof(Request), batches * batchSize,
+			totalTime / 1000000.0,
+			batches * batchSize / (totalTime / 1000000.0));
+	}
 }
@@ -1,10 +1,17 @@
 #include <TestSupport.h>
 #include <time.h>
+#include <cstdio>
+#include <algorithm>
+#include <set>
+#include <vector>
 #include <ServerKit/HttpRequest.h>
 #include <MemoryKit/palloc.h>
 #include <Core/Controller/Request.h>
 #include <Core/Controller/AppResponse.h>
 #include <Core/ResponseCache.h>
+#include <Core/SharedResponseCache.h>
+#include <Core/ResponseCompressor.h>
+#include <zlib.h>
 
 using namespace Passenger;
 using namespace Passenger::Core;
@@ -69,11 +76,14 @@ namespace tut {
 			req.appResponseInitialized = false;
 			req.strip100ContinueHeader = false;
 			req.hasPragmaHeader = false;
+			req.turboCacheRole = Request::TURBOCACHE_NO_ROLE;
 			req.host = createHostString();
 			req.bodyBytesBuffered = 0;
 			req.cacheKey = HashedStaticString();
 			req.cacheControl = NULL;
 			req.varyCookie = NULL;
+			req.nextTurboCacheWaiter = NULL;
+			req.turboCacheRevalidationEntry = ResponseCacheType::Entry();
 			req.envvars = NULL;
 
 			req.appResponse.headers.clear();
@@ -125,6 +135,7 @@ namespace tut {
 			psg_lstr_append(&header->origKey, req.pool, key.data(), key.size());
 			psg_lstr_append(&header->val, req.pool, val.data(), val.size());
 			header->hash = key.hash();
+			header->id = httpHeaderIdTable.lookup(header->hash, &header->key);
 			return header;
 		}
 
@@ -152,9 +163,197 @@ namespace tut {
 			req.appResponse.bodyType = AppResponse::RBT_CONTENT_LENGTH;
 			req.appResponse.aux.bodyInfo.contentLength = body.size();
 		}
+
+		/**
+		 * Returns the cache key for the given path. The key's data
+		 * lives in the request pool.
+		 */
+		HashedStaticString createCacheKey(const string &path) {
+			reset();
+			psg_lstr_init(&req.path);
+			psg_lstr_append(&req.path, req.pool, psg_pstrdup(req.pool, path).data(), path.size());
+			ensure(responseCache.prepareRequest(this, &req));
+			return req.cacheKey;
+		}
+
+		/**
+		 * Prepares `req` so that store() can be called on it
+		 * with any cache key.
+		 */
+		void prepareForStoring() {
+			reset();
+			initCacheableResponse();
+			ensure(responseCache.prepareRequest(this, &req));
+			ensure(responseCache.requestAllowsStoring(&req));
+			ensure(responseCache.prepareRequestForStoring(&req));
+		}
+
+		/**
+		 * Like prepareForStoring(), but the response expires after 10 seconds,
+		 * and has a stale-while-revalidate window of 30 seconds and a
+		 * stale-if-error window of 60 seconds.
+		 */
+		void prepareForStoringWithStaleWindows() {
+			reset();
+			insertAppResponseHeader(createHeader(
+				"cache-control", "public, max-age=10, stale-while-revalidate=30,"
+				" stale-if-error=60"),
+				req.pool);
+			ensure(responseCache.prepareRequest(this, &req));
+			ensure(responseCache.requestAllowsStoring(&req));
+			ensure(responseCache.prepareRequestForStoring(&req));
+		}
+
+		/**
+		 * Stores an entry whose response has an ETag and a Last-Modified header
+		 * and expires after 10 seconds, including its HTTP header data.
+		 */
+		ResponseCacheType::Entry storeEntryWithValidators(const HashedStaticString &key) {
+			StaticString headerData = P_STATIC_STRING("HTTP/1.1 200 OK\r\n"
+				"Cache-Control: public, max-age=10\r\n"
+				"ETag: \"abc\"\r\n"
+				"last-modified:  Sat, 01 Jan 2000 00:00:00 GMT\r\n");
+
+			reset();
+			insertAppResponseHeader(createHeader(
+				"cache-control", "public, max-age=10"),
+				req.pool);
+			insertAppResponseHeader(createHeader(
+				"etag", "\"abc\""),
+				req.pool);
+			insertAppResponseHeader(createHeader(
+				"last-modified", "Sat, 01 Jan 2000 00:00:00 GMT"),
+				req.pool);
+			ensure(responseCache.prepareRequest(this, &req));
+			ensure(responseCache.prepareRequestForStoring(&req));
+			req.cacheKey = key;
+			ResponseCacheType::Entry entry(responseCache.store(&req, time(NULL),
+				headerData.size(), 4));
+			ensure(entry.valid());
+			memcpy(entry.body->httpHeaderData, headerData.data(), headerData.size());
+			memcpy(entry.body->httpBodyData, "body", 4);
+			return entry;
+		}
+
+		ResponseCacheType::Entry storeEntry(const HashedStaticString &key,
+			unsigned int bodySize)
+		{
+			req.cacheKey = key;
+			return responseCache.store(&req, time(NULL), 64, bodySize);
+		}
+
+		ResponseCacheType::Entry fetchEntry(const HashedStaticString &key) {
+			req.cacheKey = key;
+			return responseCache.fetch(&req, time(NULL));
+		}
+
+		vector<HashedStaticString> createCacheKeys(unsigned int count) {
+			vector<HashedStaticString> keys;
+			for (unsigned int i = 0; i < count; i++) {
+				keys.push_back(createCacheKey("/endpoint" + toString(i)));
+			}
+			return keys;
+		}
+
+		ResponseCacheType::Entry storeAndPublishEntry(ResponseCacheType &cache,
+			const HashedStaticString &key, const StaticString &body)
+		{
+			req.cacheKey = key;
+			ResponseCacheType::Entry entry(cache.store(&req, time(NULL), 6, body.size()));
+			if (entry.valid()) {
+				memcpy(entry.body->httpHeaderData, "header", 6);
+				memcpy(entry.body->httpBodyData, body.data(), body.size());
+				cache.publish(entry);
+			}
+			return entry;
+		}
+
+		/**
+		 * Stores an entry with the given HTTP header data and body.
+		 *
+		 * @pre prepareForStoring() was called
+		 */
+		ResponseCacheType::Entry storeEntryWithData(const HashedStaticString &key,
+			const StaticString &headerData, const StaticString &body)
+		{
+			req.cacheKey = key;
+			ResponseCacheType::Entry entry(responseCache.store(&req, time(NULL),
+				headerData.size(), body.size()));
+			if (entry.valid()) {
+				memcpy(entry.body->httpHeaderData, headerData.data(), headerData.size());
+				memcpy(entry.body->httpBodyData, body.data(), body.size());
+			}
+			return entry;
+		}
+
+		static string gunzip(const StaticString &data) {
+			z_stream stream;
+			char buf[1024];
+			string result;
+
+			memset(&stream, 0, sizeof(stream));
+			ensure(inflateInit2(&stream, 15 + 16) == Z_OK);
+			stream.next_in = (Bytef *) data.data();
+			stream.avail_in = data.size();
+			int ret;
+			do {
+				stream.next_out = (Bytef *) buf;
+				stream.avail_out = sizeof(buf);
+				ret = inflate(&stream, Z_NO_FLUSH);
+				result.append(buf, sizeof(buf) - stream.avail_out);
+			} while (ret == Z_OK);
+			inflateEnd(&stream);
+			ensure_equals(ret, Z_STREAM_END);
+			return result;
+		}
+
+		static unsigned long long getNsec() {
+			struct timespec ts;
+			clock_gettime(CLOCK_MONOTONIC, &ts);
+			return (unsigned long long) ts.tv_sec * 1000000000 + ts.tv_nsec;
+		}
+
+		/**
+		 * Simulates a workload of `iterations` requests to `keys.size()` endpoints,
+		 * with Zipf-distributed popularity, in which every cache miss results in
+		 * a store. Returns the hit ratio and the average fetch time in nanoseconds.
+		 */
+		pair<double, double> simulateWorkload(const vector<HashedStaticString> &keys,
+			unsigned int bodySize, unsigned int iterations)
+		{
+			vector<double> cumulativeWeights;
+			double total = 0;
+			for (unsigned int i = 0; i < keys.size(); i++) {
+				total += 1.0 / (i + 1);
+				cumulativeWeights.push_back(total);
+			}
+
+			boost::uint32_t random = 12345;
+			unsigned int hits = 0;
+			unsigned long long fetchTime = 0;
+			for (unsigned int i = 0; i < iterations; i++) {
+				random ^= random << 13;
+				random ^= random >> 17;
+				random ^= random << 5;
+				double r = (random / 4294967296.0) * total;
+				unsigned int index = std::lower_bound(cumulativeWeights.begin(),
+					cumulativeWeights.end(), r) - cumulativeWeights.begin();
+				index = std::min<unsigned int>(index, keys.size() - 1);
+
+				unsigned long long startTime = getNsec();
+				ResponseCacheType::Entry entry(fetchEntry(keys[index]));
+				fetchTime += getNsec() - startTime;
+				if (entry.valid()) {
+					hits++;
+				} else {
+					storeEntry(keys[index], bodySize);
+				}
+			}
+			return make_pair(hits / (double) iterations, fetchTime / (double) iterations);
+		}
 	};
 
-	DEFINE_TEST_GROUP_WITH_LIMIT(Core_ResponseCacheTest, 100);
+	DEFINE_TEST_GROUP_WITH_LIMIT(Core_ResponseCacheTest, 110);
 
 
 	/***** Preparation *****/
@@ -571,4 +770,581 @@ namespace tut {
 		ResponseCacheType::Entry entry2(responseCache.fetch(&req, time(NULL)));
 		ensure("(22)", !entry2.valid());
 	}
+
+
+	/***** Stale entries *****/
+
+	TEST_METHOD(63) {
+		set_test_name("It parses stale-while-revalidate and stale-if-error from"
+			" the response's Cache-Control header");
+		vector<HashedStaticString> keys(createCacheKeys(2));
+
+		prepareForStoringWithStaleWindows();
+		ResponseCacheType::Entry entry(storeEntry(keys[0], 10));
+		ensure("(1)", entry.valid());
+		ensure_equals("(2)", entry.body->staleWhileRevalidate, 30u);
+		ensure_equals("(3)", entry.body->staleIfError, 60u);
+
+		prepareForStoring();
+		entry = storeEntry(keys[1], 10);
+		ensure("(4)", entry.valid());
+		ensure_equals("(5)", entry.body->staleWhileRevalidate, 0u);
+		ensure_equals("(6)", entry.body->staleIfError, 0u);
+	}
+
+	TEST_METHOD(64) {
+		set_test_name("Expired entries with a stale window are kept, and fetchStale()"
+			" only returns them within the window for the given purpose");
+		vector<HashedStaticString> keys(createCacheKeys(1));
+		time_t now = time(NULL);
+
+		prepareForStoringWithStaleWindows();
+		ensure("(1)", storeEntry(keys[0], 10).valid());
+		ensure("(2)", !responseCache.fetchStale(&req, now,
+			ResponseCacheType::STALE_WHILE_REVALIDATE).valid());
+
+		ResponseCacheType::Entry entry(responseCache.fetch(&req, now + 20));
+		ensure("(3)", !entry.valid());
+		ensure_equals("(4)", entry.cacheMissReason, ResponseCacheType::Entry::NOT_FRESH);
+		ensure_equals("(5)", responseCache.getEntryCount(), 1u);
+
+		ensure("(6)", responseCache.fetchStale(&req, now + 20,
+			ResponseCacheType::STALE_WHILE_REVALIDATE).valid());
+		ensure("(7)", !responseCache.fetchStale(&req, now + 50,
+			ResponseCacheType::STALE_WHILE_REVALIDATE).valid());
+		ensure("(8)", responseCache.fetchStale(&req, now + 50,
+			ResponseCacheType::STALE_IF_ERROR).valid());
+		ensure("(9)", !responseCache.fetchStale(&req, now + 80,
+			ResponseCacheType::STALE_IF_ERROR).valid());
+		ensure_equals("(10)", responseCache.getStaleHits(), 2u);
+
+		responseCache.fetch(&req, now + 80);
+		ensure_equals("(11)", responseCache.getEntryCount(), 0u);
+	}
+
+	TEST_METHOD(65) {
+		set_test_name("Expired entries without a stale window are dropped when fetched");
+		vector<HashedStaticString> keys(createCacheKeys(1));
+
+		prepareForStoring();
+		ensure("(1)", storeEntry(keys[0], 10).valid());
+		ResponseCacheType::Entry entry(responseCache.fetch(&req, time(NULL) + 100000));
+		ensure("(2)", !entry.valid());
+		ensure_equals("(3)", entry.cacheMissReason, ResponseCacheType::Entry::NOT_FRESH);
+		ensure_equals("(4)", responseCache.getEntryCount(), 0u);
+	}
+
+	TEST_METHOD(66) {
+		set_test_name("expireEntries() incrementally removes entries that are expired"
+			" and past their stale windows");
+		vector<HashedStaticString> keys(createCacheKeys(4));
+		time_t now = time(NULL);
+
+		prepareForStoringWithStaleWindows();
+		ensure("(1)", storeEntry(keys[0], 10).valid());
+		ensure("(2)", storeEntry(keys[1], 10).valid());
+		prepareForStoring();
+		ensure("(3)", storeEntry(keys[2], 10).valid());
+		ensure("(4)", storeEntry(keys[3], 10).valid());
+
+		ensure_equals("(5)", responseCache.expireEntries(now, 4), 0u);
+		ensure_equals("(6)", responseCache.expireEntries(now + 20, 4), 0u);
+		// Entries 0 and 1 expire after 10 seconds, but may be served
+		// stale for another 60 seconds. Only examine two slots at a time.
+		ensure_equals("(7)", responseCache.expireEntries(now + 100, 2), 2u);
+		ensure_equals("(8)", responseCache.getEntryCount(), 2u);
+		ensure_equals("(9)", responseCache.expireEntries(now + 100, 2), 0u);
+		ensure_equals("(10)", responseCache.expireEntries(now + 100000, 4), 2u);
+		ensure_equals("(11)", responseCache.getEntryCount(), 0u);
+		ensure_equals("(12)", responseCache.getExpirations(), 4u);
+	}
+
+
+	/***** Validators *****/
+
+	TEST_METHOD(67) {
+		set_test_name("requestIsNotModified() checks If-None-Match and If-Modified-Since"
+			" against the entry's validators");
+		vector<HashedStaticString> keys(createCacheKeys(2));
+
+		ResponseCacheType::Entry entry(storeEntryWithValidators(keys[0]));
+		ensure("(1)", entry.body->hasValidators);
+		ensure_equals("(2)", ResponseCacheType::lookupHeader(entry, "etag"), "\"abc\"");
+		ensure_equals("(3)", ResponseCacheType::lookupHeader(entry, "last-modified"),
+			"Sat, 01 Jan 2000 00:00:00 GMT");
+		ensure_equals("(4)", ResponseCacheType::lookupHeader(entry, "expires"), "");
+		ensure("(5)", !responseCache.requestIsNotModified(&req, entry));
+
+		insertReqHeader(createHeader("if-none-match", "\"xyz\", W/\"abc\""), req.pool);
+		ensure("(6)", responseCache.requestIsNotModified(&req, entry));
+		req.headers.clear();
+		insertReqHeader(createHeader("if-none-match", "*"), req.pool);
+		ensure("(7)", responseCache.requestIsNotModified(&req, entry));
+		req.headers.clear();
+		insertReqHeader(createHeader("if-none-match", "\"xyz\""), req.pool);
+		insertReqHeader(createHeader("if-modified-since", "Sat, 01 Jan 2000 00:00:00 GMT"),
+			req.pool);
+		ensure("(8)", !responseCache.requestIsNotModified(&req, entry));
+
+		req.headers.clear();
+		insertReqHeader(createHeader("if-modified-since", "Sun, 02 Jan 2000 00:00:00 GMT"),
+			req.pool);
+		ensure("(9)", responseCache.requestIsNotModified(&req, entry));
+		req.headers.clear();
+		insertReqHeader(createHeader("if-modified-since", "Fri, 31 Dec 1999 00:00:00 GMT"),
+			req.pool);
+		ensure("(10)", !responseCache.requestIsNotModified(&req, entry));
+
+		prepareForStoring();
+		entry = storeEntry(keys[1], 10);
+		ensure("(11)", !entry.body->hasValidators);
+		insertReqHeader(createHeader("if-none-match", "*"), req.pool);
+		ensure("(12)", !responseCache.requestIsNotModified(&req, entry));
+	}
+
+	TEST_METHOD(68) {
+		set_test_name("Expired entries with validators are kept for revalidation,"
+			" which turns the request into a conditional request");
+		vector<HashedStaticString> keys(createCacheKeys(1));
+		time_t now = time(NULL);
+
+		storeEntryWithValidators(keys[0]);
+		ensure("(1)", !responseCache.fetchForRevalidation(&req, now).valid());
+		ensure("(2)", !responseCache.fetch(&req, now + 20).valid());
+		ensure_equals("(3)", responseCache.getEntryCount(), 1u);
+
+		ensure("(4)", !responseCache.requestHasConditions(&req));
+		ResponseCacheType::Entry entry(responseCache.fetchForRevalidation(&req, now + 20));
+		ensure("(5)", entry.valid());
+		ResponseCacheType::Entry copy(ResponseCacheType::copyEntry(entry, req.pool));
+		responseCache.addRevalidationConditions(&req, copy);
+		ensure("(6)", responseCache.requestHasConditions(&req));
+		LString *value = req.headers.lookup("if-none-match");
+		ensure("(7)", value != NULL);
+		ensure_equals("(8)", StaticString(psg_lstr_make_contiguous(value, req.pool)
+			->start->data, value->size), "\"abc\"");
+		ensure("(9)", req.headers.lookup("if-modified-since") != NULL);
+
+		ensure("(10)", !responseCache.fetchForRevalidation(&req,
+			now + 10 + ResponseCacheType::REVALIDATION_WINDOW + 1).valid());
+		ensure_equals("(11)", responseCache.expireEntries(
+			now + 10 + ResponseCacheType::REVALIDATION_WINDOW + 1, 4), 1u);
+	}
+
+	TEST_METHOD(69) {
+		set_test_name("revalidate() renews the entry, and stores it again if it"
+			" was removed in the meantime");
+		vector<HashedStaticString> keys(createCacheKeys(1));
+		time_t now = time(NULL);
+
+		storeEntryWithValidators(keys[0]);
+		ResponseCacheType::Entry copy(ResponseCacheType::copyEntry(
+			responseCache.fetchForRevalidation(&req, now + 20), req.pool));
+
+		// The 304 response has no Cache-Control header, so the entry
+		// keeps its freshness lifetime of 10 seconds.
+		req.appResponse.headers.clear();
+		req.appResponse.statusCode = 304;
+		ResponseCacheType::Entry entry(responseCache.revalidate(&req, copy, now + 20));
+		ensure("(1)", entry.valid());
+		ensure("(2)", entry.body != copy.body);
+		ensure_equals("(3)", entry.body->expiryDate, now + 30);
+		ensure("(4)", responseCache.fetch(&req, now + 25).valid());
+
+		responseCache.clear();
+		insertAppResponseHeader(createHeader("cache-control", "max-age=100"), req.pool);
+		entry = responseCache.revalidate(&req, copy, now + 40);
+		ensure("(5)", entry.valid());
+		ensure_equals("(6)", responseCache.getEntryCount(), 1u);
+		ensure_equals("(7)", entry.body->expiryDate, now + 140);
+		ensure("(8)", entry.body->hasValidators);
+		ensure_equals("(9)", StaticString(entry.body->httpBodyData, entry.body->httpBodySize),
+			"body");
+		ensure("(10)", responseCache.fetch(&req, now + 100).valid());
+	}
+
+
+	/***** Memory budget and eviction *****/
+
+	TEST_METHOD(70) {
+		set_test_name("It can hold as many entries as fit in the memory budget");
+		vector<HashedStaticString> keys(createCacheKeys(1000));
+		prepareForStoring();
+		for (unsigned int i = 0; i < keys.size(); i++) {
+			ensure("(1)", storeEntry(keys[i], 100).valid());
+		}
+		ensure_equals("(2)", responseCache.getEntryCount(), 1000u);
+		ensure_equals("(3)", responseCache.getEvictions(), 0u);
+		for (unsigned int i = 0; i < keys.size(); i++) {
+			ResponseCacheType::Entry entry(fetchEntry(keys[i]));
+			ensure("(4)", entry.valid());
+			ensure_equals("(5)", StaticString(entry.body->key, entry.header->keySize),
+				StaticString(keys[i]));
+		}
+	}
+
+	TEST_METHOD(71) {
+		set_test_name("It evicts entries when the memory budget is exceeded");
+		vector<HashedStaticString> keys(createCacheKeys(100));
+		responseCache.configure(10000, 1000);
+		prepareForStoring();
+		for (unsigned int i = 0; i < keys.size(); i++) {
+			ensure("(1)", storeEntry(keys[i], 1000).valid());
+			ensure("(2)", responseCache.getMemoryUsage() <= 10000);
+		}
+		ensure("(3)", responseCache.getEntryCount() < 10);
+		ensure_equals("(4)", responseCache.getEvictions(),
+			100 - responseCache.getEntryCount());
+		ensure("(5)", !fetchEntry(keys[0]).valid());
+		ensure("(6)", fetchEntry(keys[99]).valid());
+	}
+
+	TEST_METHOD(72) {
+		set_test_name("Recently fetched entries get a second chance upon eviction");
+		vector<HashedStaticString> keys(createCacheKeys(5));
+		prepareForStoring();
+		ensure(storeEntry(keys[0], 1000).valid());
+		size_t entrySize = responseCache.getMemoryUsage();
+		responseCache.configure(entrySize * 4, 1000);
+		prepareForStoring();
+
+		for (unsigned int i = 0; i < 4; i++) {
+			ensure("(1)", storeEntry(keys[i], 1000).valid());
+		}
+		ensure("(2)", fetchEntry(keys[0]).valid());
+		ensure("(3)", storeEntry(keys[4], 1000).valid());
+		ensure_equals("(4)", responseCache.getEntryCount(), 4u);
+		ensure("(5)", fetchEntry(keys[0]).valid());
+		ensure("(6)", !fetchEntry(keys[1]).valid());
+		ensure("(7)", fetchEntry(keys[4]).valid());
+	}
+
+	TEST_METHOD(73) {
+		set_test_name("It refuses to store response bodies larger than the maximum body size");
+		vector<HashedStaticString> keys(createCacheKeys(2));
+		responseCache.configure(DEFAULT_TURBOCACHE_MAX_MEMORY, 100);
+		prepareForStoring();
+		ensure("(1)", !storeEntry(keys[0], 101).valid());
+		ensure("(2)", storeEntry(keys[1], 100).valid());
+		ensure_equals("(3)", responseCache.getEntryCount(), 1u);
+	}
+
+	TEST_METHOD(74) {
+		set_test_name("It refuses to store entries larger than the entire memory budget,"
+			" without evicting anything");
+		vector<HashedStaticString> keys(createCacheKeys(2));
+		responseCache.configure(2000, 10000);
+		prepareForStoring();
+		ensure("(1)", storeEntry(keys[0], 100).valid());
+		ensure("(2)", !storeEntry(keys[1], 5000).valid());
+		ensure_equals("(3)", responseCache.getEntryCount(), 1u);
+		ensure_equals("(4)", responseCache.getEvictions(), 0u);
+	}
+
+	TEST_METHOD(75) {
+		set_test_name("Storing an existing key replaces the entry");
+		vector<HashedStaticString> keys(createCacheKeys(1));
+		prepareForStoring();
+		ensure("(1)", storeEntry(keys[0], 100).valid());
+		size_t memoryUsage = responseCache.getMemoryUsage();
+		ResponseCacheType::Entry entry(storeEntry(keys[0], 200));
+		ensure("(2)", entry.valid());
+		ensure_equals("(3)", entry.body->httpBodySize, 200u);
+		ensure_equals("(4)", responseCache.getEntryCount(), 1u);
+		ensure_equals("(5)", responseCache.getMemoryUsage(), memoryUsage + 100);
+	}
+
+	TEST_METHOD(76) {
+		set_test_name("The index stays consistent under random stores and invalidations");
+		vector<HashedStaticString> keys(createCacheKeys(200));
+		set<unsigned int> stored;
+		boost::uint32_t random = 1;
+
+		prepareForStoring();
+		for (unsigned int i = 0; i < 5000; i++) {
+			random = random * 1103515245 + 12345;
+			unsigned int index = (random >> 8) % keys.size();
+			if ((random >> 4) & 1) {
+				ensure("(1)", storeEntry(keys[index], 10).valid());
+				stored.insert(index);
+			} else {
+				req.cacheKey = keys[index];
+				responseCache.invalidate(&req);
+				stored.erase(index);
+			}
+		}
+
+		ensure_equals("(2)", responseCache.getEntryCount(), (unsigned int) stored.size());
+		for (unsigned int i = 0; i < keys.size(); i++) {
+			ensure_equals("(3)", fetchEntry(keys[i]).valid(), stored.count(i) > 0);
+		}
+
+		responseCache.clear();
+		ensure_equals("(4)", responseCache.getMemoryUsage(), 0u);
+		ensure_equals("(5)", responseCache.getEntryCount(), 0u);
+	}
+
+	TEST_METHOD(80) {
+		set_test_name("Benchmark: hit ratio and fetch latency");
+		ONLY_RUN_IN_BENCHMARK_MODE();
+
+		unsigned int counts[] = { 8, 64, 512, 4096 };
+		for (unsigned int i = 0; i < sizeof(counts) / sizeof(unsigned int); i++) {
+			vector<HashedStaticString> keys(createCacheKeys(counts[i]));
+
+			// The budget of a cache that can hold 8 entries,
+			// like the fixed-size cache that we used to have.
+			responseCache.configure(DEFAULT_TURBOCACHE_MAX_MEMORY,
+				DEFAULT_TURBOCACHE_MAX_BODY_SIZE);
+			prepareForStoring();
+			storeEntry(keys[0], 1024);
+			size_t eightEntries = responseCache.getMemoryUsage() * 8;
+
+			responseCache.configure(eightEntries, DEFAULT_TURBOCACHE_MAX_BODY_SIZE);
+			prepareForStoring();
+			pair<double, double> smallResult = simulateWorkload(keys, 1024, 200000);
+
+			responseCache.configure(DEFAULT_TURBOCACHE_MAX_MEMORY,
+				DEFAULT_TURBOCACHE_MAX_BODY_SIZE);
+			prepareForStoring();
+			pair<double, double> defaultResult = simulateWorkload(keys, 1024, 200000);
+
+			fprintf(stderr, "%u endpoints: 8-entry budget: %.1f%% hits, %.0f ns/fetch;"
+				" default budget: %.1f%% hits, %.0f ns/fetch, %u entries\n",
+				counts[i],
+				smallResult.first * 100, smallResult.second,
+				defaultResult.first * 100, defaultResult.second,
+				responseCache.getEntryCount());
+		}
+	}
+
+
+	/***** Shared cache *****/
+
+	TEST_METHOD(90) {
+		set_test_name("Cache misses are looked up in the shared cache, and hits are"
+			" copied into the local cache");
+		SharedResponseCache sharedCache(1024 * 1024, 2);
+		ResponseCacheType otherCache;
+		vector<HashedStaticString> keys(createCacheKeys(1));
+		responseCache.setSharedCache(&sharedCache, 0);
+		otherCache.setSharedCache(&sharedCache, 1);
+
+		prepareForStoring();
+		ensure("(1)", storeAndPublishEntry(responseCache, keys[0], "hello").valid());
+		ensure_equals("(2)", sharedCache.getEntryCount(), 1u);
+
+		req.cacheKey = keys[0];
+		ResponseCacheType::Entry entry(otherCache.fetch(&req, time(NULL)));
+		ensure("(3)", entry.valid());
+		ensure_equals("(4)", StaticString(entry.body->httpHeaderData, entry.body->httpHeaderSize),
+			StaticString("header"));
+		ensure_equals("(5)", StaticString(entry.body->httpBodyData, entry.body->httpBodySize),
+			StaticString("hello"));
+		ensure_equals("(6)", otherCache.getHits(), 0u);
+		ensure_equals("(7)", otherCache.getSharedHits(), 1u);
+		ensure_equals("(8)", otherCache.getEntryCount(), 1u);
+
+		ensure("(10)", otherCache.fetch(&req, time(NULL)).valid());
+		ensure_equals("(11)", otherCache.getHits(), 1u);
+		ensure_equals("(12)", otherCache.getSharedFetches(), 1u);
+	}
+
+	TEST_METHOD(91) {
+		set_test_name("Invalidation is propagated to the shared cache");
+		SharedResponseCache sharedCache(1024 * 1024, 2);
+		ResponseCacheType otherCache;
+		vector<HashedStaticString> keys(createCacheKeys(1));
+		responseCache.setSharedCache(&sharedCache, 0);
+		otherCache.setSharedCache(&sharedCache, 1);
+
+		prepareForStoring();
+		ensure("(1)", storeAndPublishEntry(responseCache, keys[0], "hello").valid());
+		req.cacheKey = keys[0];
+		responseCache.invalidate(&req);
+		ensure_equals("(2)", sharedCache.getEntryCount(), 0u);
+		ensure("(3)", !otherCache.fetch(&req, time(NULL)).valid());
+		ensure_equals("(4)", otherCache.getSharedFetches(), 1u);
+		ensure_equals("(5)", otherCache.getSharedHits(), 0u);
+	}
+
+	TEST_METHOD(92) {
+		set_test_name("Entries in the shared cache that are no longer fresh are not used");
+		SharedResponseCache sharedCache(1024 * 1024, 2);
+		ResponseCacheType otherCache;
+		vector<HashedStaticString> keys(createCacheKeys(1));
+		responseCache.setSharedCache(&sharedCache, 0);
+		otherCache.setSharedCache(&sharedCache, 1);
+
+		prepareForStoring();
+		ensure("(1)", storeAndPublishEntry(responseCache, keys[0], "hello").valid());
+		req.cacheKey = keys[0];
+		ensure("(2)", !otherCache.fetch(&req, time(NULL) + 100000).valid());
+		ensure_equals("(3)", otherCache.getEntryCount(), 0u);
+	}
+
+	TEST_METHOD(93) {
+		set_test_name("Benchmark: hit ratio of 16 threads' caches while warming up,"
+			" with and without a shared cache");
+		ONLY_RUN_IN_BENCHMARK_MODE();
+
+		const unsigned int nthreads = 16;
+		vector<HashedStaticString> keys(createCacheKeys(512));
+		string body(1024, 'x');
+
+		for (int useSharedCache = 0; useSharedCache <= 1; useSharedCache++) {
+			SharedResponseCache sharedCache(DEFAULT_TURBOCACHE_SHARED_MAX_MEMORY, nthreads);
+			vector<ResponseCacheType *> caches;
+			for (unsigned int i = 0; i < nthreads; i++) {
+				caches.push_back(new ResponseCacheType());
+				if (useSharedCache) {
+					caches.back()->setSharedCache(&sharedCache, i);
+				}
+			}
+
+			prepareForStoring();
+			boost::uint32_t random = 12345;
+			unsigned int hits = 0, iterations = 50000;
+			unsigned long long fetchTime = 0;
+			for (unsigned int i = 0; i < iterations; i++) {
+				ResponseCacheType *cache = caches[i % nthreads];
+				random ^= random << 13;
+				random ^= random >> 17;
+				random ^= random << 5;
+				const HashedStaticString &key = keys[random % keys.size()];
+
+				req.cacheKey = key;
+				unsigned long long startTime = getNsec();
+				bool hit = cache->fetch(&req, time(NULL)).valid();
+				fetchTime += getNsec() - startTime;
+				if (hit) {
+					hits++;
+				} else {
+					storeAndPublishEntry(*cache, key, body);
+				}
+			}
+
+			fprintf(stderr, "%s: %.1f%% hits (%u requests reached the application),"
+				" %.0f ns/fetch\n",
+				useSharedCache ? "With shared cache" : "Without shared cache",
+				hits * 100.0 / iterations, iterations - hits,
+				fetchTime / (double) iterations);
+
+			for (unsigned int i = 0; i < nthreads; i++) {
+				delete caches[i];
+			}
+		}
+	}
+
+	TEST_METHOD(94) {
+		set_test_name("Stale windows are copied along with entries from the shared cache");
+		SharedResponseCache sharedCache(1024 * 1024, 2);
+		ResponseCacheType otherCache;
+		vector<HashedStaticString> keys(createCacheKeys(1));
+		responseCache.setSharedCache(&sharedCache, 0);
+		otherCache.setSharedCache(&sharedCache, 1);
+
+		prepareForStoringWithStaleWindows();
+		ensure("(1)", storeAndPublishEntry(responseCache, keys[0], "hello").valid());
+		req.cacheKey = keys[0];
+		ResponseCacheType::Entry entry(otherCache.fetch(&req, time(NULL)));
+		ensure("(2)", entry.valid());
+		ensure_equals("(3)", entry.body->staleWhileRevalidate, 30u);
+		ensure_equals("(4)", entry.body->staleIfError, 60u);
+	}
+
+
+	/***** Compression *****/
+
+	TEST_METHOD(100) {
+		set_test_name("ResponseCompressor compresses submitted data in the background");
+		ResponseCompressor compressor;
+		boost::container::vector<ResponseCompressor::Job> results;
+		string body = "{\"hello\": \"world\"}" + string(1000, ' ');
+
+		ensure("(1)", compressor.submit(3, 7, body));
+		EVENTUALLY(5,
+			compressor.takeResults(results);
+			result = !results.empty();
+		);
+		ensure_equals("(2)", results.size(), 1u);
+		ensure_equals("(3)", results[0].slot, 3u);
+		ensure_equals("(4)", results[0].entryId, 7u);
+		ensure("(5)", results[0].data.size() < body.size());
+		ensure_equals("(6)", gunzip(results[0].data), body);
+
+		// Incompressible data yields an empty result.
+		results.clear();
+		ensure("(7)", compressor.submit(3, 8, "x"));
+		EVENTUALLY(5,
+			compressor.takeResults(results);
+			result = !results.empty();
+		);
+		ensure_equals("(8)", results[0].data, "");
+	}
+
+	TEST_METHOD(101) {
+		set_test_name("isCompressible() accepts large enough, uncompressed, textual bodies");
+		vector<HashedStaticString> keys(createCacheKeys(4));
+		string body(1000, 'x');
+
+		prepareForStoring();
+		ensure("(1)", responseCache.isCompressible(storeEntryWithData(keys[0],
+			"HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n", body)));
+		ensure("(2)", !responseCache.isCompressible(storeEntryWithData(keys[1],
+			"HTTP/1.1 200 OK\r\nContent-Type: text/html\r\n", "small")));
+		ensure("(3)", !responseCache.isCompressible(storeEntryWithData(keys[2],
+			"HTTP/1.1 200 OK\r\nContent-Type: text/html\r\nContent-Encoding: br\r\n", body)));
+		ensure("(4)", !responseCache.isCompressible(storeEntryWithData(keys[3],
+			"HTTP/1.1 200 OK\r\nContent-Type: image/png\r\n", body)));
+	}
+
+	TEST_METHOD(102) {
+		set_test_name("setCompressedBody() attaches a compressed body to the entry,"
+			" within the memory budget, unless the entry was replaced");
+		vector<HashedStaticString> keys(createCacheKeys(1));
+		string body(1000, 'x');
+
+		prepareForStoring();
+		ResponseCacheType::Entry entry(storeEntryWithData(keys[0],
+			"HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\n", body));
+		size_t memoryUsage = responseCache.getMemoryUsage();
+		boost::uint32_t id = entry.body->id;
+		ensure("(1)", responseCache.setCompressedBody(entry.index, id, "compressed"));
+		ensure_equals("(2)", StaticString(entry.body->gzipBodyData, entry.body->gzipBodySize),
+			"compressed");
+		ensure_equals("(3)", responseCache.getMemoryUsage(), memoryUsage + 10);
+		ensure("(4)", !responseCache.setCompressedBody(entry.index, id, "compressed"));
+
+		entry = storeEntryWithData(keys[0], "HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\n",
+			body);
+		ensure_equals("(5)", responseCache.getMemoryUsage(), memoryUsage);
+		ensure("(6)", entry.body->gzipBodyData == NULL);
+		ensure("(7)", !responseCache.setCompressedBody(entry.index, id, "compressed"));
+		ensure("(8)", responseCache.setCompressedBody(entry.index, entry.body->id,
+			"compressed"));
+
+		responseCache.invalidate(&req);
+		ensure_equals("(9)", responseCache.getMemoryUsage(), 0u);
+	}
+
+	TEST_METHOD(103) {
+		set_test_name("requestAcceptsGzip() parses the Accept-Encoding header");
+		const char *accepted[] = { "gzip", "deflate, gzip", "gzip;q=0.5", "gzip; q=1",
+			"br, gzip ;q=0.01" };
+		const char *rejected[] = { "deflate", "gzip;q=0", "gzip; q=0.000", "identity" };
+
+		reset();
+		ensure("(1)", !responseCache.requestAcceptsGzip(&req));
+		for (unsigned int i = 0; i < sizeof(accepted) / sizeof(const char *); i++) {
+			req.headers.clear();
+			insertReqHeader(createHeader("accept-encoding", accepted[i]), req.pool);
+			ensure(accepted[i], responseCache.requestAcceptsGzip(&req));
+		}
+		for (unsigned int i = 0; i < sizeof(rejected) / sizeof(const char *); i++) {
+			req.headers.clear();
+			insertReqHeader(createHeader("accept-encoding", rejected[i]), req.pool);
+			ensure(rejected[i], !responseCache.requestAcceptsGzip(&req));
+		}
+	}
 }
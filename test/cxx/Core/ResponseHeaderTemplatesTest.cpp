@@ -0,0 +1,134 @@
+#include <TestSupport.h>
+#include <Core/Controller/ResponseHeaderTemplates.h>
+#include <MemoryKit/palloc.h>
+#include <Constants.h>
+#include <cstdio>
+#include <ctime>
+#include <string>
+
+using namespace Passenger;
+using namespace Passenger::Core;
+using namespace std;
+
+namespace tut {
+	struct Core_ResponseHeaderTemplatesTest {
+		ResponseHeaderTemplates templates;
+		psg_pool_t *pool;
+
+		Core_ResponseHeaderTemplatesTest() {
+			pool = psg_create_pool(PSG_DEFAULT_POOL_SIZE);
+		}
+
+		~Core_ResponseHeaderTemplatesTest() {
+			psg_destroy_pool(pool);
+		}
+
+		static string createDateHeader(time_t time) {
+			struct tm tm;
+			char buf[64];
+			gmtime_r(&time, &tm);
+			size_t size = strftime(buf, sizeof(buf), "Date: %a, %d %b %Y %H:%M:%S GMT\r\n", &tm);
+			return string(buf, size);
+		}
+
+		static unsigned long long getNsec() {
+			struct timespec ts;
+			clock_gettime(CLOCK_MONOTONIC, &ts);
+			return (unsigned long long) ts.tv_sec * 1000000000 + ts.tv_nsec;
+		}
+	};
+
+	DEFINE_TEST_GROUP(Core_ResponseHeaderTemplatesTest);
+
+	TEST_METHOD(1) {
+		set_test_name("Status lines for HTTP/1.0 and HTTP/1.1 are interned");
+		StaticString line = templates.getStatusLine(pool, 1, 1, 200);
+		ensure_equals(line, "HTTP/1.1 200 OK\r\nStatus: 200 OK\r\n");
+		ensure_equals<const void *>("Interned",
+			templates.getStatusLine(pool, 1, 1, 200).data(), line.data());
+
+		ensure_equals(templates.getStatusLine(pool, 1, 0, 404),
+			"HTTP/1.0 404 Not Found\r\nStatus: 404 Not Found\r\n");
+		ensure_equals(templates.getStatusLine(pool, 1, 1, 299),
+			"HTTP/1.1 299 Unknown Reason-Phrase\r\nStatus: 299\r\n");
+		ensure_equals<const void *>("Interned unknown status code",
+			templates.getStatusLine(pool, 1, 1, 299).data(),
+			templates.getStatusLine(pool, 1, 1, 299).data());
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("Status lines for other HTTP versions and status codes are"
+			" formatted into the given pool");
+		ensure_equals(templates.getStatusLine(pool, 2, 0, 200),
+			"HTTP/2.0 200 OK\r\nStatus: 200 OK\r\n");
+		ensure(templates.getStatusLine(pool, 2, 0, 200).data()
+			!= templates.getStatusLine(pool, 2, 0, 200).data());
+		ensure_equals(templates.getStatusLine(pool, 1, 1, 999),
+			"HTTP/1.1 999 Unknown Reason-Phrase\r\nStatus: 999\r\n");
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("The Date header is only reformatted when the time reaches the next second");
+		time_t now = 1500000000;
+		StaticString date = templates.getDateHeader(now + 0.1);
+		ensure_equals(date, createDateHeader(now));
+
+		StaticString date2 = templates.getDateHeader(now + 0.9);
+		ensure_equals<const void *>(date2.data(), date.data());
+		ensure_equals(date2, createDateHeader(now));
+
+		StaticString date3 = templates.getDateHeader(now + 1);
+		ensure_equals<const void *>("The buffer is reused", date3.data(), date.data());
+		ensure_equals("The length stays the same", date3.size(), date.size());
+		ensure_equals(date3, createDateHeader(now + 1));
+	}
+
+	TEST_METHOD(4) {
+		set_test_name("getHeaderEnd() returns the Connection header, the X-Powered-By"
+			" header and an empty line");
+		ensure_equals(ResponseHeaderTemplates::getHeaderEnd(
+				ResponseHeaderTemplates::NO_CONNECTION_HEADER, false),
+			"X-Powered-By: " PROGRAM_NAME "\r\n\r\n");
+		ensure_equals(ResponseHeaderTemplates::getHeaderEnd(
+				ResponseHeaderTemplates::CONNECTION_KEEP_ALIVE, false),
+			"Connection: keep-alive\r\nX-Powered-By: " PROGRAM_NAME "\r\n\r\n");
+		ensure_equals(ResponseHeaderTemplates::getHeaderEnd(
+				ResponseHeaderTemplates::CONNECTION_CLOSE, true),
+			"Connection: close\r\nX-Powered-By: " PROGRAM_NAME " " PASSENGER_VERSION "\r\n\r\n");
+		ensure_equals(ResponseHeaderTemplates::getHeaderEnd(
+				ResponseHeaderTemplates::CONNECTION_UPGRADE, false),
+			"Connection: upgrade\r\nX-Powered-By: " PROGRAM_NAME "\r\n\r\n");
+	}
+
+	TEST_METHOD(5) {
+		set_test_name("Benchmark: formatting the status line and Date header for every"
+			" response, versus using the templates");
+		ONLY_RUN_IN_BENCHMARK_MODE();
+
+		const unsigned int iterations = 2000000;
+		ev_tstamp now = 1500000000;
+		unsigned int total = 0;
+		unsigned long long startTime, duration;
+
+		startTime = getNsec();
+		for (unsigned int i = 0; i < iterations; i++) {
+			total += ResponseHeaderTemplates::formatStatusLine(pool, 1, 1, 200).size();
+			total += createDateHeader((time_t) (now + i / 1000000.0)).size();
+			if (i % 1000 == 0) {
+				psg_reset_pool(pool, PSG_DEFAULT_POOL_SIZE);
+			}
+		}
+		duration = getNsec() - startTime;
+		fprintf(stderr, "Formatting every time: %.1f ns per response\n",
+			duration / (double) iterations);
+
+		startTime = getNsec();
+		for (unsigned int i = 0; i < iterations; i++) {
+			total += templates.getStatusLine(pool, 1, 1, 200).size();
+			total += templates.getDateHeader(now + i / 1000000.0).size();
+		}
+		duration = getNsec() - startTime;
+		fprintf(stderr, "Templates:             %.1f ns per response (%u)\n",
+			duration / (double) iterations, total & 1);
+	}
+}
@@ -0,0 +1,177 @@
+#include <TestSupport.h>
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+#include <boost/atomic.hpp>
+#include <vector>
+#include <Core/SharedResponseCache.h>
+
+using namespace Passenger;
+using namespace std;
+
+namespace tut {
+	struct Core_SharedResponseCacheTest {
+		SharedResponseCache *cache;
+		vector<string> keys;
+		boost::atomic<bool> done;
+		boost::atomic<unsigned int> corruptions;
+		boost::atomic<unsigned int> lookups;
+
+		Core_SharedResponseCacheTest()
+			: cache(new SharedResponseCache(1024 * 1024, 4)),
+			  done(false),
+			  corruptions(0),
+			  lookups(0)
+		{
+			for (unsigned int i = 0; i < 200; i++) {
+				keys.push_back("key" + toString(i));
+			}
+		}
+
+		~Core_SharedResponseCacheTest() {
+			delete cache;
+		}
+
+		static string bodyFor(const string &key, unsigned int size) {
+			string result;
+			while (result.size() < size) {
+				result.append(key);
+			}
+			result.resize(size);
+			return result;
+		}
+
+		bool store(unsigned int i, unsigned int bodySize = 100) {
+			return cache->store(keys[i], 1, time(NULL) + 1000, "header",
+				bodyFor(keys[i], bodySize));
+		}
+
+		bool contains(unsigned int i, unsigned int reader = 0) {
+			SharedResponseCache::ReadGuard guard(cache, reader);
+			return cache->lookup(keys[i]) != NULL;
+		}
+
+		void lookupContinuously(unsigned int reader) {
+			unsigned int i = reader;
+			while (!done.load(boost::memory_order_relaxed)) {
+				SharedResponseCache::ReadGuard guard(cache, reader);
+				const string &key = keys[i % keys.size()];
+				const SharedResponseCache::Entry *entry = cache->lookup(key);
+				if (entry != NULL) {
+					StaticString body = entry->getHttpBodyData();
+					if (entry->getKey() != key
+					 || entry->getHttpHeaderData() != "header"
+					 || body != bodyFor(key, body.size()))
+					{
+						corruptions.fetch_add(1, boost::memory_order_relaxed);
+					}
+				}
+				lookups.fetch_add(1, boost::memory_order_relaxed);
+				i += 7;
+			}
+		}
+	};
+
+	DEFINE_TEST_GROUP(Core_SharedResponseCacheTest);
+
+	TEST_METHOD(1) {
+		set_test_name("Stored entries can be looked up");
+		ensure("(1)", store(0));
+		SharedResponseCache::ReadGuard guard(cache, 0);
+		const SharedResponseCache::Entry *entry = cache->lookup(keys[0]);
+		ensure("(2)", entry != NULL);
+		ensure_equals("(3)", entry->getKey(), StaticString(keys[0]));
+		ensure_equals("(4)", entry->getHttpHeaderData(), StaticString("header"));
+		ensure_equals("(5)", entry->getHttpBodyData(), StaticString(bodyFor(keys[0], 100)));
+		ensure("(6)", cache->lookup(keys[1]) == NULL);
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("Storing an existing key replaces the entry");
+		ensure("(1)", store(0, 100));
+		ensure("(2)", store(0, 200));
+		ensure_equals("(3)", cache->getEntryCount(), 1u);
+		SharedResponseCache::ReadGuard guard(cache, 0);
+		ensure_equals("(4)", cache->lookup(keys[0])->getHttpBodyData().size(), 200u);
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("Invalidation removes the entry and preserves other entries");
+		for (unsigned int i = 0; i < keys.size(); i++) {
+			ensure("(1)", store(i));
+		}
+		for (unsigned int i = 0; i < keys.size(); i += 2) {
+			cache->invalidate(keys[i]);
+		}
+		ensure_equals("(2)", cache->getEntryCount(), (unsigned int) keys.size() / 2);
+		for (unsigned int i = 0; i < keys.size(); i++) {
+			ensure_equals("(3)", contains(i), i % 2 == 1);
+		}
+	}
+
+	TEST_METHOD(4) {
+		set_test_name("It evicts entries that have not been looked up recently"
+			" when the memory budget is exceeded");
+		delete cache;
+		cache = new SharedResponseCache(4000, 1);
+		for (unsigned int i = 0; i < 3; i++) {
+			ensure("(1)", store(i, 1000));
+		}
+		ensure("(2)", contains(0));
+		ensure("(3)", contains(2));
+		ensure("(4)", store(3, 1000));
+		ensure_equals("(5)", cache->getEvictions(), 1u);
+		ensure("(6)", cache->getMemoryUsage() <= 4000);
+		ensure("(7)", contains(0));
+		ensure("(8)", !contains(1));
+		ensure("(9)", contains(2));
+		ensure("(10)", contains(3));
+		ensure("(11)", !store(4, 5000));
+	}
+
+	TEST_METHOD(5) {
+		set_test_name("Unlinked entries are not freed while a reader may still access them");
+		ensure("(1)", store(0));
+		{
+			SharedResponseCache::ReadGuard guard(cache, 1);
+			const SharedResponseCache::Entry *entry = cache->lookup(keys[0]);
+			ensure("(2)", entry != NULL);
+			cache->invalidate(keys[0]);
+			ensure_equals("(3)", cache->getRetiredEntryCount(), 1u);
+			ensure_equals("(4)", entry->getKey(), StaticString(keys[0]));
+		}
+		cache->invalidate(keys[1]);
+		ensure_equals("(5)", cache->getRetiredEntryCount(), 0u);
+	}
+
+	TEST_METHOD(6) {
+		set_test_name("Readers never observe freed or partially written entries"
+			" while writers modify the cache concurrently");
+		delete cache;
+		// Small enough to cause lots of evictions.
+		cache = new SharedResponseCache(50000, 4);
+
+		boost::thread_group threads;
+		for (unsigned int i = 0; i < 4; i++) {
+			threads.create_thread(boost::bind(
+				&Core_SharedResponseCacheTest::lookupContinuously, this, i));
+		}
+		for (unsigned int i = 0; i < 20000; i++) {
+			unsigned int index = (i * 31) % keys.size();
+			if (i % 3 == 0) {
+				cache->invalidate(keys[index]);
+			} else {
+				store(index, 50 + i % 1000);
+			}
+		}
+		EVENTUALLY(5,
+			result = lookups.load() > 1000;
+		);
+		done.store(true);
+		threads.join_all();
+
+		ensure_equals("(1)", corruptions.load(), 0u);
+		ensure("(2)", cache->getMemoryUsage() <= 50000);
+		cache->invalidate(keys[0]);
+		ensure_equals("(3)", cache->getRetiredEntryCount(), 0u);
+	}
+}
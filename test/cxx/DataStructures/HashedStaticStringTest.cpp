@@ -0,0 +1,240 @@
+#include <TestSupport.h>
+#include <DataStructures/HashedStaticString.h>
+#include <DataStructures/LString.h>
+#include <Utils/Hasher.h>
+#include <Utils/StrIntUtils.h>
+#include <boost/cstdint.hpp>
+#include <cstdio>
+#include <ctime>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace Passenger;
+using namespace std;
+
+namespace tut {
+	struct DataStructures_HashedStaticStringTest {
+		boost::uint32_t randomState;
+
+		DataStructures_HashedStaticStringTest()
+			: randomState(1234)
+			{ }
+
+		/** A deterministic pseudo-random number generator, so that failures are reproducible. */
+		unsigned int random(unsigned int max) {
+			randomState = randomState * 1103515245 + 12345;
+			return (randomState >> 16) % max;
+		}
+
+		string randomString(unsigned int size) {
+			string result;
+			for (unsigned int i = 0; i < size; i++) {
+				result.append(1, (char) random(256));
+			}
+			return result;
+		}
+
+		template<typename HashType>
+		static boost::uint32_t hashString(const string &str) {
+			HashType h;
+			h.update(str.data(), str.size());
+			return h.finalize();
+		}
+
+		/**
+		 * Returns a few families of keys like the ones that Passenger hashes:
+		 * header names, turbocache keys and app group names.
+		 */
+		static vector<string> createRealisticKeys() {
+			vector<string> keys;
+			for (unsigned int i = 0; i < 20000; i++) {
+				keys.push_back("x-custom-header-" + toString(i));
+				keys.push_back("Ghttps://www.example.com/users/" + toString(i) + "/profile");
+				keys.push_back("/var/www/app" + toString(i) + " (production)");
+				keys.push_back(toString(i));
+			}
+			return keys;
+		}
+
+		/**
+		 * Distributes the hashes' lowest bits over 1024 buckets, like
+		 * HeaderTable and StringKeyTable do, and returns the chi-squared
+		 * statistic against a uniform distribution. For a good hash it's
+		 * about 1023, with a standard deviation of about 45.
+		 */
+		template<typename HashType>
+		static double calculateChiSquared(const vector<string> &keys) {
+			vector<unsigned int> buckets(1024, 0);
+			for (unsigned int i = 0; i < keys.size(); i++) {
+				buckets[hashString<HashType>(keys[i]) % 1024]++;
+			}
+
+			double expected = keys.size() / 1024.0;
+			double result = 0;
+			for (unsigned int i = 0; i < buckets.size(); i++) {
+				result += (buckets[i] - expected) * (buckets[i] - expected) / expected;
+			}
+			return result;
+		}
+
+		template<typename HashType>
+		static unsigned int countCollisions(const vector<string> &keys) {
+			set<boost::uint32_t> hashes;
+			unsigned int collisions = 0;
+			for (unsigned int i = 0; i < keys.size(); i++) {
+				if (!hashes.insert(hashString<HashType>(keys[i])).second) {
+					collisions++;
+				}
+			}
+			return collisions;
+		}
+
+		template<typename HashType>
+		void benchmarkThroughput(const char *name, unsigned int size) {
+			const unsigned long long totalBytes = 200 * 1024 * 1024;
+			unsigned int iterations = totalBytes / size;
+			string input = randomString(size);
+			boost::uint32_t result = 0;
+
+			unsigned long long startTime = getNsec();
+			for (unsigned int i = 0; i < iterations; i++) {
+				HashType h;
+				input[0] = (char) i;
+				h.update(input.data(), size);
+				result ^= h.finalize();
+			}
+			unsigned long long duration = getNsec() - startTime;
+			fprintf(stderr, "%-11s %4u bytes: %6.1f ns per hash, %5.0f MB/s (%u)\n",
+				name, size, duration / (double) iterations,
+				totalBytes / (duration / 1000.0), result & 1);
+		}
+
+		static unsigned long long getNsec() {
+			struct timespec ts;
+			clock_gettime(CLOCK_MONOTONIC, &ts);
+			return (unsigned long long) ts.tv_sec * 1000000000 + ts.tv_nsec;
+		}
+	};
+
+	DEFINE_TEST_GROUP(DataStructures_HashedStaticStringTest);
+
+	TEST_METHOD(1) {
+		set_test_name("The hash of an empty string is EMPTY_STRING_HASH");
+		ensure_equals(HashedStaticString().hash(), Hasher::EMPTY_STRING_HASH);
+		ensure_equals(HashedStaticString("").hash(), Hasher::EMPTY_STRING_HASH);
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("The hash doesn't depend on how the input is split over update() calls");
+
+		for (unsigned int size = 0; size < 40; size++) {
+			string input = randomString(size);
+			boost::uint32_t expected = HashedStaticString(input).hash();
+
+			for (unsigned int i = 0; i <= size; i++) {
+				for (unsigned int j = i; j <= size; j++) {
+					Hasher h;
+					h.update(input.data(), i);
+					h.update(input.data() + i, j - i);
+					h.update(input.data() + j, size - j);
+					ensure_equals(("Size " + toString(size) + ", split at " + toString(i)
+						+ " and " + toString(j)).c_str(), h.finalize(), expected);
+				}
+			}
+		}
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("The hash of an LString equals the hash of its contents");
+		psg_pool_t *pool = psg_create_pool(PSG_DEFAULT_POOL_SIZE);
+		LString str;
+
+		psg_lstr_init(&str);
+		psg_lstr_append(&str, pool, "x-forw");
+		psg_lstr_append(&str, pool, "arded-");
+		psg_lstr_append(&str, pool, "f");
+		psg_lstr_append(&str, pool, "or");
+		ensure_equals(psg_lstr_hash(&str), HashedStaticString("x-forwarded-for").hash());
+		psg_destroy_pool(pool);
+	}
+
+	TEST_METHOD(4) {
+		set_test_name("updateLowerCase() gives the same hash as update() on the"
+			" output of convertLowerCase()");
+
+		for (unsigned int i = 0; i < 2000; i++) {
+			unsigned int size = random(40);
+			string input = randomString(size);
+			string lowerCase(size, '\0');
+			unsigned int split = random(size + 1);
+
+			if (i % 2 == 0) {
+				// Mostly letters, like header names.
+				for (unsigned int j = 0; j < size; j++) {
+					input[j] = "AZaz@[`{-Mm"[random(11)];
+				}
+			}
+			convertLowerCase((const unsigned char *) input.data(),
+				(unsigned char *) &lowerCase[0], size);
+
+			Hasher h;
+			h.updateLowerCase(input.data(), split);
+			h.updateLowerCase(input.data() + split, size - split);
+			ensure_equals(h.finalize(), HashedStaticString(lowerCase).hash());
+		}
+	}
+
+	TEST_METHOD(5) {
+		set_test_name("The hash distributes realistic keys uniformly over hash table buckets");
+		vector<string> keys = createRealisticKeys();
+
+		ensure("Chi-squared", calculateChiSquared<Hasher>(keys) < 1023 + 6 * 45);
+		// About 0.75 collisions are expected among 80000 random 32-bit values.
+		ensure("Collisions", countCollisions<Hasher>(keys) <= 8);
+	}
+
+	TEST_METHOD(6) {
+		set_test_name("Flipping any input bit flips each output bit with a probability of about 50%");
+		const unsigned int iterations = 1000;
+		const unsigned int size = 16;
+		vector<unsigned int> flips(size * 8 * 32, 0);
+
+		for (unsigned int i = 0; i < iterations; i++) {
+			string input = randomString(size);
+			boost::uint32_t hash = hashString<Hasher>(input);
+
+			for (unsigned int bit = 0; bit < size * 8; bit++) {
+				input[bit / 8] ^= 1 << (bit % 8);
+				boost::uint32_t diff = hash ^ hashString<Hasher>(input);
+				input[bit / 8] ^= 1 << (bit % 8);
+				for (unsigned int outputBit = 0; outputBit < 32; outputBit++) {
+					flips[bit * 32 + outputBit] += (diff >> outputBit) & 1;
+				}
+			}
+		}
+
+		for (unsigned int i = 0; i < flips.size(); i++) {
+			double probability = flips[i] / (double) iterations;
+			ensure(("Input bit " + toString(i / 32) + ", output bit " + toString(i % 32)
+				+ ": " + toString(probability)).c_str(),
+				probability > 0.4 && probability < 0.6);
+		}
+	}
+
+	TEST_METHOD(7) {
+		set_test_name("Benchmark: hash quality and throughput, JenkinsHash versus MumHash");
+		ONLY_RUN_IN_BENCHMARK_MODE();
+		vector<string> keys = createRealisticKeys();
+		unsigned int sizes[] = { 4, 10, 16, 32, 64, 256, 4096 };
+
+		fprintf(stderr, "JenkinsHash: chi-squared %.0f, %u collisions\n",
+			calculateChiSquared<JenkinsHash>(keys), countCollisions<JenkinsHash>(keys));
+		fprintf(stderr, "MumHash:     chi-squared %.0f, %u collisions\n",
+			calculateChiSquared<MumHash>(keys), countCollisions<MumHash>(keys));
+		for (unsigned int i = 0; i < sizeof(sizes) / sizeof(unsigned int); i++) {
+			benchmarkThroughput<JenkinsHash>("JenkinsHash", sizes[i]);
+			benchmarkThroughput<MumHash>("MumHash", sizes[i]);
+		}
+	}
+}
@@ -0,0 +1,182 @@
+#include <TestSupport.h>
+#include <vector>
+#include <cstdlib>
+#include <cstdio>
+#include <DataStructures/IndexedMinHeap.h>
+#include <Utils/SystemTime.h>
+
+using namespace Passenger;
+using namespace std;
+
+namespace tut {
+	struct DataStructures_IndexedMinHeapTest {
+		IndexedMinHeap<int> heap;
+
+		// The linear scan that IndexedMinHeap replaces in Group.
+		static unsigned int findLowest(const vector<int> &levels) {
+			unsigned int result = 0;
+			for (unsigned int i = 1; i < levels.size(); i++) {
+				if (levels[i] < levels[result]) {
+					result = i;
+				}
+			}
+			return result;
+		}
+
+		/**
+		 * Simulates routing requests to the least busy of `nprocesses` processes:
+		 * every iteration picks the least busy process, increases its busyness
+		 * and decreases the busyness of a random process. Returns the number
+		 * of nanoseconds per iteration.
+		 */
+		double benchmarkRouting(unsigned int nprocesses, bool useHeap) {
+			const unsigned int iterations = 2000000;
+			vector<int> levels(nprocesses, 0);
+			IndexedMinHeap<int> heap;
+			unsigned int i;
+
+			for (i = 0; i < nprocesses; i++) {
+				heap.push_back(0);
+			}
+			srand(1234);
+
+			unsigned long long startTime = SystemTime::getMonotonicUsec();
+			for (i = 0; i < iterations; i++) {
+				unsigned int selected, other;
+				if (useHeap) {
+					selected = heap.top();
+					heap.set(selected, heap[selected] + 1);
+					other = rand() % nprocesses;
+					if (heap[other] > 0) {
+						heap.set(other, heap[other] - 1);
+					}
+				} else {
+					selected = findLowest(levels);
+					levels[selected]++;
+					other = rand() % nprocesses;
+					if (levels[other] > 0) {
+						levels[other]--;
+					}
+				}
+			}
+			unsigned long long endTime = SystemTime::getMonotonicUsec();
+			return (endTime - startTime) * 1000.0 / iterations;
+		}
+	};
+
+	DEFINE_TEST_GROUP(DataStructures_IndexedMinHeapTest);
+
+	TEST_METHOD(1) {
+		set_test_name("top() returns the element with the smallest key");
+
+		heap.push_back(5);
+		ensure_equals(heap.top(), 0u);
+		heap.push_back(3);
+		heap.push_back(8);
+		heap.push_back(1);
+		heap.push_back(4);
+		ensure_equals(heap.size(), 5u);
+		ensure_equals(heap.top(), 3u);
+		ensure_equals(heap[2], 8);
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("top() returns the element with the lowest index"
+			" if multiple elements have the smallest key");
+
+		heap.push_back(2);
+		heap.push_back(1);
+		heap.push_back(3);
+		heap.push_back(1);
+		heap.push_back(1);
+		ensure_equals(heap.top(), 1u);
+		heap.set(1, 5);
+		ensure_equals(heap.top(), 3u);
+		heap.set(0, 1);
+		ensure_equals(heap.top(), 0u);
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("set() updates the position of the element in the heap");
+
+		for (int i = 0; i < 10; i++) {
+			heap.push_back(i);
+		}
+		heap.set(0, 20);
+		ensure_equals(heap.top(), 1u);
+		heap.set(9, -1);
+		ensure_equals(heap.top(), 9u);
+		heap.set(9, 100);
+		ensure_equals(heap.top(), 1u);
+		ensure_equals(heap[0], 20);
+		ensure_equals(heap[9], 100);
+	}
+
+	TEST_METHOD(4) {
+		set_test_name("erase() removes the element and shifts the indices"
+			" of subsequent elements");
+
+		heap.push_back(4);
+		heap.push_back(0);
+		heap.push_back(2);
+		heap.push_back(1);
+		heap.erase(1);
+		ensure_equals(heap.size(), 3u);
+		ensure_equals(heap[0], 4);
+		ensure_equals(heap[1], 2);
+		ensure_equals(heap[2], 1);
+		ensure_equals(heap.top(), 2u);
+		heap.set(0, 0);
+		ensure_equals(heap.top(), 0u);
+	}
+
+	TEST_METHOD(5) {
+		set_test_name("It always agrees with a linear scan, also when the number of"
+			" elements crosses LINEAR_SCAN_THRESHOLD");
+
+		vector<int> levels;
+		unsigned int i, j;
+		srand(5678);
+
+		for (i = 0; i < 4; i++) {
+			// Grow beyond the threshold, then shrink below it.
+			unsigned int targetSize = (i % 2 == 0)
+				? IndexedMinHeap<int>::LINEAR_SCAN_THRESHOLD * 2
+				: IndexedMinHeap<int>::LINEAR_SCAN_THRESHOLD / 2;
+			while (levels.size() != targetSize) {
+				if (levels.size() < targetSize) {
+					int key = rand() % 10;
+					levels.push_back(key);
+					heap.push_back(key);
+				} else {
+					unsigned int index = rand() % levels.size();
+					levels.erase(levels.begin() + index);
+					heap.erase(index);
+				}
+				ensure_equals(heap.size(), (unsigned int) levels.size());
+				ensure_equals(heap.top(), findLowest(levels));
+			}
+
+			for (j = 0; j < 2000; j++) {
+				unsigned int index = rand() % levels.size();
+				int key = rand() % 10;
+				levels[index] = key;
+				heap.set(index, key);
+				ensure_equals(heap.top(), findLowest(levels));
+			}
+		}
+	}
+
+	TEST_METHOD(6) {
+		set_test_name("Benchmark: least busy process selection with 8, 64 and 512 processes");
+		ONLY_RUN_IN_BENCHMARK_MODE();
+
+		unsigned int counts[] = { 8, 64, 512 };
+		for (unsigned int i = 0; i < sizeof(counts) / sizeof(unsigned int); i++) {
+			fprintf(stderr, "%u processes: linear scan %.1f ns, IndexedMinHeap %.1f ns per route\n",
+				counts[i],
+				benchmarkRouting(counts[i], false),
+				benchmarkRouting(counts[i], true));
+		}
+	}
+}
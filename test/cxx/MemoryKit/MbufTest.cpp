@@ -264,4 +264,134 @@ namespace tut {
 		ensure_equals("(5)", pool.nfree_mbuf_blockq, 0u);
 		ensure_equals("(6)", pool.nactive_mbuf_blockq, 0u);
 	}
+
+	TEST_METHOD(24) {
+		set_test_name("mbuf_get_with_size uses the large size class if enabled");
+		mbuf_pool_enable_large_blocks(&pool, DEFAULT_MBUF_LARGE_CHUNK_SIZE);
+		ensure_equals("(1)", mbuf_pool_large_data_size(&pool),
+			DEFAULT_MBUF_LARGE_CHUNK_SIZE - MBUF_BLOCK_HSIZE);
+
+		struct mbuf_block *block;
+		{
+			mbuf buffer(mbuf_get_with_size(&pool, mbuf_pool_data_size(&pool) + 10));
+			block = buffer.mbuf_block;
+			ensure_equals("(2)", pool.nactive_mbuf_blockq, 1u);
+			ensure_equals("(3)", pool.nactive_large_mbuf_blockq, 1u);
+			ensure_equals("(4)", buffer.size(), mbuf_pool_data_size(&pool) + 10);
+			ensure_equals("(5)", (size_t) (block->end - block->start),
+				mbuf_pool_large_data_size(&pool));
+		}
+		ensure_equals("(6)", pool.nfree_mbuf_blockq, 1u);
+		ensure_equals("(7)", pool.nfree_large_mbuf_blockq, 1u);
+		ensure_equals("(8)", pool.nactive_mbuf_blockq, 0u);
+		ensure_equals("(9)", pool.nactive_large_mbuf_blockq, 0u);
+
+		{
+			mbuf small(mbuf_get_with_size(&pool, 10));
+			ensure("(10)", small.mbuf_block != block);
+			ensure_equals("(11)", pool.nfree_large_mbuf_blockq, 1u);
+
+			mbuf large(mbuf_get_with_size(&pool, mbuf_pool_large_data_size(&pool)));
+			ensure_equals("(12)", large.mbuf_block, block);
+			ensure_equals("(13)", pool.nfree_large_mbuf_blockq, 0u);
+
+			mbuf standalone(mbuf_get_with_size(&pool, mbuf_pool_large_data_size(&pool) + 1));
+			ensure("(14)", standalone.mbuf_block->offset > 0);
+			ensure_equals("(15)", pool.nactive_large_mbuf_blockq, 1u);
+		}
+		ensure_equals("(16)", pool.nfree_mbuf_blockq, 2u);
+		ensure_equals("(17)", pool.nfree_large_mbuf_blockq, 1u);
+		ensure_equals("(18)", mbuf_pool_compact(&pool), 2u);
+		ensure_equals("(19)", pool.nfree_large_mbuf_blockq, 0u);
+	}
+
+	TEST_METHOD(25) {
+		set_test_name("Blocks are carved out of slabs if enabled");
+		mbuf_pool_enable_slabs(&pool);
+
+		struct mbuf_block *block = mbuf_block_get(&pool);
+		struct mbuf_block *block2 = mbuf_block_get(&pool);
+		ensure_equals("(1)", pool.nslabs, 1u);
+		ensure("(2)", block->slab != NULL);
+		ensure_equals("(3)", block2->slab, block->slab);
+		ensure_equals("(4)", (size_t) block->start % MBUF_SLAB_SIZE, (size_t) 0);
+		ensure_equals("(5)", block2->start, block->start + pool.mbuf_block_chunk_size);
+		ensure_equals("(6)", (size_t) (block->end - block->start), mbuf_pool_data_size(&pool));
+
+		mbuf_block_unref(block);
+		ensure_equals("(7)", pool.nfree_mbuf_blockq, 1u);
+		ensure_equals("(8)", pool.nactive_mbuf_blockq, 1u);
+		ensure_equals("(9)", mbuf_block_get(&pool), block);
+		ensure_equals("(10)", pool.nfree_mbuf_blockq, 0u);
+
+		mbuf_block_unref(block);
+		mbuf_block_unref(block2);
+		ensure_equals("(11)", pool.nfree_mbuf_blockq, 2u);
+		ensure_equals("(12)", pool.nslabs, 1u);
+		ensure_equals("(13)", mbuf_pool_compact(&pool), 2u);
+		ensure_equals("(14)", pool.nfree_mbuf_blockq, 0u);
+		ensure_equals("(15)", pool.nslabs, 0u);
+	}
+
+	TEST_METHOD(26) {
+		set_test_name("Slabs that become free are returned to the OS one by one,"
+			" except for one spare slab");
+		mbuf_pool_enable_slabs(&pool);
+		const unsigned int blocksPerSlab = MBUF_SLAB_SIZE / pool.mbuf_block_chunk_size;
+		vector<struct mbuf_block *> blocks;
+		unsigned int i;
+
+		for (i = 0; i < 3 * blocksPerSlab; i++) {
+			blocks.push_back(mbuf_block_get(&pool));
+		}
+		ensure_equals("(1)", pool.nslabs, 3u);
+		ensure_equals("(2)", pool.nactive_mbuf_blockq, 3 * blocksPerSlab);
+
+		for (i = 2 * blocksPerSlab; i < 3 * blocksPerSlab; i++) {
+			mbuf_block_unref(blocks[i]);
+		}
+		ensure_equals("The first free slab is kept as spare (1)", pool.nslabs, 3u);
+		ensure_equals("The first free slab is kept as spare (2)",
+			pool.nfree_mbuf_blockq, blocksPerSlab);
+
+		for (i = blocksPerSlab; i < 2 * blocksPerSlab; i++) {
+			mbuf_block_unref(blocks[i]);
+		}
+		ensure_equals("The second free slab is unmapped (1)", pool.nslabs, 2u);
+		ensure_equals("The second free slab is unmapped (2)",
+			pool.nfree_mbuf_blockq, blocksPerSlab);
+		ensure_equals("The second free slab is unmapped (3)",
+			pool.nactive_mbuf_blockq, blocksPerSlab);
+
+		for (i = 0; i < blocksPerSlab; i++) {
+			mbuf_block_unref(blocks[i]);
+		}
+		ensure_equals("(3)", pool.nslabs, 1u);
+		ensure_equals("(4)", pool.nfree_mbuf_blockq, blocksPerSlab);
+		ensure_equals("(5)", pool.nactive_mbuf_blockq, 0u);
+
+		ensure_equals("(6)", mbuf_pool_compact(&pool), blocksPerSlab);
+		ensure_equals("(7)", pool.nslabs, 0u);
+		ensure_equals("(8)", pool.nfree_mbuf_blockq, 0u);
+	}
+
+	TEST_METHOD(27) {
+		set_test_name("Each size class has its own slabs");
+		mbuf_pool_enable_large_blocks(&pool, DEFAULT_MBUF_LARGE_CHUNK_SIZE);
+		mbuf_pool_enable_slabs(&pool);
+		{
+			mbuf small(mbuf_get_with_size(&pool, 10));
+			mbuf large(mbuf_get_with_size(&pool, mbuf_pool_large_data_size(&pool)));
+			mbuf large2(mbuf_get_with_size(&pool, mbuf_pool_large_data_size(&pool)));
+			ensure_equals("(1)", pool.nslabs, 2u);
+			ensure("(2)", small.mbuf_block->slab != large.mbuf_block->slab);
+			ensure_equals("(3)", large2.mbuf_block->slab, large.mbuf_block->slab);
+			ensure_equals("(4)", large2.mbuf_block->start,
+				large.mbuf_block->start + DEFAULT_MBUF_LARGE_CHUNK_SIZE);
+		}
+		ensure_equals("(5)", pool.nfree_mbuf_blockq, 3u);
+		ensure_equals("(6)", pool.nfree_large_mbuf_blockq, 2u);
+		ensure_equals("(7)", mbuf_pool_compact(&pool), 3u);
+		ensure_equals("(8)", pool.nslabs, 0u);
+	}
 }
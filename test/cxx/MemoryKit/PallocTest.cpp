@@ -10,15 +10,30 @@ using namespace std;
 namespace tut {
 	struct MemoryKit_PallocTest {
 		psg_pool_t *pool;
+		psg_pool_cache_t cache;
 
 		MemoryKit_PallocTest()
 			: pool(NULL)
-			{ }
+		{
+			psg_pool_cache_init(&cache, PSG_DEFAULT_POOL_SIZE);
+		}
 
 		~MemoryKit_PallocTest() {
 			if (pool != NULL) {
 				psg_destroy_pool(pool);
 			}
+			psg_pool_cache_compact(&cache);
+		}
+
+		/** Allocates about `size` bytes from the pool, plus `nlarge` large allocations. */
+		void useCachedPool(size_t size, unsigned int nlarge) {
+			for (size_t i = 0; i < size / 1024; i++) {
+				memset(psg_pnalloc(pool, 1024), 'x', 1024);
+			}
+			for (unsigned int i = 0; i < nlarge; i++) {
+				memset(psg_pnalloc(pool, PSG_MAX_ALLOC_FROM_POOL + 1), 'x',
+					PSG_MAX_ALLOC_FROM_POOL + 1);
+			}
 		}
 	};
 
@@ -439,4 +454,70 @@ namespace tut {
 		ensure("psg_reset_pool fails",
 			!psg_reset_pool(pool, PSG_DEFAULT_POOL_SIZE));
 	}
+
+	TEST_METHOD(21) {
+		set_test_name("A pool with a cache can always be reused after a reset,"
+			" and puts additional data structs and large allocations in the cache");
+		pool = psg_create_pool(PSG_DEFAULT_POOL_SIZE, &cache);
+		ensure_equals("(1)", cache.nmallocs, 1u);
+
+		useCachedPool(3 * PSG_DEFAULT_POOL_SIZE, 2);
+		ensure("(2)", pool->data.next != NULL);
+		uint64_t nmallocs = cache.nmallocs;
+
+		ensure("(3)", psg_reset_pool(pool, PSG_DEFAULT_POOL_SIZE));
+		ensure_equals<void *>("(4)", pool->data.next, NULL);
+		ensure_equals<void *>("(5)", pool->large, NULL);
+		ensure_equals("(6)", pool->nlarge, 0u);
+		ensure("(7)", cache.nblocks >= 3);
+		ensure_equals("(8)", cache.nlarge[0], 2u);
+
+		for (unsigned int i = 0; i < 10; i++) {
+			useCachedPool(3 * PSG_DEFAULT_POOL_SIZE, 2);
+			ensure("(9)", psg_reset_pool(pool, PSG_DEFAULT_POOL_SIZE));
+		}
+		ensure_equals("Steady state usage doesn't call malloc()", cache.nmallocs, nmallocs);
+
+		psg_destroy_pool(pool);
+		pool = psg_create_pool(PSG_DEFAULT_POOL_SIZE, &cache);
+		ensure_equals("Pools are created from cached blocks", cache.nmallocs, nmallocs);
+	}
+
+	TEST_METHOD(22) {
+		set_test_name("A pool with a cache records its usage in the cache's histograms");
+		pool = psg_create_pool(PSG_DEFAULT_POOL_SIZE, &cache);
+
+		useCachedPool(1024, 0);
+		psg_reset_pool(pool, PSG_DEFAULT_POOL_SIZE);
+		ensure_equals("(1)", cache.high_water_marks[0], 1u);
+		ensure_equals("(2)", cache.large_counts[0], 1u);
+
+		useCachedPool(3 * 1024, 1);
+		psg_reset_pool(pool, PSG_DEFAULT_POOL_SIZE);
+		ensure_equals("(3)", cache.high_water_marks[3], 1u);
+		ensure_equals("(4)", cache.large_counts[1], 1u);
+
+		useCachedPool(100 * 1024, 5);
+		psg_reset_pool(pool, PSG_DEFAULT_POOL_SIZE);
+		ensure_equals("(5)", cache.high_water_marks[PSG_POOL_HIGH_WATER_MARK_BUCKETS - 1], 1u);
+		ensure_equals("(6)", cache.large_counts[3], 1u);
+
+		psg_reset_pool(pool, PSG_DEFAULT_POOL_SIZE);
+		ensure_equals("Resetting an unused pool is not recorded", cache.large_counts[0], 1u);
+	}
+
+	TEST_METHOD(23) {
+		set_test_name("psg_pool_cache_compact() frees all cached memory");
+		pool = psg_create_pool(PSG_DEFAULT_POOL_SIZE, &cache);
+		useCachedPool(2 * PSG_DEFAULT_POOL_SIZE, 1);
+		psg_pfree(pool, psg_pnalloc(pool, 10000));
+		psg_reset_pool(pool, PSG_DEFAULT_POOL_SIZE);
+
+		size_t size = psg_pool_cache_size(&cache);
+		ensure_equals("(1)", size, cache.nblocks * PSG_DEFAULT_POOL_SIZE
+			+ PSG_POOL_CACHE_MIN_LARGE_SIZE + 4 * PSG_POOL_CACHE_MIN_LARGE_SIZE);
+		ensure_equals("(2)", psg_pool_cache_compact(&cache), size);
+		ensure_equals("(3)", psg_pool_cache_size(&cache), 0u);
+		ensure_equals("(4)", cache.nblocks, 0u);
+	}
 }
@@ -0,0 +1,183 @@
+#include <TestSupport.h>
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+#include <boost/atomic.hpp>
+#include <boost/thread/barrier.hpp>
+#include <vector>
+#include <BackgroundEventLoop.h>
+#include <SafeLibev.h>
+
+using namespace Passenger;
+using namespace std;
+
+namespace tut {
+	struct SafeLibevTest {
+		BackgroundEventLoop bg;
+		boost::mutex syncher;
+		vector<int> log;
+		boost::atomic<unsigned int> counter;
+		boost::atomic<unsigned int> finishedThreads;
+
+		SafeLibevTest()
+			: bg(false, false),
+			  counter(0),
+			  finishedThreads(0)
+		{
+			bg.start();
+		}
+
+		~SafeLibevTest() {
+			bg.stop();
+		}
+
+		void append(int value) {
+			boost::lock_guard<boost::mutex> l(syncher);
+			log.push_back(value);
+		}
+
+		vector<int> getLog() {
+			boost::lock_guard<boost::mutex> l(syncher);
+			return log;
+		}
+
+		void increment() {
+			counter.fetch_add(1, boost::memory_order_relaxed);
+		}
+
+		void scheduleIncrements(unsigned int count) {
+			for (unsigned int i = 0; i < count; i++) {
+				bg.safe->runLater(boost::bind(&SafeLibevTest::increment, this));
+			}
+		}
+
+		void runIncrementsSynchronously(boost::barrier *barrier, unsigned int count) {
+			for (unsigned int i = 0; i < count; i++) {
+				// Let all threads push at the same time, after which the
+				// queue becomes quiet again.
+				barrier->wait();
+				bg.safe->runSync(boost::bind(&SafeLibevTest::increment, this));
+			}
+			finishedThreads.fetch_add(1, boost::memory_order_relaxed);
+		}
+
+		void scheduleAndCancel(bool *canceled) {
+			unsigned int id = bg.safe->runLater(boost::bind(&SafeLibevTest::append, this, 2));
+			bg.safe->runLater(boost::bind(&SafeLibevTest::append, this, 3));
+			*canceled = bg.safe->cancelCommand(id);
+		}
+
+		void getStats(boost::uint64_t *run, boost::uint64_t *canceled) {
+			*run = bg.safe->getCommandsRun();
+			*canceled = bg.safe->getCommandsCanceled();
+		}
+	};
+
+	DEFINE_TEST_GROUP(SafeLibevTest);
+
+	TEST_METHOD(1) {
+		set_test_name("runLater() runs callbacks in the order in which they were scheduled");
+
+		for (int i = 0; i < 10; i++) {
+			bg.safe->runLater(boost::bind(&SafeLibevTest::append, this, i));
+		}
+		EVENTUALLY(5,
+			result = getLog().size() == 10;
+		);
+		vector<int> result = getLog();
+		for (int i = 0; i < 10; i++) {
+			ensure_equals(result[i], i);
+		}
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("runSync() waits until the callback has been run");
+
+		bg.safe->runSync(boost::bind(&SafeLibevTest::append, this, 1));
+		ensure_equals(getLog().size(), 1u);
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("cancelCommand() prevents a scheduled callback from being run");
+
+		bool canceled = false;
+		bg.safe->runSync(boost::bind(&SafeLibevTest::scheduleAndCancel, this, &canceled));
+		ensure("The command was canceled", canceled);
+		EVENTUALLY(5,
+			result = getLog().size() == 1;
+		);
+		ensure_equals(getLog()[0], 3);
+		SHOULD_NEVER_HAPPEN(100,
+			result = getLog().size() > 1;
+		);
+	}
+
+	TEST_METHOD(4) {
+		set_test_name("cancelCommand() returns false for commands that have already been run");
+
+		unsigned int id = bg.safe->runLater(boost::bind(&SafeLibevTest::append, this, 1));
+		EVENTUALLY(5,
+			result = getLog().size() == 1;
+		);
+		bool canceled = true;
+		bg.safe->runSync(boost::bind(&SafeLibevTest::scheduleAndCancel, this, &canceled));
+		ensure("The recently scheduled command was canceled", canceled);
+
+		struct Canceler {
+			static void cancel(SafeLibev *safe, unsigned int id, bool *result) {
+				*result = safe->cancelCommand(id);
+			}
+		};
+		bg.safe->runSync(boost::bind(Canceler::cancel, bg.safe.get(), id, &canceled));
+		ensure("The old command was not canceled", !canceled);
+	}
+
+	TEST_METHOD(5) {
+		set_test_name("Callbacks scheduled concurrently from multiple threads are all run,"
+			" even when more are pending than the pre-allocated pool can hold");
+
+		boost::thread_group threads;
+		for (int i = 0; i < 4; i++) {
+			threads.create_thread(boost::bind(&SafeLibevTest::scheduleIncrements,
+				this, 5000));
+		}
+		threads.join_all();
+		EVENTUALLY(10,
+			result = counter.load() == 20000;
+		);
+	}
+
+	TEST_METHOD(6) {
+		set_test_name("It keeps statistics about run and canceled commands");
+
+		bool canceled;
+		bg.safe->runSync(boost::bind(&SafeLibevTest::scheduleAndCancel, this, &canceled));
+		EVENTUALLY(5,
+			result = getLog().size() == 1;
+		);
+
+		boost::uint64_t run, canceledCount;
+		bg.safe->runSync(boost::bind(&SafeLibevTest::getStats, this,
+			&run, &canceledCount));
+		// scheduleAndCancel and the callback that appended 3. The getStats
+		// command itself is counted before it runs.
+		ensure_equals(run, (boost::uint64_t) 3);
+		ensure_equals(canceledCount, (boost::uint64_t) 1);
+	}
+
+	TEST_METHOD(7) {
+		set_test_name("runSync() calls from multiple threads all return, even if"
+			" commands are pushed while the event loop empties the queue");
+
+		boost::barrier barrier(4);
+		boost::thread_group threads;
+		for (int i = 0; i < 4; i++) {
+			threads.create_thread(boost::bind(&SafeLibevTest::runIncrementsSynchronously,
+				this, &barrier, 20000));
+		}
+		EVENTUALLY(30,
+			result = finishedThreads.load() == 4;
+		);
+		threads.join_all();
+		ensure_equals(counter.load(), 80000u);
+	}
+}
@@ -0,0 +1,295 @@
+#include <TestSupport.h>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/thread.hpp>
+#include <oxt/system_calls.hpp>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <BackgroundEventLoop.h>
+#include <ServerKit/Server.h>
+#include <ServerKit/AcceptLoadBalancer.h>
+#include <LoggingKit/LoggingKit.h>
+#include <FileDescriptor.h>
+#include <Utils/IOUtils.h>
+
+using namespace Passenger;
+using namespace Passenger::ServerKit;
+using namespace std;
+using namespace oxt;
+
+namespace tut {
+	struct ServerKit_AcceptLoadBalancerTest {
+		struct ServerThread {
+			BackgroundEventLoop *bg;
+			ServerKit::Context *context;
+			Server<Client> *server;
+		};
+
+		ServerKit::Schema skSchema;
+		ServerKit::BaseServerSchema schema;
+		AcceptLoadBalancer< Server<Client> > loadBalancer;
+		vector<ServerThread> threads;
+		vector<int> serverSockets;
+		unsigned short port;
+
+		ServerKit_AcceptLoadBalancerTest()
+			: port(0)
+		{
+			LoggingKit::setLevel(LoggingKit::CRIT);
+		}
+
+		~ServerKit_AcceptLoadBalancerTest() {
+			loadBalancer.shutdown();
+			for (unsigned int i = 0; i < threads.size(); i++) {
+				ServerThread *thr = &threads[i];
+				thr->bg->safe->runSync(boost::bind(&Server<Client>::shutdown,
+					thr->server, true));
+				while (getServerState(thr) != Server<Client>::FINISHED_SHUTDOWN) {
+					syscalls::usleep(10000);
+				}
+				thr->bg->safe->runSync(boost::bind(destroyServer, thr));
+				thr->bg->stop();
+				delete thr->context;
+				delete thr->bg;
+			}
+			for (unsigned int i = 0; i < serverSockets.size(); i++) {
+				safelyClose(serverSockets[i]);
+			}
+			unlink("tmp.server");
+			LoggingKit::setLevel(LoggingKit::Level(DEFAULT_LOG_LEVEL));
+		}
+
+		void createServers(unsigned int count) {
+			for (unsigned int i = 0; i < count; i++) {
+				ServerThread thr;
+				thr.bg = new BackgroundEventLoop(false, true);
+				thr.context = new ServerKit::Context(skSchema);
+				thr.context->libev = thr.bg->safe;
+				thr.context->libuv = thr.bg->libuv_loop;
+				thr.context->initialize();
+				thr.server = new Server<Client>(thr.context, schema);
+				thr.server->initialize();
+				threads.push_back(thr);
+			}
+		}
+
+		void startServers() {
+			for (unsigned int i = 0; i < threads.size(); i++) {
+				threads[i].bg->start();
+			}
+		}
+
+		void initWithLoadBalancer(unsigned int nservers, bool tcp = false) {
+			createServers(nservers);
+			if (tcp) {
+				serverSockets.push_back(createTcpServer("127.0.0.1", 0));
+				port = getPort(serverSockets.back());
+			} else {
+				serverSockets.push_back(createUnixServer("tmp.server"));
+			}
+			loadBalancer.listen(serverSockets.back());
+			for (unsigned int i = 0; i < threads.size(); i++) {
+				loadBalancer.servers.push_back(threads[i].server);
+			}
+			startServers();
+			loadBalancer.start();
+		}
+
+		void initWithReusePort(unsigned int nservers) {
+			createServers(nservers);
+			for (unsigned int i = 0; i < threads.size(); i++) {
+				serverSockets.push_back(createReusePortTcpServer("127.0.0.1", port));
+				if (i == 0) {
+					port = getPort(serverSockets.back());
+				}
+				threads[i].server->listen(serverSockets.back());
+			}
+			startServers();
+		}
+
+		static unsigned short getPort(int fd) {
+			struct sockaddr_in addr;
+			socklen_t len = sizeof(addr);
+			if (getsockname(fd, (struct sockaddr *) &addr, &len) == -1) {
+				int e = errno;
+				throw SystemException("getsockname() failed", e);
+			}
+			return ntohs(addr.sin_port);
+		}
+
+		FileDescriptor connect() {
+			if (port == 0) {
+				return FileDescriptor(connectToUnixServer("tmp.server", __FILE__, __LINE__),
+					NULL, 0);
+			} else {
+				return FileDescriptor(connectToTcpServer("127.0.0.1", port, __FILE__, __LINE__),
+					NULL, 0);
+			}
+		}
+
+		static void destroyServer(ServerThread *thr) {
+			delete thr->server;
+			thr->server = NULL;
+		}
+
+		static Server<Client>::State getServerState(ServerThread *thr) {
+			Server<Client>::State result;
+			thr->bg->safe->runSync(boost::bind(_getServerState, thr, &result));
+			return result;
+		}
+
+		static void _getServerState(ServerThread *thr, Server<Client>::State *result) {
+			*result = thr->server->serverState;
+		}
+
+		unsigned long getTotalClientsAccepted(unsigned int i) {
+			unsigned long result;
+			threads[i].bg->safe->runSync(boost::bind(_getTotalClientsAccepted,
+				&threads[i], &result));
+			return result;
+		}
+
+		unsigned long getTotalClientsAccepted() {
+			unsigned long result = 0;
+			for (unsigned int i = 0; i < threads.size(); i++) {
+				result += getTotalClientsAccepted(i);
+			}
+			return result;
+		}
+
+		static void _getTotalClientsAccepted(ServerThread *thr, unsigned long *result) {
+			*result = thr->server->totalClientsAccepted;
+		}
+
+		void connectAndClose(unsigned int count) {
+			for (unsigned int i = 0; i < count; i++) {
+				connect().close();
+			}
+		}
+
+		double measureConnectionRate(unsigned int nclients, unsigned int connectionsPerClient) {
+			boost::thread_group clients;
+			unsigned long long startTime = SystemTime::getMonotonicUsec();
+
+			for (unsigned int i = 0; i < nclients; i++) {
+				clients.create_thread(boost::bind(
+					&ServerKit_AcceptLoadBalancerTest::connectAndClose,
+					this, connectionsPerClient));
+			}
+			clients.join_all();
+			while (getTotalClientsAccepted() < nclients * connectionsPerClient) {
+				syscalls::usleep(1000);
+			}
+
+			unsigned long long endTime = SystemTime::getMonotonicUsec();
+			return nclients * connectionsPerClient / ((endTime - startTime) / 1000000.0);
+		}
+	};
+
+	DEFINE_TEST_GROUP(ServerKit_AcceptLoadBalancerTest);
+
+	TEST_METHOD(1) {
+		set_test_name("It distributes clients over equally busy servers in a round-robin manner");
+
+		initWithLoadBalancer(2);
+		FileDescriptor fd1(connect());
+		FileDescriptor fd2(connect());
+		FileDescriptor fd3(connect());
+		FileDescriptor fd4(connect());
+		EVENTUALLY(5,
+			result = getTotalClientsAccepted(0) == 2u
+				&& getTotalClientsAccepted(1) == 2u;
+		);
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("It prefers the server with the fewest active clients");
+
+		initWithLoadBalancer(2);
+		vector<FileDescriptor> fds;
+		int directFds[3];
+		for (unsigned int i = 0; i < 3; i++) {
+			int sockets[2];
+			if (socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) == -1) {
+				int e = errno;
+				throw SystemException("socketpair() failed", e);
+			}
+			setNonBlocking(sockets[1]);
+			fds.push_back(FileDescriptor(sockets[0], NULL, 0));
+			directFds[i] = sockets[1];
+		}
+		threads[0].bg->safe->runSync(boost::bind(&Server<Client>::feedNewClients,
+			threads[0].server, directFds, 3u));
+
+		FileDescriptor fd1(connect());
+		FileDescriptor fd2(connect());
+		FileDescriptor fd3(connect());
+		EVENTUALLY(5,
+			result = getTotalClientsAccepted(1) == 3u;
+		);
+		ensure_equals(getTotalClientsAccepted(0), 3u);
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("In reuse port mode, every server accepts clients on its own "
+			"socket that is bound to the same port");
+
+		initWithReusePort(2);
+		vector<FileDescriptor> fds;
+		for (unsigned int i = 0; i < 16; i++) {
+			fds.push_back(connect());
+		}
+		EVENTUALLY(5,
+			result = getTotalClientsAccepted() == 16u;
+		);
+	}
+
+	TEST_METHOD(4) {
+		set_test_name("In reuse port mode, clients are still accepted when the"
+			" CPU steering filter is attached");
+
+		initWithReusePort(2);
+		try {
+			attachReusePortCpuFilter(serverSockets[0], 2);
+		} catch (const SystemException &e) {
+			if (e.code() == ENOSYS) {
+				// Not supported on this platform.
+				return;
+			}
+			throw;
+		}
+
+		vector<FileDescriptor> fds;
+		for (unsigned int i = 0; i < 16; i++) {
+			fds.push_back(connect());
+		}
+		EVENTUALLY(5,
+			result = getTotalClientsAccepted() == 16u;
+		);
+	}
+
+	TEST_METHOD(5) {
+		set_test_name("Benchmark: connection rate through the load balancer");
+		ONLY_RUN_IN_BENCHMARK_MODE();
+
+		unsigned int nthreads = std::max(2u, boost::thread::hardware_concurrency());
+		initWithLoadBalancer(nthreads, true);
+		double rate = measureConnectionRate(nthreads, 2000);
+		fprintf(stderr, "AcceptLoadBalancer, %u threads: %.0f connections/sec\n",
+			nthreads, rate);
+	}
+
+	TEST_METHOD(6) {
+		set_test_name("Benchmark: connection rate with per-thread SO_REUSEPORT sockets");
+		ONLY_RUN_IN_BENCHMARK_MODE();
+
+		unsigned int nthreads = std::max(2u, boost::thread::hardware_concurrency());
+		initWithReusePort(nthreads);
+		double rate = measureConnectionRate(nthreads, 2000);
+		fprintf(stderr, "SO_REUSEPORT, %u threads: %.0f connections/sec\n",
+			nthreads, rate);
+	}
+}
@@ -27,6 +27,7 @@ namespace tut {
 			psg_lstr_append(&header->origKey, pool, downcasedKey.data(), downcasedKey.size());
 			psg_lstr_append(&header->val, pool, val.data(), val.size());
 			header->hash = downcasedKey.hash();
+			header->id = httpHeaderIdTable.lookup(header->hash, &header->key);
 			return header;
 		}
 
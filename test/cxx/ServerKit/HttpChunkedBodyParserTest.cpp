@@ -0,0 +1,318 @@
+#include <TestSupport.h>
+#include <LoggingKit/LoggingKit.h>
+#include <MemoryKit/mbuf.h>
+#include <ServerKit/HttpChunkedBodyParser.h>
+#include <boost/cstdint.hpp>
+#include <cstdio>
+#include <ctime>
+#include <string>
+#include <vector>
+
+using namespace Passenger;
+using namespace Passenger::ServerKit;
+using namespace std;
+
+namespace tut {
+	struct ChunkedParseResult {
+		string data;
+		HttpChunkedEvent::Type type;
+		int errcode;
+		size_t consumed;
+
+		ChunkedParseResult()
+			: type(HttpChunkedEvent::NONE),
+			  errcode(0),
+			  consumed(0)
+			{ }
+	};
+
+	struct ServerKit_HttpChunkedBodyParserTest {
+		HttpChunkedBodyParserState state;
+		HttpChunkedBodyParser parser;
+		boost::uint32_t randomState;
+
+		ServerKit_HttpChunkedBodyParserTest()
+			: parser(&state, formatLoggingPrefix, NULL),
+			  randomState(1234)
+			{ }
+
+		static unsigned int formatLoggingPrefix(char *buf, unsigned int bufsize, void *userData) {
+			return 0;
+		}
+
+		/** A deterministic pseudo-random number generator, so that failures are reproducible. */
+		unsigned int random(unsigned int max) {
+			randomState = randomState * 1103515245 + 12345;
+			return (randomState >> 16) % max;
+		}
+
+		/** Parses the given pieces with feed(), one event at a time. */
+		ChunkedParseResult parseWithFeed(const vector<string> &pieces) {
+			ChunkedParseResult result;
+
+			parser.initialize();
+			for (unsigned int i = 0; i < pieces.size(); i++) {
+				size_t offset = 0;
+				while (offset < pieces[i].size()) {
+					HttpChunkedEvent event(parser.feed(MemoryKit::mbuf(
+						pieces[i].data() + offset, pieces[i].size() - offset)));
+					offset += event.consumed;
+					result.consumed += event.consumed;
+					if (event.type == HttpChunkedEvent::DATA) {
+						result.data.append(event.data.start, event.data.size());
+					} else if (event.type == HttpChunkedEvent::END
+						|| event.type == HttpChunkedEvent::ERROR)
+					{
+						result.type = event.type;
+						result.errcode = event.errcode;
+						return result;
+					}
+				}
+			}
+			return result;
+		}
+
+		/** Parses the given pieces with feedMultiple(). */
+		ChunkedParseResult parseWithFeedMultiple(const vector<string> &pieces,
+			unsigned int maxSlices)
+		{
+			ChunkedParseResult result;
+			MemoryKit::mbuf slices[16];
+			unsigned int nslices;
+
+			parser.initialize();
+			for (unsigned int i = 0; i < pieces.size(); i++) {
+				size_t offset = 0;
+				while (offset < pieces[i].size()) {
+					HttpChunkedEvent event(parser.feedMultiple(MemoryKit::mbuf(
+						pieces[i].data() + offset, pieces[i].size() - offset),
+						slices, maxSlices, nslices));
+					offset += event.consumed;
+					result.consumed += event.consumed;
+					ensure(nslices <= maxSlices);
+					for (unsigned int j = 0; j < nslices; j++) {
+						result.data.append(slices[j].start, slices[j].size());
+					}
+					if (event.type == HttpChunkedEvent::END
+						|| event.type == HttpChunkedEvent::ERROR)
+					{
+						result.type = event.type;
+						result.errcode = event.errcode;
+						return result;
+					}
+				}
+			}
+			return result;
+		}
+
+		vector<string> splitRandomly(const string &input) {
+			vector<string> pieces;
+			size_t offset = 0;
+			while (offset < input.size()) {
+				size_t size = std::min<size_t>(1 + random(64), input.size() - offset);
+				pieces.push_back(input.substr(offset, size));
+				offset += size;
+			}
+			return pieces;
+		}
+
+		string createRandomChunkedBody(string &expectedData) {
+			const char *hexDigits = random(2) ? "0123456789abcdef" : "0123456789ABCDEF";
+			unsigned int count = random(20);
+			string result;
+
+			for (unsigned int i = 0; i < count; i++) {
+				unsigned int size = 1 + random(300);
+				string data;
+				for (unsigned int j = 0; j < size; j++) {
+					data.append(1, (char) random(256));
+				}
+				expectedData.append(data);
+
+				string sizeLine;
+				while (size > 0) {
+					sizeLine.insert(0, 1, hexDigits[size % 16]);
+					size /= 16;
+				}
+				if (random(8) == 0) {
+					sizeLine.insert(0, "00");
+				}
+				if (random(8) == 0) {
+					sizeLine.append(";name=value");
+				}
+				result.append(sizeLine + "\r\n" + data + "\r\n");
+			}
+			result.append("0\r\n\r\n");
+			return result;
+		}
+
+		void mutateRandomly(string &input) {
+			unsigned int pos = random(input.size());
+			switch (random(3)) {
+			case 0:
+				input[pos] = (char) random(256);
+				break;
+			case 1:
+				input.insert(pos, 1, "0123456789aF;\r\nx"[random(16)]);
+				break;
+			default:
+				input.erase(pos, 1 + random(4));
+				break;
+			}
+		}
+
+		void ensureSameResult(const string &description, const ChunkedParseResult &expected,
+			const ChunkedParseResult &actual)
+		{
+			ensure((description + ": data").c_str(), actual.data == expected.data);
+			ensure_equals((description + ": type").c_str(), actual.type, expected.type);
+			ensure_equals((description + ": errcode").c_str(), actual.errcode, expected.errcode);
+			ensure_equals((description + ": consumed").c_str(), actual.consumed, expected.consumed);
+		}
+
+		void ensureSameResultForAllMethods(const string &description, const string &input) {
+			vector<string> whole;
+			vector<string> pieces = splitRandomly(input);
+			unsigned int maxSlices[] = { 1, 3, 16 };
+
+			whole.push_back(input);
+			ChunkedParseResult expected = parseWithFeed(whole);
+			ensureSameResult(description + ", split randomly", expected,
+				parseWithFeed(pieces));
+			for (unsigned int i = 0; i < sizeof(maxSlices) / sizeof(unsigned int); i++) {
+				ensureSameResult(description + ", feedMultiple(" + toString(maxSlices[i]) + ")",
+					expected, parseWithFeedMultiple(whole, maxSlices[i]));
+				ensureSameResult(description + ", feedMultiple(" + toString(maxSlices[i])
+					+ "), split randomly", expected, parseWithFeedMultiple(pieces, maxSlices[i]));
+			}
+		}
+
+		static unsigned long long getNsec() {
+			struct timespec ts;
+			clock_gettime(CLOCK_MONOTONIC, &ts);
+			return (unsigned long long) ts.tv_sec * 1000000000 + ts.tv_nsec;
+		}
+	};
+
+	DEFINE_TEST_GROUP(ServerKit_HttpChunkedBodyParserTest);
+
+	TEST_METHOD(1) {
+		set_test_name("feedMultiple() returns all chunk data as slices of the input buffer");
+		string input = "5\r\nhello\r\n1;foo=bar\r\n \r\n5\r\nworld\r\n0\r\n\r\nextra";
+		MemoryKit::mbuf slices[16];
+		unsigned int nslices;
+
+		parser.initialize();
+		HttpChunkedEvent event(parser.feedMultiple(MemoryKit::mbuf(input.data(), input.size()),
+			slices, 16, nslices));
+		ensure_equals(event.type, HttpChunkedEvent::END);
+		ensure_equals(event.consumed, input.size() - 5);
+		ensure_equals(nslices, 3u);
+		ensure_equals<const void *>(slices[0].start, input.data() + 3);
+		ensure_equals(StaticString(slices[0].start, slices[0].size()), "hello");
+		ensure_equals(StaticString(slices[1].start, slices[1].size()), " ");
+		ensure_equals(StaticString(slices[2].start, slices[2].size()), "world");
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("feedMultiple() returns a DATA event when the slices array is full");
+		string input = "1\r\na\r\n1\r\nb\r\n1\r\nc\r\n0\r\n\r\n";
+		MemoryKit::mbuf slices[2];
+		unsigned int nslices;
+
+		parser.initialize();
+		HttpChunkedEvent event(parser.feedMultiple(MemoryKit::mbuf(input.data(), input.size()),
+			slices, 2, nslices));
+		ensure_equals(event.type, HttpChunkedEvent::DATA);
+		ensure_equals(event.consumed, 10u);
+		ensure_equals(nslices, 2u);
+
+		event = parser.feedMultiple(MemoryKit::mbuf(input.data() + 10, input.size() - 10),
+			slices, 2, nslices);
+		ensure_equals(event.type, HttpChunkedEvent::END);
+		ensure_equals(nslices, 1u);
+		ensure_equals(StaticString(slices[0].start, slices[0].size()), "c");
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("feed() and feedMultiple() give the same results on a corpus of"
+			" valid and invalid input");
+		const char *corpus[] = {
+			"0\r\n\r\n",
+			"5\r\nhello\r\n0\r\n\r\n",
+			"5;ext=1\r\nhello\r\n0;ext\r\n\r\n",
+			"A\r\n0123456789\r\na\r\n0123456789\r\n0\r\n\r\n",
+			"0005\r\nhello\r\n0\r\n\r\n",
+			"zz\r\n",
+			"5\r\nhelloX",
+			"5\rX",
+			"5\r\nhello\r\n0\r\nX",
+			"5\r\nhello\r\n0\r\n\rX",
+			"5\r\nhello\r\n5",
+			"ffffffffff\r\n",
+			"19999999\r\n",
+			"1999999a\r\n",
+			"\r\n",
+			";\r\n"
+		};
+
+		for (unsigned int i = 0; i < sizeof(corpus) / sizeof(const char *); i++) {
+			ensureSameResultForAllMethods("Corpus entry " + toString(i), corpus[i]);
+		}
+	}
+
+	TEST_METHOD(4) {
+		set_test_name("feed() and feedMultiple() give the same results on randomly"
+			" generated and corrupted input");
+
+		for (unsigned int i = 0; i < 2000; i++) {
+			string expectedData;
+			string input = createRandomChunkedBody(expectedData);
+			if (i % 2 == 0) {
+				vector<string> whole;
+				whole.push_back(input);
+				ChunkedParseResult result = parseWithFeedMultiple(whole, 16);
+				ensure_equals(result.type, HttpChunkedEvent::END);
+				ensure(result.data == expectedData);
+			} else {
+				mutateRandomly(input);
+			}
+			ensureSameResultForAllMethods("Fuzz input " + toString(i), input);
+		}
+	}
+
+	TEST_METHOD(5) {
+		set_test_name("Benchmark: parsing a body consisting of many small chunks,"
+			" feed() versus feedMultiple()");
+		ONLY_RUN_IN_BENCHMARK_MODE();
+
+		const unsigned int iterations = 20000;
+		string input;
+		while (input.size() < 16 * 1024) {
+			input.append("10\r\n0123456789abcdef\r\n");
+		}
+		MemoryKit::mbuf buffer(input.data(), input.size());
+		MemoryKit::mbuf slices[16];
+		unsigned int nslices;
+		size_t total = 0;
+
+		for (int multiple = 0; multiple <= 1; multiple++) {
+			unsigned long long startTime = getNsec();
+			for (unsigned int i = 0; i < iterations; i++) {
+				size_t offset = 0;
+				parser.initialize();
+				while (offset < input.size()) {
+					HttpChunkedEvent event = multiple
+						? parser.feedMultiple(MemoryKit::mbuf(buffer, offset), slices, 16, nslices)
+						: parser.feed(MemoryKit::mbuf(buffer, offset));
+					offset += event.consumed;
+					total += event.consumed;
+				}
+			}
+			unsigned long long duration = getNsec() - startTime;
+			fprintf(stderr, "%s: %.0f MB/s\n", multiple ? "feedMultiple()" : "feed()",
+				input.size() * (double) iterations / (duration / 1000.0));
+		}
+		ensure(total > 0);
+	}
+}
@@ -0,0 +1,92 @@
+#include <TestSupport.h>
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+#include <boost/atomic.hpp>
+#include <Utils/ShardedSharedMutex.h>
+
+using namespace Passenger;
+using namespace std;
+
+namespace tut {
+	struct ShardedSharedMutexTest {
+		ShardedSharedMutex mutex;
+		boost::atomic<int> readers;
+		boost::atomic<bool> done;
+		unsigned int counter;
+
+		ShardedSharedMutexTest()
+			: readers(0),
+			  done(false),
+			  counter(0)
+			{ }
+
+		void holdSharedLock() {
+			boost::shared_lock<ShardedSharedMutex> l(mutex);
+			readers.fetch_add(1);
+			while (!done.load()) {
+				usleep(1000);
+			}
+			readers.fetch_sub(1);
+		}
+
+		void lockSharedAndExclusive(unsigned int count) {
+			for (unsigned int i = 0; i < count; i++) {
+				if (i % 4 == 0) {
+					boost::unique_lock<ShardedSharedMutex> l(mutex);
+					counter++;
+				} else {
+					boost::shared_lock<ShardedSharedMutex> l(mutex);
+					(void) counter;
+				}
+			}
+		}
+	};
+
+	DEFINE_TEST_GROUP(ShardedSharedMutexTest);
+
+	TEST_METHOD(1) {
+		set_test_name("Multiple threads can hold the lock in shared mode at the same time");
+
+		boost::thread_group threads;
+		for (int i = 0; i < 4; i++) {
+			threads.create_thread(boost::bind(&ShardedSharedMutexTest::holdSharedLock, this));
+		}
+		EVENTUALLY(5,
+			result = readers.load() == 4;
+		);
+		ensure("The lock can't be obtained exclusively", !mutex.try_lock());
+		done.store(true);
+		threads.join_all();
+		ensure("The lock can be obtained exclusively", mutex.try_lock());
+		mutex.unlock();
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("The lock can't be obtained in shared mode while it's held exclusively");
+
+		mutex.lock();
+		boost::thread thr(boost::bind(&ShardedSharedMutexTest::holdSharedLock, this));
+		SHOULD_NEVER_HAPPEN(100,
+			result = readers.load() > 0;
+		);
+		mutex.unlock();
+		EVENTUALLY(5,
+			result = readers.load() == 1;
+		);
+		done.store(true);
+		thr.join();
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("Exclusive lockers are serialized, also when running concurrently"
+			" with shared lockers");
+
+		boost::thread_group threads;
+		for (int i = 0; i < 20; i++) {
+			threads.create_thread(boost::bind(&ShardedSharedMutexTest::lockSharedAndExclusive,
+				this, 4000));
+		}
+		threads.join_all();
+		ensure_equals(counter, 20u * 1000u);
+	}
+}
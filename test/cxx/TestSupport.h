@@ -98,6 +98,16 @@ using namespace oxt;
 		} \
 	} while (false)
 
+// Benchmarks only run when PASSENGER_BENCHMARKS is set because they
+// take a while and their results only make sense on an idle machine.
+// They print their results to stderr instead of asserting on them.
+#define ONLY_RUN_IN_BENCHMARK_MODE() \
+	do { \
+		if (getenv("PASSENGER_BENCHMARKS") == NULL) { \
+			return; \
+		} \
+	} while (false)
+
 
 extern ResourceLocator *resourceLocator;
 extern Json::Value testConfig;
@@ -41,5 +41,24 @@ namespace tut {
 		snprintf(s, 10, "h\xeallo"); // hêllo
 		string result = escapeHTML(s);
 		ensure_equals(result, "h?llo");
+	} TEST_METHOD(5) {
+		set_test_name("convertLowerCase() only converts A-Z, at any length and alignment");
+		unsigned char input[256 + 64], output[256 + 64];
+		for (unsigned int i = 0; i < 256; i++) {
+			input[i] = (unsigned char) i;
+		}
+		for (unsigned int i = 0; i < 64; i++) {
+			input[256 + i] = (unsigned char) ('A' + i % 26);
+		}
+		for (unsigned int offset = 0; offset < 17; offset++) {
+			for (unsigned int len = 0; len <= 256 + 64 - offset; len += 7) {
+				convertLowerCase(input + offset, output, len);
+				for (unsigned int i = 0; i < len; i++) {
+					unsigned char c = input[offset + i];
+					unsigned char expected = (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+					ensure_equals(output[i], expected);
+				}
+			}
+		}
 	}
 }